@@ -11,7 +11,12 @@
  */
 
 #import <Foundation/Foundation.h>
+
+// the model layer is also built without UIKit, such as by the benchmarks on
+// Linux, where Foundation defines CGFloat
+#if __has_include(<UIKit/UIKit.h>)
 #import <UIKit/UIkit.h>
+#endif
 
 /** Button tags of the calculator */
 typedef NS_ENUM(NSInteger, NIBButtonTag) {
@@ -8,6 +8,7 @@
 
 #import "AppDelegate.h"
 #import "NIBCalculatorViewController+Store.h"
+#import "NIBInstrumentation.h"
 
 @implementation AppDelegate
 
@@ -20,6 +21,26 @@
     return YES;
 }
 
+- (void)applicationDidEnterBackground:(UIApplication * __unused)application
+{
+    NIBCalculatorViewController *viewController = nil;
+    
+    if ([self.window.rootViewController isKindOfClass:[NIBCalculatorViewController class]]) {
+        viewController = (NIBCalculatorViewController *)self.window.rootViewController;
+    }
+    
+    /* the data is written in the background, the app may be suspended before the next launch */
+    [viewController archiveData];
+    
+    /* if the instrumentation is compiled in, export what it records to the documents */
+    if ([NIBInstrumentation isEnabled]) {
+        NSString *documentsPath = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) firstObject];
+        
+        [NIBInstrumentation writeSnapshotToFile:[documentsPath stringByAppendingPathComponent:@"Instrumentation.json"]];
+        [NIBInstrumentation writeChromeTraceToFile:[documentsPath stringByAppendingPathComponent:@"Instrumentation.trace.json"]];
+    }
+}
+
 - (void)applicationWillTerminate:(UIApplication * __unused)application
 {
     NIBCalculatorViewController *viewController = nil;
@@ -28,7 +49,9 @@
         viewController = (NIBCalculatorViewController *)self.window.rootViewController;
     }
     
+    /* the data must be written before the app terminates */
     [viewController archiveData];
+    [viewController waitUntilDataArchived];
 }
 
 @end
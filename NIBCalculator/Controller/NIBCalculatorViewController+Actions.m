@@ -11,11 +11,37 @@
 #import "NIBCalculatorViewController+UpdateDisplay.h"
 #import "NIBOperator.h"
 #import "NIBCalculatorBrain.h"
+#import "NIBCalculatorEvaluator.h"
+#import "NIBCalculatorFuture.h"
 #import "NIBCalculatorPortraitView.h"
 #import "NIBCalculatorLandscapeView.h"
 #import "NIBSelectionLabel.h"
 #import "NIBViewUtilities.h"
+#import "NIBNumberFormatterPool.h"
+#import "NIBDecimalFormatter.h"
 #import "NIBConstants.h"
+#import "NIBInstrumentation.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A block which performs an operation with the calculator and the number string
+ of the current main display on the queue of the evaluator.
+ 
+ @param calculator  The calculator.
+ @param numStr      The number string without grouping separators.
+ @param maxDigits   The maximum digits of the result to display.
+ 
+ @return Returns the result to display, or nil to keep the main displays.
+ */
+typedef NSNumber *_Nullable (^NIBMainDisplayOperation)(NIBCalculatorBrain *calculator, NSString *numStr, NSUInteger *maxDigits);
+
+NS_ASSUME_NONNULL_END
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -44,15 +70,44 @@ NS_ASSUME_NONNULL_BEGIN
 @interface NIBCalculatorViewController (Actions_Private)
 
 /**
- Count the number of digits of a result after performing an operator
+ Count the number of digits of the result of peeking an operator. It is called
+ by the operations on the queue of the evaluator, off the main thread.
+ 
+ @param operator    The operator to peek.
+ @param calculator  The calculator to peek the operator.
+ 
+ @return Returns the number of digits of the result if the operator would have
+ a result, otherwise 0.
+ */
+- (NSUInteger)digitsOfPeekingOperator:(NIBOperator *)operator
+                         onCalculator:(NIBCalculatorBrain *)calculator;
+
+/**
+ Count the number of digits of a result after performing an operator. It is
+ called by the operations on the queue of the evaluator, off the main thread.
  
- @param operator The operator to perform.
+ @param operator    The operator to perform.
+ @param calculator  The calculator to perform the operator.
+ @param isPortrait  The boolean value to indicate if the current view is
+                    portrait.
  
  @return Returns the number of digits of the result if the result can be
  calculated. Otherwise, a number of maximum displayable digits of the current
  main display.
  */
-- (NSUInteger)digitsOfResultAfterPerfomingOperator:(NIBOperator *)operator;
+- (NSUInteger)digitsOfResultAfterPerfomingOperator:(NIBOperator *)operator
+                                      onCalculator:(NIBCalculatorBrain *)calculator
+                                        inPortrait:(BOOL)isPortrait;
+
+/**
+ Evaluate an operation with the number string of the current main display in
+ the background and display its result in the next frame. If the result of an
+ evaluation is pending, the number string is the one of the result, as if it
+ were displayed already.
+ 
+ @param operation The operation to evaluate.
+ */
+- (void)evaluateOperationWithMainDisplayNumberString:(NIBMainDisplayOperation)operation;
 
 @end
 
@@ -65,20 +120,29 @@ NS_ASSUME_NONNULL_END
 
 @implementation NIBCalculatorViewController (Actions_Private)
 
-- (NSUInteger)digitsOfResultAfterPerfomingOperator:(NIBOperator *)operator
+- (NSUInteger)digitsOfPeekingOperator:(NIBOperator *)operator
+                         onCalculator:(NIBCalculatorBrain *)calculator
 {
-    /* determine the max digits to display */
-    NSUInteger maxDigits;
+    double result;
     
-    NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-    numberFormatter.locale = [NSLocale currentLocale];
-    numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-    numberFormatter.maximumFractionDigits = NIBMaxDigitsInLandscape;
+    /* if the operator would have no result, there are no digits to count */
+    if (![calculator peekOperator:operator withResult:&result]) {
+        return 0;
+    }
     
-    maxDigits = [self digitsOfString:[numberFormatter stringFromNumber:[self.calculator performOperator:operator withExperimentalModeOn:YES]]];
+    /* count the digits of the result without creating its string */
+    return [[NIBNumberFormatterPool fastDecimalFormatter] digitsOfDouble:result maximumFractionDigits:NIBMaxDigitsInLandscape];
+}
+
+- (NSUInteger)digitsOfResultAfterPerfomingOperator:(NIBOperator *)operator
+                                      onCalculator:(NIBCalculatorBrain *)calculator
+                                        inPortrait:(BOOL)isPortrait
+{
+    /* determine the max digits to display */
+    NSUInteger maxDigits = [self digitsOfPeekingOperator:operator onCalculator:calculator];
     
     if (maxDigits == 0) {
-        if ([self.currentCalculatorView isKindOfClass:[NIBCalculatorPortraitView class]]) {
+        if (isPortrait) {
             maxDigits = NIBMaxDigitsInPortrait;
         } else {
             maxDigits = NIBMaxDigitsInLandscape;
@@ -88,6 +152,49 @@ NS_ASSUME_NONNULL_END
     return maxDigits;
 }
 
+- (void)evaluateOperationWithMainDisplayNumberString:(NIBMainDisplayOperation)operation
+{
+    NIBCalculatorFuture *pendingEvaluation = self.pendingEvaluation;
+    NSUInteger currentDisplayIdx = [self.currentCalculatorView isKindOfClass:[NIBCalculatorPortraitView class]] ? 0 : 1;
+    
+    /* the texts of the main displays when the operation starts, which are not known yet if a result is pending */
+    __block NSArray<NSString *> *texts = nil;
+    __block NSNumber *number = nil;
+    __block NSUInteger maxDigits = 0;
+    
+    if (!pendingEvaluation) {
+        texts = @[self.portraitCalculatorView.mainDisplay.text, self.landscapeCalculatorView.mainDisplay.text];
+    }
+    
+    // the operation and the texts of its result are two evaluations, so the
+    // texts are skipped if they are discarded before they start, while the
+    // operation still changes the calculator as the next operations expect
+    [self.evaluator evaluate:^id (NIBCalculatorBrain *calculator, NIBCalculatorFuture * __unused future) {
+        /* if a result is pending, its evaluation is finished before this one */
+        if (!texts) {
+            texts = pendingEvaluation.result ?: @[NIBMainDisplayDefaultText, NIBMainDisplayDefaultText];
+        }
+        
+        NSString *numStr = [self stringFromString:texts[currentDisplayIdx]
+                              withRevmovalOptions:NIBSymbolRemovalGroupingSeparator];
+        
+        number = operation(calculator, numStr, &maxDigits);
+        
+        return number;
+    }];
+    
+    NIBCalculatorFuture *evaluation = [self.evaluator evaluate:^id (NIBCalculatorBrain * __unused calculator, NIBCalculatorFuture * __unused future) {
+        /* if there is no result, the main displays keep their texts */
+        if (!number) {
+            return texts;
+        }
+        
+        return [self mainDisplayTextsOfNumber:number maxDisplayableDigits:maxDigits];
+    }];
+    
+    [self displayResultOfEvaluation:evaluation];
+}
+
 @end
 
 
@@ -107,6 +214,8 @@ NS_ASSUME_NONNULL_END
 
 - (void)swipeRightMainDisplay
 {
+    [self finishPendingEvaluation];
+    
     /* if the result is displayed, do nothing */
     if (self.isResultDisplayed) {
         return;
@@ -149,6 +258,7 @@ NS_ASSUME_NONNULL_END
     
     /* if main display is not selected */
     if (!self.isMainDisplaySelected) {
+        [self finishPendingEvaluation];
         [self becomeFirstResponder];
         
         /* size of current number string */
@@ -232,7 +342,15 @@ NS_ASSUME_NONNULL_END
 
 - (void)clearArithmeticOperations
 {
-    [self.calculator clearArithmetic];
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
+    
+    /* the operations which are not started are cleared anyway, so skip them */
+    [self.evaluator cancelAllEvaluations];
+    [self discardPendingEvaluation];
+    
+    [self.evaluator performChange:^(NIBCalculatorBrain *calculator) {
+        [calculator clearArithmetic];
+    }];
     [self updateMainDisplaysWithString:NIBMainDisplayDefaultText];
     
     /* if main display is selected, deselect it */
@@ -247,6 +365,9 @@ NS_ASSUME_NONNULL_END
 
 - (void)clearMainDisplays
 {
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
+    
+    [self discardPendingEvaluation];
     [self updateMainDisplaysWithString:NIBMainDisplayDefaultText];
     
     /* show arithmetic clear button */
@@ -264,6 +385,10 @@ NS_ASSUME_NONNULL_END
 
 - (void)toggleNegativePrefix
 {
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
+    
+    [self finishPendingEvaluation];
+    
     /* if the current number string is error text, do nothing */
     if ([self.currentCalculatorView.mainDisplay.text containsString:NIBMainDisplayErrorText]) {
         return;
@@ -284,6 +409,8 @@ NS_ASSUME_NONNULL_END
 
 - (void)pressDigitAndDecimalSeparator:(NIBButton *)button
 {
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
+    
     UIView<NIBCalculatorViewProtocol> *currentCalView = self.currentCalculatorView;
     NSString *currentNumberStr = currentCalView.mainDisplay.text;
     NSMutableString *numStr = nil;
@@ -368,7 +495,8 @@ NS_ASSUME_NONNULL_END
             break;
     }
     
-    /* update main displays with number string */
+    /* update main displays with number string instead of the result which is not displayed yet */
+    [self discardPendingEvaluation];
     [self updateMainDisplaysWithString:numStr];
     
     /* allow binary operator to push number */
@@ -390,24 +518,23 @@ NS_ASSUME_NONNULL_END
 
 - (void)performUnaryOperation:(NIBButton *)button
 {
-    NSString *numStr = [self stringFromString:self.currentCalculatorView.mainDisplay.text
-                          withRevmovalOptions:NIBSymbolRemovalGroupingSeparator];
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
     
-    /* if number string is not a number */
-    if ([numStr isEqualToString:NIBMainDisplayErrorText]) {
-        [self.calculator pushOperand:NAN];
-    } else {
-        NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-        numberFormatter.locale = [NSLocale currentLocale];
-        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-        numberFormatter.lenient = YES;
-        
-        [self.calculator pushOperand:[[numberFormatter numberFromString:numStr] doubleValue]];
-    }
+    NIBOperator *operator = [NIBOperator operatorWithTag:button.tag];
     
-    /* update main displays with number from calculation */
-    [self updateMainDisplaysWithNumber:[self.calculator performOperator:[NIBOperator operatorWithTag:button.tag]]
-                  maxDisplayableDigits:NIBMaxDigitsInLandscape];
+    [self evaluateOperationWithMainDisplayNumberString:^NSNumber *(NIBCalculatorBrain *calculator, NSString *numStr, NSUInteger *maxDigits) {
+        /* if number string is not a number */
+        if ([numStr isEqualToString:NIBMainDisplayErrorText]) {
+            [calculator pushOperand:NAN];
+        } else {
+            [calculator pushOperand:[[self numberFromString:numStr] doubleValue]];
+        }
+    
+        /* update main displays with number from calculation */
+        *maxDigits = NIBMaxDigitsInLandscape;
+        
+        return [calculator performOperator:operator];
+    }];
     
     /* result is displayed */
     self.resultDisplayed = YES;
@@ -415,72 +542,15 @@ NS_ASSUME_NONNULL_END
 
 - (void)performBinaryOperation:(NIBButton *)button
 {
-    /* determine the current digits of expression */
-    NSUInteger currentResultDigits = 0;
-    
-    {
-        NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-        numberFormatter.locale = [NSLocale currentLocale];
-        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-        numberFormatter.maximumFractionDigits = NIBMaxDigitsInLandscape;
-
-      NSNumber *number = [self.calculator performOperator:[NIBOperator operatorWithTag:button.tag]
-                                   withExperimentalModeOn:YES];
-        currentResultDigits = [self digitsOfString:[numberFormatter stringFromNumber: number]];
-    }
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
     
-    /* find max digits from binary operation to display on screen */
-    NSString *numStr = [self stringFromString:self.currentCalculatorView.mainDisplay.text
-                          withRevmovalOptions:NIBSymbolRemovalGroupingSeparator];
-    NSUInteger maxDigits;
+    BOOL isPortrait = [self.currentCalculatorView isKindOfClass:[NIBCalculatorPortraitView class]];
+    BOOL canBinaryOperatorPushOperand = self.canBinaryOperatorPushOperand;
+    NSInteger tag = button.tag;
+    NIBOperator *operator = [NIBOperator operatorWithTag:tag];
     
-    switch (button.tag) {
-        case NIBButtonMultiplication:
-            if (currentResultDigits && [self digitsOfString:numStr] <= currentResultDigits) {
-                maxDigits = currentResultDigits * 2;
-            } else {
-                maxDigits = [self digitsOfString:numStr] * 2;
-            }
-            break;
-            
-        case NIBButtonSubstraction:
-            if (currentResultDigits && [self digitsOfString:numStr] <= currentResultDigits) {
-                maxDigits = currentResultDigits;
-            } else {
-                maxDigits = [self digitsOfString:numStr];
-            }
-            break;
-            
-        case NIBButtonAddition:
-            if (currentResultDigits && [self digitsOfString:numStr] <= currentResultDigits) {
-                maxDigits = currentResultDigits + 1;
-            } else {
-                maxDigits = [self digitsOfString:numStr] + 1;
-            }
-            break;
-            
-        default:
-            if ([self.currentCalculatorView isKindOfClass:[NIBCalculatorPortraitView class]]) {
-                maxDigits =  NIBMaxDigitsInPortrait;
-            } else {
-                maxDigits = NIBMaxDigitsInLandscape;
-            }
-            break;
-    }
-    
-    /* if binary operator can push number  */
-    if (self.canBinaryOperatorPushOperand) {
-        /* if number string is not a number */
-        if ([numStr isEqualToString:NIBMainDisplayErrorText]) {
-            [self.calculator pushOperand:NAN];
-        } else {
-            NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-            numberFormatter.locale = [NSLocale currentLocale];
-            numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-            numberFormatter.lenient = YES;
-            [self.calculator pushOperand:[[numberFormatter numberFromString:numStr] doubleValue]];
-        }
-        
+    /* if binary operator can push number, it pushes the number once */
+    if (canBinaryOperatorPushOperand) {
         /* not allow binary operator to push number */
         self.canBinaryOperatorPushOperand = NO;
     }
@@ -500,9 +570,58 @@ NS_ASSUME_NONNULL_END
         [self.currentBinaryOperation toggleEffect];
     }
     
-    /* update main displays with number from calculation */
-    NSNumber *number = [self.calculator performOperator:[NIBOperator operatorWithTag:self.currentBinaryOperation.tag]];
-    [self updateMainDisplaysWithNumber: number maxDisplayableDigits:maxDigits];
+    [self evaluateOperationWithMainDisplayNumberString:^NSNumber *(NIBCalculatorBrain *calculator, NSString *numStr, NSUInteger *maxDigits) {
+        /* determine the current digits of expression */
+        NSUInteger currentResultDigits = [self digitsOfPeekingOperator:operator onCalculator:calculator];
+        
+        /* find max digits from binary operation to display on screen */
+        switch (tag) {
+            case NIBButtonMultiplication:
+                if (currentResultDigits && [self digitsOfString:numStr] <= currentResultDigits) {
+                    *maxDigits = currentResultDigits * 2;
+                } else {
+                    *maxDigits = [self digitsOfString:numStr] * 2;
+                }
+                break;
+                
+            case NIBButtonSubstraction:
+                if (currentResultDigits && [self digitsOfString:numStr] <= currentResultDigits) {
+                    *maxDigits = currentResultDigits;
+                } else {
+                    *maxDigits = [self digitsOfString:numStr];
+                }
+                break;
+                
+            case NIBButtonAddition:
+                if (currentResultDigits && [self digitsOfString:numStr] <= currentResultDigits) {
+                    *maxDigits = currentResultDigits + 1;
+                } else {
+                    *maxDigits = [self digitsOfString:numStr] + 1;
+                }
+                break;
+                
+            default:
+                if (isPortrait) {
+                    *maxDigits =  NIBMaxDigitsInPortrait;
+                } else {
+                    *maxDigits = NIBMaxDigitsInLandscape;
+                }
+                break;
+        }
+        
+        /* if binary operator can push number  */
+        if (canBinaryOperatorPushOperand) {
+            /* if number string is not a number */
+            if ([numStr isEqualToString:NIBMainDisplayErrorText]) {
+                [calculator pushOperand:NAN];
+            } else {
+                [calculator pushOperand:[[self numberFromString:numStr] doubleValue]];
+            }
+        }
+        
+        /* update main displays with number from calculation */
+        return [calculator performOperator:operator];
+    }];
     
     /* result is displayed */
     self.resultDisplayed = YES;
@@ -510,21 +629,10 @@ NS_ASSUME_NONNULL_END
 
 - (void)performEqualityOperation:(NIBButton *)button
 {
-    NSString *numStr = [self stringFromString:self.currentCalculatorView.mainDisplay.text
-                          withRevmovalOptions:NIBSymbolRemovalGroupingSeparator];
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
     
-    /* if number string is not a number */
-    if ([numStr isEqualToString:NIBMainDisplayErrorText]) {
-        [self.calculator pushOperand:NAN];
-        
-        /* otherwise number string is a number */
-    } else {
-        NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-        numberFormatter.locale = [NSLocale currentLocale];
-        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-        numberFormatter.lenient = YES;
-        [self.calculator pushOperand:[[numberFormatter numberFromString:numStr] doubleValue]];
-    }
+    BOOL isPortrait = [self.currentCalculatorView isKindOfClass:[NIBCalculatorPortraitView class]];
+    NIBOperator *operator = [NIBOperator operatorWithTag:button.tag];
     
     /* handle effect of current binary operation */
     if (self.currentBinaryOperation.selected) [self.currentBinaryOperation toggleEffect];
@@ -532,12 +640,22 @@ NS_ASSUME_NONNULL_END
     /* remove cached binary operation */
     if (self.currentBinaryOperation) self.currentBinaryOperation = nil;
     
-    /* determine max digits to display */
-    NSUInteger maxDigits = [self digitsOfResultAfterPerfomingOperator:[NIBOperator operatorWithTag:button.tag]];
+    [self evaluateOperationWithMainDisplayNumberString:^NSNumber *(NIBCalculatorBrain *calculator, NSString *numStr, NSUInteger *maxDigits) {
+        /* if number string is not a number */
+        if ([numStr isEqualToString:NIBMainDisplayErrorText]) {
+            [calculator pushOperand:NAN];
     
-    /* update main displays with number from calculation */
-    NSNumber *number = [self.calculator performOperator:[NIBOperator operatorWithTag:button.tag]];
-    [self updateMainDisplaysWithNumber:number maxDisplayableDigits:maxDigits];
+            /* otherwise number string is a number */
+        } else {
+            [calculator pushOperand:[[self numberFromString:numStr] doubleValue]];
+        }
+        
+        /* determine max digits to display */
+        *maxDigits = [self digitsOfResultAfterPerfomingOperator:operator onCalculator:calculator inPortrait:isPortrait];
+        
+        /* update main displays with number from calculation */
+        return [calculator performOperator:operator];
+    }];
     
     /* result is displayed */
     self.resultDisplayed = YES;
@@ -550,33 +668,40 @@ NS_ASSUME_NONNULL_END
 
 - (void)performParenthesisOperationCalculation:(NIBButton *)button
 {
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
     
-    NSString *numStr = [self stringFromString:self.currentCalculatorView.mainDisplay.text
-                          withRevmovalOptions:NIBSymbolRemovalGroupingSeparator];
+    BOOL isPortrait = [self.currentCalculatorView isKindOfClass:[NIBCalculatorPortraitView class]];
+    BOOL isClosingParenthesis = (button.tag == NIBButtonClosingParenthesis);
+    NIBOperator *operator = [NIBOperator operatorWithTag:button.tag];
     
     /* if button is closing parenthesis */
-    if (button.tag == NIBButtonClosingParenthesis) {
-        NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-        numberFormatter.locale = [NSLocale currentLocale];
-        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-        numberFormatter.lenient = YES;
-        
-        [self.calculator pushOperand:[[numberFormatter numberFromString:numStr] doubleValue]];
+    if (isClosingParenthesis) {
         if (self.currentBinaryOperation.selected) [self.currentBinaryOperation toggleEffect];
         if (self.currentBinaryOperation) self.currentBinaryOperation = nil;
         self.resultDisplayed = YES;
     }
     
-    /* determine max digits to display */
-    NSUInteger maxDigits = [self digitsOfResultAfterPerfomingOperator:[NIBOperator operatorWithTag:button.tag]];
+    [self evaluateOperationWithMainDisplayNumberString:^NSNumber *(NIBCalculatorBrain *calculator, NSString *numStr, NSUInteger *maxDigits) {
+        /* if button is closing parenthesis */
+        if (isClosingParenthesis) {
+            [calculator pushOperand:[[self numberFromString:numStr] doubleValue]];
+        }
     
-    /* update main display with number from calculation */
-    NSNumber *number = [self.calculator performOperator:[NIBOperator operatorWithTag:button.tag]];
-    [self updateMainDisplaysWithNumber:number maxDisplayableDigits:maxDigits];
+        /* determine max digits to display */
+        *maxDigits = [self digitsOfResultAfterPerfomingOperator:operator onCalculator:calculator inPortrait:isPortrait];
+        
+        /* update main display with number from calculation */
+        return [calculator performOperator:operator];
+    }];
 }
 
 - (void)performMemoryOperation:(NIBButton *)button
 {
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
+    
+    /* the memory is used directly with the number on the main display */
+    [self finishPendingEvaluation];
+    
     NSString *numStr = [self stringFromString:self.currentCalculatorView.mainDisplay.text withRevmovalOptions:NIBSymbolRemovalGroupingSeparator];
     NIBButton *memoryReadBtn = [NIBViewUtilities buttonWithTag:NIBButtonMemoryRead fromButtons:self.landscapeCalculatorView.buttons];
     
@@ -604,8 +729,7 @@ NS_ASSUME_NONNULL_END
                 /* turn on visual appearance of the clear button */
                 [memoryReadBtn toggleEffect];
             }
-            NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-            numberFormatter.locale = [NSLocale currentLocale];
+            NSNumberFormatter *numberFormatter = [NIBNumberFormatterPool plainFormatter];
             [self.calculator addToMemory:[[numberFormatter numberFromString:numStr] doubleValue]];
             break;
         }
@@ -617,8 +741,7 @@ NS_ASSUME_NONNULL_END
                 /* turn on visual appearance of the clear button */
                 [memoryReadBtn toggleEffect];
             }
-            NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-            numberFormatter.locale = [NSLocale currentLocale];
+            NSNumberFormatter *numberFormatter = [NIBNumberFormatterPool plainFormatter];
             [self.calculator subtractFromMemory:[[numberFormatter numberFromString:numStr] doubleValue]];
             break;
         }
@@ -648,8 +771,11 @@ NS_ASSUME_NONNULL_END
 
 - (void)getConstantNumber:(NIBButton *)button
 {
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageKeyAction);
+    
     NSNumber *constNum = [self.calculator constantNumber:[NIBOperator operatorWithTag:button.tag]];
     
+    [self discardPendingEvaluation];
     [self updateMainDisplaysWithNumber:constNum maxDisplayableDigits:NIBMaxDigitsInLandscape];
     self.canBinaryOperatorPushOperand = YES;
 }
@@ -680,7 +806,9 @@ NS_ASSUME_NONNULL_END
     } else {
         currentCalView.secondaryDisplay.text = NIBSecondaryDisplayDefaultText;
     }
-    [self.calculator toggleRadianMode];
+    [self.evaluator performChange:^(NIBCalculatorBrain *calculator) {
+        [calculator toggleRadianMode];
+    }];
     [currentCalView toggleAngleMode];
 }
 
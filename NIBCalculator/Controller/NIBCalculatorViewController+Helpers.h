@@ -46,7 +46,8 @@ NS_ASSUME_NONNULL_BEGIN
 /// -------------
 
 /**
- Count the number of digits of a string including exponent symbol.
+ Count the number of digits of a string including exponent symbol. The
+ operations of the evaluator call it off the main thread.
  
  @param numStr The number string to count the number of digits.
  
@@ -56,7 +57,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  Form a string by removing a symbol or symbols according to bitmask of option
- NIBSymbolRemovalOptions
+ NIBSymbolRemovalOptions. The evaluator calls it off the main thread, so it
+ must only read the current locale.
  
  @param numStr  The number string to manipulate.
  @param opts    The bitmask option of NIBSymbolRemovalOptions.
@@ -66,6 +68,18 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSString *)stringFromString:(NSString *)numStr
            withRevmovalOptions:(NIBSymbolRemovalOptions)opts;
 
+/**
+ Parse a number string of the main display. The string is parsed without a
+ number formatter unless it is not in the decimal style of the current locale,
+ such as a string in scientific notation. The operations of the evaluator call
+ it off the main thread.
+ 
+ @param numStr The number string to parse.
+ 
+ @return Returns the number of the string, or nil if the string is not a number.
+ */
+- (NSNumber *_Nullable)numberFromString:(NSString *)numStr;
+
 /**
  Switch between arithmetic clear button
  and clear button.
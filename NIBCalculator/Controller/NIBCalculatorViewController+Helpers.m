@@ -10,6 +10,8 @@
 #import "NIBCalculatorPortraitView.h"
 #import "NIBCalculatorLandscapeView.h"
 #import "NIBViewUtilities.h"
+#import "NIBNumberFormatterPool.h"
+#import "NIBDecimalFormatter.h"
 
 @implementation NIBCalculatorViewController (Helpers)
 
@@ -48,6 +50,19 @@
     return numStr;
 }
 
+- (NSNumber *)numberFromString:(NSString *)numStr
+{
+    double value;
+    
+    /* if the string is in the decimal style, parse it directly */
+    if ([[NIBNumberFormatterPool fastDecimalFormatter] getDouble:&value fromString:numStr]) {
+        return [[NSNumber alloc] initWithDouble:value];
+    }
+    
+    /* otherwise, fall back on the number formatter */
+    return [[NIBNumberFormatterPool lenientDecimalFormatter] numberFromString:numStr];
+}
+
 - (void)toggleArithmeticClearButtonOrClearButton
 {
     [self.portraitCalculatorView toggleArithmeticClearButtonOrClearButton];
@@ -11,7 +11,8 @@
 
 /**
  `NIBCalculatorViewController+Store` is a category that handles the
- archiving/unarchiving of the data of the calcualtor.
+ archiving/unarchiving of the data of the calcualtor. The data is kept in a
+ snapshot, see `NIBCalculatorSnapshot`.
  */
 @interface NIBCalculatorViewController (Store)
 
@@ -21,18 +22,28 @@
 
 /**
  Archive current data of view controller to file. The data includes state of
- the view such as current display of result on screen and the model data.
+ the view such as current display of result on screen and the model data, with
+ the calculation in progress. Only the data which changes since the last
+ archiving is written, and it is written in the background, along with the
+ history of the calculations.
  */
 - (void)archiveData;
 
+/**
+ Wait until the data which is archived is written to file.
+ */
+- (void)waitUntilDataArchived;
+
 /// ----------------------
 /// @name Data Unarchiving
 /// ----------------------
 
 /**
- Read data from the last used data file. The file includes data of states of
- the view such as current display of result on screen and the model data.
- The key used to access the data object is
+ Read data from the snapshot file, which is mapped into memory. The file
+ includes data of states of the view such as current display of result on
+ screen and the model data. If there is no snapshot file, the data is read from
+ the last used data file of the earlier versions. The calculator records the
+ history of the calculations to the tape file from then on.
  */
 - (void)readArchive;
 
@@ -9,16 +9,58 @@
 #import "NIBCalculatorViewController+Store.h"
 #import "NIBCalculatorViewController+UpdateDisplay.h"
 #import "NIBCalculatorBrain.h"
+#import "NIBCalculatorSnapshot.h"
+#import "NIBCalculatorTape.h"
 #import "NIBButton.h"
 #import "NIBCalculatorLandscapeView.h"
 #import "NIBViewUtilities.h"
 
 
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/** Values to indicate the states of the keypad in the keypad field of the snapshot. */
+typedef NS_OPTIONS(uint8_t, NIBKeypadStates) {
+    /** The secondary functional buttons are toggled. */
+    NIBKeypadStateSecondaryFunctionalButtonsToggled = 1 << 0,
+    /** The main display shows the result from an operation. */
+    NIBKeypadStateResultDisplayed = 1 << 1,
+    /** A binary operator can push the number on the main display. */
+    NIBKeypadStateBinaryOperatorCanPushOperand = 1 << 2
+};
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Snapshot Fields
+
+
+/** The snapshot file. */
+static NSString * const NIBSnapshotFile = @"LastUsedData.snapshot";
+
+/** The number string on the main display, empty if it is the default text. */
+static const NIBSnapshotField NIBSnapshotFieldMainDisplayNumberString = NIBSnapshotFieldFirstCustom;
+
+/** The states of the keypad, one byte of NIBKeypadStates. */
+static const NIBSnapshotField NIBSnapshotFieldKeypadStates = NIBSnapshotFieldFirstCustom + 1;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Tape
+
+
+/** The tape file, the log of the history of the calculations. */
+static NSString * const NIBTapeFile = @"History.tape";
+
+/** The number of the last calculations which the tape keeps in memory. */
+static const NSUInteger NIBTapeCapacity = 256;
+
+
 /////////////////////////////////////////////////////////////////////////////
 #pragma mark - Keys Used in Archiving/Unarchiving
 
 
-/** The last used data file */
+/** The last used data file, which is read if there is no snapshot file yet. */
 static NSString * const NIBLastUsedDataFile = @"LastUsedData.plist";
 
 /** The current number string on the main display. */
@@ -35,69 +77,88 @@ static NSString * const NIBLastUsedAngleModeIsRadian = @"NIB Angle Mode Is Radia
 
 
 /////////////////////////////////////////////////////////////////////////////
-#pragma mark - Category Implementation
+#pragma mark - Class Extension
 
 
-@implementation NIBCalculatorViewController (Store)
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBCalculatorViewController ()
+
+@property (readwrite, assign, nonatomic) BOOL resultDisplayed;
+@property (readwrite, assign, nonatomic) BOOL canBinaryOperatorPushOperand;
+@property (readwrite, strong, nonatomic) NIBCalculatorSnapshot *_Nullable snapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
 
 
 /////////////////////////////////////////////////////////////////////////////
-#pragma mark - Data Archiving
+#pragma mark - Private Category
 
 
-- (void)archiveData
-{
-    NSArray *path = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
-    NSString *documentsDir = [path firstObject];
-    NSString *dataPath = [documentsDir stringByAppendingPathComponent:NIBLastUsedDataFile];
-    NSMutableDictionary *dictOfData = [[NSMutableDictionary alloc] init];
+NS_ASSUME_NONNULL_BEGIN
     
-    /* if the main display has result that is not default text */
-    if (![self.currentCalculatorView.mainDisplay.text isEqualToString:NIBMainDisplayDefaultText]) {
-        [dictOfData setObject:self.currentCalculatorView.mainDisplay.text forKey:NIBLastUsedMainDisplayNumberString];
-    } else {
-        [dictOfData setObject:[NSNull null] forKey:NIBLastUsedMainDisplayNumberString];
-    }
+@interface NIBCalculatorViewController (Store_Private)
     
-    /* if the calculator has memory */
-    if (self.calculator.memory) {
-        [dictOfData setObject:self.calculator.memory forKey:NIBLastUsedCalculatorMemory];
-    } else {
-        [dictOfData setObject:[NSNull null] forKey:NIBLastUsedCalculatorMemory];
-    }
+/**
+ Get the snapshot of the calculator, which is loaded from the snapshot file the
+ first time.
     
-    NIBButton *secondaryFunctionalOperationToggleSwitchBtn = [NIBViewUtilities buttonWithTag:NIBButtonSecondaryFunctionalToggleSwitch fromButtons:self.landscapeCalculatorView.buttons];
+ @return Returns the snapshot.
+ */
+- (NIBCalculatorSnapshot *)loadedSnapshot;
     
-    /* if secondary functional button toggled */
-    if (secondaryFunctionalOperationToggleSwitchBtn.selected) {
-        [dictOfData setObject:[NSNumber numberWithBool:YES] forKey:NIBLastUsedSecondaryFunctionalButtonsIsToogled];
-    } else {
-        [dictOfData setObject:[NSNumber numberWithBool:NO] forKey:NIBLastUsedSecondaryFunctionalButtonsIsToogled];
-    }
+/**
+ Read data from the last used data file of the versions before the snapshot.
+ */
+- (void)readLastUsedDataFile;
     
-    /* if angle mode is degree mode */
-    if ([self.landscapeCalculatorView.secondaryDisplay.text isEqualToString:NIBSecondaryDisplayDefaultText]) {
-        [dictOfData setObject:[NSNumber numberWithBool:NO] forKey:NIBLastUsedAngleModeIsRadian];
-    } else {
-        [dictOfData setObject:[NSNumber numberWithBool:YES] forKey:NIBLastUsedAngleModeIsRadian];
-    }
+/**
+ Toggle the secondary functional buttons in landscape.
+ */
+- (void)toggleSecondaryFunctionalButtons;
 
-    [[NSKeyedArchiver archivedDataWithRootObject:dictOfData
-                           requiringSecureCoding:NO error:nil]
-     writeToFile:dataPath
-     atomically:YES];
-}
+/**
+ Show the radian mode in landscape.
+ */
+- (void)showRadianMode;
+
+@end
+
+NS_ASSUME_NONNULL_END
 
 
 /////////////////////////////////////////////////////////////////////////////
-#pragma mark - Data Unarchiving
+#pragma mark - Private Category Implementation
 
 
-- (void)readArchive
+@implementation NIBCalculatorViewController (Store_Private)
+
+- (NIBCalculatorSnapshot *)loadedSnapshot
+{
+    /* if the snapshot is not loaded, load it from the snapshot file */
+    if (!self.snapshot) {
+        NSArray *path = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
+        NSString *snapshotPath = [[path firstObject] stringByAppendingPathComponent:NIBSnapshotFile];
+        
+        self.snapshot = [NIBCalculatorSnapshot snapshotWithContentsOfFile:snapshotPath];
+    }
+    
+    return self.snapshot;
+}
+
+- (void)readLastUsedDataFile
 {
     NSArray *path = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
     NSString *dataPath = [[path firstObject] stringByAppendingPathComponent:NIBLastUsedDataFile];
     NSData *data =  [NSData  dataWithContentsOfFile:dataPath];
+    
+    /* if there is no last used data file, there is nothing to read */
+    if (!data) {
+        return;
+    }
+    
     data = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSMutableDictionary class] fromData:data error:nil];
     
     id obj;
@@ -122,23 +183,153 @@ static NSString * const NIBLastUsedAngleModeIsRadian = @"NIB Angle Mode Is Radia
     /* restore secondary functional operation toggle switch state */
     obj = [data valueForKey:NIBLastUsedSecondaryFunctionalButtonsIsToogled];
     if ([obj isKindOfClass:[NSNumber class]] && [(NSNumber *)obj boolValue]) {
-        NIBButton *secondaryFunctionalOperationToggleSwitchBtn = [NIBViewUtilities buttonWithTag:NIBButtonSecondaryFunctionalToggleSwitch
-                                                                                     fromButtons:self.landscapeCalculatorView.buttons];
-        
-        [secondaryFunctionalOperationToggleSwitchBtn toggleEffect];
-        [self.landscapeCalculatorView toggleSecondaryFunctionalButtons];
+        [self toggleSecondaryFunctionalButtons];
     }
     
     /* restore last used angle mode */
     obj = [data valueForKey:NIBLastUsedAngleModeIsRadian];
     if ([obj isKindOfClass:[NSNumber class]] && [(NSNumber *)obj boolValue] ) {
-        NIBButton *radianBtn = [NIBViewUtilities buttonWithTag:NIBButtonRad
-                                                   fromButtons:self.landscapeCalculatorView.buttons];
+        [self.calculator toggleRadianMode];
+        [self showRadianMode];
+    }
+}
+        
+- (void)toggleSecondaryFunctionalButtons
+{
+    NIBButton *secondaryFunctionalOperationToggleSwitchBtn = [NIBViewUtilities buttonWithTag:NIBButtonSecondaryFunctionalToggleSwitch
+                                                                                 fromButtons:self.landscapeCalculatorView.buttons];
+    
+    [secondaryFunctionalOperationToggleSwitchBtn toggleEffect];
+    [self.landscapeCalculatorView toggleSecondaryFunctionalButtons];
+}
+
+- (void)showRadianMode
+{
+    NIBButton *radianBtn = [NIBViewUtilities buttonWithTag:NIBButtonRad
+                                               fromButtons:self.landscapeCalculatorView.buttons];
+    
+    /* toggle radian mode */
+    [self.landscapeCalculatorView toggleAngleMode];
+    self.landscapeCalculatorView.secondaryDisplay.text = radianBtn.titleLabel.text;
+}
+
+@end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Category Implementation
+
+
+@implementation NIBCalculatorViewController (Store)
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Data Archiving
+
+
+- (void)archiveData
+{
+    /* the state is saved after the operations in progress */
+    [self finishPendingEvaluation];
+    
+    NIBCalculatorSnapshot *snapshot = [self loadedSnapshot];
+    NSString *mainDisplayNumberString = self.currentCalculatorView.mainDisplay.text;
+    NIBKeypadStates keypadStates = 0;
+    
+    /* if the main display has the default text, there is no number string */
+    if ([mainDisplayNumberString isEqualToString:NIBMainDisplayDefaultText]) {
+        mainDisplayNumberString = @"";
+    }
+    
+    NIBButton *secondaryFunctionalOperationToggleSwitchBtn = [NIBViewUtilities buttonWithTag:NIBButtonSecondaryFunctionalToggleSwitch fromButtons:self.landscapeCalculatorView.buttons];
+    
+    /* if secondary functional button toggled */
+    if (secondaryFunctionalOperationToggleSwitchBtn.selected) {
+        keypadStates |= NIBKeypadStateSecondaryFunctionalButtonsToggled;
+    }
+    
+    /* if the main display shows a result */
+    if (self.isResultDisplayed) {
+        keypadStates |= NIBKeypadStateResultDisplayed;
+    }
+    
+    /* if a binary operator can push the number on the main display */
+    if (self.canBinaryOperatorPushOperand) {
+        keypadStates |= NIBKeypadStateBinaryOperatorCanPushOperand;
+    }
+    
+    // the fields are compared with the last saved ones, so only the fields
+    // which change are written, and they are written in the background
+    [snapshot setData:[mainDisplayNumberString dataUsingEncoding:NSUTF8StringEncoding]
+              ofField:NIBSnapshotFieldMainDisplayNumberString];
+    [snapshot setData:[NSData dataWithBytes:&keypadStates length:sizeof(keypadStates)]
+              ofField:NIBSnapshotFieldKeypadStates];
+    [self.calculator writeStateToSnapshot:snapshot];
+    [snapshot save];
+    [self.calculator.tape synchronize];
+}
+
+- (void)waitUntilDataArchived
+{
+    [self.snapshot waitUntilSaved];
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Data Unarchiving
+
+
+- (void)readArchive
+{
+    NSArray *path = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
+    NSString *tapePath = [[path firstObject] stringByAppendingPathComponent:NIBTapeFile];
+    
+    /* record the history of the calculations to the tape file */
+    self.calculator.tape = [NIBCalculatorTape tapeWithCapacity:NIBTapeCapacity contentsOfFile:tapePath];
+    
+    NIBCalculatorSnapshot *snapshot = [self loadedSnapshot];
+    
+    /* if the snapshot does not have the state of the calculator, read the last used data file instead */
+    if (![self.calculator readStateFromSnapshot:snapshot]) {
+        [self readLastUsedDataFile];
+        return;
+    }
+    
+    NSData *mainDisplayData = [snapshot dataOfField:NIBSnapshotFieldMainDisplayNumberString];
+    NSString *mainDisplayNumberString = mainDisplayData ? [[NSString alloc] initWithData:mainDisplayData encoding:NSUTF8StringEncoding] : nil;
+    NSData *keypadData = [snapshot dataOfField:NIBSnapshotFieldKeypadStates];
+    NIBKeypadStates keypadStates = 0;
+    
+    if (keypadData.length == sizeof(keypadStates)) {
+        [keypadData getBytes:&keypadStates length:sizeof(keypadStates)];
+    }
+    
+    /* restore last used main display number string */
+    if (mainDisplayNumberString.length > 0) {
+        [self updateMainDisplaysWithString:mainDisplayNumberString];
+    }
+    
+    /* restore last used calculator memory */
+    if (self.calculator.memory) {
+        NIBButton *memoryReadBtn = [NIBViewUtilities buttonWithTag:NIBButtonMemoryRead
+                                                       fromButtons:self.landscapeCalculatorView.buttons];
         
-        /* toggle radian mode */
-        [self.landscapeCalculatorView toggleAngleMode];
-        self.landscapeCalculatorView.secondaryDisplay.text = radianBtn.titleLabel.text;
+        [memoryReadBtn toggleEffect];
+    }
+    
+    /* restore secondary functional operation toggle switch state */
+    if (keypadStates & NIBKeypadStateSecondaryFunctionalButtonsToggled) {
+        [self toggleSecondaryFunctionalButtons];
+    }
+    
+    /* restore last used angle mode, which the calculator is already in */
+    if (self.calculator.isRadianMode) {
+        [self showRadianMode];
     }
+    
+    /* restore the calculation in progress */
+    self.resultDisplayed = (keypadStates & NIBKeypadStateResultDisplayed) != 0;
+    self.canBinaryOperatorPushOperand = (keypadStates & NIBKeypadStateBinaryOperatorCanPushOperand) != 0;
 }
 
 @end
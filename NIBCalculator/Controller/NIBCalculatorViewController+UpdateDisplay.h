@@ -9,11 +9,16 @@
 #import <Foundation/Foundation.h>
 #import "NIBCalculatorViewController.h"
 
+@class NIBCalculatorFuture;
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
  `NIBCalculatorViewController+UpdateDisplay` is a category that updates the
  results on the main display.
+ 
+ The results of the evaluations are displayed in the frame after they finish.
+ When several results finish in one frame, only the last one is displayed.
  */
 @interface NIBCalculatorViewController (UpdateDisplay)
 
@@ -58,6 +63,64 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)updateMainDisplayOfLandscapeCalculatorViewWithNumber:(NSNumber *)number
                                         maxDisplayableDigits:(NSUInteger)maxDigits;
 
+/**
+ Update main displays in both views with their texts.
+ 
+ @param texts   The texts of the main displays in portrait and in landscape.
+ */
+- (void)updateMainDisplaysWithTexts:(NSArray<NSString *> *)texts;
+
+/// ------------------------
+/// @name Main Display Texts
+/// ------------------------
+
+/**
+ Create the texts of the main displays in both views of a number object
+ limited to maximum displayable digits. The method is called on the queue of
+ the evaluator, off the main thread, so it must not use the views or any other
+ state of the controller.
+ 
+ @param number      The number object to display.
+ @param maxDigits   The maximum digits of a number to display.
+ 
+ @return Returns the texts of the main displays in portrait and in landscape.
+ */
+- (NSArray<NSString *> *)mainDisplayTextsOfNumber:(NSNumber *)number
+                             maxDisplayableDigits:(NSUInteger)maxDigits;
+
+/// --------------------------------
+/// @name Display Evaluation Results
+/// --------------------------------
+
+/**
+ Display the result of an evaluation, which is the texts of the main displays,
+ in the frame after it finishes. The evaluation becomes the pending evaluation
+ until then. The evaluation only creates the texts, so it is cancelled if its
+ result is discarded.
+ 
+ @param evaluation  The future of the evaluation.
+ */
+- (void)displayResultOfEvaluation:(NIBCalculatorFuture *)evaluation;
+
+/**
+ Do not display the result of the pending evaluation. The main displays are
+ updated with other texts instead.
+ */
+- (void)discardPendingEvaluation;
+
+/**
+ Wait until the evaluations are finished and display the result of the pending
+ evaluation at once. The calculator can be used directly after this until the
+ next evaluation starts.
+ */
+- (void)finishPendingEvaluation;
+
+/**
+ Display the result of the pending evaluation if it is finished. The method is
+ called by the display link once a frame while a result is waiting.
+ */
+- (void)updateMainDisplaysWithPendingEvaluation;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -9,8 +9,37 @@
 #import "NIBCalculatorViewController+UpdateDisplay.h"
 #import "NIBCalculatorViewController+Helpers.h"
 #import "NIBCalculatorBrain.h"
+#import "NIBCalculatorEvaluator.h"
+#import "NIBCalculatorFuture.h"
 #import "NIBCalculatorPortraitView.h"
 #import "NIBCalculatorLandscapeView.h"
+#import "NIBNumberFormatterPool.h"
+#import "NIBDecimalFormatter.h"
+#import "NIBInstrumentation.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Variables
+
+
+/** Class variable the time when the pending evaluation is started by a key, for the instrumentation. */
+static uint64_t pendingEvaluationStartTime = 0;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Extension
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBCalculatorViewController ()
+
+@property (readwrite, strong, nonatomic) NIBCalculatorFuture *_Nullable pendingEvaluation;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
 
 /////////////////////////////////////////////////////////////////////////////
 #pragma mark - Private Category
@@ -18,6 +47,9 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+// the methods which create the texts of a number are called by
+// mainDisplayTextsOfNumber:maxDisplayableDigits: on the queue of the
+// evaluator, off the main thread, so they only format the number
 @interface NIBCalculatorViewController (UpdateDisplay_Private)
 
 /**
@@ -54,26 +86,21 @@ NS_ASSUME_NONNULL_BEGIN
                             maxDisplayableDigits:(NSUInteger)maxDigits;
 
 /**
- Create a number string by removing insignificant digits from a given
- number string. For example, the number string "1000.054000" will become
- "1000.054".
+ Create a number string from a rounded absolute value of a decimal number and
+ the number of its digits after the decimal separator, in one pass. The
+ insignificant zeros after the decimal separator are removed and the grouping
+ separator of the current locale is added. For example, the round number
+ 1000054000 with 6 fraction digits becomes "1,000.054".
  
- @param numStr The input number string.
+ @param roundNumber     The rounded absolute value scaled to an integer.
+ @param fractionDigits  The number of digits after the decimal separator.
+ @param isNegative      The boolean value to indicate if the number is negative.
  
- @return Returns the new number string after removing insignificant digits.
+ @return Returns the number string.
  */
-- (NSString *)stringByRemovingInsignificantDigitsFromString:(NSString *)numStr;
-
-/**
- Create a number string by adding a grouping separator to a given number string.
- The grouping separator can be a space or a comma depending on the current
- locale.
- 
- @param numStr The input number string.
- 
- @return Returns the new number string after adding the grouping seprator.
- */
-- (NSString *)stringByAddingGroupingSeparatorToString:(NSString *)numStr;
+- (NSString *)stringOfRoundNumber:(double)roundNumber
+                   fractionDigits:(NSUInteger)fractionDigits
+                       isNegative:(BOOL)isNegative;
 
 /**
  Create a string in scientific notation of a number object limited to a maximum
@@ -100,6 +127,30 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL)needScienficNotationOfDecimalNumber:(NSNumber *)number
                        maxDisplayableDigits:(NSUInteger)maxDigits;
 
+/**
+ Create the text of the main display in portrait of a number object limited to
+ maximum displayable digits.
+ 
+ @param number      The number object to display.
+ @param maxDigits   The maximum digits of a number to display.
+ 
+ @return Returns the text of the main display in portrait.
+ */
+- (NSString *)portraitMainDisplayTextOfNumber:(NSNumber *)number
+                         maxDisplayableDigits:(NSUInteger)maxDigits;
+
+/**
+ Create the text of the main display in landscape of a number object limited to
+ maximum displayable digits.
+ 
+ @param number      The number object to display.
+ @param maxDigits   The maximum digits of a number to display.
+ 
+ @return Returns the text of the main display in landscape.
+ */
+- (NSString *)landscapeMainDisplayTextOfNumber:(NSNumber *)number
+                          maxDisplayableDigits:(NSUInteger)maxDigits;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -140,20 +191,17 @@ NS_ASSUME_NONNULL_END
     
     /* otherwise, it is a decimal. However the number can be still
      an integer with small decimal up to 15 digits */
-    NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-    numberFormatter.locale = [NSLocale currentLocale];
-    numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-    numberFormatter.maximumFractionDigits = maxDigits-1;
+    NIBDecimalFormatter *decimalFormatter = [NIBNumberFormatterPool fastDecimalFormatter];
     
-    /* number string from number */
-    NSString *numStr = [numberFormatter stringFromNumber:number];
+    /* count digits of the number string without creating it */
+    NSUInteger digitsOfNumStr = [decimalFormatter digitsOfDouble:number.doubleValue maximumFractionDigits:maxDigits-1];
     
     /* count digits of integer part */
     NSUInteger  digitsOfIntegerPart = [self digitsOfIntegerPartOfDecimalNumber:number
                                                           maxDisplayableDigits:maxDigits];
     
     /* if the digits of integer part equal the number of digits in the string, return immediately */
-    if (digitsOfIntegerPart == [self digitsOfString:numStr]) {
+    if (digitsOfIntegerPart == digitsOfNumStr) {
         return @"Integer";
     }
     
@@ -183,28 +231,9 @@ NS_ASSUME_NONNULL_END
     double roundNumber = round(fabs(number.doubleValue) * pow(10, optimizedRoundDigits));
     
     /* convert round number to string */
-    NSMutableString *roundNumberStr = [[NSMutableString alloc] initWithFormat:@"%lld", (long long)roundNumber];
-    
-    /* if round number string has less digits than the max digits */
-    if (roundNumberStr.length <= optimizedRoundDigits) {
-        NSUInteger roundNumberStrLenght = roundNumberStr.length;
-        /* padding zero to the beginning */
-        for (NSUInteger i = 0; i <= optimizedRoundDigits-roundNumberStrLenght; i++) {
-            [roundNumberStr insertString:@"0" atIndex:0];
-        }
-    }
-    
-    /* put back the decimal separator */
-    [roundNumberStr insertString:[[NSLocale currentLocale] decimalSeparator]
-                         atIndex:roundNumberStr.length-optimizedRoundDigits];
-    
-    /* put back the negative sign if needed */
-    if (number.doubleValue < 0) {
-        [roundNumberStr insertString:NIBNegativePrefix atIndex:0];
-    }
-    
-    result = [self stringByRemovingInsignificantDigitsFromString:roundNumberStr];
-    result = [self stringByAddingGroupingSeparatorToString:result];
+    result = [self stringOfRoundNumber:roundNumber
+                        fractionDigits:optimizedRoundDigits
+                            isNegative:(number.doubleValue < 0)];
     
     return result;
 }
@@ -212,84 +241,63 @@ NS_ASSUME_NONNULL_END
 - (NSUInteger)digitsOfIntegerPartOfDecimalNumber:(NSNumber *)number
                             maxDisplayableDigits:(NSUInteger)maxDigits
 {
-    NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-    numberFormatter.locale = [NSLocale currentLocale];
-    numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-    numberFormatter.maximumFractionDigits = maxDigits-1;
-    
-    /* number string from number */
-    NSString *numStr = [numberFormatter stringFromNumber:number];
-    
-    /* count the integer part length */
-    NSString *decimalSeparator = [[NSLocale currentLocale] objectForKey:NSLocaleDecimalSeparator];
-    NIBSymbolRemovalOptions removalOptions = (NIBSymbolRemovalGroupingSeparator | NIBSymbolRemovalNegativePrefix);
-    NSRange digitsOfIntegerPartRange = [[self stringFromString:numStr withRevmovalOptions:removalOptions] rangeOfString:decimalSeparator];
-    NSUInteger digitsOfIntegerPart;
+    NIBDecimalFormatter *decimalFormatter = [NIBNumberFormatterPool fastDecimalFormatter];
     
-    /* if there is no decimal separtor found */
-    if (digitsOfIntegerPartRange.location == NSNotFound) {
-        digitsOfIntegerPart = [self digitsOfString:numStr];
-    } else {
-        digitsOfIntegerPart = digitsOfIntegerPartRange.location;
-    }
-    
-    return digitsOfIntegerPart;
+    /* count the integer part length of the number string without creating it */
+    return [decimalFormatter digitsOfIntegerPartOfDouble:number.doubleValue maximumFractionDigits:maxDigits-1];
 }
 
-- (NSString *)stringByRemovingInsignificantDigitsFromString:(NSString *)numStr
+- (NSString *)stringOfRoundNumber:(double)roundNumber
+                   fractionDigits:(NSUInteger)fractionDigits
+                       isNegative:(BOOL)isNegative
 {
+    NSString *groupingSeparator = [[NSLocale currentLocale] objectForKey:NSLocaleGroupingSeparator];
     NSString *decimalSeparator = [[NSLocale currentLocale] objectForKey:NSLocaleDecimalSeparator];
-    NSString *result = nil;
+    NSString *prefix = isNegative ? NIBNegativePrefix : @"";
+    char digits[32];
+    NSUInteger digitsCount = (NSUInteger)snprintf(digits, sizeof(digits), "%lld", (long long)roundNumber);
     
-    NSUInteger __block insignificantDigitsAfterDecimalSeparator = 0;
-    
-    /* count insignificant digits after decimal separator */
-    NSStringEnumerationOptions options = (NSStringEnumerationReverse | NSStringEnumerationByComposedCharacterSequences);
-    [numStr enumerateSubstringsInRange:NSMakeRange(0, numStr.length)
-                               options: options
-                            usingBlock:^(NSString *substring, NSRange __unused substringRange, NSRange __unused enclosingRange, BOOL * stop) {
-        /* stop when reach decimal or a digit not zero */
-        if ([substring isEqualToString:decimalSeparator] ||
-            ![substring isEqualToString:@"0"]) {
-            *stop = YES;
-        } else {
-            insignificantDigitsAfterDecimalSeparator++;
-        }
-    }];
+    /* if round number has less digits than the fraction digits, pad zeros to the beginning */
+    NSUInteger paddingZeros = (digitsCount <= fractionDigits) ? fractionDigits - digitsCount + 1 : 0;
+    char paddedDigits[paddingZeros + digitsCount];
     
-    /* create result string by removing insignificant digits after decimal separator */
-    result = [numStr substringToIndex:numStr.length-insignificantDigitsAfterDecimalSeparator];
+    memset(paddedDigits, '0', paddingZeros);
+    memcpy(paddedDigits + paddingZeros, digits, digitsCount);
     
-    return result;
-}
-
-- (NSString *)stringByAddingGroupingSeparatorToString:(NSString *)numStr
-{
-    NSString *groupingSeparator = [[NSLocale currentLocale] objectForKey:NSLocaleGroupingSeparator];
-    NSString *decimalSeparator = [[NSLocale currentLocale] objectForKey:NSLocaleDecimalSeparator];
-    NSMutableString *result = [[NSMutableString alloc] initWithString:[self stringFromString:numStr withRevmovalOptions:NIBSymbolRemovalGroupingSeparator]];
-    NSUInteger digitsOfIntegerPart, decimalSeparatorIdx;
+    NSUInteger digitsOfIntegerPart = paddingZeros + digitsCount - fractionDigits;
+    NSUInteger significantFractionDigits = fractionDigits;
     
-    decimalSeparatorIdx = [result rangeOfString:decimalSeparator].location;
+    /* remove insignificant digits after decimal separator */
+    while (significantFractionDigits > 0 && paddedDigits[digitsOfIntegerPart + significantFractionDigits - 1] == '0') {
+        significantFractionDigits--;
+    }
     
-    /* if not found decimal separator in a number string, it is integer number */
-    if (decimalSeparatorIdx == NSNotFound) {
-        digitsOfIntegerPart = [result length];
+    // the grouping separator is added every 3 characters from the decimal
+    // separator, counting the negative prefix as the number string did
+    NSUInteger prefixLength = prefix.length;
+    NSUInteger integerPartLength = prefixLength + digitsOfIntegerPart;
+    NSUInteger capacity = integerPartLength * (1 + groupingSeparator.length) + decimalSeparator.length + significantFractionDigits;
+    unichar characters[capacity];
+    NSUInteger length = 0;
+    
+    for (NSUInteger i = 0; i < integerPartLength; i++) {
+        if (integerPartLength > 3 && i >= 1 && (integerPartLength - i) % 3 == 0) {
+            [groupingSeparator getCharacters:characters + length range:NSMakeRange(0, groupingSeparator.length)];
+            length += groupingSeparator.length;
+        }
         
-        /* otherwise, the number is decimal number */
-    } else {
-        digitsOfIntegerPart = decimalSeparatorIdx;
+        characters[length++] = (i < prefixLength) ? [prefix characterAtIndex:i] : (unichar)paddedDigits[i - prefixLength];
     }
     
-    if (digitsOfIntegerPart > 3) {
-        for (NSUInteger i = digitsOfIntegerPart-1, j = 1; i >= 1; i--, j++) {
-            if (j % 3 == 0) {
-                [result insertString:groupingSeparator atIndex:i];
-            }
-        }
+    /* put back the decimal separator and the significant digits after it */
+    [decimalSeparator getCharacters:characters + length range:NSMakeRange(0, decimalSeparator.length)];
+    length += decimalSeparator.length;
+    
+    for (NSUInteger i = 0; i < significantFractionDigits; i++) {
+        characters[length++] = (unichar)paddedDigits[digitsOfIntegerPart + i];
     }
     
-    return [NSString stringWithString:result];
+    return [[NSString alloc] initWithCharacters:characters length:length];
 }
 
 - (NSString *)stringInScientificNotationOfNumber:(NSNumber *)number
@@ -325,11 +333,9 @@ NS_ASSUME_NONNULL_END
     NSString *negativeFormat = [[NSString alloc] initWithFormat:@"-%@", positiveFormat];
     
     /* number formatter according to the positve format and negative format */
-    NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-    numberFormatter.locale = [NSLocale currentLocale];
-    numberFormatter.exponentSymbol = NIBExponentSymbol;
-    numberFormatter.positiveFormat = positiveFormat;
-    numberFormatter.negativeFormat = negativeFormat;
+    NSNumberFormatter *numberFormatter = [NIBNumberFormatterPool formatterWithPositiveFormat:positiveFormat
+                                                                              negativeFormat:negativeFormat
+                                                                              exponentSymbol:NIBExponentSymbol];
     
     /* number string from the format */
     NSString *numStr = [numberFormatter stringFromNumber:number];
@@ -358,8 +364,9 @@ NS_ASSUME_NONNULL_END
         negativeFormat = [[NSString alloc] initWithFormat:@"-%@", positiveFormat];
         
         /* update number format */
-        numberFormatter.positiveFormat = positiveFormat;
-        numberFormatter.negativeFormat = negativeFormat;
+        numberFormatter = [NIBNumberFormatterPool formatterWithPositiveFormat:positiveFormat
+                                                               negativeFormat:negativeFormat
+                                                               exponentSymbol:NIBExponentSymbol];
         
         /* the new number string is resturned */
         result = [numberFormatter stringFromNumber:number];
@@ -371,10 +378,9 @@ NS_ASSUME_NONNULL_END
 - (BOOL)needScienficNotationOfDecimalNumber:(NSNumber *)number
                        maxDisplayableDigits:(NSUInteger)maxDigits
 {
-    NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-    numberFormatter.locale = [NSLocale currentLocale];
-    numberFormatter.positiveFormat = @"0.#E0";
-    numberFormatter.negativeFormat = @"-0.#E0";
+    NSNumberFormatter *numberFormatter = [NIBNumberFormatterPool formatterWithPositiveFormat:@"0.#E0"
+                                                                              negativeFormat:@"-0.#E0"
+                                                                              exponentSymbol:nil];
     
     /* find the exponent of the scientific notation display */
     NSString *numberStr = [numberFormatter stringFromNumber:number];
@@ -384,6 +390,82 @@ NS_ASSUME_NONNULL_END
     return (NSUInteger)labs(exponent) >= maxDigits;
 }
 
+
+- (NSString *)portraitMainDisplayTextOfNumber:(NSNumber *)number
+                         maxDisplayableDigits:(NSUInteger)maxDigits
+{
+    
+    /* keep the displayable digits not larger than the limit */
+    if (maxDigits > NIBMaxDigitsInPortrait) maxDigits = NIBMaxDigitsInPortrait;
+    
+    /* prevent a number displayed as -0 */
+    if (number.doubleValue == 0) number = [[NSNumber alloc] initWithDouble:0];
+    
+    /* if number is integer */
+    if ([NIBCalculatorBrain isInterger:number]) {
+        
+        /* if the number is within range */
+        if (number.doubleValue <= NIBMaxFullDisplayablePositiveIntegerInPortrait &&
+            number.doubleValue >= NIBMinFullDisplayableNegativeIntegerInPortrait) {
+            
+            NIBDecimalFormatter *decimalFormatter = [NIBNumberFormatterPool fastDecimalFormatter];
+            
+            return [decimalFormatter stringFromDouble:number.doubleValue maximumSignificantDigits:maxDigits];
+            
+        /* otherwise, the number is out of range. This number is only created in landscape view */
+        } else {
+            return [self stringInScientificNotationOfNumber:number maxDisplayableDigits:maxDigits];
+        }
+        
+    /*--- otherwise, the number is decimal ---*/
+        
+    /* if the number needs to display in scientific notation */
+    } else if ([self needScienficNotationOfDecimalNumber:number maxDisplayableDigits:NIBMaxDigitsInPortrait]) {
+        return [self stringInScientificNotationOfNumber:number maxDisplayableDigits:maxDigits];
+      
+    /* otherwise, the number display normally */
+    } else {
+        return [self stringOfDecimalNumber:number maxDisplayableDigits:maxDigits];
+    }
+}
+
+- (NSString *)landscapeMainDisplayTextOfNumber:(NSNumber *)number
+                          maxDisplayableDigits:(NSUInteger)maxDigits
+{
+    if (maxDigits > NIBMaxDigitsInLandscape) {
+        maxDigits = NIBMaxDigitsInLandscape;
+    }
+    
+    /* prevent a number displayed as -0 */
+    if (number.doubleValue == 0) number = [[NSNumber alloc] initWithDouble:0];
+    
+    /* if number is integer */
+    if ([NIBCalculatorBrain isInterger:number]) {
+        
+        /* if the number is within range */
+        if (number.doubleValue < NIBMaxFullDisplayablePositiveIntegerInLandscape &&
+            number.doubleValue >= NIBMinFullDisplayableNegativeIntegerInLandscape) {
+            NIBDecimalFormatter *decimalFormatter = [NIBNumberFormatterPool fastDecimalFormatter];
+            
+            return [decimalFormatter stringFromDouble:number.doubleValue maximumSignificantDigits:maxDigits];
+            
+        /* otherwise, the number is out of range */
+        } else {
+            return [self stringInScientificNotationOfNumber:number maxDisplayableDigits:maxDigits];
+        }
+    
+    /*--- otherwise, the number is decimal ---*/
+     
+    /* if the number needs to display in scientific notation */
+    } else if ([self needScienficNotationOfDecimalNumber:number maxDisplayableDigits:NIBMaxDigitsInLandscape]) {
+        return [self stringInScientificNotationOfNumber:number maxDisplayableDigits:NIBMaxDigitsInLandscape];
+        
+    /* otherwise, the number display normally */
+    } else {
+        return [self stringOfDecimalNumber:number maxDisplayableDigits:maxDigits];
+    }
+}
+
 @end
 
 
@@ -412,20 +494,16 @@ NS_ASSUME_NONNULL_END
 
 - (void)updateMainDisplaysWithString:(NSString *)numStr
 {
-    NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-    numberFormatter.locale = [NSLocale currentLocale];
-    numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-    numberFormatter.lenient = YES;
-    
     /* if a decimal number string contains only zero after decimals */
     if ( [numStr containsString:[[NSLocale currentLocale] decimalSeparator]] &&
         [self containOnlyZerosAfterDecimalSeparatorInString:numStr] ) {
         
         /* convert to number */
-        NSNumber *number = [numberFormatter numberFromString:numStr];
+        NSNumber *number = [self numberFromString:numStr];
         
-        numberFormatter.positiveFormat = @"0.#E0";
-        numberFormatter.negativeFormat = @"-0.#E0";
+        NSNumberFormatter *numberFormatter = [NIBNumberFormatterPool formatterWithPositiveFormat:@"0.#E0"
+                                                               negativeFormat:@"-0.#E0"
+                                                               exponentSymbol:nil];
         
         /* find the exponent of scientific notation */
         NSString *temp = [numberFormatter stringFromNumber:number];
@@ -464,100 +542,95 @@ NS_ASSUME_NONNULL_END
     /* max digits to display */
     NSUInteger maxDigits = [self digitsOfString:numStr];
     
-    [self updateMainDisplayOfPortraitCalculatorViewWithNumber:[numberFormatter numberFromString:formatedNumberStr]
+    /* the number of the string */
+    NSNumber *number = [self numberFromString:formatedNumberStr];
+    
+    [self updateMainDisplayOfPortraitCalculatorViewWithNumber:number
                                          maxDisplayableDigits:maxDigits];
-    [self updateMainDisplayOfLandscapeCalculatorViewWithNumber:[numberFormatter numberFromString:formatedNumberStr]
+    [self updateMainDisplayOfLandscapeCalculatorViewWithNumber:number
                                           maxDisplayableDigits:maxDigits];
 }
 
 - (void)updateMainDisplayOfPortraitCalculatorViewWithNumber:(NSNumber *)number
                                        maxDisplayableDigits:(NSUInteger)maxDigits
 {
-    
-    /* keep the displayable digits not larger than the limit */
-    if (maxDigits > NIBMaxDigitsInPortrait) maxDigits = NIBMaxDigitsInPortrait;
-    
-    /* prevent a number displayed as -0 */
-    if (number.doubleValue == 0) number = [[NSNumber alloc] initWithDouble:0];
-    
-    /* if number is integer */
-    if ([NIBCalculatorBrain isInterger:number]) {
-        
-        /* if the number is within range */
-        if (number.doubleValue <= NIBMaxFullDisplayablePositiveIntegerInPortrait &&
-            number.doubleValue >= NIBMinFullDisplayableNegativeIntegerInPortrait) {
-            
-            NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-            numberFormatter.locale = [NSLocale currentLocale];
-            numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-            numberFormatter.usesGroupingSeparator = YES;
-            numberFormatter.usesSignificantDigits = YES;
-            numberFormatter.maximumSignificantDigits = maxDigits;
-            
-            self.portraitCalculatorView.mainDisplay.text = [numberFormatter stringFromNumber:number];
-            
-        /* otherwise, the number is out of range. This number is only created in landscape view */
-        } else {
-            self.portraitCalculatorView.mainDisplay.text = [self stringInScientificNotationOfNumber:number
-                                                                               maxDisplayableDigits:maxDigits];
-        }
-        
-    /*--- otherwise, the number is decimal ---*/
-        
-    /* if the number needs to display in scientific notation */
-    } else if ([self needScienficNotationOfDecimalNumber:number maxDisplayableDigits:NIBMaxDigitsInPortrait]) {
-            self.portraitCalculatorView.mainDisplay.text = [self stringInScientificNotationOfNumber:number
-                                                                               maxDisplayableDigits:maxDigits];
-      
-    /* otherwise, the number display normally */
-    } else {
-        self.portraitCalculatorView.mainDisplay.text = [self stringOfDecimalNumber:number maxDisplayableDigits:maxDigits];
-    }
+    self.portraitCalculatorView.mainDisplay.text = [self portraitMainDisplayTextOfNumber:number
+                                                                    maxDisplayableDigits:maxDigits];
 }
 
 - (void)updateMainDisplayOfLandscapeCalculatorViewWithNumber:(NSNumber *)number
                                         maxDisplayableDigits:(NSUInteger)maxDigits
 {
-    if (maxDigits > NIBMaxDigitsInLandscape) {
-        maxDigits = NIBMaxDigitsInLandscape;
+    self.landscapeCalculatorView.mainDisplay.text = [self landscapeMainDisplayTextOfNumber:number
+                                                                      maxDisplayableDigits:maxDigits];
+}
+
+- (void)updateMainDisplaysWithTexts:(NSArray<NSString *> *)texts
+{
+    self.portraitCalculatorView.mainDisplay.text = texts[0];
+    self.landscapeCalculatorView.mainDisplay.text = texts[1];
+}
+
+#pragma mark Main Display Texts
+
+- (NSArray<NSString *> *)mainDisplayTextsOfNumber:(NSNumber *)number
+                             maxDisplayableDigits:(NSUInteger)maxDigits
+{
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageFormatting);
+    
+    if ([number isEqualToNumber:[NSDecimalNumber notANumber]]) {
+        return @[NIBMainDisplayErrorText, NIBMainDisplayErrorText];
     }
     
-    /* prevent a number displayed as -0 */
-    if (number.doubleValue == 0) number = [[NSNumber alloc] initWithDouble:0];
+    NIB_COUNT_ALLOCATION(NIBInstrumentationAllocationDisplayTexts, 0);
     
-    /* if number is integer */
-    if ([NIBCalculatorBrain isInterger:number]) {
-        
-        /* if the number is within range */
-        if (number.doubleValue < NIBMaxFullDisplayablePositiveIntegerInLandscape &&
-            number.doubleValue >= NIBMinFullDisplayableNegativeIntegerInLandscape) {
-            NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-            numberFormatter.locale = [NSLocale currentLocale];
-            numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
-            numberFormatter.usesGroupingSeparator = YES;
-            numberFormatter.usesSignificantDigits = YES;
-            numberFormatter.maximumSignificantDigits = maxDigits;
-            self.landscapeCalculatorView.mainDisplay.text = [numberFormatter stringFromNumber:number];
-            
-        /* otherwise, the number is out of range */
-        } else {
-            self.landscapeCalculatorView.mainDisplay.text = [self stringInScientificNotationOfNumber:number
-                                                                                maxDisplayableDigits:maxDigits];
+    return @[[self portraitMainDisplayTextOfNumber:number maxDisplayableDigits:maxDigits],
+             [self landscapeMainDisplayTextOfNumber:number maxDisplayableDigits:maxDigits]];
+}
+
+#pragma mark Display Evaluation Results
+
+- (void)displayResultOfEvaluation:(NIBCalculatorFuture *)evaluation
+{
+    self.pendingEvaluation = evaluation;
+    pendingEvaluationStartTime = NIB_INSTRUMENTATION_TIME();
+    
+    [evaluation notifyOnQueue:dispatch_get_main_queue() usingBlock:^(id result) {
+        // the result is displayed on the next frame, so the results which
+        // finish within a frame are displayed once, as the last of them
+        if (self.pendingEvaluation == evaluation) {
+            self.displayLink.paused = NO;
         }
+    }];
+}
+
+- (void)discardPendingEvaluation
+{
+    [self.pendingEvaluation cancel];
+    self.pendingEvaluation = nil;
+}
+
+- (void)finishPendingEvaluation
+{
+    [self.evaluator waitUntilFinished];
+    [self updateMainDisplaysWithPendingEvaluation];
+}
+
+- (void)updateMainDisplaysWithPendingEvaluation
+{
+    NIBCalculatorFuture *evaluation = self.pendingEvaluation;
     
-    /*--- otherwise, the number is decimal ---*/
-     
-    /* if the number needs to display in scientific notation */
-    } else if ([self needScienficNotationOfDecimalNumber:number maxDisplayableDigits:NIBMaxDigitsInLandscape]) {
-        self.landscapeCalculatorView.mainDisplay.text = [self stringInScientificNotationOfNumber:number
-                                                                            maxDisplayableDigits:NIBMaxDigitsInLandscape];
-        
-    /* otherwise, the number display normally */
-    } else {
-        self.landscapeCalculatorView.mainDisplay.text = [self stringOfDecimalNumber:number
-                                                               maxDisplayableDigits:maxDigits];
+    /* if there is no result to display, wait until there is one */
+    if (!evaluation.isFinished) {
+        self.displayLink.paused = YES;
+        return;
     }
+    
+    self.pendingEvaluation = nil;
+    self.displayLink.paused = YES;
+    
+    [self updateMainDisplaysWithTexts:evaluation.result];
+    NIB_RECORD_INTERVAL(NIBInstrumentationStageKeyToDisplay, pendingEvaluationStartTime);
 }
 
 @end
-
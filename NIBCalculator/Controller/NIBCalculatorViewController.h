@@ -13,6 +13,9 @@
 @class NIBCalculatorPortraitView;
 @class NIBCalculatorLandscapeView;
 @class NIBCalculatorBrain;
+@class NIBCalculatorEvaluator;
+@class NIBCalculatorFuture;
+@class NIBCalculatorSnapshot;
 @class NIBSelectionLabel;
 
 
@@ -78,6 +81,15 @@ NS_ASSUME_NONNULL_BEGIN
 /** The calculator brain. */
 @property (readonly, strong, nonatomic) NIBCalculatorBrain *calculator;
 
+/** The evaluator which performs the operations of the calculator brain in the background. */
+@property (readonly, strong, nonatomic) NIBCalculatorEvaluator *evaluator;
+
+/** The evaluation whose result is displayed next, nil if there is none. */
+@property (readonly, strong, nonatomic) NIBCalculatorFuture *_Nullable pendingEvaluation;
+
+/** The display link which displays the result of the pending evaluation, nil while the view is not on screen. */
+@property (readonly, strong, nonatomic) CADisplayLink *_Nullable displayLink;
+
 /** Button sound. */
 @property (readonly, assign, nonatomic) SystemSoundID btnSound;
 
@@ -96,6 +108,15 @@ NS_ASSUME_NONNULL_BEGIN
 /** Boolean value indicating if a binary operator can push and operand. */
 @property (readonly, assign, nonatomic) BOOL canBinaryOperatorPushOperand;
 
+/** The snapshot which the state of the calculator is saved to. */
+@property (readonly, strong, nonatomic) NIBCalculatorSnapshot *_Nullable snapshot;
+
+/** The change count of the general pasteboard when it was last checked for an expression. */
+@property (readonly, assign, nonatomic) NSInteger pasteboardChangeCount;
+
+/** Boolean value indicating if the general pasteboard contained an expression when it was last checked. */
+@property (readonly, assign, nonatomic) BOOL pasteboardHasExpression;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -13,6 +13,8 @@
 #import "NIBCalculatorViewController+Store.h"
 #import "NIBOperator.h"
 #import "NIBCalculatorBrain.h"
+#import "NIBCalculatorEvaluator.h"
+#import "NIBExpressionTokenizer.h"
 #import "NIBCalculatorPortraitView.h"
 #import "NIBCalculatorLandscapeView.h"
 #import "NIBSelectionLabel.h"
@@ -57,12 +59,18 @@ NS_ASSUME_NONNULL_BEGIN
 @property (readwrite, strong, nonatomic) NIBCalculatorLandscapeView *landscapeCalculatorView;
 @property (readwrite, strong, nonatomic) UIView<NIBCalculatorViewProtocol> *currentCalculatorView;
 @property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+@property (readwrite, strong, nonatomic) NIBCalculatorEvaluator *evaluator;
+@property (readwrite, strong, nonatomic) NIBCalculatorFuture *_Nullable pendingEvaluation;
+@property (readwrite, strong, nonatomic) CADisplayLink *_Nullable displayLink;
 @property (readwrite, assign, nonatomic) SystemSoundID btnSound;
 @property (readwrite, assign, nonatomic) BOOL resultDisplayed;
 @property (readwrite, assign, nonatomic) BOOL mainDisplaySelected;
 @property (readwrite, strong, nonatomic) NIBSelectionLabel *selectionLabel;
 @property (readwrite, strong, nonatomic) NIBButton *_Nullable currentBinaryOperation;
 @property (readwrite, assign, nonatomic) BOOL canBinaryOperatorPushOperand;
+@property (readwrite, strong, nonatomic) NIBCalculatorSnapshot *_Nullable snapshot;
+@property (readwrite, assign, nonatomic) NSInteger pasteboardChangeCount;
+@property (readwrite, assign, nonatomic) BOOL pasteboardHasExpression;
 
 /// -----------------------------------------------
 /// @name Layout Calculator View On View Controller
@@ -148,6 +156,9 @@ NS_ASSUME_NONNULL_END
     
     /* initialize property */
     self.calculator = [[NIBCalculatorBrain alloc] init];
+    self.evaluator = [NIBCalculatorEvaluator evaluatorWithCalculator:self.calculator];
+    self.pendingEvaluation = nil;
+    self.pasteboardChangeCount = NSNotFound;
     NSURL *btnSoundURL = [[NSURL alloc] initFileURLWithPath:[[NSBundle mainBundle] pathForResource:@"Tock" ofType:@"aif"]];
     AudioServicesCreateSystemSoundID((__bridge CFURLRef)btnSoundURL, &self->_btnSound);
     self.currentBinaryOperation = nil;
@@ -206,7 +217,7 @@ NS_ASSUME_NONNULL_END
         NIBButton *btn = [NIBViewUtilities buttonWithTag:btnTag.integerValue fromButtons:self.landscapeCalculatorView.buttons];
         [btn setSelectedEffectBorderWidth:NIBButtonBorderWidthWhenSelectedInLandscape borderColor:[UIColor blackColor]];
     }
-
+    
     /* unarchive data */
     [self readArchive];
 
@@ -247,6 +258,27 @@ NS_ASSUME_NONNULL_END
     }
 }
 
+- (void)viewWillAppear:(BOOL)animated
+{
+    [super viewWillAppear:animated];
+    
+    // the display link retains its target, so it only exists while the view
+    // is on screen, otherwise the view controller would never be released
+    self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(updateMainDisplaysWithPendingEvaluation)];
+    
+    /* display the results of the evaluations once a frame, if there is one pending */
+    self.displayLink.paused = (self.pendingEvaluation == nil);
+    [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (void)viewDidDisappear:(BOOL)animated
+{
+    [super viewDidDisappear:animated];
+    
+    [self.displayLink invalidate];
+    self.displayLink = nil;
+}
+
 - (void)didReceiveMemoryWarning {
     [super didReceiveMemoryWarning];
     // Dispose of any resources that can be recreated.
@@ -549,12 +581,22 @@ NS_ASSUME_NONNULL_END
         result = YES;
     } else if (action == @selector(paste:)) {
         UIPasteboard *pasteBoard = [UIPasteboard generalPasteboard];
-        NSCharacterSet *notDigits = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
-
-        /* if the paste board contains string that is a number */
-        if ([pasteBoard.string rangeOfCharacterFromSet:notDigits].location == NSNotFound) {
-            result = YES;
+        
+        // the menu validates its actions every time it is shown, so the paste
+        // board is only tokenized again after its content changes
+        if (pasteBoard.changeCount != self.pasteboardChangeCount) {
+            const char *text = pasteBoard.string.UTF8String;
+            NIBNumberSeparators separators = NIBNumberSeparatorsOfLocale([NSLocale currentLocale]);
+            NIBTokenBuffer tokens = {0};
+            
+            /* if the paste board contains string that is an expression */
+            self.pasteboardHasExpression = text && NIBTokenizeExpression(text, strlen(text), &separators, &tokens, NULL) && tokens.count > 0;
+            self.pasteboardChangeCount = pasteBoard.changeCount;
+            
+            NIBTokenBufferFree(&tokens);
         }
+        
+        result = self.pasteboardHasExpression;
     }
 
     return result;
@@ -562,6 +604,8 @@ NS_ASSUME_NONNULL_END
 
 - (void)copy:(id __unused)sender
 {
+    [self finishPendingEvaluation];
+    
     UIPasteboard *pasteBoard = [UIPasteboard generalPasteboard];
     pasteBoard.string = self.currentCalculatorView.mainDisplay.text;
 
@@ -572,7 +616,48 @@ NS_ASSUME_NONNULL_END
 - (void)paste:(id __unused)sender
 {
     UIPasteboard *pasteBoard = [UIPasteboard generalPasteboard];
-    self.currentCalculatorView.mainDisplay.text = pasteBoard.string;
+    const char *text = pasteBoard.string.UTF8String;
+    NIBNumberSeparators separators = NIBNumberSeparatorsOfLocale([NSLocale currentLocale]);
+    NIBTokenBuffer tokens = {0};
+    
+    /* the expression is performed directly after the operations in progress */
+    [self finishPendingEvaluation];
+    
+    /* if the paste board does not contain an expression, do nothing */
+    if (!text || !NIBTokenizeExpression(text, strlen(text), &separators, &tokens, NULL) || tokens.count == 0) {
+        NIBTokenBufferFree(&tokens);
+        return;
+    }
+    
+    /* if the expression is a number, type it on the main display */
+    if (tokens.count == 1 && tokens.tokens[0].kind == NIBTokenKindOperand) {
+        [self updateMainDisplaysWithNumber:@(tokens.tokens[0].operand) maxDisplayableDigits:NIBMaxDigitsInLandscape];
+    
+    /* otherwise, perform the expression at once and display the result */
+    } else {
+        /* remove cached binary operation */
+        if (self.currentBinaryOperation.selected) [self.currentBinaryOperation toggleEffect];
+        if (self.currentBinaryOperation) self.currentBinaryOperation = nil;
+        
+        NSNumber *number = [self.calculator performExpression:tokens.tokens count:tokens.count];
+        [self updateMainDisplaysWithNumber:number maxDisplayableDigits:NIBMaxDigitsInLandscape];
+    }
+    
+    // a binary operator pushes the display if a number is the last token
+    // since the last binary operator, as if the keys were pressed
+    BOOL canBinaryOperatorPushOperand = NO;
+    
+    for (NSUInteger i = 0; i < tokens.count; i++) {
+        if (tokens.tokens[i].kind == NIBTokenKindOperand) {
+            canBinaryOperatorPushOperand = YES;
+        } else if (NIBIsBinaryOperatorTag(tokens.tokens[i].tag)) {
+            canBinaryOperatorPushOperand = NO;
+        }
+    }
+    
+    self.canBinaryOperatorPushOperand = canBinaryOperatorPushOperand;
+    self.resultDisplayed = YES;
+    NIBTokenBufferFree(&tokens);
 
     /* if the main display is selected, deselect it */
     if (self.isMainDisplaySelected) [self deselectMainDisplay];
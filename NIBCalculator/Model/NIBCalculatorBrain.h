@@ -8,8 +8,12 @@
 
 #import <Foundation/Foundation.h>
 #import "NIBConstants.h"
+#import "NIBToken.h"
 
 @class NIBOperator;
+@class NIBCalculatorProgram;
+@class NIBCalculatorSnapshot;
+@class NIBCalculatorTape;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -28,6 +32,22 @@ NS_ASSUME_NONNULL_BEGIN
 /** The trigonometric mode for angle. */
 @property (readonly, assign, nonatomic) BOOL isRadianMode;
 
+/**
+ The number mode. In decimal mode, the operands are read as the shortest
+ decimals of their doubles and the arithmetic, the integer powers and the
+ memory are calculated in 34 decimal digits, so 0.1 + 0.2 is 0.3. The results
+ are still returned as the nearest doubles.
+ */
+@property (readonly, assign, nonatomic) BOOL isDecimalMode;
+
+/**
+ The tape to record the history of the calculations to, nil if there is no
+ history. Every infix expression which is completed by the equality operator
+ is recorded with its result, the cached operation which is repeated on an
+ operand is recorded with the operand.
+ */
+@property (readwrite, strong, nonatomic) NIBCalculatorTape *_Nullable tape;
+
 /// ----------------------------
 /// @name Interactive Operations
 /// ----------------------------
@@ -56,15 +76,54 @@ NS_ASSUME_NONNULL_BEGIN
  @param operator                The operator to calculate.
  @param isExperimentalModeOn    The boolean value to indicate
                                 if the experimental mode is on. If the value is
-                                YES, the calculation does not modify the infix
-                                expression of the calculator. Otherwise, the
-                                calculation modifies the infix expression.
+                                YES, the operator is peeked as peekOperator:
+                                does. Otherwise, the calculation modifies the
+                                infix expression.
  
  @return Returns the number object if the operation can be executed sucessfully,
  otherwise `[NSDecimalNumber notANumber]`.
  */
 - (NSNumber *_Nullable)performOperator:(NIBOperator *)operator withExperimentalModeOn:(BOOL)isExperimentalModeOn;
 
+/**
+ Perform the tokens of an expression in one call, as the keys of the
+ calculator press them one by one. An operand is typed on the display. A binary
+ operator pushes the display if a number is typed since the last binary
+ operator, the other operators but the openning parenthesis push the display,
+ and the result of an operator is shown on the display. The calculator is left
+ as pressing the keys leaves it.
+ 
+ @param tokens  The tokens of the expression, as NIBTokenizeExpression() reads
+                them.
+ @param count   The number of tokens.
+ 
+ @return Returns the number object of the display after the last token, or nil
+ if there is no token.
+ */
+- (NSNumber *_Nullable)performExpression:(const NIBToken *_Nullable)tokens count:(NSUInteger)count;
+
+/**
+ Get the result of performing an operator without performing it. Neither the
+ infix expression nor the arithmetic cache of the calculator is modified, so
+ the operator can be peeked before it is performed.
+ 
+ @param operator    The operator to peek.
+ 
+ @return Returns the number object performOperator: would return.
+ */
+- (NSNumber *_Nullable)peekOperator:(NIBOperator *)operator;
+
+/**
+ Get the result of performing an operator without performing it, as
+ peekOperator: does, without creating a number object.
+ 
+ @param operator    The operator to peek.
+ @param result      The result performOperator: would return.
+ 
+ @return Returns YES if the operator would have a result, otherwise NO.
+ */
+- (BOOL)peekOperator:(NIBOperator *)operator withResult:(double *)result;
+
 /**
  Add a value to the memory of the calculator.
  
@@ -94,6 +153,12 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)toggleRadianMode;
 
+/**
+ Toggle decimal mode of calculator. The default mode is binary floating point.
+ The arithmetic operations in progress are kept and evaluated in the new mode.
+ */
+- (void)toggleDecimalMode;
+
 /**
  Get a constant number.
  
@@ -103,6 +168,136 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSNumber *_Nullable)constantNumber:(NIBOperator *)operator;
 
+/// -----------------------
+/// @name Compiled Programs
+/// -----------------------
+
+/**
+ Compile an infix expression into a program. The program evaluates the
+ expression as the calculator does and can be evaluated again with new operands
+ without parsing the expression.
+ 
+ @param infixExp    The tokens of the infix expression.
+ @param count       The number of tokens.
+ 
+ @return Returns the program of the infix expression.
+ */
+- (NIBCalculatorProgram *)programWithInfixExpression:(const NIBToken *_Nullable)infixExp count:(NSUInteger)count;
+
+/**
+ Compile the infix expression of the calculator into a program. The infix
+ expression of the calculator is not modified.
+ 
+ @return Returns the program of the infix expression of the calculator.
+ */
+- (NIBCalculatorProgram *)programFromInfixExpression;
+
+/// ----------------------
+/// @name Batch Operations
+/// ----------------------
+
+/**
+ Perform a unary operator on every operand of an array. Each result is the same
+ as the result of pushing the operand and performing the operator, but the
+ infix expression and the arithmetic cache of the calculator are not modified.
+ 
+ @param operator    The unary operator to calculate.
+ @param operands    The operands.
+ @param count       The number of operands.
+ @param results     The buffer with room for count values to store the results.
+                    It can be the operands buffer. The result of an operation
+                    which can not be executed successfully is NAN.
+ */
+- (void)performOperator:(NIBOperator *)operator
+             onOperands:(const double *)operands
+                  count:(NSUInteger)count
+                results:(double *)results;
+
+/**
+ Perform a binary operator on every pair of operands of two arrays. Each result
+ is the same as the result of evaluating the left operand, the operator and the
+ right operand, but the infix expression and the arithmetic cache of the
+ calculator are not modified.
+ 
+ @param operator        The binary operator to calculate.
+ @param leftOperands    The left operands.
+ @param rightOperands   The right operands.
+ @param count           The number of pairs of operands.
+ @param results         The buffer with room for count values to store the
+                        results. It can be one of the operands buffers. The
+                        result of an operation which can not be executed
+                        successfully is NAN.
+ */
+- (void)performOperator:(NIBOperator *)operator
+         onLeftOperands:(const double *)leftOperands
+          rightOperands:(const double *)rightOperands
+                  count:(NSUInteger)count
+                results:(double *)results;
+
+/// ----------------
+/// @name Solve Mode
+/// ----------------
+
+/**
+ Push an operand which is the unknown of the infix expression, in place of
+ pushOperand:. Its value is the guess the solve starts from. The unary
+ operators and the parenthesized groups performed on the unknown are kept with
+ it, so if the last result is calculated from the unknown, pushing the result
+ back with this method continues the unknown instead of starting a new one.
+ There is one unknown in the infix expression, a new one replaces the last.
+ 
+ @param operand The operand as double number.
+ */
+- (void)pushUnknown:(double)operand;
+
+/**
+ Find the value of the unknown which makes the infix expression equal to a
+ target, and complete the calculation as the equality does. The infix
+ expression at the root updates the arithmetic cache and is recorded to the
+ tape, so the equality after a solve repeats the last operation of the
+ expression. The derivatives the solve takes Newton steps with are evaluated
+ together with the values on dual numbers, in binary in decimal mode as well.
+ 
+ @param target  The value of the infix expression at the root.
+ 
+ @return Returns the number object of the unknown if there is a root, otherwise
+ `[NSDecimalNumber notANumber]`. Returns nil if there is no unknown in the
+ infix expression or the expression can not be evaluated.
+ */
+- (NSNumber *_Nullable)solveForTarget:(double)target;
+
+/**
+ Check if the infix expression of the calculator has an unknown.
+ 
+ @return Returns YES if the infix expression has an unknown, otherwise NO.
+ */
+- (BOOL)hasUnknownInInfixExpression;
+
+/// ---------------
+/// @name Snapshots
+/// ---------------
+
+/**
+ Set the state of the calculator to the fields of a snapshot, which are the
+ modes, the memory, the infix expression and the arithmetic cache. The snapshot
+ saves only the fields which change.
+ 
+ @param snapshot    The snapshot.
+ */
+- (void)writeStateToSnapshot:(NIBCalculatorSnapshot *)snapshot;
+
+/**
+ Restore the state of the calculator from the fields of a snapshot. The infix
+ expression is pushed token by token, so the calculator continues the
+ calculation in progress as if it is never stopped.
+ 
+ @param snapshot    The snapshot.
+ 
+ @return Returns YES if the snapshot has the state of a calculator, otherwise NO
+ and the calculator is not modified.
+ */
+- (BOOL)readStateFromSnapshot:(NIBCalculatorSnapshot *)snapshot;
+
 /// ---------------
 /// @name Utilities
 /// ---------------
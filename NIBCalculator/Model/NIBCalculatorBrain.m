@@ -7,8 +7,13 @@
 //
 
 #import "NIBCalculatorBrain.h"
-#import "NIBCalculatorStack.h"
+#import "NIBCalculatorKernels.h"
+#import "NIBCalculatorProgram.h"
+#import "NIBCalculatorSnapshot.h"
+#import "NIBCalculatorTape.h"
+#import "NIBInstrumentation.h"
 #import "NIBOperator.h"
+#import "NIBShuntingYard.h"
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -16,79 +21,53 @@
 
 
 /**
- @struct Fraction.
+ @struct NIBInfixCounts.
  
- @field numerator   Numerator of a fraction.
- @field denominator Denominator of a fraction.
+ @field operandCount                The number of operands.
+ @field binaryOperatorCount         The number of binary operators.
+ @field openingParenthesisCount     The number of openning parentheses.
+ @field closingParenthesisCount     The number of closing parentheses.
  */
-typedef struct Fraction {
-    int_least64_t numerator;
-    int_least64_t denominator;
-} Fraction;
-
-/** Values to indicate which of trigonometric functions is used. */
-typedef NS_ENUM(NSUInteger, NIBTrigonometricFuntion) {
-    /** Trigonometric sine function. */
-    NIBTrigonometricSinFunction,
-    /** Trigonometric cosine function. */
-    NIBTrigonometricCosFunction,
-    /** Trigonometric tangent function. */
-    NIBTrigonometricTanFunction
+typedef struct NIBInfixCounts {
+    NSInteger operandCount;
+    NSInteger binaryOperatorCount;
+    NSInteger openingParenthesisCount;
+    NSInteger closingParenthesisCount;
+} NIBInfixCounts;
+
+/** Values to indicate if the shunting yard follows the infix expression. */
+typedef NS_ENUM(NSUInteger, NIBShuntingYardState) {
+    /** The shunting yard holds the infix expression. */
+    NIBShuntingYardSynchronized,
+    /** The shunting yard must be rebuilt from the infix expression. */
+    NIBShuntingYardOutOfDate,
+    /** The infix expression is not a sequence the shunting yard can hold. */
+    NIBShuntingYardUnusable
 };
 
-/** Values to indicate which of hyperbolic functions is used. */
-typedef NS_ENUM(NSUInteger, NIBHyperbolicFunction) {
-    /** Hyperbolic sine function. */
-    NIBHyperbolicSineFunction,
-    /** Hyperbolic cosine function. */
-    NIBHyperbolicCosineFunction,
-    /** Hyperbolic tangent function. */
-    NIBHyperbolicTangentFunction
-};
-
-/** Values to indicate which of inverse trigonometricfunctions is used. */
-typedef NS_ENUM(NSUInteger, NIBInverseTrigonometricFuntion) {
-    /** Inverse trigonometric sine function. */
-    NIBInverseTrigonometricArcSinFunction,
-    /** Inverse trigonometric cosine function. */
-    NIBInverseTrigonometricArcCosFunction,
-    /** Inverse trigonometric tangent function. */
-    NIBInverseTrigonometricArcTanFunction
-};
-
-/** Values to indicate which of inversehyperbolic functions is used. */
-typedef NS_ENUM(NSUInteger, NIBInverseHyperbolicFunction) {
-    /** Inverse hyperbolic sine function. */
-    NIBInverseHyperbolicSineFunction,
-    /** Inverse hyperbolic sine function. */
-    NIBInverseHyperbolicCosineFunction,
-    /** Inverse hyperbolic sine function. */
-    NIBInverseHyperbolicTangentFunction
-};
-
-
-/////////////////////////////////////////////////////////////////////////////
-#pragma mark - Private Constants
-
-
-/** Max denominator using in the algorithm to convert a double number to fraction. */
-static const int_least64_t NIB_MAX_DENOMINATOR = INT_LEAST64_MAX;
-
-/** Approximation error using in the algorithm to convert a double number to fraction.  */
-static const double NIB_APPROX_ERROR = 0.0000000000001f;   // 10^-13
-
-/** Calculation error of the calculator. */
-static const double NIB_CAL_ERROR = 0.000000000000001f; // 10^-15
+/**
+ @struct NIBInfixEvaluation.
+ 
+ @field isValid     The boolean value to indicate if the evaluation is of the
+                    current infix expression.
+ @field hasResult   The boolean value to indicate if the expression has a result.
+ @field result      The result of the expression.
+ */
+typedef struct NIBInfixEvaluation {
+    BOOL isValid;
+    BOOL hasResult;
+    double result;
+} NIBInfixEvaluation;
 
 
 /////////////////////////////////////////////////////////////////////////////
 #pragma mark - Declaration of Private Functions
 
 
-static Fraction NIBFractionFromDouble(double);
-static BOOL NIBIsNegativeFraction(Fraction);
-static int_least64_t NIBGreatCommonDivisor(uint_least64_t, uint_least64_t);
-static NSNumber * NIBRoundNumberWithCalculationError(NSNumber *);
+static void NIBInfixCountsCountToken(NIBInfixCounts *, NIBToken, NSInteger);
+static BOOL NIBShuntingYardPushToken(NIBShuntingYard *, NIBToken, const NIBToken *_Nullable);
+static NSInteger NIBReductionPrecedenceOfAddingOperator(NIBButtonTag);
+static NSNumber * NIBNumberFromDouble(double);
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -97,7 +76,55 @@ static NSNumber * NIBRoundNumberWithCalculationError(NSNumber *);
 
 NS_ASSUME_NONNULL_BEGIN
 
-@interface NIBCalculatorBrain ()
+@interface NIBCalculatorBrain () {
+    /** The arithmetic cache of the calculator. */
+    NIBTokenBuffer _arithmeticCache;
+    
+    /** The infix expression. */
+    NIBTokenBuffer _infixExpression;
+    
+    /** The counts of the tokens of the infix expression, kept up to date by every change. */
+    NIBInfixCounts _infixCounts;
+    
+    /** The infix expression as a shunting yard, reduced as the tokens arrive. */
+    NIBShuntingYard _shuntingYard;
+    
+    /** The state of the shunting yard. */
+    NIBShuntingYardState _shuntingYardState;
+    
+    /** The evaluation of the whole infix expression, kept until the infix expression changes. */
+    NIBInfixEvaluation _infixEvaluation;
+    
+    /** The postfix expression reused by every evaluation. */
+    NIBTokenBuffer _postfixExpression;
+    
+    /** The infix expression followed by the arithmetic cache, reused by every peek of the equality. */
+    NIBTokenBuffer _peekExpression;
+    
+    /** The operator stack reused by every conversion to postfix expression. */
+    NIBTokenBuffer _operatorStack;
+    
+    /** The expression recorded to the tape, reused by every record. */
+    NIBTokenBuffer _tapeExpression;
+    
+    /** The index of the operand which is the unknown in the infix expression, NSNotFound if there is none. */
+    NSUInteger _unknownIndex;
+    
+    /** The postfix expression of the unary operators and the groups performed on the unknown, which the unknown operand stands for. */
+    NIBTokenBuffer _unknownExpression;
+    
+    /** The index of the unknown among the operands of the unknown expression. */
+    NSUInteger _unknownOperandIndex;
+    
+    /** The boolean value to indicate if the last result is calculated from the unknown and is not pushed back yet. */
+    BOOL _hasPendingUnknownResult;
+    
+    /** The postfix expression reused by every solve. */
+    NIBTokenBuffer _solveExpression;
+    
+    /** The memory as a decimal, which the memory is converted from in decimal mode. */
+    NIBDecimal128 _decimalMemory;
+}
 
 /// -----------------------
 /// @name Public Properties
@@ -109,259 +136,235 @@ NS_ASSUME_NONNULL_BEGIN
 /// @name Private Properties
 /// ------------------------
 
-/** The arithmetic cache of the calculator. */
-@property (readwrite, strong, nonatomic) NSMutableArray *arithmeticCache;
-
-/** The infix expression. */
-@property (readwrite, strong, nonatomic) NSMutableArray *infixExpression;
-
 /** The trigonometric mode for angle. */
 @property (readwrite, assign, nonatomic) BOOL isRadianMode;
 
+/** The number mode. */
+@property (readwrite, assign, nonatomic) BOOL isDecimalMode;
+
+/** The compiled program repeating the arithmetic cache on a sole operand. */
+@property (readwrite, strong, nonatomic) NIBCalculatorProgram *_Nullable arithmeticCacheProgram;
+
 /// --------------------------
 /// @name Operation Processing
 /// --------------------------
 
 /**
- Process when operator is equality.
+ Perform an operator on the infix expression.
  
- @return Returns the number object after process.
+ @param operatorTag The tag of the operator.
+ @param result      The result of the operator.
+ 
+ @return Returns YES if the operator has a result, otherwise NO.
  */
-- (NSNumber *_Nullable)processEqualityOperator;
+- (BOOL)performOperatorTag:(NIBButtonTag)operatorTag result:(double *)result;
 
 /**
- Process when operation is an parenthesis operator.
+ Process when operator is equality.
  
- @param operator The parenthesis operator.
+ @param result  The result after process.
  
- @return Returns the number object after process.
+ @return Returns YES if the process has a result, otherwise NO.
  */
-- (NSNumber *_Nullable)processClosingParenthesisOperator:(NIBOperator *)operator;
+- (BOOL)processEqualityOperatorWithResult:(double *)result;
 
 /**
- Process when operator is a binary operator.
+ Process when operation is an parenthesis operator.
  
- @param operator The unary operator.
+ @param operatorTag The tag of the parenthesis operator.
+ @param result      The result after process.
  
- @return Returns the number object after process.
+ @return Returns YES if the process has a result, otherwise NO.
  */
-- (NSNumber *_Nullable)processUnaryOperator:(NIBOperator *)operator;
+- (BOOL)processClosingParenthesisOperator:(NIBButtonTag)operatorTag result:(double *)result;
 
 /**
  Process when operator is a binary operator.
  
- @param operator The binary operator.
+ @param operatorTag The tag of the unary operator.
+ @param result      The result after process.
  
- @return Returns the number object after process.
+ @return Returns YES if the process has a result, otherwise NO.
  */
-- (NSNumber *_Nullable)processBinaryOperator:(NIBOperator *)operator;
-
-/// ------------------------
-/// @name Calculation Center
-/// ------------------------
+- (BOOL)processUnaryOperator:(NIBButtonTag)operatorTag result:(double *)result;
 
 /**
- Evaluate infix expression.
+ Process when operator is a binary operator.
  
- @param infixExp The infix expression.
+ @param operatorTag The tag of the binary operator.
+ @param result      The result after process.
  
- @return Returns the number of the expression.
+ @return Returns YES if the process has a result, otherwise NO.
  */
-- (NSNumber *_Nullable)evaluateInfixExpression:(NSArray *)infixExp;
+- (BOOL)processBinaryOperator:(NIBButtonTag)operatorTag result:(double *)result;
+
+/// -----------------------
+/// @name Operator Peeking
+/// -----------------------
 
 /**
- Evaluate posfix expression.
+ Get the result of processing an operator without modifying the infix
+ expression or the arithmetic cache.
  
- @param postfixExp The postfix expression.
+ @param operatorTag The tag of the operator.
+ @param result      The result the process would have.
  
- @return Returns the result as a number object of the postfix expression.
+ @return Returns YES if the process would have a result, otherwise NO.
  */
-- (NSNumber *_Nullable)evaluatePostfixExpression:(NSArray *)postfixExp;
+- (BOOL)peekOperator:(NIBButtonTag)operatorTag result:(double *)result;
 
 /**
- Perform unary operator on an operand.
+ Get the result of processing the equality operator without modifying the
+ infix expression or the arithmetic cache.
  
- @param operator    The unary operator.
- @param operand     The operand to perform unary operation.
+ @param result  The result the process would have.
  
- @return Returns the result as a number object of the unary operator if it
- is successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @return Returns YES if the process would have a result, otherwise NO.
  */
-- (NSNumber *_Nullable)performUnaryOperator:(NIBOperator *)operator
-                                  onOperand:(NSNumber *_Nullable)operand;
+- (BOOL)peekEqualityOperatorWithResult:(double *)result;
 
-/// ---------------------------
-/// @name Arithmetic Operations
-/// ---------------------------
+/// ------------------------
+/// @name Calculation Center
+/// ------------------------
 
 /**
- Handle division operation of calculation stack.
+ Evaluate infix expression. The evaluation of the whole infix expression of an
+ instance is kept until the infix expression changes.
  
- @param calStack The calculation stack.
- */
-- (void)performDivisionOfStack:(NIBCalculatorStack<NSNumber *> *)calStack;
-
-/**
- Handle multiplicaiton operation of calculation stack.
+ @param infixExp    The tokens of the infix expression.
+ @param count       The number of tokens.
+ @param result      The result of the expression.
  
- @param calStack The calculation stack.
+ @return Returns YES if the expression has a result, otherwise NO.
  */
-- (void)performMultiplicationOfStack:(NIBCalculatorStack<NSNumber *> *)calStack;
+- (BOOL)evaluateInfixExpression:(const NIBToken *_Nullable)infixExp
+                          count:(NSUInteger)count
+                         result:(double *)result;
 
 /**
- Handle substraction operation of calculation stack.
+ Evaluate posfix expression.
  
- @param calStack The calculation stack.
- */
-- (void)performSubstractionOfStack:(NIBCalculatorStack<NSNumber *> *)calStack;
-
-/**
- Handle addition operation of calculation stack.
+ @param postfixExp  The postfix expression.
+ @param result      The result of the expression.
  
- @param calStack The calculation stack.
+ @return Returns YES if the expression has a result, otherwise NO.
  */
-- (void)performAdditionOfStack:(NIBCalculatorStack<NSNumber *> *)calStack;
-
-/// ---------------------------
-/// @name Functional Operations
-/// ---------------------------
+- (BOOL)evaluatePostfixExpression:(const NIBTokenBuffer *)postfixExp result:(double *)result;
 
 /**
- Handle percentage operation of calculation stack.
+ Perform unary operator on an operand.
  
- @param operand The operand to calculate percentage.
+ @param operatorTag The tag of the unary operator.
+ @param operand     The operand to perform unary operation.
  
- @return Returns a number object as a result of the percentage operation
- if it is successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @return Returns the result of the unary operator if it is successful,
+ otherwise NAN.
  */
-- (NSNumber *)percentageOfOperand:(NSNumber *_Nullable)operand;
+- (double)performUnaryOperator:(NIBButtonTag)operatorTag onOperand:(double)operand;
 
-/**
- Raise to the power of base. It used to handle root
- and exponent operation.
- 
- @param power   The power to raise.
- @param base    The base of exponent operation.
- 
- @return Returns a number object as a result of the exponentiation if
- it is successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
- */
-- (NSNumber *)raiseToPower:(NSNumber *_Nullable)power
-                    ofBase:(NSNumber *_Nullable)base;
+/// ----------------------
+/// @name Arithmetic Cache
+/// ----------------------
 
 /**
- Perform trigonometric functions on an operand.
- 
- @param trigonometricFunction   The trigonometric functions defined
-                                in NIBTrigonometricFuntion.
- @param operand                 The operand to perform trigonometric functions.
+ Update the arithmetic cache.
  
- @return Returns a number object as a result of the trigonometric function
- if it is successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @param exp     The tokens of the expression to cache.
+ @param count   The number of tokens. If the count is 0, the cache is cleared.
  */
-- (NSNumber *)performTrigonometricFunction:(NIBTrigonometricFuntion)trigonometricFunction
-                                 ofOperand:(NSNumber *_Nullable)operand;
+- (void)updateArithmeticCacheWithExpression:(const NIBToken *_Nullable)exp count:(NSUInteger)count;
+
+/// ----------
+/// @name Tape
+/// ----------
 
 /**
- Perform hyperbolic functions on an operand.
- 
- @param hyperbolicFunction  The hyperbolic functions defined
-                            in NIBHyperbolicFunction.
- @param operand             The operand to perform hyperbolic functions.
+ Record the infix expression and its result to the tape.
  
- @return Returns a number object as a result of the hyperbolic function
- if it is successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @param isWithArithmeticCache   The boolean value to indicate if the arithmetic
+                                cache is repeated on the infix expression, so
+                                it is recorded after the infix expression.
+ @param result                  The result of the expression.
  */
-- (NSNumber *)performHyperbolicFunction:(NIBHyperbolicFunction)hyperbolicFunction
-                              ofOperand:(NSNumber *_Nullable)operand;
+- (void)recordInfixExpressionWithArithmeticCache:(BOOL)isWithArithmeticCache result:(double)result;
 
 /**
- Perform inverse trigonometric functions of an operand.
+ Repeat the arithmetic cache on an operand. For example: given the arithmetic
+ cache x3, repeating the cache on the operand 5 evaluates 5x3. The expression is
+ compiled once until the arithmetic cache changes.
  
- @param inverseTrigFunc The inverse trigonometric functions
-                        defined in NIBInverseTrigonometricFunction.
- @param operand         The operand to perform trigonometric functions.
+ @param operand The operand.
+ @param result  The result of the expression.
  
- @return Returns a number object as a result of the inverse trigonometric
- function if it is successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @return Returns YES if the expression has a result, otherwise NO.
  */
-- (NSNumber *)performInverseTrigonometricFunction:(NIBInverseTrigonometricFuntion)inverseTrigFunc
-                                        ofOperand:(NSNumber *_Nullable)operand;
+- (BOOL)repeatArithmeticCacheOnOperand:(double)operand result:(double *)result;
+
+/// ----------------
+/// @name Solve Mode
+/// ----------------
 
 /**
- Handle inverse hyperbolic functions.
- 
- @param inverseHyperbolicFunc   The inverse trigonometric
-                                defined in NIBInverseHyperbolicFunction.
- @param operand                 The operand to perform inverse hyperbolic
-                                functions.
+ Complete the infix expression at the root of a solve as the equality does. The
+ unknown operand is replaced with the value of the unknown expression at the
+ root, the arithmetic cache is updated from the completed expression if it has
+ more than one operand, and the expression is recorded to the tape with its
+ result.
  
- @return Returns a number object as a result of the inverse hyperbolic
- function if it is successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @param root    The root of the unknown.
  */
-- (NSNumber *)performInverseHyperbolicFunction:(NIBInverseHyperbolicFunction)inverseHyperbolicFunc
-                                     ofOperand:(NSNumber *_Nullable)operand;
+- (void)completeInfixExpressionWithUnknownAtRoot:(double)root;
+
+/// ----------------------
+/// @name Infix Expression
+/// ----------------------
 
 /**
- Perform function of f(x)=1/x.
- 
- @param operand The operand to perform a function.
+ Append a token to the infix expression of an instance.
  
- @return Returns a number object as a result of the function if it is
- successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @param token   The token to append.
  */
-- (NSNumber *)performInverseFunctionOfOperand:(NSNumber *_Nullable)operand;
+- (void)appendTokenToInfixExpression:(NIBToken)token;
 
 /**
- Handle logarithm function of a certain base.
+ Append tokens to the infix expression of an instance.
  
- @param operand     The operand to find logarithm.
- @param base        The base of a logarithm. Base is a positive real number not
- equal to 1.
- 
- @return Returns a number object as a result of the logarithm function if it is
- successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @param tokens  The tokens to append.
+ @param count   The number of tokens.
  */
-- (NSNumber *)performLogarithmFunctionOf:(NSNumber *_Nullable)operand
-                       withRespectToBase:(NSNumber *)base;
+- (void)appendTokensToInfixExpression:(const NIBToken *_Nullable)tokens count:(NSUInteger)count;
 
 /**
- Handle factorial operation of an operand.
- 
- @param operand The operand to perform a function.
+ Remove the tokens from an index to the end of the infix expression of an
+ instance.
  
- @return Returns a number object as a result of the factorial function if
- it is successful. If the operation is not successful, returns
- [NSDecimalNumber notANumber]. Otherwise, returns nil.
+ @param count   The number of tokens to keep.
  */
-- (NSNumber *_Nullable)performFactorialOf:(NSNumber *_Nullable)operand;
+- (void)truncateInfixExpressionToCount:(NSUInteger)count;
+
+/// -------------------
+/// @name Shunting Yard
+/// -------------------
 
 /**
- Hanlde scientific notation operation of calculation stack.
+ Rebuild the shunting yard from the infix expression of an instance if it is
+ out of date.
  
- @param calStack The calculation stack.
+ @return Returns YES if the shunting yard holds the infix expression, otherwise
+ NO.
  */
-- (void)performScientificNotationOfStack:(NIBCalculatorStack<NSNumber *> *)calStack;
-
-/// ----------------------
-/// @name Arithmetic Cache
-/// ----------------------
+- (BOOL)synchronizeShuntingYard;
 
 /**
- Update the arithmetic cache.
+ Reduce the shunting yard to the partial infix expression which is the left
+ operand if add a given operator to the infix expression of an instance, as
+ indexOfPartialInfixExpressionAsLeftOperandOfAddingOperator: does.
  
- @param exp The expression to cache.
+ @param operatorTag The tag of the operator to add.
+ 
+ @return Returns the value of the partial infix expression.
  */
-- (void)updateArithmeticCacheWithExpression:(NSArray *_Nullable)exp;
+- (double)reduceShuntingYardForAddingOperator:(NIBButtonTag)operatorTag;
 
 /// -------------
 /// @name Helpers
@@ -371,7 +374,7 @@ NS_ASSUME_NONNULL_BEGIN
  Check if an operand can be replaced in an infix expression of an instance.
  The operand can be replaced if and only if there is a sole operand and no
  binary operators in the expression.
-
+ 
  @return Returns YES it the operand can be replaced in the infix expression
  of the instance. Otherwise, NO.
  */
@@ -403,46 +406,47 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  Convert to postfix expression from infix expression.
  
- @param infixExp The infix expression.
- 
- @return Returns the posfix expression.
- */
-- (NSArray *)postfixExpressionFromInfixExpression:(NSArray *)infixExp;
-
-/**
- Check if an angle is equals Pi/2*(2k+1) (k is integer).
- 
- @param angle The angle to check.
- 
- @return Returns YES if the angle is an odd multiplication of Pi/2, otherwise NO.
+ @param infixExp    The tokens of the infix expression.
+ @param count       The number of tokens.
+ @param postfixExp  The buffer to store the postfix expression.
  */
-- (BOOL)isOddMultiplicationOfPi_2:(double)angle;
+- (void)postfixExpressionFromInfixExpression:(const NIBToken *_Nullable)infixExp
+                                       count:(NSUInteger)count
+                                    toBuffer:(NIBTokenBuffer *)postfixExp;
 
 /**
- Get the partial infix expression containing the last binary operator and
- operand of the infix expression.
+ Convert to postfix expression from infix expression which holds the unknown,
+ with the unknown operand replaced by the unknown expression it stands for.
  
- @param infixExp The infix expression.
+ @param infixExp        The tokens of the infix expression.
+ @param count           The number of tokens.
+ @param unknownIndex    The index of the unknown operand in the tokens.
+ @param postfixExp      The buffer to store the postfix expression.
  
- @return Returns the partical infix expression of the given infix expression.
- If the last part of infix expression having parenthesis, return nil.
+ @return Returns the index of the unknown among the operands of the postfix
+ expression.
  */
-- (NSArray *_Nullable)partialInfixExpressionContainingLastElementsFromExpression:(NSArray *)infixExp;
+- (NSUInteger)postfixExpressionFromInfixExpression:(const NIBToken *_Nullable)infixExp
+                                             count:(NSUInteger)count
+                                      unknownIndex:(NSUInteger)unknownIndex
+                                          toBuffer:(NIBTokenBuffer *)postfixExp;
 
 /**
  Get the partial infix expression which is the left operand if add a given
- operator to a whole infix expression. For example: given the expression 3+4x5.
- If the plus sign (+) is added, the partial expression is 3+4x5. If the
- multiplication sign (x) is added, the partial expression is 4x5.
+ operator to the infix expression of an instance. For example: given the
+ expression 3+4x5. If the plus sign (+) is added, the partial expression is
+ 3+4x5. If the multiplication sign (x) is added, the partial expression is 4x5.
+ The partial infix expression always runs to the end of the leading tokens.
  
- @param infixExp    The infix expression.
- @param operator    The operator to add.
+ @param operatorTag The tag of the operator to add.
+ @param count       The number of leading tokens of the infix expression to
+                    add the operator to.
  
- @return Returns the partical infix expression of the given infix expression,
- which is a left operand of adding operator.
+ @return Returns the index of the first token of the partial infix expression
+ in the infix expression of an instance.
  */
-- (NSArray *_Nullable)partialInfixExpressionFromExpression:(NSArray *)infixExp
-                             asLeftOperandOfAddingOperator:(NIBOperator *)operator;
+- (NSUInteger)indexOfPartialInfixExpressionAsLeftOperandOfAddingOperator:(NIBButtonTag)operatorTag
+                                                                   count:(NSUInteger)count;
 
 @end
 
@@ -460,14 +464,27 @@ NS_ASSUME_NONNULL_END
     
     if (self) {
         _memory = nil;
-        _arithmeticCache = [[NSMutableArray alloc] initWithCapacity:2];
         _isRadianMode = NO;
-        _infixExpression = [[NSMutableArray alloc] init];
+        _isDecimalMode = NO;
+        _unknownIndex = NSNotFound;
     }
     
     return self;
 }
 
+- (void)dealloc
+{
+    NIBTokenBufferFree(&_arithmeticCache);
+    NIBTokenBufferFree(&_infixExpression);
+    NIBTokenBufferFree(&_postfixExpression);
+    NIBTokenBufferFree(&_peekExpression);
+    NIBTokenBufferFree(&_operatorStack);
+    NIBTokenBufferFree(&_tapeExpression);
+    NIBTokenBufferFree(&_unknownExpression);
+    NIBTokenBufferFree(&_solveExpression);
+    NIBShuntingYardFree(&_shuntingYard);
+}
+
 
 /////////////////////////////////////////////////////////////////////////////
 #pragma mark - Public Methods
@@ -477,7 +494,7 @@ NS_ASSUME_NONNULL_END
 
 - (void)pushOperand:(double)operand
 {
-    [self.infixExpression addObject:[[NSNumber alloc] initWithDouble:operand]];
+    [self appendTokenToInfixExpression:NIBTokenMakeOperand(operand)];
 }
 
 - (NSNumber *)performOperator:(NIBOperator *)operator
@@ -488,48 +505,82 @@ NS_ASSUME_NONNULL_END
 - (NSNumber *)performOperator:(NIBOperator *)operator
        withExperimentalModeOn:(BOOL)isExperimentalModeOn
 {
-    NSArray *cloneInfExp = [self.infixExpression copy];
-    NSNumber *result = nil;
+    /* if the experimental mode on, peek the operator instead */
+    if (isExperimentalModeOn) {
+        return [self peekOperator:operator];
+    }
     
-    /* if an operator is equality */
-    if (operator.idx == NIBButtonEquality) {
-        result = [self processEqualityOperator];
-        
-    /* if an operator is unary operator */
-    } else if ([operator isUnaryOperator]) {
-        result = [self processUnaryOperator:operator];
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageEvaluation);
     
-    /* if an operator is closing parenthesis */
-    } else if ([operator isClosingParanthesis]) {
-        result = [self processClosingParenthesisOperator:operator];
-        
-    /* otherwise, an operator is binary operator */
-    } else if ([operator isBinaryOperator]) {
-        result = [self processBinaryOperator:operator];
+    double result = NAN;
+    BOOL hasResult = [self performOperatorTag:(NIBButtonTag)operator.idx result:&result];
+    
+    return hasResult ? NIBNumberFromDouble(result) : nil;
+}
 
-    /* otherwise, an operator may be open parenthesis */
-    } else {
-        [self.infixExpression addObject:operator];
+- (NSNumber *)performExpression:(const NIBToken *)tokens count:(NSUInteger)count
+{
+    /* if there is no token, there is nothing on the display */
+    if (count == 0) {
+        return nil;
     }
     
-    // if result is not a number, clear the operand stack and
-    // operation stack to avoid future calculation error
-    if ([result isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        [self.infixExpression removeAllObjects];
-    };
+    double display = 0;
+    BOOL canBinaryOperatorPushOperand = NO;
     
-    /* if the experimental mode on */
-    if (isExperimentalModeOn) {
-        [self.infixExpression removeAllObjects];
-        [self.infixExpression addObjectsFromArray:cloneInfExp];
+    for (NSUInteger i = 0; i < count; i++) {
+        NIBToken token = tokens[i];
+        double result = NAN;
+        
+        /* if a token is an operand, it is typed on the display */
+        if (token.kind == NIBTokenKindOperand) {
+            display = token.operand;
+            canBinaryOperatorPushOperand = YES;
+            continue;
+        }
+        
+        /* if a token is a binary operator, it pushes the display once after a number is typed */
+        if (NIBIsBinaryOperatorTag(token.tag)) {
+            if (canBinaryOperatorPushOperand) {
+                [self appendTokenToInfixExpression:NIBTokenMakeOperand(display)];
+                canBinaryOperatorPushOperand = NO;
+            }
+        
+        /* otherwise, a token pushes the display unless it is an openning parenthesis */
+        } else if (token.tag != NIBButtonOpenningParenthesis) {
+            [self appendTokenToInfixExpression:NIBTokenMakeOperand(display)];
+        }
+        
+        if ([self performOperatorTag:token.tag result:&result]) {
+            display = result;
+        }
     }
     
-    return result;
+    return NIBNumberFromDouble(display);
+}
+
+- (NSNumber *)peekOperator:(NIBOperator *)operator
+{
+    double result = NAN;
+    BOOL hasResult = [self peekOperator:(NIBButtonTag)operator.idx result:&result];
+    
+    return hasResult ? NIBNumberFromDouble(result) : nil;
+}
+
+- (BOOL)peekOperator:(NIBOperator *)operator withResult:(double *)result
+{
+    return [self peekOperator:(NIBButtonTag)operator.idx result:result];
 }
 
 - (void)addToMemory:(double)value
 {
-    if (self.memory == nil) {
+    /* if the calculator is in decimal mode, add to the decimal memory */
+    if (self.isDecimalMode) {
+        NIBDecimal128 decimalValue = NIBDecimal128FromDouble(value);
+        
+        _decimalMemory = (self.memory == nil) ? decimalValue : NIBDecimal128Add(_decimalMemory, decimalValue);
+        self.memory = [[NSNumber alloc] initWithDouble:NIBDecimal128ToDouble(_decimalMemory)];
+    } else if (self.memory == nil) {
         self.memory = [[NSNumber alloc] initWithDouble:value];
     } else {
         self.memory = [[NSNumber alloc] initWithDouble:(self.memory.doubleValue + value)];
@@ -538,7 +589,13 @@ NS_ASSUME_NONNULL_END
 
 - (void)subtractFromMemory:(double)value
 {
-    if (self.memory == nil) {
+    /* if the calculator is in decimal mode, subtract from the decimal memory */
+    if (self.isDecimalMode) {
+        NIBDecimal128 memory = (self.memory == nil) ? NIBDecimal128FromDouble(0) : _decimalMemory;
+        
+        _decimalMemory = NIBDecimal128Subtract(memory, NIBDecimal128FromDouble(value));
+        self.memory = [[NSNumber alloc] initWithDouble:NIBDecimal128ToDouble(_decimalMemory)];
+    } else if (self.memory == nil) {
         self.memory = [[NSNumber alloc] initWithDouble:-value];
     } else {
         self.memory = [[NSNumber alloc] initWithDouble:(self.memory.doubleValue - value)];
@@ -552,8 +609,9 @@ NS_ASSUME_NONNULL_END
 
 - (void)clearArithmetic
 {
-    [self.arithmeticCache removeAllObjects];
-    [self.infixExpression removeAllObjects];
+    NIBTokenBufferTruncate(&_arithmeticCache, 0);
+    [self truncateInfixExpressionToCount:0];
+    self.arithmeticCacheProgram = nil;
 }
 
 - (void)toggleRadianMode
@@ -561,6 +619,22 @@ NS_ASSUME_NONNULL_END
     self.isRadianMode = !self.isRadianMode;
 }
 
+- (void)toggleDecimalMode
+{
+    self.isDecimalMode = !self.isDecimalMode;
+    _decimalMemory = NIBDecimal128FromDouble(self.memory.doubleValue);
+    
+    // the operands are kept as doubles in both modes, and the decimal
+    // evaluation reads each of them as its shortest decimal, so only the
+    // evaluations of the old mode are dropped. The shunting yard and the
+    // compiled programs reduce doubles, so the shunting yard is not used in
+    // decimal mode and is rebuilt from the infix expression after it
+    _infixEvaluation.isValid = NO;
+    self.arithmeticCacheProgram = nil;
+    NIBShuntingYardReset(&_shuntingYard);
+    _shuntingYardState = self.isDecimalMode ? NIBShuntingYardUnusable : NIBShuntingYardOutOfDate;
+}
+
 - (NSNumber *)constantNumber:(NIBOperator *)operator
 {
     NSNumber *result = nil;
@@ -569,11 +643,11 @@ NS_ASSUME_NONNULL_END
         case NIBButtonPi:
             result = [[NSNumber alloc] initWithDouble:M_PI];
             break;
-            
+        
         case NIBButtonEulerNumber:
             result = [[NSNumber alloc] initWithDouble:M_E];
             break;
-            
+        
         case NIBButtonRand:
             result = [[NSNumber alloc] initWithDouble:arc4random_uniform(UINT_FAST32_MAX)/(double)UINT_FAST32_MAX];
             break;
@@ -582,50 +656,216 @@ NS_ASSUME_NONNULL_END
     return result;
 }
 
-#pragma mark Utilities
+#pragma mark Compiled Programs
 
-- (BOOL)isWaitingForOperandInInfixExpression
+- (NIBCalculatorProgram *)programWithInfixExpression:(const NIBToken *)infixExp count:(NSUInteger)count
 {
-    NSInteger operandCount = 0;
-    NSInteger binaryOperationCount = 0;
-   
-    /* count the number of operand and binary operator in infix expression */
-    for (id token in self.infixExpression) {
-        if ([token isKindOfClass:[NSNumber class]]) {
-            operandCount++;
-            continue;
-        }
-        if ([token isKindOfClass:[NIBOperator class]] && [token isBinaryOperator]) {
-            binaryOperationCount++;
+    [self postfixExpressionFromInfixExpression:infixExp count:count toBuffer:&_postfixExpression];
+    
+    return [NIBCalculatorProgram programWithPostfixExpression:_postfixExpression.tokens
+                                                        count:_postfixExpression.count];
+}
+
+- (NIBCalculatorProgram *)programFromInfixExpression
+{
+    return [self programWithInfixExpression:_infixExpression.tokens count:_infixExpression.count];
+}
+
+#pragma mark Batch Operations
+
+- (void)performOperator:(NIBOperator *)operator
+             onOperands:(const double *)operands
+                  count:(NSUInteger)count
+                results:(double *)results
+{
+    /* if the operator is not unary, every result is not a number */
+    if (![operator isUnaryOperator]) {
+        for (NSUInteger i = 0; i < count; i++) results[i] = NAN;
+        return;
+    }
+    
+    NIBPerformUnaryOperatorOnOperands((NIBButtonTag)operator.idx, operands, results, count, self.isRadianMode);
+}
+
+- (void)performOperator:(NIBOperator *)operator
+         onLeftOperands:(const double *)leftOperands
+          rightOperands:(const double *)rightOperands
+                  count:(NSUInteger)count
+                results:(double *)results
+{
+    /* if the operator is not binary, every result is not a number */
+    if (![operator isBinaryOperator]) {
+        for (NSUInteger i = 0; i < count; i++) results[i] = NAN;
+        return;
+    }
+    
+    NIBPerformBinaryOperatorOnOperands((NIBButtonTag)operator.idx, leftOperands, rightOperands, results, count);
+}
+
+#pragma mark Solve Mode
+
+- (void)pushUnknown:(double)operand
+{
+    /* if the operand is not the result calculated from the unknown, it is a new unknown */
+    if (!_hasPendingUnknownResult) {
+        NIBTokenBufferTruncate(&_unknownExpression, 0);
+        NIBTokenBufferAppend(&_unknownExpression, NIBTokenMakeOperand(operand));
+        _unknownOperandIndex = 0;
+    }
+    
+    [self appendTokenToInfixExpression:NIBTokenMakeOperand(operand)];
+    _unknownIndex = _infixExpression.count - 1;
+}
+
+- (NSNumber *)solveForTarget:(double)target
+{
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageEvaluation);
+    
+    // the expression is solved where the equality evaluates it, when the
+    // operands match the binary operators or the parentheses are mismatched
+    if (_unknownIndex == NSNotFound ||
+        (_infixCounts.operandCount != _infixCounts.binaryOperatorCount + 1 && ![self hasMisMatchedParenthesesInInfixExpression])) {
+        return nil;
+    }
+    
+    NSUInteger unknownOperandIdx = [self postfixExpressionFromInfixExpression:_infixExpression.tokens
+                                                                        count:_infixExpression.count
+                                                                 unknownIndex:_unknownIndex
+                                                                     toBuffer:&_solveExpression];
+    
+    /* the guess is the value the unknown is pushed with */
+    double guess = NAN;
+    NSUInteger operandIdx = 0;
+    
+    for (NSUInteger i = 0; i < _unknownExpression.count; i++) {
+        if (_unknownExpression.tokens[i].kind == NIBTokenKindOperand && operandIdx++ == _unknownOperandIndex) {
+            guess = _unknownExpression.tokens[i].operand;
+            break;
         }
     }
+    
+    double root = NAN;
+    
+    /* if there is a root, complete the infix expression at the root as the equality does */
+    if (NIBSolvePostfixExpression(_solveExpression.tokens, _solveExpression.count, unknownOperandIdx, target, guess, self.isRadianMode, &root, NULL)) {
+        [self completeInfixExpressionWithUnknownAtRoot:root];
+    }
+    
+    /* clear the infix expression */
+    [self truncateInfixExpressionToCount:0];
+    
+    return NIBNumberFromDouble(root);
+}
 
-    // the infix expression is waiting for an operand if there is at least
-    // one binary operator and at least one operand and the number of
-    // of operand is less than than the number of binary operator plus 1
-    return (binaryOperationCount > 0 && operandCount > 0 && operandCount < binaryOperationCount + 1);
+- (BOOL)hasUnknownInInfixExpression
+{
+    return (_unknownIndex != NSNotFound);
 }
 
-+ (BOOL)isInterger:(NSNumber *)decimalNumber
+- (void)completeInfixExpressionWithUnknownAtRoot:(double)root
+{
+    NSUInteger unknownIdx = _unknownIndex;
+    NIBDual unknownValue = NIBDualMake(NAN, NAN);
+    
+    /* the unknown operand stands for the unknown expression, evaluate it at the root */
+    NIBEvaluateDualPostfixExpression(_unknownExpression.tokens, _unknownExpression.count, _unknownOperandIndex, root, self.isRadianMode, &unknownValue);
+    
+    /* substitute the value for the unknown operand, the tokens after it are pushed again */
+    NIBTokenBufferSetBuffer(&_solveExpression, &_infixExpression);
+    _solveExpression.tokens[unknownIdx] = NIBTokenMakeOperand(unknownValue.value);
+    
+    [self truncateInfixExpressionToCount:unknownIdx];
+    [self appendTokensToInfixExpression:_solveExpression.tokens + unknownIdx count:_solveExpression.count - unknownIdx];
+    
+    // as the equality does, a sole operand keeps the arithmetic cache, so the
+    // unary operator performed on the unknown is repeated as it is after x sin =
+    if ([self countOperandInInfixExpression] > 1 && ![self hasMisMatchedParenthesesInInfixExpression]) {
+        [self updateArithmeticCacheWithExpression:_infixExpression.tokens + _infixExpression.count - 2
+                                            count:2];
+    }
+    
+    double result = NAN;
+    
+    /* record the completed expression and its result to the tape */
+    if ([self evaluateInfixExpression:_infixExpression.tokens count:_infixExpression.count result:&result] && self.tape) {
+        [self recordInfixExpressionWithArithmeticCache:NO result:result];
+    }
+}
+
+#pragma mark Snapshots
+
+- (void)writeStateToSnapshot:(NIBCalculatorSnapshot *)snapshot
 {
-    BOOL isInteger = NO;
+    NIBSnapshotModes modes = (self.isRadianMode ? NIBSnapshotModeRadian : 0) | (self.isDecimalMode ? NIBSnapshotModeDecimal : 0);
+    double memory = self.memory.doubleValue;
     
-    NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
-    numberFormatter.locale = [NSLocale currentLocale];
-    numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+    [snapshot setData:[NSData dataWithBytes:&modes length:sizeof(modes)] ofField:NIBSnapshotFieldModes];
+    [snapshot setData:[NSData dataWithBytes:&memory length:(self.memory ? sizeof(memory) : 0)] ofField:NIBSnapshotFieldMemory];
+    [snapshot setData:NIBSnapshotDataFromTokens(_infixExpression.tokens, _infixExpression.count) ofField:NIBSnapshotFieldInfixExpression];
+    [snapshot setData:NIBSnapshotDataFromTokens(_arithmeticCache.tokens, _arithmeticCache.count) ofField:NIBSnapshotFieldArithmeticCache];
+}
+
+- (BOOL)readStateFromSnapshot:(NIBCalculatorSnapshot *)snapshot
+{
+    NSData *modesData = [snapshot dataOfField:NIBSnapshotFieldModes];
+    NSData *memoryData = [snapshot dataOfField:NIBSnapshotFieldMemory];
+    NSData *infixData = [snapshot dataOfField:NIBSnapshotFieldInfixExpression];
+    NSData *cacheData = [snapshot dataOfField:NIBSnapshotFieldArithmeticCache];
+    NIBTokenBuffer infixExp = {0};
+    NIBTokenBuffer cacheExp = {0};
+    
+    /* if a field is missing or is not of the calculator, do not modify the calculator */
+    if (modesData.length != sizeof(NIBSnapshotModes) ||
+        (memoryData.length != 0 && memoryData.length != sizeof(double)) ||
+        !infixData || !NIBSnapshotGetTokens(infixData, &infixExp) ||
+        !cacheData || !NIBSnapshotGetTokens(cacheData, &cacheExp)) {
+        NIBTokenBufferFree(&infixExp);
+        NIBTokenBufferFree(&cacheExp);
+        return NO;
+    }
     
-    /* number string from number */
-    NSString *numStr = [numberFormatter stringFromNumber:decimalNumber];
+    NIBSnapshotModes modes = *(const NIBSnapshotModes *)modesData.bytes;
+    double memory = 0;
     
-    /* count the integer part length */
-    NSString *decimalSeparator = [[NSLocale currentLocale] objectForKey:NSLocaleDecimalSeparator];
-    NSRange digitsOfIntegerPartRange = [numStr rangeOfString:decimalSeparator];
+    [memoryData getBytes:&memory length:sizeof(memory)];
     
-    if (decimalNumber.doubleValue == round(decimalNumber.doubleValue) && digitsOfIntegerPartRange.location == NSNotFound) {
-        isInteger = YES;
+    /* if the number mode is different, toggle it */
+    if (self.isDecimalMode != ((modes & NIBSnapshotModeDecimal) != 0)) {
+        [self toggleDecimalMode];
     }
     
-    return isInteger;
+    self.isRadianMode = (modes & NIBSnapshotModeRadian) != 0;
+    self.memory = (memoryData.length > 0) ? [[NSNumber alloc] initWithDouble:memory] : nil;
+    _decimalMemory = NIBDecimal128FromDouble(memory);
+    
+    [self clearArithmetic];
+    [self appendTokensToInfixExpression:infixExp.tokens count:infixExp.count];
+    [self updateArithmeticCacheWithExpression:cacheExp.tokens count:cacheExp.count];
+    
+    NIBTokenBufferFree(&infixExp);
+    NIBTokenBufferFree(&cacheExp);
+    
+    return YES;
+}
+
+#pragma mark Utilities
+
+- (BOOL)isWaitingForOperandInInfixExpression
+{
+    NSInteger operandCount = _infixCounts.operandCount;
+    NSInteger binaryOperationCount = _infixCounts.binaryOperatorCount;
+    
+    // the infix expression is waiting for an operand if there is at least
+    // one binary operator and at least one operand and the number of
+    // of operand is less than than the number of binary operator plus 1
+    return (binaryOperationCount > 0 && operandCount > 0 && operandCount < binaryOperationCount + 1);
+}
+
++ (BOOL)isInterger:(NSNumber *)decimalNumber
+{
+    // a whole number is formatted without a decimal separator, so it is
+    // enough to compare the number with its rounded value
+    return (decimalNumber.doubleValue == round(decimalNumber.doubleValue));
 }
 
 
@@ -635,34 +875,71 @@ NS_ASSUME_NONNULL_END
 
 #pragma mark Operator Processing
 
-- (NSNumber *)processEqualityOperator
+- (BOOL)performOperatorTag:(NIBButtonTag)operatorTag result:(double *)result
 {
-    NSNumber *result = nil;
+    BOOL hasResult = NO;
+    
+    /* if an operator is equality */
+    if (operatorTag == NIBButtonEquality) {
+        hasResult = [self processEqualityOperatorWithResult:result];
+    
+    /* if an operator is unary operator */
+    } else if (NIBIsUnaryOperatorTag(operatorTag)) {
+        hasResult = [self processUnaryOperator:operatorTag result:result];
+    
+    /* if an operator is closing parenthesis */
+    } else if (operatorTag == NIBButtonClosingParenthesis) {
+        hasResult = [self processClosingParenthesisOperator:operatorTag result:result];
+    
+    /* otherwise, an operator is binary operator */
+    } else if (NIBIsBinaryOperatorTag(operatorTag)) {
+        hasResult = [self processBinaryOperator:operatorTag result:result];
+    
+    /* otherwise, an operator may be open parenthesis */
+    } else {
+        [self appendTokenToInfixExpression:NIBTokenMakeOperator(operatorTag)];
+    }
+    
+    // if result is not a number, clear the operand stack and
+    // operation stack to avoid future calculation error
+    if (hasResult && isnan(*result)) {
+        [self truncateInfixExpressionToCount:0];
+    }
+    
+    return hasResult;
+}
+
+- (BOOL)processEqualityOperatorWithResult:(double *)result
+{
+    BOOL hasResult = NO;
+    BOOL isRepeatingArithmeticCache = NO;
     
     /* if infix expression contains one operand */
     if ([self countOperandInInfixExpression] == 1) {
         
-        switch (self.arithmeticCache.count) {
+        switch (_arithmeticCache.count) {
             /* arithmetic cache has one token */
             case 1:
             {
                 /* get operand from infix expression */
-                NSNumber * __block operand = nil;
+                double operand = NAN;
                 
-                for (id obj in self.infixExpression) {
-                    if ([obj isKindOfClass:[NSNumber class]]) {
-                        operand = obj;
+                for (NSUInteger i = 0; i < _infixExpression.count; i++) {
+                    if (_infixExpression.tokens[i].kind == NIBTokenKindOperand) {
+                        operand = _infixExpression.tokens[i].operand;
                         break;
                     }
                 }
                 
                 /* token of arithemtic cache */
-                id token = [self.arithmeticCache lastObject];
+                NIBToken token = _arithmeticCache.tokens[0];
                 
                 /* if a token is an unary operator */
-                if ([token isKindOfClass:[NIBOperator class]] && [token isUnaryOperator]) {
-                        /* perform unary operaton */
-                        result = [self performUnaryOperator:token onOperand:operand];
+                if (token.kind == NIBTokenKindOperator && NIBIsUnaryOperatorTag(token.tag)) {
+                    /* perform unary operaton */
+                    *result = [self performUnaryOperator:token.tag onOperand:operand];
+                    hasResult = YES;
+                    isRepeatingArithmeticCache = YES;
                 }
                 break;
             }
@@ -670,12 +947,25 @@ NS_ASSUME_NONNULL_END
             /* arithmetic cache has two tokens */
             case 2:
             {
+                /* if the infix expression is a sole operand, repeat the compiled arithmetic cache on it */
+                if (_infixExpression.count == 1) {
+                    hasResult = [self repeatArithmeticCacheOnOperand:_infixExpression.tokens[0].operand
+                                                              result:result];
+                    isRepeatingArithmeticCache = YES;
+                    break;
+                }
+                
                 /* append the arithmetic cache to the infix expression */
-                [self.infixExpression addObjectsFromArray:self.arithmeticCache];
+                [self appendTokensToInfixExpression:_arithmeticCache.tokens count:_arithmeticCache.count];
                 /* evaluate new infix expression */
-                result = [self evaluateInfixExpression:self.infixExpression];
+                hasResult = [self evaluateInfixExpression:_infixExpression.tokens
+                                                    count:_infixExpression.count
+                                                   result:result];
                 break;
             }
+            
+            default:
+                break;
         }
     
     /* otherwise, infix expression contains more than one operand */
@@ -683,923 +973,534 @@ NS_ASSUME_NONNULL_END
     } else if ( [self canEvalualateInfixExpression] &&
                 ![self hasMisMatchedParenthesesInInfixExpression] ) {
         
-        /* create arithmetic cache from infix expression */
-        NSArray *arithmeticCache = [self partialInfixExpressionContainingLastElementsFromExpression:self.infixExpression];
+        /* if has arithmetic cache, the cache is the last two tokens */
+        if (_infixExpression.count >= 2) {
+            [self updateArithmeticCacheWithExpression:_infixExpression.tokens + _infixExpression.count - 2
+                                                count:2];
         
-        /* if has arithmetic cache */
-        if (arithmeticCache) {
-            /* update arithemtic cache */
-            [self updateArithmeticCacheWithExpression:arithmeticCache];
-        
-        /* otherwise, arithmetic cache */
+        /* otherwise, clear arithmetic cache */
         } else {
-            [self updateArithmeticCacheWithExpression:nil];
+            [self updateArithmeticCacheWithExpression:NULL count:0];
         }
         
-        result = [self evaluateInfixExpression:self.infixExpression];
+        hasResult = [self evaluateInfixExpression:_infixExpression.tokens
+                                            count:_infixExpression.count
+                                           result:result];
     
     /* otherwise, infix expression can not be evaluated or having mismatched parentheses */
     /* if infix expression has mismatched parentheses */
     } else if ([self hasMisMatchedParenthesesInInfixExpression]) {
-        result = [self evaluateInfixExpression:self.infixExpression];
+        hasResult = [self evaluateInfixExpression:_infixExpression.tokens
+                                            count:_infixExpression.count
+                                           result:result];
     }
     
-    /*** otherwise, infix expression can not be evaluated, result is nil ***/
+    /*** otherwise, infix expression can not be evaluated, there is no result ***/
+    
+    /* record the completed expression and its result to the tape */
+    if (hasResult && self.tape) {
+        [self recordInfixExpressionWithArithmeticCache:isRepeatingArithmeticCache result:*result];
+    }
     
     /* clear the infix expression */
-    [self.infixExpression removeAllObjects];
+    [self truncateInfixExpressionToCount:0];
     
-    return result;
+    return hasResult;
 }
 
-- (NSNumber *)processClosingParenthesisOperator:(NIBOperator *)operator
+- (BOOL)processClosingParenthesisOperator:(NIBButtonTag)operatorTag result:(double *)result
 {
-    NSNumber *result = nil;
-    NSArray *partialInfExp = [self partialInfixExpressionFromExpression:self.infixExpression
-                                          asLeftOperandOfAddingOperator:operator];
-    
-    result = [self evaluateInfixExpression:partialInfExp];
+    BOOL hasResult = NO;
     
     /* first token of parital infix expression index */
-    NSUInteger firstTokenOfPartialInfExpIdx = [self.infixExpression indexOfObjectIdenticalTo:partialInfExp[0]];
+    NSUInteger firstTokenOfPartialInfExpIdx = [self indexOfPartialInfixExpressionAsLeftOperandOfAddingOperator:operatorTag
+                                                                                                         count:_infixExpression.count];
+    
+    BOOL isUnknownInPartialInfExp = (_unknownIndex != NSNotFound && _unknownIndex >= firstTokenOfPartialInfExpIdx);
+    
+    /* if the unknown is in the partial infix expression, the unknown expression becomes the partial infix expression */
+    if (isUnknownInPartialInfExp) {
+        _unknownOperandIndex = [self postfixExpressionFromInfixExpression:_infixExpression.tokens + firstTokenOfPartialInfExpIdx
+                                                                    count:_infixExpression.count - firstTokenOfPartialInfExpIdx
+                                                             unknownIndex:_unknownIndex - firstTokenOfPartialInfExpIdx
+                                                                 toBuffer:&_solveExpression];
+        NIBTokenBufferSetBuffer(&_unknownExpression, &_solveExpression);
+    }
     
-    /* if the partial infix expression is different than the infix expression */
-    if (firstTokenOfPartialInfExpIdx > 0) {
-        self.infixExpression = [NSMutableArray arrayWithArray:[self.infixExpression subarrayWithRange:NSMakeRange(0, firstTokenOfPartialInfExpIdx)]];
-        //if (result) [self.infixExpression addObject:result];
+    /* if the shunting yard holds an openning parenthesis closed by an operand, reduce it */
+    if ([self synchronizeShuntingYard] &&
+        _infixCounts.openingParenthesisCount > 0 &&
+        _infixExpression.tokens[_infixExpression.count - 1].kind == NIBTokenKindOperand) {
+        
+        *result = [self reduceShuntingYardForAddingOperator:operatorTag];
+        hasResult = YES;
     
-    /* otherwise, the partial infix expression is the infix expression */
+    /* otherwise, evaluate the partial infix expression */
     } else {
-        /* clear the infix expression */
-        [self.infixExpression removeAllObjects];
+        hasResult = [self evaluateInfixExpression:_infixExpression.tokens + firstTokenOfPartialInfExpIdx
+                                            count:_infixExpression.count - firstTokenOfPartialInfExpIdx
+                                           result:result];
     }
     
-    return result;
+    // remove the partial infix expression from the infix expression, if the
+    // partial infix expression is the infix expression, the infix expression
+    // is cleared
+    [self truncateInfixExpressionToCount:firstTokenOfPartialInfExpIdx];
+    
+    /* if the partial infix expression holds the unknown, the result stands for the unknown */
+    if (isUnknownInPartialInfExp) _hasPendingUnknownResult = YES;
+    
+    return hasResult;
 }
 
-- (NSNumber *)processUnaryOperator:(NIBOperator *)operator
+- (BOOL)processUnaryOperator:(NIBButtonTag)operatorTag result:(double *)result
 {
-    NSNumber *result = nil;
-    
-    /* last token of infix expression */
-    id token = [self.infixExpression lastObject];
-    
     /* if there is no token in infix expresion, return immediately */
-    if (!token) {
-        return nil;
-        
+    if (_infixExpression.count == 0) {
+        return NO;
     }
     
+    /* last token of infix expression */
+    NIBToken token = _infixExpression.tokens[_infixExpression.count - 1];
+    BOOL isUnknown = (_unknownIndex == _infixExpression.count - 1);
+    
     /* remove last token */
-    [self.infixExpression removeLastObject];
+    [self truncateInfixExpressionToCount:_infixExpression.count - 1];
     
     /* if a token is a number */
-    if ([token isKindOfClass:[NSNumber class]]) {
+    if (token.kind == NIBTokenKindOperand) {
         /* perform unary operaton */
-        result = [self performUnaryOperator:operator onOperand:token];
+        *result = [self performUnaryOperator:operatorTag onOperand:token.operand];
         
         /* if not have mismatched parentheses */
         if (![self hasMisMatchedParenthesesInInfixExpression]) {
             /* update arithmetic cache */
-            NSArray *arithmeticCahe = @[operator];
-            [self updateArithmeticCacheWithExpression:arithmeticCahe];
+            NIBToken arithmeticCache = NIBTokenMakeOperator(operatorTag);
+            [self updateArithmeticCacheWithExpression:&arithmeticCache count:1];
         }
         
+        /* if the operand is the unknown, the result stands for the unknown with the operator */
+        if (isUnknown) {
+            NIBTokenBufferAppend(&_unknownExpression, NIBTokenMakeOperator(operatorTag));
+            _hasPendingUnknownResult = YES;
+        }
+    
     /* otherwise, token is not a number */
     } else {
         /* can not perform unary operation */
-        NSLog(@"Can not perform unary operation: %@", operator);
-        result = [NSDecimalNumber notANumber];
+        NSLog(@"Can not perform unary operation: %@", [NIBOperator operatorWithTag:operatorTag]);
+        *result = NAN;
     }
     
-    /* add result from unary operation to the infix expression */
-//    [self.infixExpression addObject:result];
-    
-    return result;
+    return YES;
 }
 
-- (NSNumber *)processBinaryOperator:(NIBOperator *)operator
+- (BOOL)processBinaryOperator:(NIBButtonTag)operatorTag result:(double *)result
 {
-    NSNumber *result = nil;
+    BOOL hasResult = NO;
     
     /* if the infix expression is waiting for operand */
     if ([self isWaitingForOperandInInfixExpression]) {
         /* replace the last operator with the new one */
-        [self.infixExpression removeLastObject];
+        [self truncateInfixExpressionToCount:_infixExpression.count - 1];
     }
     
+    /* if the infix expression can be evaluated and the shunting yard holds it, reduce it */
+    if ([self canEvalualateInfixExpression] && [self synchronizeShuntingYard]) {
+        *result = [self reduceShuntingYardForAddingOperator:operatorTag];
+        hasResult = YES;
+    
     /* if the infix expression can be evaluated */
-    if ([self canEvalualateInfixExpression]) {
+    } else if ([self canEvalualateInfixExpression]) {
         
         /* partical infix expression */
-        NSArray *partialInfExp = [self partialInfixExpressionFromExpression:self.infixExpression
-                                              asLeftOperandOfAddingOperator:operator];
+        NSUInteger firstTokenOfPartialInfExpIdx = [self indexOfPartialInfixExpressionAsLeftOperandOfAddingOperator:operatorTag
+                                                                                                             count:_infixExpression.count];
         
         /* evaluate the partial infix expression */
-        result = [self evaluateInfixExpression:partialInfExp];
+        hasResult = [self evaluateInfixExpression:_infixExpression.tokens + firstTokenOfPartialInfExpIdx
+                                            count:_infixExpression.count - firstTokenOfPartialInfExpIdx
+                                           result:result];
     }
     
-    [self.infixExpression addObject:operator];
-
-    return result;
+    [self appendTokenToInfixExpression:NIBTokenMakeOperator(operatorTag)];
+    
+    return hasResult;
 }
 
-#pragma mark Calculation Center
+#pragma mark Operator Peeking
 
-- (NSNumber *)evaluateInfixExpression:(NSArray *)infixExp
+- (BOOL)peekOperator:(NIBButtonTag)operatorTag result:(double *)result
 {
-    NSNumber *result = nil;
-    NSArray *posfixExp = [self postfixExpressionFromInfixExpression:infixExp];
-    result = [self evaluatePostfixExpression:posfixExp];
+    NSUInteger count = _infixExpression.count;
     
-    return result;
-}
-
-- (NSNumber *)evaluatePostfixExpression:(NSArray *)postfixExp
-{
-    NIBCalculatorStack<NSNumber *> *calStack = [[NIBCalculatorStack alloc] init];
+    /* if an operator is equality */
+    if (operatorTag == NIBButtonEquality) {
+        return [self peekEqualityOperatorWithResult:result];
+    }
     
-    for (id token in postfixExp) {
-        /* if token is number, push to calculation stack */
-        if ([token isKindOfClass:[NSNumber class]]) [calStack push:token];
+    /* if an operator is unary operator, it would be performed on the last token */
+    if (NIBIsUnaryOperatorTag(operatorTag)) {
+        if (count == 0) {
+            return NO;
+        }
+        
+        NIBToken token = _infixExpression.tokens[count - 1];
+        *result = (token.kind == NIBTokenKindOperand) ? [self performUnaryOperator:operatorTag onOperand:token.operand] : NAN;
         
-        /* if token is an operator */
-        if ([token isKindOfClass:[NIBOperator class]]) {
-            NIBOperator *operator = (NIBOperator *)token;
+        return YES;
+    }
+    
+    /* if an operator is closing parenthesis */
+    if (operatorTag == NIBButtonClosingParenthesis) {
+        /* if the shunting yard holds an openning parenthesis closed by an operand, peek it */
+        if ([self synchronizeShuntingYard] &&
+            _infixCounts.openingParenthesisCount > 0 &&
+            _infixExpression.tokens[count - 1].kind == NIBTokenKindOperand) {
             
-            switch (operator.idx) {
-                /* operator is division */
-                case NIBButtonDivision:
-                    [self performDivisionOfStack:calStack];
-                    break;
-                    
-                /* operator is multiplication */
-                case NIBButtonMultiplication:
-                    [self performMultiplicationOfStack:calStack];
-                    break;
-                    
-                /* operator is substraction */
-                case NIBButtonSubstraction:
-                    [self performSubstractionOfStack:calStack];
-                    break;
-                    
-                /* operator is addition */
-                case NIBButtonAddition:
-                    [self performAdditionOfStack:calStack];
-                    break;
-                    
-                /* operator is yth root */
-                case NIBButtonYthRootOfX:
-                {
-                    NSNumber *power = [NSNumber numberWithDouble:1.0/[[calStack pop] doubleValue]];
-                    NSNumber *result = [self raiseToPower:power ofBase:[calStack pop]];
-                    [calStack push:result];
-                    break;
-                }
-                    
-                /* operator is x^y */
-                case NIBButtonXPowerY:
-                {
-                    NSNumber *result = [self raiseToPower:[calStack pop] ofBase:[calStack pop]];
-                    [calStack push:result];
-                    break;
-                }
-                    
-                /* operator is y^x */
-                case NIBButtonYPowerX:
-                {
-                    NSNumber *base = [calStack pop];
-                    NSNumber *result  = [self raiseToPower:[calStack pop] ofBase:base];
-                    [calStack push:result];
-                    break;
-                }
-                
-                /* operator is logy */
-                case NIBButtonLogarithmBaseYOfX:
-                {
-                    NSNumber *base = [calStack pop];
-                    NSNumber *result = [self performLogarithmFunctionOf:[calStack pop]
-                                                      withRespectToBase:base];
-                    [calStack push:result];
-                    break;
-                }
-                    
-                /* operator is EE */
-                case NIBButtonEE:
-                    [self performScientificNotationOfStack:calStack];
-                    break;
-                
-                /* default case, push not a number to calculation stack to make the program fault-tolerance */
-                default:
-                   [calStack push:[NSDecimalNumber notANumber]];
-                    break;
-            }
+            *result = NIBShuntingYardPeek(&_shuntingYard, NIBReductionPrecedenceOfAddingOperator(operatorTag));
+            return YES;
         }
+        
+        NSUInteger firstTokenOfPartialInfExpIdx = [self indexOfPartialInfixExpressionAsLeftOperandOfAddingOperator:operatorTag
+                                                                                                             count:count];
+        
+        return [self evaluateInfixExpression:_infixExpression.tokens + firstTokenOfPartialInfExpIdx
+                                       count:count - firstTokenOfPartialInfExpIdx
+                                      result:result];
     }
     
-    return [calStack pop];
+    /* if an operator is not binary operator, it would not have a result */
+    if (!NIBIsBinaryOperatorTag(operatorTag)) {
+        return NO;
+    }
+    
+    // if the infix expression is waiting for operand, the last operator would
+    // be replaced, so the tokens before it are the infix expression
+    BOOL isWaitingForOperand = [self isWaitingForOperandInInfixExpression];
+    NSInteger binaryOperatorCount = _infixCounts.binaryOperatorCount - (isWaitingForOperand ? 1 : 0);
+    
+    if (isWaitingForOperand) count--;
+    
+    /* if the infix expression can not be evaluated, there is no result */
+    if (binaryOperatorCount == 0 || _infixCounts.operandCount != binaryOperatorCount + 1) {
+        return NO;
+    }
+    
+    /* if the shunting yard holds the infix expression, peek it */
+    if (!isWaitingForOperand && [self synchronizeShuntingYard]) {
+        *result = NIBShuntingYardPeek(&_shuntingYard, NIBReductionPrecedenceOfAddingOperator(operatorTag));
+        return YES;
+    }
+    
+    /* otherwise, evaluate the partial infix expression */
+    NSUInteger firstTokenOfPartialInfExpIdx = [self indexOfPartialInfixExpressionAsLeftOperandOfAddingOperator:operatorTag
+                                                                                                         count:count];
+    
+    return [self evaluateInfixExpression:_infixExpression.tokens + firstTokenOfPartialInfExpIdx
+                                   count:count - firstTokenOfPartialInfExpIdx
+                                  result:result];
 }
 
-- (NSNumber *)performUnaryOperator:(NIBOperator *)operator
-                         onOperand:(NSNumber *)operand
+- (BOOL)peekEqualityOperatorWithResult:(double *)result
 {
-    NSNumber *result = nil;
-    
-    switch (operator.idx) {
-        /* operator is percentage */
-        case NIBButtonPercentage:
-            result = [self percentageOfOperand:operand];
-            break;
-            
-        /* operator is square root */
-        case NIBButtonSquareRootOfX:
-            result = [self raiseToPower:[NSNumber numberWithDouble:(1.0/2)]
-                                 ofBase:operand];
-            break;
-            
-        /* operator is cubic root */
-        case NIBButtonCubicRootOfX:
-            result = [self raiseToPower:[NSNumber numberWithDouble:(1.0/3)]
-                                 ofBase:operand];
-            break;
-            
-        /* operator is x^2 */
-        case NIBButtonXSquared:
-            result = [self raiseToPower:[NSNumber numberWithDouble:2.0]
-                                 ofBase:operand];
-            break;
-            
-        /* operator is x^3 */
-        case NIBButtonXCubed:
-            result = [self raiseToPower:[NSNumber numberWithDouble:3.0]
-                                 ofBase:operand];
-            break;
-            
-        /* operator is e^x */
-        case NIBButtonEulerNumberPowerX:
-            result = [self raiseToPower:operand
-                                 ofBase:[[NSNumber alloc] initWithDouble:M_E]];
-            break;
-            
-        /* operator is 10^x */
-        case NIBButtonTenPowerX:
-            result = [self raiseToPower:operand
-                                 ofBase:[[NSNumber alloc] initWithDouble:10.0]];
-            break;
-            
-        /* operator is 2^x */
-        case NIBButtonTwoPowerX:
-            result = [self raiseToPower:operand
-                                 ofBase:[[NSNumber alloc] initWithDouble:2.0]];
-            break;
+    /* if infix expression contains one operand, the arithmetic cache would be repeated */
+    if ([self countOperandInInfixExpression] == 1) {
+        double operand = NAN;
         
-        /* operator is sin */
-        case NIBButtonSin:
-            result = [self performTrigonometricFunction:NIBTrigonometricSinFunction
-                                              ofOperand:operand];
-            break;
-            
-        /* operator is cos */
-        case NIBButtonCos:
-            result = [self performTrigonometricFunction:NIBTrigonometricCosFunction
-                                              ofOperand:operand];
-            break;
-            
-        /* operator is tan */
-        case NIBButtonTan:
-            result = [self performTrigonometricFunction:NIBTrigonometricTanFunction
-                                              ofOperand:operand];
-            break;
-            
-        /* operator is sinh */
-        case NIBButtonSinh:
-            result = [self performHyperbolicFunction:NIBHyperbolicSineFunction
-                                           ofOperand:operand];
-            break;
-            
-        /* operator is cosh */
-        case NIBButtonCosh:
-            result = [self performHyperbolicFunction:NIBHyperbolicCosineFunction
-                                           ofOperand:operand];
-            break;
-            
-        /* operator is tanh */
-        case NIBButtonTanh:
-            result = [self performHyperbolicFunction:NIBHyperbolicTangentFunction
-                                           ofOperand:operand];
-            break;
-            
-        /* operator is 1/x */
-        case NIBButtonOneOverX:
-            result = [self performInverseFunctionOfOperand:operand];
-            break;
-            
-        /* operator is arcsin */
-        case NIBButtonArcSin:
-            result = [self performInverseTrigonometricFunction:NIBInverseTrigonometricArcSinFunction
-                                                     ofOperand:operand];
-            break;
-            
-        /* operator is arccos */
-        case NIBButtonArcCos:
-            result = [self performInverseTrigonometricFunction:NIBInverseTrigonometricArcCosFunction
-                                                     ofOperand:operand];
-            break;
-            
-        /* operator is arctan */
-        case NIBButtonArcTan:
-            result = [self performInverseTrigonometricFunction:NIBInverseTrigonometricArcTanFunction
-                                                     ofOperand:operand];
-            break;
-            
-        /* operator is arcshinh */
-        case NIBButtonArcSinh:
-            result = [self performInverseHyperbolicFunction:NIBInverseHyperbolicSineFunction
-                                                  ofOperand:operand];
-            break;
-            
-        /* operator is arccosh */
-        case NIBButtonArcCosh:
-            result = [self performInverseHyperbolicFunction:NIBInverseHyperbolicCosineFunction
-                                                  ofOperand:operand];
-            break;
+        for (NSUInteger i = 0; i < _infixExpression.count; i++) {
+            if (_infixExpression.tokens[i].kind == NIBTokenKindOperand) {
+                operand = _infixExpression.tokens[i].operand;
+                break;
+            }
+        }
+        
+        /* if arithmetic cache is an unary operator */
+        if (_arithmeticCache.count == 1) {
+            NIBToken token = _arithmeticCache.tokens[0];
             
-        /* operator is arctanh */
-        case NIBButtonArcTanh:
-            result = [self performInverseHyperbolicFunction:NIBInverseHyperbolicTangentFunction
-                                                  ofOperand:operand];
-            break;
+            if (token.kind == NIBTokenKindOperator && NIBIsUnaryOperatorTag(token.tag)) {
+                *result = [self performUnaryOperator:token.tag onOperand:operand];
+                return YES;
+            }
             
-        /* operator is ln */
-        case NIBButtonNaturalLogarithm:
-            result = [self performLogarithmFunctionOf:operand
-                                    withRespectToBase:[NSNumber numberWithDouble:M_E]];
-            break;
+            return NO;
+        }
+        
+        /* if arithmetic cache has two tokens */
+        if (_arithmeticCache.count == 2) {
+            /* if the infix expression is a sole operand, repeat the compiled arithmetic cache on it */
+            if (_infixExpression.count == 1) {
+                return [self repeatArithmeticCacheOnOperand:operand result:result];
+            }
             
-        /* operator is log10 */
-        case NIBButtonCommonLogarithm:
-            result = [self performLogarithmFunctionOf:operand
-                                    withRespectToBase:[NSNumber numberWithDouble:10]];
-            break;
+            /* evaluate the infix expression followed by the arithmetic cache */
+            NIBTokenBufferSetBuffer(&_peekExpression, &_infixExpression);
+            NIBTokenBufferAppendTokens(&_peekExpression, _arithmeticCache.tokens, _arithmeticCache.count);
             
-        /* operator is log2 */
-        case NIBButtonLogarithmBaseTwo:
-            result = [self performLogarithmFunctionOf:operand
-                                    withRespectToBase:[NSNumber numberWithDouble:2]];
-            break;
-        
-        /* operator is x! */
-        case NIBButtonXFactorial:
-            result = [self performFactorialOf:operand];
-            break;
+            return [self evaluateInfixExpression:_peekExpression.tokens count:_peekExpression.count result:result];
+        }
         
-        /* default case, result is not a number to make the program fault-tolerance */
-        default:
-            result = [NSDecimalNumber notANumber];
-            break;
+        return NO;
     }
     
-    return result;
+    /* if infix expression can be evaluated or has mismatched parentheses */
+    if ([self canEvalualateInfixExpression] || [self hasMisMatchedParenthesesInInfixExpression]) {
+        return [self evaluateInfixExpression:_infixExpression.tokens
+                                       count:_infixExpression.count
+                                      result:result];
+    }
+    
+    return NO;
 }
 
-#pragma mark Arithmetic Operations
+#pragma mark Calculation Center
 
-- (void)performDivisionOfStack:(NIBCalculatorStack<NSNumber *> *)calStack
+- (BOOL)evaluateInfixExpression:(const NIBToken *)infixExp
+                          count:(NSUInteger)count
+                         result:(double *)result
 {
-    NSNumber *divisor = nil;
-    NSNumber *dividend = nil;
-    NSNumber *result = nil;
-    
-    divisor = [calStack pop];
-    dividend = [calStack pop];
+    BOOL isInfixExpression = (infixExp == _infixExpression.tokens && count == _infixExpression.count);
     
-    /* if either the divisor or dividend is nil or not a number */
-    if (!divisor || !dividend ||
-        isnan(dividend.doubleValue/divisor.doubleValue) ||
-        isinf(dividend.doubleValue/divisor.doubleValue)) {
-        
-        result = [NSDecimalNumber notANumber];
-        
-    /* otherwise, the divisor and dividend are valid */
-    } else {
-        result = [[NSNumber alloc] initWithDouble:(dividend.doubleValue/divisor.doubleValue)];
+    /* if the whole infix expression is already evaluated, reuse the evaluation */
+    if (isInfixExpression && _infixEvaluation.isValid) {
+        *result = _infixEvaluation.result;
+        return _infixEvaluation.hasResult;
     }
     
-    /* push result to calculation stack */
-    [calStack push:result];
-}
-
-- (void)performMultiplicationOfStack:(NIBCalculatorStack<NSNumber *> *)calStack
-{
-    NSNumber *factor2 = nil;
-    NSNumber *factor1 = nil;
-    NSNumber *result =  nil;
-    
-    factor2 = [calStack pop];
-    factor1 = [calStack pop];
+    [self postfixExpressionFromInfixExpression:infixExp count:count toBuffer:&_postfixExpression];
     
-    /* if either the factor is nil or not a number */
-    if (!factor2 || !factor1 ||
-        [factor2 isEqualToNumber:[NSDecimalNumber notANumber]] ||
-        [factor1 isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        
-        result = [NSDecimalNumber notANumber];
+    BOOL hasResult = [self evaluatePostfixExpression:&_postfixExpression result:result];
     
-    /* otherwise, factors are valid */
-    } else {
-        result = [[NSNumber alloc] initWithDouble:(factor1.doubleValue * factor2.doubleValue)];
+    /* if the expression is the whole infix expression, keep the evaluation */
+    if (isInfixExpression) {
+        _infixEvaluation = (NIBInfixEvaluation){YES, hasResult, hasResult ? *result : NAN};
     }
     
-    /* push result to calculation stack */
-    [calStack push:result];
+    return hasResult;
 }
 
-- (void)performSubstractionOfStack:(NIBCalculatorStack<NSNumber *> *)calStack
+- (BOOL)evaluatePostfixExpression:(const NIBTokenBuffer *)postfixExp result:(double *)result
 {
-    NSNumber *subtrahend = nil;
-    NSNumber *minuend = nil;
-    NSNumber *result =  nil;
-    
-    subtrahend = [calStack pop];
-    minuend = [calStack pop];
+    NIB_COUNT_OPERATORS(NIBInstrumentationOperatorCounterPostfix, postfixExp->tokens, postfixExp->count);
     
-    /* if either the subtrahend or minuend is nil or not a number */
-    if (!subtrahend || !minuend ||
-        [subtrahend isEqualToNumber:[NSDecimalNumber notANumber]] ||
-        [minuend isEqualToNumber:[NSDecimalNumber notANumber]]) {
+    /* if the calculator is in decimal mode, evaluate the expression in decimal */
+    if (self.isDecimalMode) {
+        NIBDecimal128 decimalResult;
+        BOOL hasResult = NIBEvaluateDecimalPostfixExpression(postfixExp->tokens, postfixExp->count, &decimalResult);
         
-        result = [NSDecimalNumber notANumber];
-    
-    /* otherwise, the subtrahend and minuend are valid */
-    } else {
-        result = [[NSNumber alloc] initWithDouble:(minuend.doubleValue - subtrahend.doubleValue)];
+        if (hasResult) *result = NIBDecimal128ToDouble(decimalResult);
+        
+        return hasResult;
     }
     
-    /* push result to calculation stack */
-    [calStack push:result];
+    return NIBEvaluatePostfixExpression(postfixExp->tokens, postfixExp->count, NULL, NULL, result);
 }
 
-- (void)performAdditionOfStack:(NIBCalculatorStack<NSNumber *> *)calStack
+- (double)performUnaryOperator:(NIBButtonTag)operatorTag onOperand:(double)operand
 {
-    NSNumber *summand2 = nil;
-    NSNumber *summand1 = nil;
-    NSNumber *result =  nil;
-    
-    summand2 = [calStack pop];
-    summand1 = [calStack pop];
-    
-    /* if either of the summands is nil or not a number */
-    if (!summand2 || !summand2 ||
-        [summand2 isEqualToNumber:[NSDecimalNumber notANumber]] ||
-        [summand1 isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        
-        result = [NSDecimalNumber notANumber];
+    NIB_COUNT_OPERATOR(NIBInstrumentationOperatorCounterUnary, operatorTag);
     
-    /* otherwise, both of the summands are valid */
-    } else {
-        result = [[NSNumber alloc] initWithDouble:(summand1.doubleValue + summand2.doubleValue)];
-    }
-    
-    /* push result to calculation stack */
-    [calStack push:result];
+    // the same functions are applied to the same operands again and again,
+    // such as a repeated equality or a batch of lines, so the results are
+    // kept in the unary memo of the thread, in decimal mode as well
+    return NIBPerformMemoizedUnaryOperator(operatorTag, operand, self.isRadianMode, self.isDecimalMode);
 }
 
-#pragma mark Functional Operations
+#pragma mark Arithmetic Cache
 
-- (NSNumber *)percentageOfOperand:(NSNumber *)operand
+- (void)updateArithmeticCacheWithExpression:(const NIBToken *)exp count:(NSUInteger)count
 {
-    NSNumber *result = nil;
-    
-    if (operand == nil || [operand isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        result = [NSDecimalNumber notANumber];
-    } else {
-        result = [[NSNumber alloc] initWithDouble:operand.doubleValue/100];
-    }
+    /* update arithmetic cache from an infix expression, clear cache if needed */
+    NIBTokenBufferTruncate(&_arithmeticCache, 0);
+    NIBTokenBufferAppendTokens(&_arithmeticCache, exp, count);
     
-    return result;
+    /* the compiled arithmetic cache is out of date */
+    self.arithmeticCacheProgram = nil;
 }
 
-- (NSNumber *)raiseToPower:(NSNumber *)power ofBase:(NSNumber *)base
+- (BOOL)repeatArithmeticCacheOnOperand:(double)operand result:(double *)result
 {
-    
-    /* if  a power is nil or not a number or infinity or
-       the base is nil or not a number */
-    if ( !base || [base isEqualToNumber:[NSDecimalNumber notANumber]] ||
-         !power || isnan(power.doubleValue) || isinf(power.doubleValue) ) {
+    /* if the calculator is in decimal mode, evaluate the arithmetic cache as an expression in decimal */
+    if (self.isDecimalMode) {
+        NIBToken cacheExp[3] = { NIBTokenMakeOperand(operand), _arithmeticCache.tokens[0], _arithmeticCache.tokens[1] };
         
-        return [NSDecimalNumber notANumber];
+        return [self evaluateInfixExpression:cacheExp count:3 result:result];
     }
     
-    /* otherwise, power is a valid double */
-    NSNumber *result = nil;
-    
-    /* convert power to fraction */
-    Fraction frac = NIBFractionFromDouble(power.doubleValue);
-        
-    /* if the power is not rational */
-    if (frac.denominator == 0) {
-        result = [NSDecimalNumber notANumber];
-        
-    /* otherwise, the power is rational */
-    // the root can not be calculated when the base is negative and
-    // the fraction has odd numerator and even denominator
-    } else if (base.doubleValue < 0 && (frac.numerator % 2) && !(frac.denominator % 2)) {
-        result = [NSDecimalNumber notANumber];
-        
-    /* otherwise, the root can be calculated */
-    /* if the power is interger */
-    } else if (frac.denominator == 1) {
-        result = [[NSNumber alloc] initWithDouble:pow(base.doubleValue, (double)frac.numerator)];
-        
-    /* otherwise, the power is not an integer */
-    /* if the power is 1/3 -> cubic root */
-    } else if (frac.numerator == 1 && frac.denominator == 3) {
-        result = [[NSNumber alloc] initWithDouble:cbrt(base.doubleValue)];
-        
-    /* if the base is negative and the numerator is odd */
-    } else if (base.doubleValue < 0 && frac.numerator % 2 != 0) {
-        // the pow(base, power) function can not calculate
-        // with negative number as base and double value as exponent.
-        // Result is -(|base|^(numerator/denominator))
-        result = [[NSNumber alloc] initWithDouble:-pow(fabs(base.doubleValue), (double)frac.numerator/frac.denominator)];
+    /* if the arithmetic cache is not compiled, compile it with the operand */
+    if (!self.arithmeticCacheProgram) {
+        NIBToken cacheExp[3] = { NIBTokenMakeOperand(operand), _arithmeticCache.tokens[0], _arithmeticCache.tokens[1] };
         
-    /* otherwise, the base is positive or the numerator of the fraction is even */
-    } else {
-        /* result is base^(numerator/denominator) */
-        result = [[NSNumber alloc] initWithDouble:pow(fabs(base.doubleValue), (double)frac.numerator/frac.denominator)];
+        self.arithmeticCacheProgram = [self programWithInfixExpression:cacheExp count:3];
     }
     
+    // the program has at most three operands and the operand is the first
+    // one, the others are the operands of the arithmetic cache
+    double operands[3];
     
-    /* if result is infinity, result is not a number  */
-    if (isinf(result.doubleValue)) result = [NSDecimalNumber notANumber];
+    [self.arithmeticCacheProgram getOperands:operands];
+    operands[0] = operand;
     
-    return result;
+    return [self.arithmeticCacheProgram evaluateWithOperands:operands result:result];
 }
 
-- (NSNumber *)performTrigonometricFunction:(NIBTrigonometricFuntion)trigonometricFunction
-                          ofOperand:(NSNumber *)operand
+#pragma mark Tape
+
+- (void)recordInfixExpressionWithArithmeticCache:(BOOL)isWithArithmeticCache result:(double)result
 {
-    NSNumber *angle = operand;
-    
-    /* if the anlge is nil or not a number, return not a number */
-    if (!angle || [angle isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        return [NSDecimalNumber notANumber];
-    }
-    
-    /* otherwise, the angle is not nil */
-    NSNumber *result = nil;
-    
-    switch (trigonometricFunction) {
-        /* calculate sin function */
-        case NIBTrigonometricSinFunction:
-            if (self.isRadianMode) {
-                result = [[NSNumber alloc] initWithDouble:sin(angle.doubleValue)];
-            } else {
-                result = [[NSNumber alloc] initWithDouble:sin(angle.doubleValue*M_PI/180)];
-            }
-            break;
-            
-        /* calculate cos function */
-        case NIBTrigonometricCosFunction:
-            if (self.isRadianMode) {
-                result = [[NSNumber alloc] initWithDouble:cos(angle.doubleValue)];
-            } else {
-                result = [[NSNumber alloc] initWithDouble:cos(angle.doubleValue*M_PI/180)];
-            }
-            break;
-            
-        /* calculate tan function */
-        case NIBTrigonometricTanFunction:
-            /* if the angle is pi, 3*pi, 5*pi, ... */
-            if ([self isOddMultiplicationOfPi_2:angle.doubleValue]) {
-                result = [NSDecimalNumber notANumber];
-            } else if (self.isRadianMode) {
-                result = [[NSNumber alloc] initWithDouble:tan(angle.doubleValue)];
-            } else {
-                result = [[NSNumber alloc] initWithDouble:tan(angle.doubleValue*M_PI/180)];
-            }
-            break;
-            
-        /* default case, return not a number to make the program fault-tolerance */
-        default:
-            result = [NSDecimalNumber notANumber];
-            break;
-    }
-    
-    /* if result is a number, round the result with calculation error */
-    if (![result isEqual:[NSDecimalNumber notANumber]]) {
-        result = NIBRoundNumberWithCalculationError(result);
+    /* if the arithmetic cache is not repeated, the infix expression is the whole expression */
+    if (!isWithArithmeticCache) {
+        [self.tape appendExpression:_infixExpression.tokens count:_infixExpression.count result:result];
+        return;
     }
     
-    return result;
+    NIBTokenBufferSetBuffer(&_tapeExpression, &_infixExpression);
+    NIBTokenBufferAppendTokens(&_tapeExpression, _arithmeticCache.tokens, _arithmeticCache.count);
+    [self.tape appendExpression:_tapeExpression.tokens count:_tapeExpression.count result:result];
 }
 
-- (NSNumber *)performHyperbolicFunction:(NIBHyperbolicFunction)hyperbolicFunction
-                              ofOperand:(NSNumber *)operand
+#pragma mark Infix Expression
+
+- (void)appendTokenToInfixExpression:(NIBToken)token
 {
-    
-    /* if the operand is nil, return not a number */
-    if (!operand || [operand isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        return [NSDecimalNumber notANumber];
-    }
-    
-    /* otherwise the operand is not nil */
-    NSNumber *result = nil;
-    
-    switch (hyperbolicFunction) {
-        /* calculate hyperbolic sine function */
-        case NIBHyperbolicSineFunction:
-            result = [[NSNumber alloc] initWithDouble:sinh(operand.doubleValue)];
-            break;
-            
-        /* calculate hyperbolic cosine function */
-        case NIBHyperbolicCosineFunction:
-            result = [[NSNumber alloc] initWithDouble:cosh(operand.doubleValue)];
-            break;
-            
-        /* calculate hyperbolic tangent function */
-        case NIBHyperbolicTangentFunction:
-            result = [[NSNumber alloc] initWithDouble:tanh(operand.doubleValue)];
-            break;
-            
-        /* default case, return not a number to make the program fault-tolerance */
-        default:
-            result = [NSDecimalNumber notANumber];
-            break;
+    /* if the shunting yard holds the infix expression, push the token to it */
+    if (_shuntingYardState == NIBShuntingYardSynchronized) {
+        const NIBToken *previousToken = (_infixExpression.count > 0) ? &_infixExpression.tokens[_infixExpression.count - 1] : NULL;
+        
+        if (!NIBShuntingYardPushToken(&_shuntingYard, token, previousToken)) {
+            _shuntingYardState = NIBShuntingYardUnusable;
+        }
     }
     
-    /* if the result is infinity, result is not a number */
-    if (isinf(result.doubleValue)) result = [NSDecimalNumber notANumber];
-    
-    return result;
+    NIBTokenBufferAppend(&_infixExpression, token);
+    NIBInfixCountsCountToken(&_infixCounts, token, 1);
+    _infixEvaluation.isValid = NO;
+    _hasPendingUnknownResult = NO;
 }
 
-- (NSNumber *)performInverseTrigonometricFunction:(NIBInverseTrigonometricFuntion)inverseTrigFunc
-                                        ofOperand:(NSNumber *)operand
+- (void)appendTokensToInfixExpression:(const NIBToken *)tokens count:(NSUInteger)count
 {
-    /* if operand is nil or not a number, return not a number */
-    if (!operand || [operand isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        return [NSDecimalNumber notANumber];
-    }
-    
-    /* otherwise, the operand is not nil */
-    NSNumber *result = nil;
-    
-    switch (inverseTrigFunc) {
-        /* calculate arcsin function */
-        case NIBInverseTrigonometricArcSinFunction:
-            if (operand.doubleValue < -1 || operand.doubleValue > 1) {
-                result = [NSDecimalNumber notANumber];
-            } else if (self.isRadianMode) {
-                result = [[NSNumber alloc] initWithDouble:asin(operand.doubleValue)];
-            } else {
-                result = [[NSNumber alloc] initWithDouble:asin(operand.doubleValue)*180/M_PI];
-            }
-            break;
-            
-        /* calculate arcos function */
-        case NIBInverseTrigonometricArcCosFunction:
-            if (operand.doubleValue < -1 || operand.doubleValue > 1) {
-                result = [NSDecimalNumber notANumber];
-            } else if (self.isRadianMode) {
-                result = [[NSNumber alloc] initWithDouble:acos(operand.doubleValue)];
-            } else {
-                result = [[NSNumber alloc] initWithDouble:acos(operand.doubleValue)*180/M_PI];
-            }
-            break;
-            
-        /* calculate arctan function */
-        case NIBInverseTrigonometricArcTanFunction:
-            if (self.isRadianMode) {
-                result = [[NSNumber alloc] initWithDouble:atan(operand.doubleValue)];
-            } else {
-                result = [[NSNumber alloc] initWithDouble:atan(operand.doubleValue)*180/M_PI];
-            }
-            break;
-            
-        /* default case, return not a number to make the program fault-tolerance */
-        default:
-            result = [NSDecimalNumber notANumber];
-            break;
+    for (NSUInteger i = 0; i < count; i++) {
+        [self appendTokenToInfixExpression:tokens[i]];
     }
-    
-    return result;
 }
 
-- (NSNumber *)performInverseHyperbolicFunction:(NIBInverseHyperbolicFunction)inverseHyperbolicFunc
-                                     ofOperand:(NSNumber *)operand
+- (void)truncateInfixExpressionToCount:(NSUInteger)count
 {
+    /* if the unknown is removed, the infix expression has no unknown */
+    if (_unknownIndex != NSNotFound && _unknownIndex >= count) _unknownIndex = NSNotFound;
     
-    /* if operand is nil or not a number, return not a number */
-    if (!operand || [operand isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        return [NSDecimalNumber notANumber];
-    }
-    
-    /* otherwise, the operand is not nil */
-    NSNumber *result =  nil;
+    _hasPendingUnknownResult = NO;
     
-    switch (inverseHyperbolicFunc) {
-        /* calculate arcsinh function */
-        case NIBInverseHyperbolicSineFunction:
-            result = [[NSNumber alloc] initWithDouble:asinh(operand.doubleValue)];
-            break;
-            
-        /* calculate arccosh function */
-        case NIBInverseHyperbolicCosineFunction:
-            result = [[NSNumber alloc] initWithDouble:acosh(operand.doubleValue)];
-            break;
-            
-        /* calculate arctanh function */
-        case NIBInverseHyperbolicTangentFunction:
-            result = [[NSNumber alloc] initWithDouble:atanh(operand.doubleValue)];
-            break;
-            
-        /* default case, return not a number to make the program fault-tolerance */
-        default:
-            result = [NSDecimalNumber notANumber];
-            break;
+    /* if there is no token to remove, return immediately */
+    if (count >= _infixExpression.count) {
+        return;
     }
     
-    /* if result is a number, round the result with calculation error */
-    if (![result isEqual:[NSDecimalNumber notANumber]]) {
-        result = NIBRoundNumberWithCalculationError(result);
+    _infixEvaluation.isValid = NO;
+    
+    /* if the infix expression is cleared, reset the counts and the shunting yard */
+    if (count == 0) {
+        _infixCounts = (NIBInfixCounts){0, 0, 0, 0};
+        NIBShuntingYardReset(&_shuntingYard);
+        _shuntingYardState = self.isDecimalMode ? NIBShuntingYardUnusable : NIBShuntingYardSynchronized;
+        NIBTokenBufferTruncate(&_infixExpression, 0);
+        return;
     }
     
-    return result;
-}
-
-- (NSNumber *)performInverseFunctionOfOperand:(NSNumber *)operand
-{
-    NSNumber *result = nil;
+    /* otherwise, uncount the removed tokens */
+    NSInteger removedOpeningParenthesisCount = 0;
     
-    /* if operand is nil or not a number or zero */
-    if (!operand || [operand isEqualToNumber:[NSDecimalNumber notANumber]] ||
-        operand.doubleValue == 0) {
+    for (NSUInteger i = count; i < _infixExpression.count; i++) {
+        NIBToken token = _infixExpression.tokens[i];
         
-        result = [NSDecimalNumber notANumber];
-    
-    /* otherwise, the operand is valid to perform reciprocal function of x */
-    } else {
-        result = [[NSNumber alloc] initWithDouble:1.0/operand.doubleValue];
+        if (NIBTokenIsOperatorWithTag(token, NIBButtonOpenningParenthesis)) removedOpeningParenthesisCount++;
+        NIBInfixCountsCountToken(&_infixCounts, token, -1);
     }
     
-    return result;
-}
-
-- (NSNumber *)performLogarithmFunctionOf:(NSNumber *)operand
-                       withRespectToBase:(NSNumber *)base
-{
-    NSNumber *result =  nil;
-    
-    /* if an operand is nil or zero or not a number or a base is not valid or not a number */
-    if (!operand || operand.doubleValue == 0 ||
-        [operand isEqualToNumber:[NSDecimalNumber notANumber]] ||
-        base.doubleValue <= 0 || base.doubleValue == 1 ||
-        [base isEqualToNumber:[NSDecimalNumber notANumber]]) {
-
-        result = [NSDecimalNumber notANumber];
-    
-    /* otherwise, the operand and a base is valid numbers */
-    /* if base is Euler number */
-    } else if (base.doubleValue == M_E) {
-        result = [[NSNumber alloc] initWithDouble:log(operand.doubleValue)];
-    
-    /* if the base is 10 */
-    } else if (base.doubleValue == 10) {
-        result = [[NSNumber alloc] initWithDouble:log10(operand.doubleValue)];
+    NIBToken firstRemovedToken = _infixExpression.tokens[count];
+    NIBToken lastRemovedToken = _infixExpression.tokens[_infixExpression.count - 1];
+    BOOL isRemovingLastToken = (count == _infixExpression.count - 1);
     
-    /* if the base is 2 */
-    } else if (base.doubleValue == 2) {
-        result = [[NSNumber alloc] initWithDouble:log2(operand.doubleValue)];
+    /* if the shunting yard holds the infix expression, remove the tokens from it */
+    if (_shuntingYardState == NIBShuntingYardSynchronized) {
+        /* if the last token is an operand */
+        if (isRemovingLastToken && firstRemovedToken.kind == NIBTokenKindOperand) {
+            NIBShuntingYardPopOperand(&_shuntingYard);
+        
+        /* if the last token is an openning parenthesis */
+        } else if (isRemovingLastToken && NIBTokenIsOperatorWithTag(firstRemovedToken, NIBButtonOpenningParenthesis)) {
+            NIBShuntingYardPopOperator(&_shuntingYard);
+        
+        /* if the tokens are the last parenthesized group closed by an operand */
+        } else if (NIBTokenIsOperatorWithTag(firstRemovedToken, NIBButtonOpenningParenthesis) &&
+                   removedOpeningParenthesisCount == 1 &&
+                   lastRemovedToken.kind == NIBTokenKindOperand) {
+            NIBShuntingYardRemoveGroup(&_shuntingYard);
+        
+        // otherwise, a binary operator is removed. It has already reduced the
+        // operators before it, which can not be undone
+        } else {
+            _shuntingYardState = NIBShuntingYardOutOfDate;
+        }
     
-    /* otherwise, the base is another positive number */
+    /* otherwise, the remaining infix expression may be held by the shunting yard */
     } else {
-        result = [[NSNumber alloc] initWithDouble:log(operand.doubleValue)/log(base.doubleValue)];
+        _shuntingYardState = NIBShuntingYardOutOfDate;
     }
     
-    return result;
+    NIBTokenBufferTruncate(&_infixExpression, count);
 }
 
-- (NSNumber *)performFactorialOf:(NSNumber *)operand
+#pragma mark Shunting Yard
+
+- (BOOL)synchronizeShuntingYard
 {
-    NSNumber *result =  nil;
+    /* if the calculator is in decimal mode, the shunting yard is not used */
+    if (self.isDecimalMode) {
+        return NO;
+    }
     
-    /* if an operand is nil or negative number or not integer number or not a number */
-    if (!operand || operand.doubleValue < 0 ||
-        operand.doubleValue != round(operand.doubleValue) ||
-        [operand isEqualToNumber:[NSDecimalNumber notANumber]]) {
+    /* if the shunting yard is out of date, push the infix expression to it again */
+    if (_shuntingYardState == NIBShuntingYardOutOfDate) {
+        NIBShuntingYardReset(&_shuntingYard);
+        _shuntingYardState = NIBShuntingYardSynchronized;
         
-        result = [NSDecimalNumber notANumber];
-    
-    /* otherwise, operand is valid */
-    /* if the number is zero */
-    } else if (operand == 0) {
-        result = [[NSNumber alloc] initWithDouble:1.0];
-    
-    /* otherwise, the operand is positive integer larger than one */
-    } else {
-        double temp = 1;
-        for (NSUInteger i = 1; i <= (NSUInteger)operand.doubleValue; i++) {
-            temp *= i;
-            /* if calculation is infinity, result is not a number, stop calculation */
-            if (isinf(temp)) {
-                result = [NSDecimalNumber notANumber];
+        for (NSUInteger i = 0; i < _infixExpression.count; i++) {
+            const NIBToken *previousToken = (i > 0) ? &_infixExpression.tokens[i - 1] : NULL;
+            
+            if (!NIBShuntingYardPushToken(&_shuntingYard, _infixExpression.tokens[i], previousToken)) {
+                _shuntingYardState = NIBShuntingYardUnusable;
                 break;
             }
         }
-        
-        /* if calculation is finity, result is the calculation */
-        if (!isinf(temp)) result = [[NSNumber alloc] initWithDouble:temp];
-    }
-    
-    return result;
-}
-
-- (void)performScientificNotationOfStack:(NIBCalculatorStack<NSNumber *> *)calStack
-{
-    NSNumber *power = [calStack pop];
-    NSNumber *coefficient = [calStack pop];
-    NSNumber *result = nil;
-    
-    /* if either power or base is nil or not a number */
-    if (!power || !coefficient ||
-        [power isEqualToNumber:[NSDecimalNumber notANumber]] ||
-        [coefficient isEqualToNumber:[NSDecimalNumber notANumber]]) {
-        
-        result = [NSDecimalNumber notANumber];
-    
-    /* otherwise, power and base are valid */
-    } else {
-        result = [[NSNumber alloc] initWithDouble:coefficient.doubleValue * pow(10, power.doubleValue)];
     }
     
-    /* if calculation is infinity, result is not a number */
-    if (isinf(result.doubleValue)) {
-        result = [NSDecimalNumber notANumber];
-    }
-    
-    /* push result to calculation stack */
-    [calStack push:result];
+    return _shuntingYardState == NIBShuntingYardSynchronized;
 }
 
-#pragma mark Arithmetic Cache
-
-- (void)updateArithmeticCacheWithExpression:(NSArray *_Nullable)exp
+- (double)reduceShuntingYardForAddingOperator:(NIBButtonTag)operatorTag
 {
-    /* clear cache if needed */
-    if (self.arithmeticCache.count > 0) [self.arithmeticCache removeAllObjects];
-    
-    /* if exp is nil, do nothing */
-    if (!exp) {
-        return;
-    }
-    
-    /* update arithmetic cache from an infix expression */
-    [self.arithmeticCache addObjectsFromArray:exp];
+    return NIBShuntingYardReduce(&_shuntingYard, NIBReductionPrecedenceOfAddingOperator(operatorTag));
 }
 
 #pragma mark Helpers
 
 - (BOOL)isOperandReplaceableInInfixExpression
 {
-    NSInteger __block countOperand = 0;
-    NSInteger __block countBinaryOperator = 0;
-    
-    for (id obj in self.infixExpression) {
-        if ([obj isKindOfClass:[NSNumber class]]) {
-            countOperand++;
-        } else if ([obj isKindOfClass:[NIBOperator class]] && [obj isBinaryOperator]) {
-            countBinaryOperator++;
-        }
-    }
-    
-    return (countOperand == 1 && countBinaryOperator == 0);
+    return (_infixCounts.operandCount == 1 && _infixCounts.binaryOperatorCount == 0);
 }
 
 - (NSInteger)countOperandInInfixExpression
 {
-    NSInteger countOperand = 0;
-    
-    for (id obj in self.infixExpression) {
-        if ([obj isKindOfClass:[NSNumber class]]) countOperand++;
-    }
-    
-    return countOperand;
+    return _infixCounts.operandCount;
 }
 
 - (BOOL)canEvalualateInfixExpression
 {
-    NSInteger operandCount = 0;
-    NSInteger binaryOperationCount = 0;
-    
-    /* count the number of operand and binary operator in infix expression */
-    for (id token in self.infixExpression) {
-        if ([token isKindOfClass:[NSNumber class]]) {
-            operandCount++;
-        } else if ([token isKindOfClass:[NIBOperator class]] && [token isBinaryOperator]) {
-            binaryOperationCount++;
-        }
-    }
+    NSInteger operandCount = _infixCounts.operandCount;
+    NSInteger binaryOperationCount = _infixCounts.binaryOperatorCount;
     
     // the infix expression can be evaluated if there is at least one binary
     // operator and the number of operand == the number binary operation + 1
@@ -1608,211 +1509,167 @@ NS_ASSUME_NONNULL_END
 
 - (BOOL)hasMisMatchedParenthesesInInfixExpression
 {
-    NSInteger __block countOpenningParentheses = 0;
-    NSInteger __block countClosingParentheses = 0;
-    
-    /* count the number of openning parentheses and of closing parentheses in infix expression */
-    for (id obj in self.infixExpression) {
-        if ([obj isKindOfClass:[NIBOperator class]] && [obj isOpeningParanthesis]) {
-            countOpenningParentheses++;
-        } else if ([obj isKindOfClass:[NIBOperator class]] && [obj isOpeningParanthesis]) {
-            countClosingParentheses++;
-        }
-    }
-    
     // the infix has mismatched parentheses if the numbers of openning
     // parentheses and closing parentheses are not equal
-    return (countOpenningParentheses != countClosingParentheses);
+    return (_infixCounts.openingParenthesisCount != _infixCounts.closingParenthesisCount);
 }
 
-- (NSArray *)postfixExpressionFromInfixExpression:(NSArray *)infixExp
+- (void)postfixExpressionFromInfixExpression:(const NIBToken *)infixExp
+                                       count:(NSUInteger)count
+                                    toBuffer:(NIBTokenBuffer *)postfixExp
 {
-    NIBCalculatorStack<NIBOperator *> *stack = [[NIBCalculatorStack alloc] init];
-    NSMutableArray *posfixExp = [[NSMutableArray alloc] init];
+    NIBTokenBuffer *stack = &_operatorStack;
+    
+    NIBTokenBufferTruncate(stack, 0);
+    NIBTokenBufferTruncate(postfixExp, 0);
     
     /* read the token in infix expression one by one to the end */
-    for (id token in infixExp) {
+    for (NSUInteger i = 0; i < count; i++) {
+        NIBToken token = infixExp[i];
+        
         /* if a token is a number, add to the posfix */
-        if ([token isKindOfClass:[NSNumber class]]) {
-            [posfixExp addObject:token];
-            
-        /* otherwise, token is NIBOperator */
+        if (token.kind == NIBTokenKindOperand) {
+            NIBTokenBufferAppend(postfixExp, token);
+        
+        /* otherwise, token is an operator */
         /* if a token is not a parenthesis */
-        } else if (![token isParanthesis]) {
-            while ([stack peek] &&
-                   [[stack peek] isOpeningParanthesis] == NO &&
-                   [[stack peek] comparePriorityWithOperator:token] != NSOrderedAscending) {
-                [posfixExp addObject:[stack pop]];
+        } else if (!NIBIsParenthesisOperatorTag(token.tag)) {
+            while (stack->count > 0 &&
+                   stack->tokens[stack->count - 1].tag != NIBButtonOpenningParenthesis &&
+                   NIBComparePriorityOfOperatorTags(stack->tokens[stack->count - 1].tag, token.tag) != NSOrderedAscending) {
+                NIBTokenBufferAppend(postfixExp, stack->tokens[--stack->count]);
             }
             
-            [stack push:token];
-            
+            NIBTokenBufferAppend(stack, token);
+        
         /* otherwise, token is either openning parenthesis or closing parenthesis */
         /* if the token is an openning parenthesis */
-        } else if ([token isOpeningParanthesis]) {
+        } else if (token.tag == NIBButtonOpenningParenthesis) {
             /* push the openning parentheis to the stack */
-            [stack push:token];
-            
+            NIBTokenBufferAppend(stack, token);
+        
         /* otherwise, token is a closing parentheis */
-        } else if ([token isClosingParanthesis]) {
+        } else {
             
             /* pop all the operator between two parentheses to the posfix */
             // if the stack runs out without finding an openning parenthesis,
             // then there are mistmatched parenthesis
-            while ([stack peek] && [[stack peek] isOpeningParanthesis] == NO) {
-                [posfixExp addObject:[stack pop]];
+            while (stack->count > 0 && stack->tokens[stack->count - 1].tag != NIBButtonOpenningParenthesis) {
+                NIBTokenBufferAppend(postfixExp, stack->tokens[--stack->count]);
             }
             
             /* pop openning parenthesis */
-            [stack pop];
+            if (stack->count > 0) stack->count--;
         }
     }
     
     /* if there is still operator token on the stack */
-    while ([stack peek]) {
-        /* if there is mismatched parenthesis, pop of stack */
-        if ([[stack peek] isParanthesis]) {
-            [stack pop];
-            
-        /* otherwise, add the operator to the postfix expression */
-        } else {
-            [posfixExp addObject:[stack pop]];
+    while (stack->count > 0) {
+        NIBToken token = stack->tokens[--stack->count];
+        
+        /* if there is not mismatched parenthesis, add the operator to the postfix expression */
+        if (!NIBIsParenthesisOperatorTag(token.tag)) {
+            NIBTokenBufferAppend(postfixExp, token);
         }
     }
-    
-    return [posfixExp copy];
 }
 
-- (BOOL)isOddMultiplicationOfPi_2:(double)angle
+- (NSUInteger)postfixExpressionFromInfixExpression:(const NIBToken *)infixExp
+                                             count:(NSUInteger)count
+                                      unknownIndex:(NSUInteger)unknownIndex
+                                          toBuffer:(NIBTokenBuffer *)postfixExp
 {
-    BOOL isOddMultiplicationOfPi_2 = NO;
+    NSUInteger unknownOperandIdx = 0;
     
-    /* if angle is negative, convert to positive angle */
-    if (angle < 0) angle = -angle;
+    // the conversion keeps the order of the operands, so the unknown is the
+    // operand after the ones before it in the infix expression
+    for (NSUInteger i = 0; i < unknownIndex; i++) {
+        if (infixExp[i].kind == NIBTokenKindOperand) unknownOperandIdx++;
+    }
     
-    NSInteger i = 1;
-    double oddPi_2 = (self.isRadianMode) ? M_PI_2 * i : 90.0 * i;
+    [self postfixExpressionFromInfixExpression:infixExp count:count toBuffer:&_postfixExpression];
     
-    while (angle >= oddPi_2) {
-        /* if angle is odd multiplication of M_PI_2 */
-        if (angle == oddPi_2 && (i % 2)) {
-            isOddMultiplicationOfPi_2 = YES;
-            break;
-        }
-        /* update oddPi */
-        i++;
-        oddPi_2 = (self.isRadianMode) ? M_PI_2 * i : 90.0 * i;
-    }
+    NIBTokenBufferTruncate(postfixExp, 0);
     
-    return isOddMultiplicationOfPi_2;
-}
-
-- (NSArray *)partialInfixExpressionContainingLastElementsFromExpression:(NSArray *)infixExp
-{
-    NSMutableArray *partialInfExp = [[NSMutableArray alloc] init];
+    NSUInteger operandIdx = 0;
     
-    /* reverse enumerate an infix expression */
-    [infixExp enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(id token, NSUInteger __unused idx, BOOL *stop) {
-        /* if a token is a number or not a parentheses */
-        if ( [token isKindOfClass:[NSNumber class]] ||
-             ([token isKindOfClass:[NIBOperator class]] && ![token isClosingParanthesis]) ) {
-            
-            /* add token to the partial infix expression */
-            [partialInfExp insertObject:token atIndex:0];
-        }
+    for (NSUInteger i = 0; i < _postfixExpression.count; i++) {
+        NIBToken token = _postfixExpression.tokens[i];
         
-        if (partialInfExp.count == 2) *stop= YES;
-    }];
+        /* if the token is the unknown operand, replace it with the unknown expression */
+        if (token.kind == NIBTokenKindOperand && operandIdx++ == unknownOperandIdx) {
+            NIBTokenBufferAppendTokens(postfixExp, _unknownExpression.tokens, _unknownExpression.count);
+        } else {
+            NIBTokenBufferAppend(postfixExp, token);
+        }
+    }
     
-    return (partialInfExp.count == 1) ? nil : partialInfExp;
+    return unknownOperandIdx + _unknownOperandIndex;
 }
 
-- (NSArray *)partialInfixExpressionFromExpression:(NSArray *)infixExp
-                    asLeftOperandOfAddingOperator:(NIBOperator *)operator
+- (NSUInteger)indexOfPartialInfixExpressionAsLeftOperandOfAddingOperator:(NIBButtonTag)operatorTag
+                                                                   count:(NSUInteger)count
 {
-    NSMutableArray *partialInfExp = [[NSMutableArray alloc] init];
+    const NIBToken *infixExp = _infixExpression.tokens;
+    NSUInteger idx = count;
     
-    switch (operator.idx) {
+    switch (operatorTag) {
         /* adding operator is addition or substraction */
         case NIBButtonAddition:
         case NIBButtonSubstraction:
         {
-            /* if the infix expression has openning parenthesis only */
-            if ([self hasMisMatchedParenthesesInInfixExpression]) {
-                
-                /* reverse enumerate an infix expression */
-                [infixExp enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(id token, NSUInteger __unused idx, BOOL *stop) {
-                    
-                    /* if a token is a number or an operator not openning parenthesis */
-                    if( [token isKindOfClass:[NSNumber class]] ||
-                       ([token isKindOfClass:[NIBOperator class]] && ![token isOpeningParanthesis]) ) {
-                        
-                        /* add token to the partial infix expression */
-                        [partialInfExp insertObject:token atIndex:0];
-                        
-                    /* otherwise a token is an openning parenthesis,
-                           stop forming infix expression */
-                    } else if ([token isKindOfClass:[NIBOperator class]] && [token isOpeningParanthesis]) {
-                        *stop = YES;
-                    }
-                }];
-            } else {
-                [partialInfExp addObjectsFromArray:self.infixExpression];
+            /* if the infix expression has openning parenthesis, stop at the last one */
+            while (idx > 0 && !NIBTokenIsOperatorWithTag(infixExp[idx - 1], NIBButtonOpenningParenthesis)) {
+                idx--;
             }
             
             break;
         }
-            
+        
         /* adding operator is multiplication of division */
         case NIBButtonMultiplication:
         case NIBButtonDivision:
         {
-            /* reverse enumerate an infix expression */
-            [infixExp enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(id token, NSUInteger __unused idx, BOOL *stop) {
-                
-                // if a token is a number or a token is an operator that
-                //  is not an openning parenthesis and have equal or higher
-                // precedence than the adding operator
-                if( [token isKindOfClass:[NSNumber class]] ||
-                    ([token isKindOfClass:[NIBOperator class]] && ![token isOpeningParanthesis] && [token comparePriorityWithOperator:operator] != NSOrderedAscending) ) {
-                    
-                    /* add token to the partial infix expression */
-                    [partialInfExp insertObject:token atIndex:0];
+            // reverse enumerate an infix expression while a token is a number
+            // or a token is an operator that is not an openning parenthesis
+            // and have equal or higher precedence than the adding operator
+            while (idx > 0) {
+                NIBToken token = infixExp[idx - 1];
                 
-                /* otherwise a token has lower precedence than the adding
-                   operator or a token is an openning parenthesis, stop forming
-                   infix epxression */
-                } else {
-                    *stop = YES;
+                if (token.kind == NIBTokenKindOperator &&
+                    (token.tag == NIBButtonOpenningParenthesis ||
+                     NIBComparePriorityOfOperatorTags(token.tag, operatorTag) == NSOrderedAscending)) {
+                    break;
                 }
-            }];
+                
+                idx--;
+            }
             
             break;
         }
-            
+        
         /* adding operator is closing parenthesis */
         case NIBButtonClosingParenthesis:
         {
-            /* reverse enumerate an infix expression */
-            [infixExp enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(id token, NSUInteger __unused idx, BOOL *stop) {
-                /* add token to the partial infix expression */
-                [partialInfExp insertObject:token atIndex:0];
+            /* reverse enumerate an infix expression, include the last openning parenthesis */
+            while (idx > 0) {
+                idx--;
                 
-                /* if a token is openning parenthesis, stop */
-                if ([token isKindOfClass:[NIBOperator class]] && [token isOpeningParanthesis]) {
-                    *stop = YES;
+                if (NIBTokenIsOperatorWithTag(infixExp[idx], NIBButtonOpenningParenthesis)) {
+                    break;
                 }
-            }];
+            }
             
             break;
         }
-            
+        
         default:
-            [partialInfExp addObject:[self.infixExpression lastObject]];
+            /* the partial infix expression is the last token */
+            if (idx > 0) idx--;
             break;
     }
     
-    return partialInfExp;
+    return idx;
 }
 
 @end
@@ -1823,140 +1680,107 @@ NS_ASSUME_NONNULL_END
 
 
 /**
- Convert from double number to Fraction.
- 
- @param number The double number.
+ Count a token of the infix expression.
  
- @return Returns the fraction with numerator and denominator representing the number.
+ @param counts  The counts of the infix expression.
+ @param token   The token to count.
+ @param delta   1 if the token is added, -1 if the token is removed.
  */
-Fraction NIBFractionFromDouble(double number) {
-    Fraction frac = {0, 0};
-    
-    /* if a number is an integer */
-    if (number == round(number)) {
-        /* fraction is number/1 */
-        frac.numerator = (int_least64_t)number;
-        frac.denominator = 1;
-        
-        /* if a number is not an integer */
-    } else {
-        Fraction fractions[2];
-        fractions[0] = (Fraction) {1, 0};
-        fractions[1] = (Fraction) {0, 1};
-        
-        /* approximation always convert to postive */
-        double approximation = (number < 0) ? -number : number;
-        int_least64_t integerPart = (int_least64_t)approximation;
-        
-        while (fractions[0].denominator * integerPart + fractions[1].denominator <= NIB_MAX_DENOMINATOR) {
-            int_least64_t temp;
-            temp = fractions[0].numerator * integerPart + fractions[1].numerator;
-            fractions[1].numerator = fractions[0].numerator;
-            fractions[0].numerator = temp;
-            temp = fractions[0].denominator * integerPart + fractions[1].denominator;
-            fractions[1].denominator = fractions[0].denominator;
-            fractions[0].denominator = temp;
-            
-            /* if approximation is perfect */
-            if (approximation == integerPart) {
-                break;
-            
-            /* if approximation is acceptable with an error */
-            } else if (approximation - integerPart <= NIB_APPROX_ERROR) {
-                break;
-                
-            /* if the number can not be represented as rational form */
-            } else if ( NIBIsNegativeFraction(fractions[0]) || NIBIsNegativeFraction(fractions[1]) ) {
-                fractions[0] = (Fraction) {1, 0};
-                break;
-            }
-                
-            /* update approximation and integer part */
-            approximation = 1.0/(approximation - integerPart);
-            integerPart = (int_least64_t)approximation;
-            
-            if (approximation > (double)0x7FFFFFFF) {
-                break;
-            }
-        }
-        
-        /* get the fraction of a number */
-        frac = fractions[0];
-        
-        /* if valid fraction */
-        if (frac.denominator != 0) {
-            /* find GCD of numerator and denominator of the fraction */
-            int_least64_t greatCommondDivisor = NIBGreatCommonDivisor((uint_least64_t)frac.numerator, (uint_least64_t)frac.denominator);
-            
-            /* reduce the fraction to simplest form */
-            frac.numerator = frac.numerator/greatCommondDivisor;
-            frac.denominator = frac.denominator/greatCommondDivisor;
-            
-            /* return the sign of the fraction if negative */
-            if (number < 0) {
-                frac.numerator = -frac.numerator;
-            }
-        }
-        
+static void NIBInfixCountsCountToken(NIBInfixCounts *counts, NIBToken token, NSInteger delta) {
+    if (token.kind == NIBTokenKindOperand) {
+        counts->operandCount += delta;
+    } else if (token.tag == NIBButtonOpenningParenthesis) {
+        counts->openingParenthesisCount += delta;
+    } else if (token.tag == NIBButtonClosingParenthesis) {
+        counts->closingParenthesisCount += delta;
+    } else if (NIBIsBinaryOperatorTag(token.tag)) {
+        counts->binaryOperatorCount += delta;
     }
-    
-    return frac;
 }
 
 /**
- Check if a fraction is negative.
+ Push a token of the infix expression to a shunting yard. The shunting yard
+ holds sequences where operands and binary operators alternate, and openning
+ parentheses come before operands.
  
- @param frac The fraction to check.
+ @param yard            The shunting yard.
+ @param token           The token to push.
+ @param previousToken   The token before in the infix expression, or NULL if
+                        the token is the first one.
  
- @return Returns YES if the fraction is negative, otherwise NO.
+ @return Returns YES if the token is pushed, or NO if the shunting yard can not
+ hold the sequence.
  */
-static BOOL NIBIsNegativeFraction(Fraction frac) {
-    BOOL isNegativeFraction = NO;
-    
-    if ((frac.numerator < 0 && frac.denominator > 0) ||
-        (frac.numerator > 0 && frac.denominator < 0)) {
-        isNegativeFraction = YES;
+static BOOL NIBShuntingYardPushToken(NIBShuntingYard *yard, NIBToken token, const NIBToken *previousToken) {
+    /* an operand is expected at the beginning and after an openning parenthesis or a binary operator */
+    BOOL isExpectingOperand = (previousToken == NULL || previousToken->kind == NIBTokenKindOperator);
+    
+    /* if the token is an operand */
+    if (token.kind == NIBTokenKindOperand) {
+        if (!isExpectingOperand) return NO;
+        NIBShuntingYardPushOperand(yard, token.operand);
+    
+    /* if the token is an openning parenthesis */
+    } else if (token.tag == NIBButtonOpenningParenthesis) {
+        if (!isExpectingOperand) return NO;
+        NIBShuntingYardPushOperator(yard, token.tag);
+    
+    /* if the token is a binary operator */
+    } else if (NIBIsBinaryOperatorTag(token.tag)) {
+        if (isExpectingOperand) return NO;
+        NIBShuntingYardPushOperator(yard, token.tag);
+    
+    /* otherwise, the token can not be held */
+    } else {
+        return NO;
     }
     
-    return isNegativeFraction;
+    return YES;
 }
 
 /**
- Find the great common divisor of two positive integers.
+ Get the lowest precedence the shunting yard reduces to get the partial infix
+ expression which is the left operand of an adding operator.
  
- @param number1 The first number.
- @param number2 The second number.
+ @param operatorTag The tag of the operator to add.
  
- @return Returns the great common divisor of two numbers.
+ @return Returns 1 for addition, substraction and closing parenthesis, the
+ precedence of multiplication and division, or NSIntegerMax for the others as
+ their left operand is the last operand.
  */
-static int_least64_t NIBGreatCommonDivisor(uint_least64_t number1, uint_least64_t number2) {
-    uint_least64_t temp;
-    
-    while (number2 != 0) {
-        temp = number1 % number2;
-        number1 = number2;
-        number2 = temp;
+static NSInteger NIBReductionPrecedenceOfAddingOperator(NIBButtonTag operatorTag) {
+    switch (operatorTag) {
+        /* adding operator is addition or substraction or closing parenthesis, reduce back to the last openning parenthesis */
+        case NIBButtonAddition:
+        case NIBButtonSubstraction:
+        case NIBButtonClosingParenthesis:
+            return 1;
+        
+        /* adding operator is multiplication of division, reduce the operators of equal or higher precedence */
+        case NIBButtonMultiplication:
+        case NIBButtonDivision:
+            return NIBPrecedenceOfOperatorTag(operatorTag);
+        
+        /* otherwise, the partial infix expression is the last operand */
+        default:
+            return NSIntegerMax;
     }
-    
-    return (int_least64_t)number1;
 }
 
 /**
- Round the double with calculation error.
+ Create a number object from a result of calculation.
  
- @param doubleNumber The double number to round.
+ @param number The result of calculation.
  
- @return Returns the number object after rounding.
+ @return Returns the number object of the result, or [NSDecimalNumber notANumber]
+ if the result is not a number.
  */
-static NSNumber * NIBRoundNumberWithCalculationError(NSNumber *doubleNumber) {
-    NSNumber *result = nil;
-    double roundedVal = round(doubleNumber.doubleValue);
-    
-    if (fabs(roundedVal - doubleNumber.doubleValue) <= NIB_CAL_ERROR) {
-        result = [[NSNumber alloc] initWithDouble:roundedVal];
-    } else {
-        result = doubleNumber;
+static NSNumber * NIBNumberFromDouble(double number) {
+    if (isnan(number)) {
+        return [NSDecimalNumber notANumber];
     }
     
-    return result;
+    NIB_COUNT_ALLOCATION(NIBInstrumentationAllocationNumber, 0);
+    
+    return [[NSNumber alloc] initWithDouble:number];
 }
@@ -0,0 +1,102 @@
+//
+//  NIBCalculatorEvaluator.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class NIBCalculatorBrain;
+@class NIBCalculatorFuture;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A block which evaluates with the calculator on the queue of an evaluator.
+ 
+ @param calculator  The calculator.
+ @param future      The future of the evaluation. The block can skip the work
+                    which is only for the result if the future is cancelled.
+ 
+ @return Returns the result of the evaluation.
+ */
+typedef id _Nullable (^NIBCalculatorEvaluationBlock)(NIBCalculatorBrain *calculator, NIBCalculatorFuture *future);
+
+/**
+ `NIBCalculatorEvaluator` evaluates with a calculator on a serial queue in the
+ background, so an expensive operation does not hold up the thread which
+ starts it. The evaluations run one after another in the order they are
+ started, and each of them returns a future of its result.
+ 
+ @note The calculator is not safe to use from multiple threads, so it is only
+ used in the evaluations, or after waitUntilFinished returns, until the next
+ evaluation starts.
+ */
+@interface NIBCalculatorEvaluator : NSObject
+
+/// ----------------
+/// @name Properties
+/// ----------------
+
+/** The calculator of the evaluator. */
+@property (readonly, strong, nonatomic) NIBCalculatorBrain *calculator;
+
+/// -------------------------
+/// @name Unavailable Methods
+/// -------------------------
+
+/**
+ The init method is unavailable.
+ */
+- (instancetype)init __attribute__((unavailable("use +evaluatorWithCalculator: method")));
+
+/// --------------------
+/// @name Initialization
+/// --------------------
+
+/**
+ Create the evaluator of a calculator.
+ 
+ @param calculator  The calculator.
+ 
+ @return Returns the NIBCalculatorEvaluator instance.
+ */
++ (instancetype)evaluatorWithCalculator:(NIBCalculatorBrain *)calculator;
+
+/// ----------------
+/// @name Evaluation
+/// ----------------
+
+/**
+ Start an evaluation after the evaluations which are started before it.
+ 
+ @param block   The block to evaluate.
+ 
+ @return Returns the future of the result of the evaluation.
+ */
+- (NIBCalculatorFuture *)evaluate:(NIBCalculatorEvaluationBlock)block;
+
+/**
+ Change the calculator after the evaluations which are started before it. A
+ change has no result, so it is not cancelled with the evaluations.
+ 
+ @param block   The block to change the calculator.
+ */
+- (void)performChange:(void (^)(NIBCalculatorBrain *calculator))block;
+
+/**
+ Cancel the evaluations which are not finished. The evaluations which are not
+ started are skipped with nil results.
+ */
+- (void)cancelAllEvaluations;
+
+/**
+ Wait until the evaluations and the changes which are started are finished.
+ */
+- (void)waitUntilFinished;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,129 @@
+//
+//  NIBCalculatorEvaluator.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBCalculatorEvaluator.h"
+#import "NIBCalculatorFuture.h"
+#import "NIBCalculatorBrain.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Extension
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBCalculatorEvaluator () {
+    /** The serial queue which evaluates. */
+    dispatch_queue_t _queue;
+    
+    /** The futures of the evaluations which are not finished, in order. */
+    NSMutableArray<NIBCalculatorFuture *> *_unfinishedFutures;
+}
+
+@property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+
+/**
+ Initialize the evaluator of a calculator.
+ 
+ @param calculator  The calculator.
+ 
+ @return Returns the NIBCalculatorEvaluator instance.
+ */
+- (instancetype)initWithCalculator:(NIBCalculatorBrain *)calculator;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Implementation
+
+
+@implementation NIBCalculatorEvaluator
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Public Methods
+
+#pragma mark Create An Evaluator
+
++ (instancetype)evaluatorWithCalculator:(NIBCalculatorBrain *)calculator
+{
+    NIBCalculatorEvaluator *evaluator = [[self alloc] initWithCalculator:calculator];
+    
+    return evaluator;
+}
+
+#pragma mark Evaluation
+
+- (NIBCalculatorFuture *)evaluate:(NIBCalculatorEvaluationBlock)block
+{
+    NIBCalculatorFuture *future = [[NIBCalculatorFuture alloc] init];
+    NIBCalculatorBrain *calculator = self.calculator;
+    NSMutableArray<NIBCalculatorFuture *> *unfinishedFutures = _unfinishedFutures;
+    
+    @synchronized (unfinishedFutures) {
+        [unfinishedFutures addObject:future];
+    }
+    
+    dispatch_async(_queue, ^{
+        /* if the future is cancelled before the evaluation starts, skip it */
+        id result = future.isCancelled ? nil : block(calculator, future);
+        
+        @synchronized (unfinishedFutures) {
+            [unfinishedFutures removeObjectIdenticalTo:future];
+        }
+        
+        [future finishWithResult:result];
+    });
+    
+    return future;
+}
+
+- (void)performChange:(void (^)(NIBCalculatorBrain *))block
+{
+    NIBCalculatorBrain *calculator = self.calculator;
+    
+    dispatch_async(_queue, ^{
+        block(calculator);
+    });
+}
+
+- (void)cancelAllEvaluations
+{
+    @synchronized (_unfinishedFutures) {
+        [_unfinishedFutures makeObjectsPerformSelector:@selector(cancel)];
+    }
+}
+
+- (void)waitUntilFinished
+{
+    dispatch_sync(_queue, ^{});
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Methods
+
+
+#pragma mark Initialize
+
+- (instancetype)initWithCalculator:(NIBCalculatorBrain *)calculator
+{
+    self = [super init];
+    
+    if (self) {
+        _calculator = calculator;
+        _queue = dispatch_queue_create("com.lv.NIBCalculator.evaluator", DISPATCH_QUEUE_SERIAL);
+        _unfinishedFutures = [[NSMutableArray alloc] init];
+    }
+    
+    return self;
+}
+
+@end
@@ -0,0 +1,82 @@
+//
+//  NIBCalculatorFuture.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ `NIBCalculatorFuture` is the result of an evaluation which finishes later, on
+ the queue of a NIBCalculatorEvaluator. The result can be waited for, or sent
+ to a block on a queue when the evaluation finishes.
+ 
+ A future which is cancelled before its evaluation starts is not evaluated. A
+ future which is cancelled later still finishes, but its result is not sent to
+ the blocks which are waiting for it.
+ 
+ @note The future is safe to use from multiple threads.
+ */
+@interface NIBCalculatorFuture : NSObject
+
+/// ----------------
+/// @name Properties
+/// ----------------
+
+/** Boolean value indicating if the future is cancelled. */
+@property (readonly, getter=isCancelled, atomic, assign) BOOL cancelled;
+
+/** Boolean value indicating if the evaluation of the future is finished. */
+@property (readonly, getter=isFinished, atomic, assign) BOOL finished;
+
+/** The result of the evaluation, nil until the evaluation is finished. */
+@property (readonly, atomic, strong) id _Nullable result;
+
+/// ------------
+/// @name Result
+/// ------------
+
+/**
+ Wait until the evaluation is finished.
+ 
+ @return Returns the result of the evaluation.
+ */
+- (id _Nullable)waitForResult;
+
+/**
+ Send the result to a block when the evaluation is finished. The block is not
+ called if the future is cancelled by then.
+ 
+ @param queue   The queue to call the block on.
+ @param block   The block to call with the result.
+ */
+- (void)notifyOnQueue:(dispatch_queue_t)queue usingBlock:(void (^)(id _Nullable result))block;
+
+/// ------------------
+/// @name Cancellation
+/// ------------------
+
+/**
+ Cancel the future.
+ */
+- (void)cancel;
+
+/// ---------------
+/// @name Finishing
+/// ---------------
+
+/**
+ Finish the evaluation with a result. The future is finished once, by the
+ evaluator which creates it.
+ 
+ @param result  The result of the evaluation.
+ */
+- (void)finishWithResult:(id _Nullable)result;
+
+@end
+
+NS_ASSUME_NONNULL_END
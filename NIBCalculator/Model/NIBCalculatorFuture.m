@@ -0,0 +1,118 @@
+//
+//  NIBCalculatorFuture.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBCalculatorFuture.h"
+#import <stdatomic.h>
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Extension
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBCalculatorFuture () {
+    /** The group which is left when the evaluation is finished. */
+    dispatch_group_t _group;
+    
+    /** The boolean value to indicate if the future is cancelled. */
+    atomic_bool _cancelled;
+    
+    /** The boolean value to indicate if the evaluation is finished. */
+    atomic_bool _finished;
+}
+
+@property (readwrite, atomic, strong) id _Nullable result;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Implementation
+
+
+@implementation NIBCalculatorFuture
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Initialize
+
+- (instancetype)init
+{
+    self = [super init];
+    
+    if (self) {
+        _group = dispatch_group_create();
+        atomic_init(&_cancelled, NO);
+        atomic_init(&_finished, NO);
+        
+        dispatch_group_enter(_group);
+    }
+    
+    return self;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Public Methods
+
+#pragma mark Getters
+
+- (BOOL)isCancelled
+{
+    return atomic_load(&_cancelled);
+}
+
+- (BOOL)isFinished
+{
+    return atomic_load(&_finished);
+}
+
+#pragma mark Result
+
+- (id)waitForResult
+{
+    dispatch_group_wait(_group, DISPATCH_TIME_FOREVER);
+    
+    return self.result;
+}
+
+- (void)notifyOnQueue:(dispatch_queue_t)queue usingBlock:(void (^)(id _Nullable))block
+{
+    dispatch_group_notify(_group, queue, ^{
+        /* if the future is cancelled, nobody waits for the result */
+        if (self.isCancelled) {
+            return;
+        }
+        
+        block(self.result);
+    });
+}
+
+#pragma mark Cancellation
+
+- (void)cancel
+{
+    atomic_store(&_cancelled, YES);
+}
+
+#pragma mark Finishing
+
+- (void)finishWithResult:(id)result
+{
+    /* if the future is already finished, the result does not change */
+    if (self.isFinished) {
+        return;
+    }
+    
+    self.result = result;
+    atomic_store(&_finished, YES);
+    dispatch_group_leave(_group);
+}
+
+@end
@@ -0,0 +1,387 @@
+//
+//  NIBCalculatorKernels.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+/**
+ `NIBCalculatorKernels` contain the calculation kernels of the calculator. The
+ kernels work on plain doubles and report every error as NAN, so they can be
+ shared by the calculator brain and compiled programs.
+ */
+
+#import <Foundation/Foundation.h>
+#import "NIBConstants.h"
+#import "NIBDecimal128.h"
+#import "NIBToken.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Functional Kernels
+
+
+/**
+ Raise to the power of base. It used to handle root and exponent operation.
+ 
+ @param power   The power to raise.
+ @param base    The base of exponent operation.
+ 
+ @return Returns the result of the exponentiation if it is successful,
+ otherwise NAN.
+ */
+FOUNDATION_EXPORT double NIBRaiseToPower(double power, double base);
+
+/**
+ Find the logarithm of an operand with respect to a base.
+ 
+ @param operand The operand to find logarithm.
+ @param base    The base of a logarithm. Base is a positive real number not
+                equal to 1.
+ 
+ @return Returns the result of the logarithm function if it is successful,
+ otherwise NAN.
+ */
+FOUNDATION_EXPORT double NIBLogarithm(double operand, double base);
+
+/**
+ Find the natural logarithm of the factorial of an operand, ln(x!). It does not
+ overflow for the operands whose factorial is too large for a double, so huge
+ factorials can be combined, such as ln(n!) - ln(k!) - ln((n-k)!).
+ 
+ @param operand The operand. It is larger than -1, where x! is positive.
+ 
+ @return Returns the logarithm of the factorial if it is successful, otherwise
+ NAN.
+ */
+FOUNDATION_EXPORT double NIBLogarithmOfFactorial(double operand);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Unary Kernels
+
+
+/**
+ Perform a unary operator on an operand.
+ 
+ @param operatorTag     The tag of the unary operator.
+ @param operand         The operand.
+ @param isRadianMode    YES if angles are in radian, NO if they are in degree.
+ 
+ @return Returns the result of the operator if it is successful, otherwise NAN.
+ */
+FOUNDATION_EXPORT double NIBPerformUnaryOperator(NIBButtonTag operatorTag, double operand, BOOL isRadianMode);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Memoized Unary Kernels
+
+
+/**
+ @struct NIBUnaryMemoStatistics
+ 
+ The counters of the unary memo of a thread.
+ 
+ @field hitCount    The number of results found in the memo.
+ @field missCount   The number of results calculated and kept in the memo.
+ */
+typedef struct NIBUnaryMemoStatistics {
+    uint64_t hitCount;
+    uint64_t missCount;
+} NIBUnaryMemoStatistics;
+
+/**
+ Perform a unary operator on an operand through the unary memo of the current
+ thread. The memo keeps the last results of the costly operators, such as the
+ trigonometric functions, the logarithms, the roots and the factorial, keyed by
+ the operator, the bits of the operand and the modes, so a result is the same
+ as the one calculated again, for NAN, -0 and in degree as well. Each thread
+ has its own memo, so it takes no lock.
+ 
+ @param operatorTag     The tag of the unary operator.
+ @param operand         The operand.
+ @param isRadianMode    YES if angles are in radian, NO if they are in degree.
+ @param isDecimalMode   YES if the operator is performed in decimal as
+                        NIBPerformDecimalUnaryOperator does, NO if it is
+                        performed as NIBPerformUnaryOperator does.
+ 
+ @return Returns the result of the operator if it is successful, otherwise NAN.
+ */
+FOUNDATION_EXPORT double NIBPerformMemoizedUnaryOperator(NIBButtonTag operatorTag,
+                                                         double operand,
+                                                         BOOL isRadianMode,
+                                                         BOOL isDecimalMode);
+
+/**
+ Get the counters of the unary memo of the current thread.
+ 
+ @return Returns the counters since the thread started or the memo was reset.
+ */
+FOUNDATION_EXPORT NIBUnaryMemoStatistics NIBUnaryMemoStatisticsOfCurrentThread(void);
+
+/**
+ Empty the unary memo of the current thread and reset its counters.
+ */
+FOUNDATION_EXPORT void NIBResetUnaryMemoOfCurrentThread(void);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Binary Kernels
+
+
+/**
+ Perform a binary operator on two operands.
+ 
+ @param operatorTag     The tag of the binary operator.
+ @param leftOperand     The left operand.
+ @param rightOperand    The right operand.
+ 
+ @return Returns the result of the operator if it is successful, otherwise NAN.
+ */
+FOUNDATION_EXPORT double NIBPerformBinaryOperator(NIBButtonTag operatorTag, double leftOperand, double rightOperand);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Batch Kernels
+
+
+/**
+ Perform a unary operator on every operand of an array. The result of each
+ operand is the same as NIBPerformUnaryOperator.
+ 
+ @param operatorTag     The tag of the unary operator.
+ @param operands        The operands.
+ @param results         The buffer with room for count values to store the
+                        results. It can be the operands buffer.
+ @param count           The number of operands.
+ @param isRadianMode    YES if angles are in radian, NO if they are in degree.
+ */
+FOUNDATION_EXPORT void NIBPerformUnaryOperatorOnOperands(NIBButtonTag operatorTag,
+                                                         const double *operands,
+                                                         double *results,
+                                                         NSUInteger count,
+                                                         BOOL isRadianMode);
+
+/**
+ Perform a binary operator on every pair of operands of two arrays. The result
+ of each pair is the same as NIBPerformBinaryOperator.
+ 
+ @param operatorTag     The tag of the binary operator.
+ @param leftOperands    The left operands.
+ @param rightOperands   The right operands.
+ @param results         The buffer with room for count values to store the
+                        results. It can be one of the operands buffers.
+ @param count           The number of pairs of operands.
+ */
+FOUNDATION_EXPORT void NIBPerformBinaryOperatorOnOperands(NIBButtonTag operatorTag,
+                                                          const double *leftOperands,
+                                                          const double *rightOperands,
+                                                          double *results,
+                                                          NSUInteger count);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Postfix Evaluation
+
+
+/**
+ Evaluate a postfix expression. A missing operand of an operator is NAN
+ except the first summand of an addition, then the sole summand is the sum.
+ 
+ @param postfixExp  The tokens of the postfix expression.
+ @param count       The number of tokens.
+ @param operands    The values of the operands in order of appearance in the
+                    expression, or NULL to use the operands of the expression.
+ @param stack       The calculation stack with room for count values, or NULL
+                    to let the function provide one.
+ @param result      The result of the expression.
+ 
+ @return Returns YES if the expression has a result, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBEvaluatePostfixExpression(const NIBToken *_Nullable postfixExp,
+                                                    NSUInteger count,
+                                                    const double *_Nullable operands,
+                                                    double *_Nullable stack,
+                                                    double *result);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Dual Kernels
+
+
+/**
+ @struct NIBDual
+ 
+ A dual number, value + derivative·ε where ε² = 0. An operator on dual numbers
+ carries the derivative of its result with respect to an unknown along with the
+ value, so one evaluation of an expression gives both, without the error of a
+ finite difference.
+ 
+ @field value       The value.
+ @field derivative  The derivative of the value with respect to the unknown.
+ */
+typedef struct NIBDual {
+    double value;
+    double derivative;
+} NIBDual;
+
+/**
+ Create a dual number.
+ 
+ @param value       The value.
+ @param derivative  The derivative of the value with respect to the unknown.
+ 
+ @return Returns the dual number.
+ */
+NS_INLINE NIBDual NIBDualMake(double value, double derivative) {
+    NIBDual dual;
+    dual.value = value;
+    dual.derivative = derivative;
+    return dual;
+}
+
+/**
+ Perform a unary operator on a dual operand. The value is the result of
+ NIBPerformUnaryOperator and the derivative follows by the chain rule. The
+ derivative of a trigonometric function in degree is per degree.
+ 
+ @param operatorTag     The tag of the unary operator.
+ @param operand         The operand.
+ @param isRadianMode    YES if angles are in radian, NO if they are in degree.
+ 
+ @return Returns the result of the operator, NAN with a NAN derivative if it is
+ not successful.
+ */
+FOUNDATION_EXPORT NIBDual NIBPerformDualUnaryOperator(NIBButtonTag operatorTag, NIBDual operand, BOOL isRadianMode);
+
+/**
+ Perform a binary operator on two dual operands. The value is the result of
+ NIBPerformBinaryOperator and the derivative follows by the chain rule. The
+ derivative with respect to a power is NAN where the base is negative.
+ 
+ @param operatorTag     The tag of the binary operator.
+ @param leftOperand     The left operand.
+ @param rightOperand    The right operand.
+ 
+ @return Returns the result of the operator, NAN with a NAN derivative if it is
+ not successful.
+ */
+FOUNDATION_EXPORT NIBDual NIBPerformDualBinaryOperator(NIBButtonTag operatorTag, NIBDual leftOperand, NIBDual rightOperand);
+
+/**
+ Evaluate a postfix expression on dual numbers, with respect to one of its
+ operands. The value of the result is the one of NIBEvaluatePostfixExpression.
+ An unary operator in the expression is performed on the value at the top of
+ the calculation stack, so the unknown can be inside a function, such as
+ `x sin 2 +` for sin(x) + 2.
+ 
+ @param postfixExp      The tokens of the postfix expression.
+ @param count           The number of tokens.
+ @param unknownIndex    The index of the unknown in order of appearance of the
+                        operands in the expression.
+ @param unknown         The value of the unknown, which replaces its operand.
+ @param isRadianMode    YES if angles are in radian, NO if they are in degree.
+ @param result          The result of the expression and its derivative with
+                        respect to the unknown.
+ 
+ @return Returns YES if the expression has a result, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBEvaluateDualPostfixExpression(const NIBToken *_Nullable postfixExp,
+                                                        NSUInteger count,
+                                                        NSUInteger unknownIndex,
+                                                        double unknown,
+                                                        BOOL isRadianMode,
+                                                        NIBDual *result);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Solver
+
+
+/**
+ Find the unknown operand which makes a postfix expression equal to a target.
+ Every pass evaluates the value and the derivative of the expression together
+ with NIBEvaluateDualPostfixExpression. The solver takes Newton steps from the
+ guess, halving a step until the residual decreases. If the steps stall or the
+ guess is not in the domain of the expression, it searches for a sign change
+ of the residual on both sides of the guess at doubling distances. Once the
+ root is bracketed by a sign change, a Newton step which leaves the bracket or
+ does not halve the step before the last one is replaced by bisection, so the
+ bracket always shrinks. A point which the steps converge to is a root only if
+ its residual is small, so a pole inside a bracket, such as of 1/x, is not
+ taken as a root.
+ 
+ @param postfixExp      The tokens of the postfix expression, which can hold
+                        unary operators as NIBEvaluateDualPostfixExpression
+                        reads them.
+ @param count           The number of tokens.
+ @param unknownIndex    The index of the unknown in order of appearance of the
+                        operands in the expression.
+ @param target          The value of the expression at the root.
+ @param guess           The value of the unknown to start from.
+ @param isRadianMode    YES if angles are in radian, NO if they are in degree.
+ @param root            The root, or NAN if there is no root.
+ @param passCount       The number of evaluations of the expression, or NULL.
+ 
+ @return Returns YES if a root is found, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBSolvePostfixExpression(const NIBToken *_Nullable postfixExp,
+                                                 NSUInteger count,
+                                                 NSUInteger unknownIndex,
+                                                 double target,
+                                                 double guess,
+                                                 BOOL isRadianMode,
+                                                 double *root,
+                                                 NSUInteger *_Nullable passCount);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Decimal Kernels
+
+
+/**
+ Perform a unary operator on a decimal operand. Percentage, x^2, x^3 and 1/x
+ are decimal, the other operators go through NIBPerformUnaryOperator.
+ 
+ @param operatorTag     The tag of the unary operator.
+ @param operand         The operand.
+ @param isRadianMode    YES if angles are in radian, NO if they are in degree.
+ 
+ @return Returns the result of the operator if it is successful, otherwise not
+ a number.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBPerformDecimalUnaryOperator(NIBButtonTag operatorTag, NIBDecimal128 operand, BOOL isRadianMode);
+
+/**
+ Perform a binary operator on two decimal operands. The four arithmetic
+ operators, the powers with an integer exponent and EE with an integer power
+ are decimal, the other operators go through NIBPerformBinaryOperator.
+ 
+ @param operatorTag     The tag of the binary operator.
+ @param leftOperand     The left operand.
+ @param rightOperand    The right operand.
+ 
+ @return Returns the result of the operator if it is successful, otherwise not
+ a number.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBPerformDecimalBinaryOperator(NIBButtonTag operatorTag, NIBDecimal128 leftOperand, NIBDecimal128 rightOperand);
+
+/**
+ Evaluate a postfix expression in decimal. The operands of the expression are
+ read as the shortest decimals of their doubles. A missing operand is handled
+ as NIBEvaluatePostfixExpression does.
+ 
+ @param postfixExp  The tokens of the postfix expression.
+ @param count       The number of tokens.
+ @param result      The result of the expression.
+ 
+ @return Returns YES if the expression has a result, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBEvaluateDecimalPostfixExpression(const NIBToken *_Nullable postfixExp,
+                                                           NSUInteger count,
+                                                           NIBDecimal128 *result);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,2366 @@
+//
+//  NIBCalculatorKernels.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBCalculatorKernels.h"
+#import "NIBCalculatorStack.h"
+#import "NIBInstrumentation.h"
+#import "NIBOperator.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/** Values to indicate which of trigonometric functions is used. */
+typedef NS_ENUM(NSUInteger, NIBTrigonometricFuntion) {
+    /** Trigonometric sine function. */
+    NIBTrigonometricSinFunction,
+    /** Trigonometric cosine function. */
+    NIBTrigonometricCosFunction,
+    /** Trigonometric tangent function. */
+    NIBTrigonometricTanFunction
+};
+
+/** Values to indicate which of hyperbolic functions is used. */
+typedef NS_ENUM(NSUInteger, NIBHyperbolicFunction) {
+    /** Hyperbolic sine function. */
+    NIBHyperbolicSineFunction,
+    /** Hyperbolic cosine function. */
+    NIBHyperbolicCosineFunction,
+    /** Hyperbolic tangent function. */
+    NIBHyperbolicTangentFunction
+};
+
+/** Values to indicate which of inverse trigonometricfunctions is used. */
+typedef NS_ENUM(NSUInteger, NIBInverseTrigonometricFuntion) {
+    /** Inverse trigonometric sine function. */
+    NIBInverseTrigonometricArcSinFunction,
+    /** Inverse trigonometric cosine function. */
+    NIBInverseTrigonometricArcCosFunction,
+    /** Inverse trigonometric tangent function. */
+    NIBInverseTrigonometricArcTanFunction
+};
+
+/** Values to indicate which of inversehyperbolic functions is used. */
+typedef NS_ENUM(NSUInteger, NIBInverseHyperbolicFunction) {
+    /** Inverse hyperbolic sine function. */
+    NIBInverseHyperbolicSineFunction,
+    /** Inverse hyperbolic sine function. */
+    NIBInverseHyperbolicCosineFunction,
+    /** Inverse hyperbolic sine function. */
+    NIBInverseHyperbolicTangentFunction
+};
+
+/** Values to indicate which of exponential functions is used. */
+typedef NS_ENUM(NSUInteger, NIBExponentialFunction) {
+    /** Exponential function of Euler number. */
+    NIBExponentialNaturalFunction,
+    /** Exponential function of ten. */
+    NIBExponentialDecimalFunction,
+    /** Exponential function of two. */
+    NIBExponentialBinaryFunction
+};
+
+
+/**
+ @struct Fraction.
+ 
+ @field numerator   Numerator of a fraction.
+ @field denominator Denominator of a fraction.
+ */
+typedef struct Fraction {
+    int_least64_t numerator;
+    int_least64_t denominator;
+} Fraction;
+
+/**
+ @struct FractionCache.
+ 
+ @field power       The power converted last.
+ @field fraction    The fraction of the power.
+ */
+typedef struct FractionCache {
+    double power;
+    Fraction fraction;
+} FractionCache;
+
+/**
+ @struct NIBUnaryMemoEntry.
+ 
+ @field operandBits The bits of the operand.
+ @field key         The operator and the modes of the result, 0 if the entry
+                    is empty.
+ @field result      The result of the operator on the operand.
+ */
+typedef struct NIBUnaryMemoEntry {
+    uint64_t operandBits;
+    uint32_t key;
+    double result;
+} NIBUnaryMemoEntry;
+
+/**
+ @struct NIBSolveProblem.
+ 
+ @field postfixExp          The tokens of the postfix expression to solve.
+ @field count               The number of tokens.
+ @field unknownIndex        The index of the unknown among the operands.
+ @field target              The value of the expression at the root.
+ @field isRadianMode        YES if angles are in radian, NO if they are in degree.
+ @field passCount           The number of evaluations of the expression.
+ @field negativePoint       The last unknown whose residual is negative, NAN if
+                            there is none.
+ @field negativeResidual    The residual at the negative point.
+ @field positivePoint       The last unknown whose residual is positive, NAN if
+                            there is none.
+ @field positiveResidual    The residual at the positive point.
+ */
+typedef struct NIBSolveProblem {
+    const NIBToken *postfixExp;
+    NSUInteger count;
+    NSUInteger unknownIndex;
+    double target;
+    BOOL isRadianMode;
+    NSUInteger passCount;
+    double negativePoint;
+    NIBDual negativeResidual;
+    double positivePoint;
+    NIBDual positiveResidual;
+} NIBSolveProblem;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** Calculation error of the calculator. */
+static const double NIB_CAL_ERROR = 0.000000000000001f; // 10^-15
+
+/** Max denominator using in the algorithm to convert a double number to fraction. */
+static const int_least64_t NIB_MAX_DENOMINATOR = INT_LEAST64_MAX;
+
+/** Approximation error using in the algorithm to convert a double number to fraction.  */
+static const double NIB_APPROX_ERROR = 0.0000000000001f;   // 10^-13
+
+/** The largest integer whose factorial is a finite double. */
+#define NIB_MAX_FACTORIAL_OPERAND 170
+
+/** The factorials 0! to 170!, each rounded to the nearest double. */
+static const double NIB_FACTORIALS[NIB_MAX_FACTORIAL_OPERAND + 1] = {
+    1.0, 1.0, 2.0, 6.0, 24.0, 120.0, 720.0, 5040.0, 40320.0, 362880.0, 3628800.0, 39916800.0,
+    479001600.0, 6227020800.0, 87178291200.0, 1307674368000.0, 20922789888000.0, 355687428096000.0,
+    6402373705728000.0, 1.21645100408832e+17, 2.43290200817664e+18, 5.109094217170944e+19,
+    1.1240007277776077e+21, 2.585201673888498e+22, 6.204484017332394e+23, 1.5511210043330986e+25,
+    4.0329146112660565e+26, 1.0888869450418352e+28, 3.0488834461171387e+29, 8.841761993739702e+30,
+    2.6525285981219107e+32, 8.222838654177922e+33, 2.631308369336935e+35, 8.683317618811886e+36,
+    2.9523279903960416e+38, 1.0333147966386145e+40, 3.7199332678990125e+41, 1.3763753091226346e+43,
+    5.230226174666011e+44, 2.0397882081197444e+46, 8.159152832478977e+47, 3.345252661316381e+49,
+    1.40500611775288e+51, 6.041526306337383e+52, 2.658271574788449e+54, 1.1962222086548019e+56,
+    5.502622159812089e+57, 2.5862324151116818e+59, 1.2413915592536073e+61, 6.082818640342675e+62,
+    3.0414093201713376e+64, 1.5511187532873822e+66, 8.065817517094388e+67, 4.2748832840600255e+69,
+    2.308436973392414e+71, 1.2696403353658276e+73, 7.109985878048635e+74, 4.0526919504877214e+76,
+    2.3505613312828785e+78, 1.3868311854568984e+80, 8.32098711274139e+81, 5.075802138772248e+83,
+    3.146997326038794e+85, 1.98260831540444e+87, 1.2688693218588417e+89, 8.247650592082472e+90,
+    5.443449390774431e+92, 3.647111091818868e+94, 2.4800355424368305e+96, 1.711224524281413e+98,
+    1.1978571669969892e+100, 8.504785885678623e+101, 6.1234458376886085e+103,
+    4.4701154615126844e+105, 3.307885441519386e+107, 2.48091408113954e+109, 1.8854947016660504e+111,
+    1.4518309202828587e+113, 1.1324281178206297e+115, 8.946182130782976e+116,
+    7.156945704626381e+118, 5.797126020747368e+120, 4.753643337012842e+122, 3.945523969720659e+124,
+    3.314240134565353e+126, 2.81710411438055e+128, 2.4227095383672734e+130, 2.107757298379528e+132,
+    1.8548264225739844e+134, 1.650795516090846e+136, 1.4857159644817615e+138,
+    1.352001527678403e+140, 1.2438414054641308e+142, 1.1567725070816416e+144,
+    1.087366156656743e+146, 1.032997848823906e+148, 9.916779348709496e+149, 9.619275968248212e+151,
+    9.426890448883248e+153, 9.332621544394415e+155, 9.332621544394415e+157, 9.42594775983836e+159,
+    9.614466715035127e+161, 9.90290071648618e+163, 1.0299016745145628e+166, 1.081396758240291e+168,
+    1.1462805637347084e+170, 1.226520203196138e+172, 1.324641819451829e+174,
+    1.4438595832024937e+176, 1.588245541522743e+178, 1.7629525510902446e+180,
+    1.974506857221074e+182, 2.2311927486598138e+184, 2.5435597334721877e+186,
+    2.925093693493016e+188, 3.393108684451898e+190, 3.969937160808721e+192, 4.684525849754291e+194,
+    5.574585761207606e+196, 6.689502913449127e+198, 8.094298525273444e+200, 9.875044200833601e+202,
+    1.214630436702533e+205, 1.506141741511141e+207, 1.882677176888926e+209, 2.372173242880047e+211,
+    3.0126600184576594e+213, 3.856204823625804e+215, 4.974504222477287e+217, 6.466855489220474e+219,
+    8.47158069087882e+221, 1.1182486511960043e+224, 1.4872707060906857e+226,
+    1.9929427461615188e+228, 2.6904727073180504e+230, 3.659042881952549e+232,
+    5.012888748274992e+234, 6.917786472619489e+236, 9.615723196941089e+238, 1.3462012475717526e+241,
+    1.898143759076171e+243, 2.695364137888163e+245, 3.854370717180073e+247, 5.5502938327393044e+249,
+    8.047926057471992e+251, 1.1749972043909107e+254, 1.727245890454639e+256,
+    2.5563239178728654e+258, 3.80892263763057e+260, 5.713383956445855e+262, 8.62720977423324e+264,
+    1.3113358856834524e+267, 2.0063439050956823e+269, 3.0897696138473508e+271,
+    4.789142901463394e+273, 7.471062926282894e+275, 1.1729568794264145e+278, 1.853271869493735e+280,
+    2.9467022724950384e+282, 4.7147236359920616e+284, 7.590705053947219e+286,
+    1.2296942187394494e+289, 2.0044015765453026e+291, 3.287218585534296e+293,
+    5.423910666131589e+295, 9.003691705778438e+297, 1.503616514864999e+300, 2.5260757449731984e+302,
+    4.269068009004705e+304, 7.257415615307999e+306
+};
+
+/** The largest magnitude of an integer power which is raised by squaring. */
+#define NIB_MAX_SQUARING_POWER 64
+
+/** The largest power of ten which is exact in a double. */
+#define NIB_MAX_EXACT_POWER_OF_TEN 22
+
+/** The powers of ten 10^0 to 10^22, each exact in a double. */
+static const double NIB_POWERS_OF_TEN[NIB_MAX_EXACT_POWER_OF_TEN + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/** The number of bits of the index of a set of the unary memo. */
+#define NIB_UNARY_MEMO_INDEX_BITS 8
+
+/** The number of entries of the unary memo of a thread, in sets of two. */
+#define NIB_UNARY_MEMO_SIZE (2 << NIB_UNARY_MEMO_INDEX_BITS)
+
+/** The step, relative to the unknown, below which the solver has converged. */
+static const double NIB_SOLVE_TOLERANCE = 4 * DBL_EPSILON;
+
+/** The residual, relative to the target, below which the solver accepts a root. */
+static const double NIB_SOLVE_RESIDUAL_TOLERANCE = 1e-9;
+
+/** The largest number of evaluations of the expression in a solve. */
+#define NIB_SOLVE_MAX_PASSES 200
+
+/** The largest number of halvings of a Newton step which does not decrease the residual. */
+#define NIB_SOLVE_MAX_HALVINGS 16
+
+/** The largest number of doublings of the distance from the guess in the search for a sign change. */
+#define NIB_SOLVE_MAX_SEARCH_STEPS 64
+
+/** The first distance from the guess in the search for a sign change, relative to the guess. */
+static const double NIB_SOLVE_SEARCH_WIDTH = 0.1;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Variables
+
+
+/** The fraction of the last power raised on a negative base, one for each thread. */
+static _Thread_local FractionCache NIBNegativeBasePowerCache = {NAN, {0, 0}};
+
+/** The unary memo, one for each thread. */
+static _Thread_local NIBUnaryMemoEntry NIBUnaryMemo[NIB_UNARY_MEMO_SIZE];
+
+/** The counters of the unary memo, one for each thread. */
+static _Thread_local NIBUnaryMemoStatistics NIBUnaryMemoCounters;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static double NIBPerformTrigonometricFunction(NIBTrigonometricFuntion, double, BOOL);
+static double NIBPerformHyperbolicFunction(NIBHyperbolicFunction, double);
+static double NIBPerformInverseTrigonometricFunction(NIBInverseTrigonometricFuntion, double, BOOL);
+static double NIBPerformInverseHyperbolicFunction(NIBInverseHyperbolicFunction, double);
+static double NIBPerformInverseFunction(double);
+static double NIBPerformFactorial(double);
+static double NIBPerformExponentialFunction(NIBExponentialFunction, double);
+static double NIBRaiseToIntegerPower(double, int_least64_t);
+static double NIBScaleByPowerOfTen(double, double);
+static double NIBPerformDegreeTrigonometricFunction(NIBTrigonometricFuntion, double);
+static double NIBSinOfReducedDegrees(double);
+static double NIBCosOfReducedDegrees(double);
+static double NIBTanOfReducedDegrees(double);
+static BOOL NIBIsOddMultiplicationOfPi_2(double);
+static double NIBRoundNumberWithCalculationError(double);
+static Fraction NIBFractionFromDouble(double);
+static Fraction NIBCachedFractionFromDouble(double);
+static BOOL NIBIsNegativeFraction(Fraction);
+static int_least64_t NIBGreatCommonDivisor(uint_least64_t, uint_least64_t);
+static BOOL NIBIsMemoizedUnaryOperator(NIBButtonTag, BOOL);
+static NSUInteger NIBUnaryMemoIndex(uint64_t, uint32_t);
+static double NIBDigamma(double);
+static double NIBDerivativeOfPower(NIBDual, NIBDual, double);
+static NIBDual NIBEvaluateSolveResidual(NIBSolveProblem *, double);
+static BOOL NIBIsSolveBracketed(const NIBSolveProblem *);
+static BOOL NIBTakeSolveNewtonSteps(NIBSolveProblem *, double *, NIBDual *);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Functional Kernels
+
+
+double NIBRaiseToPower(double power, double base) {
+    
+    /* if  a power is not a number or infinity or the base is not a number */
+    if (isnan(base) || isnan(power) || isinf(power)) {
+        return NAN;
+    }
+    
+    /* otherwise, power is a valid double */
+    double result = NAN;
+    
+    /* if the power is a small integer, raise by squaring */
+    if (power == round(power) && fabs(power) <= NIB_MAX_SQUARING_POWER) {
+        result = NIBRaiseToIntegerPower(base, (int_least64_t)power);
+    
+    /* if the power is another integer */
+    } else if (power == round(power)) {
+        result = pow(base, power);
+        
+    /* otherwise, the power is not an integer */
+    /* if the power is 1/3 -> cubic root */
+    } else if (power == 1.0/3) {
+        result = cbrt(base);
+        
+    /* if the base is not negative, the power does not need its fraction */
+    } else if (!(base < 0)) {
+        /* if the power is 1/2 -> square root */
+        if (power == 1.0/2) {
+            result = sqrt(fabs(base));
+        } else {
+            result = pow(fabs(base), power);
+        }
+        
+    /* otherwise, the base is negative and the sign of the root depends on the fraction of the power */
+    } else {
+        Fraction frac = NIBCachedFractionFromDouble(power);
+        
+        /* if the power is not rational */
+        if (frac.denominator == 0) {
+            result = NAN;
+            
+        /* otherwise, the power is rational */
+        // the root can not be calculated when the base is negative and
+        // the fraction has odd numerator and even denominator
+        } else if ((frac.numerator % 2) && !(frac.denominator % 2)) {
+            result = NAN;
+            
+        /* if the power is close to 1/3 -> cubic root */
+        } else if (frac.numerator == 1 && frac.denominator == 3) {
+            result = cbrt(base);
+            
+        /* if the numerator is odd */
+        } else if (frac.numerator % 2 != 0) {
+            // the pow(base, power) function can not calculate
+            // with negative number as base and double value as exponent.
+            // Result is -(|base|^(numerator/denominator))
+            result = -pow(fabs(base), (double)frac.numerator/frac.denominator);
+            
+        /* otherwise, the numerator of the fraction is even */
+        } else {
+            /* result is |base|^(numerator/denominator) */
+            result = pow(fabs(base), (double)frac.numerator/frac.denominator);
+        }
+    }
+    
+    
+    /* if result is infinity, result is not a number  */
+    if (isinf(result)) result = NAN;
+    
+    return result;
+}
+
+double NIBLogarithm(double operand, double base) {
+    double result = NAN;
+    
+    /* if an operand is zero or not a number or a base is not valid or not a number */
+    if (operand == 0 || isnan(operand) ||
+        base <= 0 || base == 1 || isnan(base)) {
+        
+        result = NAN;
+        
+    /* otherwise, the operand and a base is valid numbers */
+    /* if base is Euler number */
+    } else if (base == M_E) {
+        result = log(operand);
+        
+    /* if the base is 10 */
+    } else if (base == 10) {
+        result = log10(operand);
+        
+    /* if the base is 2 */
+    } else if (base == 2) {
+        result = log2(operand);
+        
+    /* otherwise, the base is another positive number */
+    } else {
+        result = log(operand)/log(base);
+    }
+    
+    return result;
+}
+
+double NIBLogarithmOfFactorial(double operand) {
+    double result = NAN;
+    
+    /* if an operand is not a number or the factorial is not positive */
+    if (isnan(operand) || operand <= -1) {
+        result = NAN;
+    
+    /* if the operand is an integer in the table, take the logarithm of the exact factorial */
+    } else if (operand == round(operand) && operand <= NIB_MAX_FACTORIAL_OPERAND) {
+        result = log(NIB_FACTORIALS[(NSUInteger)operand]);
+    
+    /* otherwise, ln(x!) = ln(Gamma(x + 1)), and Gamma(x + 1) is positive for x > -1 */
+    } else {
+        result = lgamma(operand + 1);
+    }
+    
+    return result;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Unary Kernels
+
+
+double NIBPerformUnaryOperator(NIBButtonTag operatorTag, double operand, BOOL isRadianMode) {
+    double result = NAN;
+    
+    switch (operatorTag) {
+        /* operator is percentage */
+        case NIBButtonPercentage:
+            result = operand/100;
+            break;
+        
+        /* operator is square root */
+        case NIBButtonSquareRootOfX:
+            result = NIBRaiseToPower((1.0/2), operand);
+            break;
+        
+        /* operator is cubic root */
+        case NIBButtonCubicRootOfX:
+            result = NIBRaiseToPower((1.0/3), operand);
+            break;
+        
+        /* operator is x^2 */
+        case NIBButtonXSquared:
+            result = NIBRaiseToPower(2.0, operand);
+            break;
+        
+        /* operator is x^3 */
+        case NIBButtonXCubed:
+            result = NIBRaiseToPower(3.0, operand);
+            break;
+        
+        /* operator is e^x */
+        case NIBButtonEulerNumberPowerX:
+            result = NIBPerformExponentialFunction(NIBExponentialNaturalFunction, operand);
+            break;
+        
+        /* operator is 10^x */
+        case NIBButtonTenPowerX:
+            result = NIBPerformExponentialFunction(NIBExponentialDecimalFunction, operand);
+            break;
+        
+        /* operator is 2^x */
+        case NIBButtonTwoPowerX:
+            result = NIBPerformExponentialFunction(NIBExponentialBinaryFunction, operand);
+            break;
+        
+        /* operator is sin */
+        case NIBButtonSin:
+            result = NIBPerformTrigonometricFunction(NIBTrigonometricSinFunction, operand, isRadianMode);
+            break;
+        
+        /* operator is cos */
+        case NIBButtonCos:
+            result = NIBPerformTrigonometricFunction(NIBTrigonometricCosFunction, operand, isRadianMode);
+            break;
+        
+        /* operator is tan */
+        case NIBButtonTan:
+            result = NIBPerformTrigonometricFunction(NIBTrigonometricTanFunction, operand, isRadianMode);
+            break;
+        
+        /* operator is sinh */
+        case NIBButtonSinh:
+            result = NIBPerformHyperbolicFunction(NIBHyperbolicSineFunction, operand);
+            break;
+        
+        /* operator is cosh */
+        case NIBButtonCosh:
+            result = NIBPerformHyperbolicFunction(NIBHyperbolicCosineFunction, operand);
+            break;
+        
+        /* operator is tanh */
+        case NIBButtonTanh:
+            result = NIBPerformHyperbolicFunction(NIBHyperbolicTangentFunction, operand);
+            break;
+        
+        /* operator is 1/x */
+        case NIBButtonOneOverX:
+            result = NIBPerformInverseFunction(operand);
+            break;
+        
+        /* operator is arcsin */
+        case NIBButtonArcSin:
+            result = NIBPerformInverseTrigonometricFunction(NIBInverseTrigonometricArcSinFunction, operand, isRadianMode);
+            break;
+        
+        /* operator is arccos */
+        case NIBButtonArcCos:
+            result = NIBPerformInverseTrigonometricFunction(NIBInverseTrigonometricArcCosFunction, operand, isRadianMode);
+            break;
+        
+        /* operator is arctan */
+        case NIBButtonArcTan:
+            result = NIBPerformInverseTrigonometricFunction(NIBInverseTrigonometricArcTanFunction, operand, isRadianMode);
+            break;
+        
+        /* operator is arcshinh */
+        case NIBButtonArcSinh:
+            result = NIBPerformInverseHyperbolicFunction(NIBInverseHyperbolicSineFunction, operand);
+            break;
+        
+        /* operator is arccosh */
+        case NIBButtonArcCosh:
+            result = NIBPerformInverseHyperbolicFunction(NIBInverseHyperbolicCosineFunction, operand);
+            break;
+        
+        /* operator is arctanh */
+        case NIBButtonArcTanh:
+            result = NIBPerformInverseHyperbolicFunction(NIBInverseHyperbolicTangentFunction, operand);
+            break;
+        
+        /* operator is ln */
+        case NIBButtonNaturalLogarithm:
+            result = NIBLogarithm(operand, M_E);
+            break;
+        
+        /* operator is log10 */
+        case NIBButtonCommonLogarithm:
+            result = NIBLogarithm(operand, 10);
+            break;
+        
+        /* operator is log2 */
+        case NIBButtonLogarithmBaseTwo:
+            result = NIBLogarithm(operand, 2);
+            break;
+        
+        /* operator is x! */
+        case NIBButtonXFactorial:
+            result = NIBPerformFactorial(operand);
+            break;
+        
+        /* default case, result is not a number to make the program fault-tolerance */
+        default:
+            result = NAN;
+            break;
+    }
+    
+    return result;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Memoized Unary Kernels
+
+
+double NIBPerformMemoizedUnaryOperator(NIBButtonTag operatorTag, double operand, BOOL isRadianMode, BOOL isDecimalMode) {
+    
+    /* if the operator is cheaper than the memo, perform it */
+    if (!NIBIsMemoizedUnaryOperator(operatorTag, isDecimalMode)) {
+        return NIBPerformUnaryOperator(operatorTag, operand, isRadianMode);
+    }
+    
+    // the operand is compared by its bits, so -0 and 0 are different keys and
+    // a NAN operand finds its own result, which a comparison of doubles misses
+    uint64_t operandBits = 0;
+    uint32_t key = ((uint32_t)operatorTag + 1) << 2 | (isRadianMode ? 2 : 0) | (isDecimalMode ? 1 : 0);
+    
+    memcpy(&operandBits, &operand, sizeof(operandBits));
+    
+    // an operand is kept in one of the two entries of its set, the entry used
+    // last first, so two operands of the same set do not evict each other
+    NIBUnaryMemoEntry *entries = &NIBUnaryMemo[NIBUnaryMemoIndex(operandBits, key) * 2];
+    
+    /* if the first entry holds the result, return it */
+    if (entries[0].key == key && entries[0].operandBits == operandBits) {
+        NIBUnaryMemoCounters.hitCount++;
+        return entries[0].result;
+    }
+    
+    NIBUnaryMemoEntry usedEntry = entries[0];
+    
+    /* if the second entry holds the result, move it first and return it */
+    if (entries[1].key == key && entries[1].operandBits == operandBits) {
+        entries[0] = entries[1];
+        entries[1] = usedEntry;
+        NIBUnaryMemoCounters.hitCount++;
+        
+        return entries[0].result;
+    }
+    
+    double result = NAN;
+    
+    /* if the operator is performed in decimal */
+    if (isDecimalMode) {
+        result = NIBDecimal128ToDouble(NIBPerformDecimalUnaryOperator(operatorTag, NIBDecimal128FromDouble(operand), isRadianMode));
+    
+    /* otherwise, the operator is performed in binary floating point */
+    } else {
+        result = NIBPerformUnaryOperator(operatorTag, operand, isRadianMode);
+    }
+    
+    /* keep the result first, the entry used last is moved second */
+    NIBUnaryMemoCounters.missCount++;
+    entries[1] = usedEntry;
+    entries[0] = (NIBUnaryMemoEntry){operandBits, key, result};
+    
+    return result;
+}
+
+NIBUnaryMemoStatistics NIBUnaryMemoStatisticsOfCurrentThread(void) {
+    return NIBUnaryMemoCounters;
+}
+
+void NIBResetUnaryMemoOfCurrentThread(void) {
+    memset(NIBUnaryMemo, 0, sizeof(NIBUnaryMemo));
+    NIBUnaryMemoCounters = (NIBUnaryMemoStatistics){0, 0};
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Binary Kernels
+
+
+double NIBPerformBinaryOperator(NIBButtonTag operatorTag, double leftOperand, double rightOperand) {
+    double result = NAN;
+    
+    switch (operatorTag) {
+        /* operator is division */
+        case NIBButtonDivision:
+            result = leftOperand/rightOperand;
+            
+            /* if the quotient is not a number or infinity, result is not a number */
+            if (isnan(result) || isinf(result)) result = NAN;
+            break;
+            
+        /* operator is multiplication */
+        case NIBButtonMultiplication:
+            result = leftOperand * rightOperand;
+            break;
+            
+        /* operator is substraction */
+        case NIBButtonSubstraction:
+            result = leftOperand - rightOperand;
+            break;
+            
+        /* operator is addition */
+        case NIBButtonAddition:
+            result = leftOperand + rightOperand;
+            break;
+            
+        /* operator is yth root */
+        case NIBButtonYthRootOfX:
+            result = NIBRaiseToPower(1.0/rightOperand, leftOperand);
+            break;
+            
+        /* operator is x^y */
+        case NIBButtonXPowerY:
+            result = NIBRaiseToPower(rightOperand, leftOperand);
+            break;
+            
+        /* operator is y^x */
+        case NIBButtonYPowerX:
+            result = NIBRaiseToPower(leftOperand, rightOperand);
+            break;
+            
+        /* operator is logy */
+        case NIBButtonLogarithmBaseYOfX:
+            result = NIBLogarithm(leftOperand, rightOperand);
+            break;
+            
+        /* operator is EE */
+        case NIBButtonEE:
+            result = NIBScaleByPowerOfTen(leftOperand, rightOperand);
+            
+            /* if calculation is infinity, result is not a number */
+            if (isinf(result)) result = NAN;
+            break;
+            
+        /* default case, result is not a number to make the program fault-tolerance */
+        default:
+            result = NAN;
+            break;
+    }
+    
+    return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Batch Kernels
+
+
+void NIBPerformUnaryOperatorOnOperands(NIBButtonTag operatorTag,
+                                       const double *operands,
+                                       double *results,
+                                       NSUInteger count,
+                                       BOOL isRadianMode) {
+    
+    // the operator is dispatched once for the whole batch. The operators
+    // without branches in their kernels get a straight loop which the
+    // compiler can vectorize, the others go through the scalar kernel.
+    switch (operatorTag) {
+        /* operator is percentage */
+        case NIBButtonPercentage:
+            for (NSUInteger i = 0; i < count; i++) {
+                results[i] = operands[i]/100;
+            }
+            break;
+        
+        /* operator is sinh, cosh, tanh */
+        case NIBButtonSinh:
+        case NIBButtonCosh:
+        case NIBButtonTanh:
+        {
+            double (*hyperbolicFunc)(double) = (operatorTag == NIBButtonSinh) ? sinh : (operatorTag == NIBButtonCosh) ? cosh : tanh;
+            
+            for (NSUInteger i = 0; i < count; i++) {
+                double result = hyperbolicFunc(operands[i]);
+                
+                /* if the result is infinity, result is not a number */
+                results[i] = isinf(result) ? NAN : result;
+            }
+            break;
+        }
+        
+        /* operator is sin, cos in radian, the angles in degree are reduced by the scalar kernel */
+        case NIBButtonSin:
+        case NIBButtonCos:
+        {
+            double (*trigFunc)(double) = (operatorTag == NIBButtonSin) ? sin : cos;
+            
+            for (NSUInteger i = 0; i < count && isRadianMode; i++) {
+                /* round the result with calculation error */
+                results[i] = NIBRoundNumberWithCalculationError(trigFunc(operands[i]));
+            }
+            
+            for (NSUInteger i = 0; i < count && !isRadianMode; i++) {
+                results[i] = NIBPerformUnaryOperator(operatorTag, operands[i], isRadianMode);
+            }
+            break;
+        }
+        
+        /* otherwise, perform the operator on each operand */
+        default:
+            for (NSUInteger i = 0; i < count; i++) {
+                results[i] = NIBPerformUnaryOperator(operatorTag, operands[i], isRadianMode);
+            }
+            break;
+    }
+}
+
+void NIBPerformBinaryOperatorOnOperands(NIBButtonTag operatorTag,
+                                        const double *leftOperands,
+                                        const double *rightOperands,
+                                        double *results,
+                                        NSUInteger count) {
+    
+    switch (operatorTag) {
+        /* operator is division */
+        case NIBButtonDivision:
+            for (NSUInteger i = 0; i < count; i++) {
+                double result = leftOperands[i]/rightOperands[i];
+                
+                /* if the quotient is infinity, result is not a number */
+                results[i] = isinf(result) ? NAN : result;
+            }
+            break;
+        
+        /* operator is multiplication */
+        case NIBButtonMultiplication:
+            for (NSUInteger i = 0; i < count; i++) {
+                results[i] = leftOperands[i] * rightOperands[i];
+            }
+            break;
+        
+        /* operator is substraction */
+        case NIBButtonSubstraction:
+            for (NSUInteger i = 0; i < count; i++) {
+                results[i] = leftOperands[i] - rightOperands[i];
+            }
+            break;
+        
+        /* operator is addition */
+        case NIBButtonAddition:
+            for (NSUInteger i = 0; i < count; i++) {
+                results[i] = leftOperands[i] + rightOperands[i];
+            }
+            break;
+        
+        /* otherwise, perform the operator on each pair of operands */
+        default:
+            for (NSUInteger i = 0; i < count; i++) {
+                results[i] = NIBPerformBinaryOperator(operatorTag, leftOperands[i], rightOperands[i]);
+            }
+            break;
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Postfix Evaluation
+
+
+BOOL NIBEvaluatePostfixExpression(const NIBToken *postfixExp,
+                                  NSUInteger count,
+                                  const double *operands,
+                                  double *stack,
+                                  double *result) {
+    NIBDoubleStack providedStack;
+    double *calStack = stack;
+    NSUInteger depth = 0;
+    NSUInteger operandIdx = 0;
+    
+    // every token pushes at most one value to the calculation stack, so the
+    // stack never holds more values than the number of tokens and it grows
+    // once, beyond its inline storage, before the evaluation
+    if (calStack == NULL) {
+        NIBDoubleStackInit(&providedStack);
+        NIBDoubleStackReserve(&providedStack, count);
+        calStack = NIBDoubleStackValues(&providedStack);
+    }
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        NIBToken token = postfixExp[i];
+        
+        /* if token is number, push to calculation stack */
+        if (token.kind == NIBTokenKindOperand) {
+            calStack[depth++] = (operands != NULL) ? operands[operandIdx++] : token.operand;
+            continue;
+        }
+        
+        /* if token is not a binary operator, push not a number to calculation stack to make the program fault-tolerance */
+        if (!NIBIsBinaryOperatorTag(token.tag)) {
+            calStack[depth++] = NAN;
+            continue;
+        }
+        
+        /* otherwise, token is a binary operator, a missing operand is not a number */
+        double rightOperand = (depth > 0) ? calStack[--depth] : NAN;
+        double leftOperand = NAN;
+        
+        if (depth > 0) {
+            leftOperand = calStack[--depth];
+            
+        /* if there is no first summand, the sole summand is the sum */
+        } else if (token.tag == NIBButtonAddition) {
+            leftOperand = 0;
+        }
+        
+        /* push result to calculation stack */
+        calStack[depth++] = NIBPerformBinaryOperator(token.tag, leftOperand, rightOperand);
+    }
+    
+    /* if the calculation stack is not empty, the result is on the top */
+    BOOL hasResult = (depth > 0);
+    
+    if (hasResult) *result = calStack[depth - 1];
+    
+    /* release the calculation stack if it was provided */
+    if (calStack != stack) NIBDoubleStackFree(&providedStack);
+    
+    return hasResult;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Dual Kernels
+
+
+NIBDual NIBPerformDualUnaryOperator(NIBButtonTag operatorTag, NIBDual operand, BOOL isRadianMode) {
+    double x = operand.value;
+    double value = NIBPerformUnaryOperator(operatorTag, x, isRadianMode);
+    
+    /* if the result is not a number, neither is its derivative */
+    if (isnan(value)) {
+        return NIBDualMake(NAN, NAN);
+    }
+    
+    /* if the operand does not depend on the unknown, neither does the result */
+    if (operand.derivative == 0) {
+        return NIBDualMake(value, 0);
+    }
+    
+    // an angle in degree is angleScale radians, so the derivatives of the
+    // trigonometric functions are scaled by it and the ones of their inverses
+    // are divided by it
+    double angleScale = isRadianMode ? 1 : M_PI/180;
+    double slope = NAN;
+    
+    switch (operatorTag) {
+        /* operator is percentage */
+        case NIBButtonPercentage:
+            slope = 1.0/100;
+            break;
+        
+        /* operator is square root */
+        case NIBButtonSquareRootOfX:
+            slope = 1/(2*value);
+            break;
+        
+        /* operator is cubic root */
+        case NIBButtonCubicRootOfX:
+            slope = 1/(3*value*value);
+            break;
+        
+        /* operator is x^2 */
+        case NIBButtonXSquared:
+            slope = 2*x;
+            break;
+        
+        /* operator is x^3 */
+        case NIBButtonXCubed:
+            slope = 3*x*x;
+            break;
+        
+        /* operator is e^x */
+        case NIBButtonEulerNumberPowerX:
+            slope = value;
+            break;
+        
+        /* operator is 10^x */
+        case NIBButtonTenPowerX:
+            slope = value*M_LN10;
+            break;
+        
+        /* operator is 2^x */
+        case NIBButtonTwoPowerX:
+            slope = value*M_LN2;
+            break;
+        
+        /* operator is sin, the cosine comes from the kernel so it is exact at the special angles */
+        case NIBButtonSin:
+            slope = NIBPerformUnaryOperator(NIBButtonCos, x, isRadianMode)*angleScale;
+            break;
+        
+        /* operator is cos */
+        case NIBButtonCos:
+            slope = -NIBPerformUnaryOperator(NIBButtonSin, x, isRadianMode)*angleScale;
+            break;
+        
+        /* operator is tan */
+        case NIBButtonTan:
+            slope = (1 + value*value)*angleScale;
+            break;
+        
+        /* operator is sinh */
+        case NIBButtonSinh:
+            slope = cosh(x);
+            break;
+        
+        /* operator is cosh */
+        case NIBButtonCosh:
+            slope = sinh(x);
+            break;
+        
+        /* operator is tanh */
+        case NIBButtonTanh:
+            slope = 1 - value*value;
+            break;
+        
+        /* operator is 1/x */
+        case NIBButtonOneOverX:
+            slope = -value*value;
+            break;
+        
+        /* operator is arcsin */
+        case NIBButtonArcSin:
+            slope = 1/sqrt(1 - x*x)/angleScale;
+            break;
+        
+        /* operator is arccos */
+        case NIBButtonArcCos:
+            slope = -1/sqrt(1 - x*x)/angleScale;
+            break;
+        
+        /* operator is arctan */
+        case NIBButtonArcTan:
+            slope = 1/(1 + x*x)/angleScale;
+            break;
+        
+        /* operator is arcsinh */
+        case NIBButtonArcSinh:
+            slope = 1/sqrt(x*x + 1);
+            break;
+        
+        /* operator is arccosh */
+        case NIBButtonArcCosh:
+            slope = 1/sqrt(x*x - 1);
+            break;
+        
+        /* operator is arctanh */
+        case NIBButtonArcTanh:
+            slope = 1/(1 - x*x);
+            break;
+        
+        /* operator is ln */
+        case NIBButtonNaturalLogarithm:
+            slope = 1/x;
+            break;
+        
+        /* operator is log10 */
+        case NIBButtonCommonLogarithm:
+            slope = 1/(x*M_LN10);
+            break;
+        
+        /* operator is log2 */
+        case NIBButtonLogarithmBaseTwo:
+            slope = 1/(x*M_LN2);
+            break;
+        
+        /* operator is x!, the derivative of Gamma(x + 1) is Gamma(x + 1)*digamma(x + 1) */
+        case NIBButtonXFactorial:
+            slope = value*NIBDigamma(x + 1);
+            break;
+        
+        /* default case, the derivative is not a number */
+        default:
+            slope = NAN;
+            break;
+    }
+    
+    return NIBDualMake(value, slope*operand.derivative);
+}
+
+NIBDual NIBPerformDualBinaryOperator(NIBButtonTag operatorTag, NIBDual leftOperand, NIBDual rightOperand) {
+    double value = NIBPerformBinaryOperator(operatorTag, leftOperand.value, rightOperand.value);
+    
+    /* if the result is not a number, neither is its derivative */
+    if (isnan(value)) {
+        return NIBDualMake(NAN, NAN);
+    }
+    
+    /* if no operand depends on the unknown, neither does the result */
+    if (leftOperand.derivative == 0 && rightOperand.derivative == 0) {
+        return NIBDualMake(value, 0);
+    }
+    
+    double derivative = NAN;
+    
+    switch (operatorTag) {
+        /* operator is division */
+        case NIBButtonDivision:
+            derivative = (leftOperand.derivative - value*rightOperand.derivative)/rightOperand.value;
+            break;
+        
+        /* operator is multiplication */
+        case NIBButtonMultiplication:
+            derivative = leftOperand.derivative*rightOperand.value + leftOperand.value*rightOperand.derivative;
+            break;
+        
+        /* operator is substraction */
+        case NIBButtonSubstraction:
+            derivative = leftOperand.derivative - rightOperand.derivative;
+            break;
+        
+        /* operator is addition */
+        case NIBButtonAddition:
+            derivative = leftOperand.derivative + rightOperand.derivative;
+            break;
+        
+        /* operator is yth root, the power is 1/y */
+        case NIBButtonYthRootOfX: {
+            NIBDual power = NIBDualMake(1/rightOperand.value,
+                                        -rightOperand.derivative/(rightOperand.value*rightOperand.value));
+            derivative = NIBDerivativeOfPower(leftOperand, power, value);
+            break;
+        }
+        
+        /* operator is x^y */
+        case NIBButtonXPowerY:
+            derivative = NIBDerivativeOfPower(leftOperand, rightOperand, value);
+            break;
+        
+        /* operator is y^x */
+        case NIBButtonYPowerX:
+            derivative = NIBDerivativeOfPower(rightOperand, leftOperand, value);
+            break;
+        
+        /* operator is logy, log_y(x) = ln(x)/ln(y) */
+        case NIBButtonLogarithmBaseYOfX:
+            derivative = (leftOperand.derivative/leftOperand.value - value*rightOperand.derivative/rightOperand.value)/log(rightOperand.value);
+            break;
+        
+        /* operator is EE, x*10^y */
+        case NIBButtonEE:
+            derivative = 0;
+            
+            if (leftOperand.derivative != 0) derivative += leftOperand.derivative*NIBScaleByPowerOfTen(1, rightOperand.value);
+            if (rightOperand.derivative != 0) derivative += value*M_LN10*rightOperand.derivative;
+            break;
+        
+        /* default case, the derivative is not a number */
+        default:
+            derivative = NAN;
+            break;
+    }
+    
+    return NIBDualMake(value, derivative);
+}
+
+BOOL NIBEvaluateDualPostfixExpression(const NIBToken *postfixExp,
+                                      NSUInteger count,
+                                      NSUInteger unknownIndex,
+                                      double unknown,
+                                      BOOL isRadianMode,
+                                      NIBDual *result) {
+    NIBDual inlineStack[NIB_STACK_INLINE_CAPACITY];
+    NIBDual *calStack = (count <= NIB_STACK_INLINE_CAPACITY) ? inlineStack : malloc(count * sizeof(NIBDual));
+    NSUInteger depth = 0;
+    NSUInteger operandIdx = 0;
+    
+    /* if the calculation stack can not be allocated */
+    if (calStack == NULL) {
+        [NSException raise:NSMallocException format:@"Can not allocate calculation stack of %lu dual numbers", (unsigned long)count];
+    }
+    
+    if (calStack != inlineStack) {
+        NIB_COUNT_ALLOCATION(NIBInstrumentationAllocationEvaluationStack, count * sizeof(NIBDual));
+    }
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        NIBToken token = postfixExp[i];
+        
+        /* if token is number, push it to calculation stack, the unknown with a unit derivative */
+        if (token.kind == NIBTokenKindOperand) {
+            calStack[depth++] = (operandIdx++ == unknownIndex) ? NIBDualMake(unknown, 1) : NIBDualMake(token.operand, 0);
+            continue;
+        }
+        
+        /* if token is an unary operator, perform it on the top of calculation stack */
+        if (NIBIsUnaryOperatorTag(token.tag)) {
+            NIBDual operand = (depth > 0) ? calStack[--depth] : NIBDualMake(NAN, NAN);
+            
+            calStack[depth++] = NIBPerformDualUnaryOperator(token.tag, operand, isRadianMode);
+            continue;
+        }
+        
+        /* if token is not a binary operator, push not a number to calculation stack to make the program fault-tolerance */
+        if (!NIBIsBinaryOperatorTag(token.tag)) {
+            calStack[depth++] = NIBDualMake(NAN, NAN);
+            continue;
+        }
+        
+        /* otherwise, token is a binary operator, a missing operand is not a number */
+        NIBDual rightOperand = (depth > 0) ? calStack[--depth] : NIBDualMake(NAN, NAN);
+        NIBDual leftOperand = NIBDualMake(NAN, NAN);
+        
+        if (depth > 0) {
+            leftOperand = calStack[--depth];
+        
+        /* if there is no first summand, the sole summand is the sum */
+        } else if (token.tag == NIBButtonAddition) {
+            leftOperand = NIBDualMake(0, 0);
+        }
+        
+        /* push result to calculation stack */
+        calStack[depth++] = NIBPerformDualBinaryOperator(token.tag, leftOperand, rightOperand);
+    }
+    
+    /* if the calculation stack is not empty, the result is on the top */
+    BOOL hasResult = (depth > 0);
+    
+    if (hasResult) *result = calStack[depth - 1];
+    
+    /* release the calculation stack if it was allocated */
+    if (calStack != inlineStack) free(calStack);
+    
+    return hasResult;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Solver
+
+
+BOOL NIBSolvePostfixExpression(const NIBToken *postfixExp,
+                               NSUInteger count,
+                               NSUInteger unknownIndex,
+                               double target,
+                               double guess,
+                               BOOL isRadianMode,
+                               double *root,
+                               NSUInteger *passCount) {
+    NIBSolveProblem problem = {postfixExp, count, unknownIndex, target, isRadianMode, 0, NAN, {NAN, NAN}, NAN, {NAN, NAN}};
+    double x = guess;
+    NIBDual residual = NIBEvaluateSolveResidual(&problem, x);
+    double startResidual = fabs(residual.value);
+    BOOL isConverged = (residual.value == 0);
+    
+    // if the Newton steps stall or the guess is not in the domain, search for
+    // a sign change of the residual on both sides of the guess at doubling
+    // distances, and take Newton steps again from a sample whose residual is
+    // smaller than at the point they stalled
+    double width = fmax(fabs(guess)*NIB_SOLVE_SEARCH_WIDTH, NIB_SOLVE_SEARCH_WIDTH);
+    NSUInteger searchStep = 0;
+    BOOL isRestarted = YES;
+    
+    while (isRestarted && !isConverged && !NIBIsSolveBracketed(&problem)) {
+        isConverged = NIBTakeSolveNewtonSteps(&problem, &x, &residual);
+        isRestarted = NO;
+        
+        double stallResidual = isnan(residual.value) ? INFINITY : fabs(residual.value);
+        
+        for (; searchStep < NIB_SOLVE_MAX_SEARCH_STEPS && !isRestarted && !isConverged && !NIBIsSolveBracketed(&problem) && problem.passCount < NIB_SOLVE_MAX_PASSES; searchStep++) {
+            for (int side = -1; side <= 1 && !isRestarted && !isConverged; side += 2) {
+                double sampleX = guess + side*width;
+                NIBDual sample = NIBEvaluateSolveResidual(&problem, sampleX);
+                
+                /* if the sample is a root */
+                if (sample.value == 0) {
+                    x = sampleX;
+                    residual = sample;
+                    isConverged = YES;
+                
+                /* if the residual of the sample is smaller, take Newton steps from it */
+                } else if (fabs(sample.value) < stallResidual) {
+                    x = sampleX;
+                    residual = sample;
+                    isRestarted = YES;
+                }
+            }
+            
+            width *= 2;
+        }
+    }
+    
+    /* if the root is bracketed, start from the end with the smaller residual */
+    if (!isConverged && NIBIsSolveBracketed(&problem)) {
+        BOOL isNegativeCloser = (fabs(problem.negativeResidual.value) < fabs(problem.positiveResidual.value));
+        
+        x = isNegativeCloser ? problem.negativePoint : problem.positivePoint;
+        residual = isNegativeCloser ? problem.negativeResidual : problem.positiveResidual;
+    }
+    
+    // Newton steps safeguarded by bisection: a step which leaves the bracket or
+    // does not halve the step before the last one is replaced by bisection,
+    // and every point replaces the end of the bracket whose residual has its sign
+    double step = fabs(problem.positivePoint - problem.negativePoint);
+    double lastStep = step;
+    
+    while (!isConverged && NIBIsSolveBracketed(&problem) && problem.passCount < NIB_SOLVE_MAX_PASSES) {
+        double low = fmin(problem.negativePoint, problem.positivePoint);
+        double high = fmax(problem.negativePoint, problem.positivePoint);
+        double newtonX = x - residual.value/residual.derivative;
+        double stepBeforeLast = lastStep;
+        
+        lastStep = step;
+        
+        /* if the Newton step stays in the bracket and converges fast enough, take it */
+        if (newtonX > low && newtonX < high && fabs(2*(newtonX - x)) <= fabs(stepBeforeLast)) {
+            step = newtonX - x;
+            x = newtonX;
+        
+        /* otherwise, bisect the bracket */
+        } else {
+            step = (high - low)/2;
+            x = low + step;
+        }
+        
+        residual = NIBEvaluateSolveResidual(&problem, x);
+        isConverged = (residual.value == 0 || fabs(step) <= NIB_SOLVE_TOLERANCE * fmax(fabs(x), DBL_MIN));
+        
+        /* if the residual is not a number, the bracket holds a hole of the domain */
+        if (isnan(residual.value)) break;
+    }
+    
+    // a point the steps converge to is a root if its residual is small, either
+    // against the target or against the rounding error of the unknown, and not
+    // larger than at the guess, so a pole the bracket shrinks to is not a root
+    double absResidual = fabs(residual.value);
+    BOOL isRoot = (isConverged &&
+                   isfinite(x) &&
+                   isfinite(residual.value) &&
+                   (isnan(startResidual) || absResidual <= startResidual) &&
+                   (absResidual <= NIB_SOLVE_RESIDUAL_TOLERANCE * fmax(1, fabs(target)) ||
+                    absResidual <= 8 * fabs(residual.derivative * x) * DBL_EPSILON));
+    
+    *root = isRoot ? x : NAN;
+    
+    if (passCount != NULL) *passCount = problem.passCount;
+    
+    return isRoot;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Decimal Kernels
+
+
+NIBDecimal128 NIBPerformDecimalUnaryOperator(NIBButtonTag operatorTag, NIBDecimal128 operand, BOOL isRadianMode) {
+    NIBDecimal128 result;
+    
+    switch (operatorTag) {
+        /* operator is percentage */
+        case NIBButtonPercentage:
+            result = NIBDecimal128ScaleByPowerOfTen(operand, -2);
+            break;
+        
+        /* operator is x^2 */
+        case NIBButtonXSquared:
+            result = NIBDecimal128Multiply(operand, operand);
+            break;
+        
+        /* operator is x^3 */
+        case NIBButtonXCubed:
+            result = NIBDecimal128RaiseToIntegerPower(operand, 3);
+            break;
+        
+        /* operator is 1/x */
+        case NIBButtonOneOverX:
+            result = NIBDecimal128Divide(NIBDecimal128Make(1, 0, NO), operand);
+            break;
+        
+        /* otherwise, the operator has no decimal kernel, perform it on the double */
+        default:
+            result = NIBDecimal128FromDouble(NIBPerformUnaryOperator(operatorTag, NIBDecimal128ToDouble(operand), isRadianMode));
+            break;
+    }
+    
+    return result;
+}
+
+NIBDecimal128 NIBPerformDecimalBinaryOperator(NIBButtonTag operatorTag, NIBDecimal128 leftOperand, NIBDecimal128 rightOperand) {
+    int64_t integer = 0;
+    
+    switch (operatorTag) {
+        /* operator is division */
+        case NIBButtonDivision:
+            return NIBDecimal128Divide(leftOperand, rightOperand);
+        
+        /* operator is multiplication */
+        case NIBButtonMultiplication:
+            return NIBDecimal128Multiply(leftOperand, rightOperand);
+        
+        /* operator is substraction */
+        case NIBButtonSubstraction:
+            return NIBDecimal128Subtract(leftOperand, rightOperand);
+        
+        /* operator is addition */
+        case NIBButtonAddition:
+            return NIBDecimal128Add(leftOperand, rightOperand);
+        
+        /* operator is x^y, if y is an integer */
+        case NIBButtonXPowerY:
+            if (NIBDecimal128GetInteger(rightOperand, &integer)) {
+                return NIBDecimal128RaiseToIntegerPower(leftOperand, integer);
+            }
+            break;
+        
+        /* operator is y^x, if x is an integer */
+        case NIBButtonYPowerX:
+            if (NIBDecimal128GetInteger(leftOperand, &integer)) {
+                return NIBDecimal128RaiseToIntegerPower(rightOperand, integer);
+            }
+            break;
+        
+        /* operator is EE, if the power is an integer */
+        case NIBButtonEE:
+            if (NIBDecimal128GetInteger(rightOperand, &integer)) {
+                return NIBDecimal128ScaleByPowerOfTen(leftOperand, integer);
+            }
+            break;
+        
+        default:
+            break;
+    }
+    
+    /* otherwise, the operator has no decimal kernel, perform it on the doubles */
+    double result = NIBPerformBinaryOperator(operatorTag,
+                                             NIBDecimal128ToDouble(leftOperand),
+                                             NIBDecimal128ToDouble(rightOperand));
+    
+    return NIBDecimal128FromDouble(result);
+}
+
+BOOL NIBEvaluateDecimalPostfixExpression(const NIBToken *postfixExp, NSUInteger count, NIBDecimal128 *result) {
+    NIBDecimal128 inlineStack[NIB_STACK_INLINE_CAPACITY];
+    NIBDecimal128 *calStack = (count <= NIB_STACK_INLINE_CAPACITY) ? inlineStack : malloc(count * sizeof(NIBDecimal128));
+    NSUInteger depth = 0;
+    
+    /* if the calculation stack can not be allocated */
+    if (calStack == NULL) {
+        [NSException raise:NSMallocException format:@"Can not allocate calculation stack of %lu decimals", (unsigned long)count];
+    }
+    
+    if (calStack != inlineStack) {
+        NIB_COUNT_ALLOCATION(NIBInstrumentationAllocationEvaluationStack, count * sizeof(NIBDecimal128));
+    }
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        NIBToken token = postfixExp[i];
+        
+        /* if token is number, push its decimal to calculation stack */
+        if (token.kind == NIBTokenKindOperand) {
+            calStack[depth++] = NIBDecimal128FromDouble(token.operand);
+            continue;
+        }
+        
+        /* if token is not a binary operator, push not a number to calculation stack to make the program fault-tolerance */
+        if (!NIBIsBinaryOperatorTag(token.tag)) {
+            calStack[depth++] = NIBDecimal128NotANumber();
+            continue;
+        }
+        
+        /* otherwise, token is a binary operator, a missing operand is not a number */
+        NIBDecimal128 rightOperand = (depth > 0) ? calStack[--depth] : NIBDecimal128NotANumber();
+        NIBDecimal128 leftOperand = NIBDecimal128NotANumber();
+        
+        if (depth > 0) {
+            leftOperand = calStack[--depth];
+        
+        /* if there is no first summand, the sole summand is the sum */
+        } else if (token.tag == NIBButtonAddition) {
+            leftOperand = NIBDecimal128Make(0, 0, NO);
+        }
+        
+        /* push result to calculation stack */
+        calStack[depth++] = NIBPerformDecimalBinaryOperator(token.tag, leftOperand, rightOperand);
+    }
+    
+    /* if the calculation stack is not empty, the result is on the top */
+    BOOL hasResult = (depth > 0);
+    
+    if (hasResult) *result = calStack[depth - 1];
+    
+    /* release the calculation stack if it was allocated */
+    if (calStack != inlineStack) free(calStack);
+    
+    return hasResult;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Perform trigonometric functions on an operand.
+ 
+ @param trigonometricFunction   The trigonometric functions defined
+                                in NIBTrigonometricFuntion.
+ @param operand                 The operand to perform trigonometric functions.
+ @param isRadianMode            YES if the operand is in radian, NO if it is in
+                                degree.
+ 
+ @return Returns the result of the trigonometric function if it is successful,
+ otherwise NAN.
+ */
+static double NIBPerformTrigonometricFunction(NIBTrigonometricFuntion trigonometricFunction, double operand, BOOL isRadianMode) {
+    double angle = operand;
+    
+    /* if the anlge is not a number, return not a number */
+    if (isnan(angle)) {
+        return NAN;
+    }
+    
+    /* if the angle is in degree, it is reduced exactly and needs no rounding */
+    if (!isRadianMode) {
+        return NIBPerformDegreeTrigonometricFunction(trigonometricFunction, angle);
+    }
+    
+    /* otherwise, the angle is a number in radian */
+    double result = NAN;
+    
+    switch (trigonometricFunction) {
+        /* calculate sin function */
+        case NIBTrigonometricSinFunction:
+            result = sin(angle);
+            break;
+        
+        /* calculate cos function */
+        case NIBTrigonometricCosFunction:
+            result = cos(angle);
+            break;
+        
+        /* calculate tan function */
+        case NIBTrigonometricTanFunction:
+            /* if the angle is pi/2, 3*pi/2, 5*pi/2, ... */
+            if (NIBIsOddMultiplicationOfPi_2(angle)) {
+                result = NAN;
+            } else {
+                result = tan(angle);
+            }
+            break;
+        
+        /* default case, return not a number to make the program fault-tolerance */
+        default:
+            result = NAN;
+            break;
+    }
+    
+    // pi is not a double, so the functions of the multiplications of pi/2
+    // are not exact. Round the result with calculation error
+    return NIBRoundNumberWithCalculationError(result);
+}
+
+/**
+ Perform trigonometric functions on an angle in degree. The angle is reduced to
+ a quadrant and an angle from -45 to 45 degrees without error, so every angle
+ costs the same and the multiplications of 90 degrees have exact results.
+ 
+ @param trigonometricFunction   The trigonometric function defined in
+                                NIBTrigonometricFuntion.
+ @param angle                   The angle in degree.
+ 
+ @return Returns the result of the trigonometric function if it is successful,
+ otherwise NAN.
+ */
+static double NIBPerformDegreeTrigonometricFunction(NIBTrigonometricFuntion trigonometricFunction, double angle) {
+    
+    /* if the angle is infinity, it has no trigonometric function */
+    if (isinf(angle)) {
+        return NAN;
+    }
+    
+    // fmod is exact, and the reduced angle minus its nearest multiplication of
+    // 90 is exact too because both are within a factor of two of each other
+    double reducedAngle = fmod(fabs(angle), 360.0);
+    double quadrant = nearbyint(reducedAngle / 90.0);
+    double quadrantAngle = reducedAngle - 90.0 * quadrant;
+    BOOL isOddQuadrant = (quadrant == 1 || quadrant == 3);
+    BOOL isNegative = (quadrant == 2 || quadrant == 3);
+    double result = NAN;
+    
+    switch (trigonometricFunction) {
+        /* calculate sin function, sin(x + 90) = cos(x), sin(x + 180) = -sin(x) */
+        case NIBTrigonometricSinFunction:
+            result = isOddQuadrant ? NIBCosOfReducedDegrees(quadrantAngle) : NIBSinOfReducedDegrees(quadrantAngle);
+            result = isNegative ? -result : result;
+            
+            /* sin is odd */
+            if (angle < 0) result = -result;
+            break;
+        
+        /* calculate cos function, cos(x + 90) = -sin(x), cos(x + 180) = -cos(x) */
+        case NIBTrigonometricCosFunction:
+            result = isOddQuadrant ? -NIBSinOfReducedDegrees(quadrantAngle) : NIBCosOfReducedDegrees(quadrantAngle);
+            result = isNegative ? -result : result;
+            break;
+        
+        /* calculate tan function, tan(x + 90) = -1/tan(x), tan(x + 180) = tan(x) */
+        case NIBTrigonometricTanFunction:
+            /* if the angle is 90, 270, 450, ... */
+            if (isOddQuadrant && quadrantAngle == 0) {
+                result = NAN;
+            } else {
+                result = isOddQuadrant ? -1 / NIBTanOfReducedDegrees(quadrantAngle) : NIBTanOfReducedDegrees(quadrantAngle);
+                
+                /* tan is odd */
+                if (angle < 0) result = -result;
+            }
+            break;
+        
+        /* default case, return not a number to make the program fault-tolerance */
+        default:
+            result = NAN;
+            break;
+    }
+    
+    /* the zeros of the multiplications of 180 degrees are positive */
+    return (result == 0) ? 0 : result;
+}
+
+/**
+ Find sin of an angle from -45 to 45 degrees.
+ 
+ @param angle   The angle in degree.
+ 
+ @return Returns sin of the angle, exact for 0 and 30 degrees.
+ */
+static double NIBSinOfReducedDegrees(double angle) {
+    
+    /* if the angle is 0 or 30 degrees, sin is exact */
+    if (angle == 0 || fabs(angle) == 30) {
+        return angle / 60;
+    }
+    
+    return sin(angle*M_PI/180);
+}
+
+/**
+ Find cos of an angle from -45 to 45 degrees.
+ 
+ @param angle   The angle in degree.
+ 
+ @return Returns cos of the angle, exact for 0 degree.
+ */
+static double NIBCosOfReducedDegrees(double angle) {
+    
+    /* if the angle is 0 degree, cos is exact */
+    if (angle == 0) {
+        return 1;
+    }
+    
+    return cos(angle*M_PI/180);
+}
+
+/**
+ Find tan of an angle from -45 to 45 degrees.
+ 
+ @param angle   The angle in degree.
+ 
+ @return Returns tan of the angle, exact for 0 and 45 degrees.
+ */
+static double NIBTanOfReducedDegrees(double angle) {
+    
+    /* if the angle is 0 or 45 degrees, tan is exact */
+    if (angle == 0 || fabs(angle) == 45) {
+        return angle / 45;
+    }
+    
+    return tan(angle*M_PI/180);
+}
+
+/**
+ Perform hyperbolic functions on an operand.
+ 
+ @param hyperbolicFunction  The hyperbolic functions defined
+                            in NIBHyperbolicFunction.
+ @param operand             The operand to perform hyperbolic functions.
+ 
+ @return Returns the result of the hyperbolic function if it is successful,
+ otherwise NAN.
+ */
+static double NIBPerformHyperbolicFunction(NIBHyperbolicFunction hyperbolicFunction, double operand) {
+    
+    /* if the operand is not a number, return not a number */
+    if (isnan(operand)) {
+        return NAN;
+    }
+    
+    /* otherwise the operand is a number */
+    double result = NAN;
+    
+    switch (hyperbolicFunction) {
+        /* calculate hyperbolic sine function */
+        case NIBHyperbolicSineFunction:
+            result = sinh(operand);
+            break;
+        
+        /* calculate hyperbolic cosine function */
+        case NIBHyperbolicCosineFunction:
+            result = cosh(operand);
+            break;
+        
+        /* calculate hyperbolic tangent function */
+        case NIBHyperbolicTangentFunction:
+            result = tanh(operand);
+            break;
+        
+        /* default case, return not a number to make the program fault-tolerance */
+        default:
+            result = NAN;
+            break;
+    }
+    
+    /* if the result is infinity, result is not a number */
+    if (isinf(result)) result = NAN;
+    
+    return result;
+}
+
+/**
+ Perform inverse trigonometric functions of an operand.
+ 
+ @param inverseTrigFunc The inverse trigonometric functions
+                        defined in NIBInverseTrigonometricFunction.
+ @param operand         The operand to perform trigonometric functions.
+ @param isRadianMode    YES if the result is in radian, NO if it is in degree.
+ 
+ @return Returns the result of the inverse trigonometric function if it is
+ successful, otherwise NAN.
+ */
+static double NIBPerformInverseTrigonometricFunction(NIBInverseTrigonometricFuntion inverseTrigFunc, double operand, BOOL isRadianMode) {
+    /* if operand is not a number, return not a number */
+    if (isnan(operand)) {
+        return NAN;
+    }
+    
+    /* otherwise, the operand is a number */
+    double result = NAN;
+    
+    switch (inverseTrigFunc) {
+        /* calculate arcsin function */
+        case NIBInverseTrigonometricArcSinFunction:
+            if (operand < -1 || operand > 1) {
+                result = NAN;
+            } else if (isRadianMode) {
+                result = asin(operand);
+            } else {
+                result = asin(operand)*180/M_PI;
+            }
+            break;
+        
+        /* calculate arcos function */
+        case NIBInverseTrigonometricArcCosFunction:
+            if (operand < -1 || operand > 1) {
+                result = NAN;
+            } else if (isRadianMode) {
+                result = acos(operand);
+            } else {
+                result = acos(operand)*180/M_PI;
+            }
+            break;
+        
+        /* calculate arctan function */
+        case NIBInverseTrigonometricArcTanFunction:
+            if (isRadianMode) {
+                result = atan(operand);
+            } else {
+                result = atan(operand)*180/M_PI;
+            }
+            break;
+        
+        /* default case, return not a number to make the program fault-tolerance */
+        default:
+            result = NAN;
+            break;
+    }
+    
+    return result;
+}
+
+/**
+ Handle inverse hyperbolic functions.
+ 
+ @param inverseHyperbolicFunc   The inverse trigonometric
+                                defined in NIBInverseHyperbolicFunction.
+ @param operand                 The operand to perform inverse hyperbolic
+                                functions.
+ 
+ @return Returns the result of the inverse hyperbolic function if it is
+ successful, otherwise NAN.
+ */
+static double NIBPerformInverseHyperbolicFunction(NIBInverseHyperbolicFunction inverseHyperbolicFunc, double operand) {
+    
+    /* if operand is not a number, return not a number */
+    if (isnan(operand)) {
+        return NAN;
+    }
+    
+    /* otherwise, the operand is a number */
+    double result = NAN;
+    
+    switch (inverseHyperbolicFunc) {
+        /* calculate arcsinh function */
+        case NIBInverseHyperbolicSineFunction:
+            result = asinh(operand);
+            break;
+        
+        /* calculate arccosh function */
+        case NIBInverseHyperbolicCosineFunction:
+            result = acosh(operand);
+            break;
+        
+        /* calculate arctanh function */
+        case NIBInverseHyperbolicTangentFunction:
+            result = atanh(operand);
+            break;
+        
+        /* default case, return not a number to make the program fault-tolerance */
+        default:
+            result = NAN;
+            break;
+    }
+    
+    /* round the result with calculation error */
+    return NIBRoundNumberWithCalculationError(result);
+}
+
+/**
+ Perform function of f(x)=1/x.
+ 
+ @param operand The operand to perform a function.
+ 
+ @return Returns the result of the function if it is successful,
+ otherwise NAN.
+ */
+static double NIBPerformInverseFunction(double operand) {
+    double result = NAN;
+    
+    /* if operand is not a number or zero */
+    if (isnan(operand) || operand == 0) {
+        result = NAN;
+    
+    /* otherwise, the operand is valid to perform reciprocal function of x */
+    } else {
+        result = 1.0/operand;
+    }
+    
+    return result;
+}
+
+/**
+ Handle factorial operation of an operand. The factorial of an integer is taken
+ from a table, and the factorial of another number is Gamma(x + 1).
+ 
+ @param operand The operand to perform a function.
+ 
+ @return Returns the result of the factorial function if it is successful,
+ otherwise NAN.
+ */
+static double NIBPerformFactorial(double operand) {
+    double result = NAN;
+    
+    /* if an operand is not a number or a negative integer, where Gamma has poles */
+    if (isnan(operand) || (operand < 0 && operand == round(operand))) {
+        result = NAN;
+    
+    /* otherwise, operand is valid */
+    /* if the operand is an integer, the factorial is in the table unless it overflows */
+    } else if (operand == round(operand)) {
+        if (operand <= NIB_MAX_FACTORIAL_OPERAND) result = NIB_FACTORIALS[(NSUInteger)operand];
+    
+    /* otherwise, the operand is not an integer and x! = Gamma(x + 1) */
+    } else {
+        result = tgamma(operand + 1);
+        
+        /* if calculation is infinity, result is not a number */
+        if (isinf(result)) result = NAN;
+    }
+    
+    return result;
+}
+
+/**
+ Perform exponential functions on an operand.
+ 
+ @param exponentialFunction The exponential functions defined
+                            in NIBExponentialFunction.
+ @param operand             The power to raise the base of the function.
+ 
+ @return Returns the result of the exponential function if it is successful,
+ otherwise NAN.
+ */
+static double NIBPerformExponentialFunction(NIBExponentialFunction exponentialFunction, double operand) {
+    
+    /* if the operand is not a number or infinity, return not a number */
+    if (isnan(operand) || isinf(operand)) {
+        return NAN;
+    }
+    
+    /* otherwise the operand is a number */
+    double result = NAN;
+    
+    switch (exponentialFunction) {
+        /* calculate e^x */
+        case NIBExponentialNaturalFunction:
+            result = exp(operand);
+            break;
+            
+        /* calculate 10^x */
+        case NIBExponentialDecimalFunction:
+            result = NIBScaleByPowerOfTen(1.0, operand);
+            break;
+            
+        /* calculate 2^x */
+        case NIBExponentialBinaryFunction:
+            result = exp2(operand);
+            break;
+            
+        /* default case, return not a number to make the program fault-tolerance */
+        default:
+            result = NAN;
+            break;
+    }
+    
+    /* if result is infinity, result is not a number */
+    if (isinf(result)) result = NAN;
+    
+    return result;
+}
+
+/**
+ Raise a base to an integer power by squaring. The products are kept as the
+ sum of two doubles, so the result is within an ulp or so of the one of pow().
+ If a product overflows or the result is not finite or subnormal, the power is
+ raised by pow() instead, so the intermediate overflow of a negative power
+ which underflows does not turn into not a number.
+ 
+ @param base    The base of exponent operation.
+ @param power   The integer power to raise.
+ 
+ @return Returns the result of the exponentiation, infinity if it overflows.
+ */
+static double NIBRaiseToIntegerPower(double base, int_least64_t power) {
+    uint_least64_t exponent = (power < 0) ? -(uint_least64_t)power : (uint_least64_t)power;
+    
+    /* the result and the squared base, each one is high + low */
+    double resultHigh = 1.0, resultLow = 0.0;
+    double baseHigh = base, baseLow = 0.0;
+    
+    while (exponent != 0) {
+        /* if the bit of the exponent is set, multiply the result by the squared base */
+        if (exponent & 1) {
+            double product = resultHigh * baseHigh;
+            
+            /* if the product overflows, the error of the product is not a number */
+            if (isinf(product)) return pow(base, (double)power);
+            
+            double error = fma(resultHigh, baseHigh, -product) + (resultHigh * baseLow + resultLow * baseHigh);
+            resultHigh = product + error;
+            resultLow = error - (resultHigh - product);
+        }
+        
+        exponent >>= 1;
+        
+        /* if the exponent has more bits, square the base */
+        if (exponent != 0) {
+            double product = baseHigh * baseHigh;
+            
+            /* if the square overflows, the error of the square is not a number */
+            if (isinf(product)) return pow(base, (double)power);
+            
+            double error = fma(baseHigh, baseHigh, -product) + 2 * baseHigh * baseLow;
+            baseHigh = product + error;
+            baseLow = error - (baseHigh - product);
+        }
+    }
+    
+    /* if the power is negative, take the reciprocal of high + low */
+    if (power < 0) {
+        double reciprocal = 1.0/resultHigh;
+        double residual = fma(-reciprocal, resultHigh, 1.0) - reciprocal * resultLow;
+        double result = reciprocal + reciprocal * residual;
+        
+        /* if the reciprocal loses its low bits as a subnormal, let pow() round it once */
+        if (!isnormal(result) || !isfinite(residual)) return pow(base, (double)power);
+        
+        return result;
+    }
+    
+    double result = resultHigh + resultLow;
+    
+    /* if the sum is not finite, the low part is not a number */
+    if (!isfinite(result)) return pow(base, (double)power);
+    
+    return result;
+}
+
+/**
+ Multiply a number by a power of ten. An integer power up to 22 is exact in a
+ double, so the number is multiplied or divided by it with one rounding.
+ 
+ @param number  The number to multiply.
+ @param power   The power of ten.
+ 
+ @return Returns the number times 10^power, not a number if it is infinity.
+ */
+static double NIBScaleByPowerOfTen(double number, double power) {
+    double result = NAN;
+    
+    /* if the power is an integer in the table */
+    if (power == round(power) && fabs(power) <= NIB_MAX_EXACT_POWER_OF_TEN) {
+        NSUInteger index = (NSUInteger)fabs(power);
+        
+        /* if the power is negative, divide by the exact power of ten */
+        if (power < 0) {
+            result = number / NIB_POWERS_OF_TEN[index];
+        } else {
+            result = number * NIB_POWERS_OF_TEN[index];
+        }
+        
+    /* otherwise, the power of ten is not exact */
+    } else {
+        result = number * pow(10, power);
+    }
+    
+    /* if calculation is infinity, result is not a number */
+    if (isinf(result)) result = NAN;
+    
+    return result;
+}
+
+/**
+ Check if an angle in radian is equals Pi/2*(2k+1) (k is integer). The nearest
+ multiplication of Pi/2 is found at once, so every angle costs the same.
+ 
+ @param angle   The angle to check.
+ 
+ @return Returns YES if the angle is an odd multiplication of Pi/2, otherwise NO.
+ */
+static BOOL NIBIsOddMultiplicationOfPi_2(double angle) {
+    double multiplier = nearbyint(fabs(angle) / M_PI_2);
+    
+    // the quotient of an exact multiplication of Pi/2 rounds to its
+    // multiplier, and a multiplier of 2^53 or more is even
+    return fmod(multiplier, 2) == 1 && M_PI_2 * multiplier == fabs(angle);
+}
+
+/**
+ Round the double with calculation error.
+ 
+ @param doubleNumber The double number to round.
+ 
+ @return Returns the number after rounding.
+ */
+static double NIBRoundNumberWithCalculationError(double doubleNumber) {
+    double result = doubleNumber;
+    double roundedVal = round(doubleNumber);
+    
+    if (fabs(roundedVal - doubleNumber) <= NIB_CAL_ERROR) {
+        result = roundedVal;
+    }
+    
+    return result;
+}
+
+/**
+ Convert from double number to Fraction.
+ 
+ @param number The double number.
+ 
+ @return Returns the fraction with numerator and denominator representing the number.
+ */
+static Fraction NIBFractionFromDouble(double number) {
+    Fraction frac = {0, 0};
+    
+    /* if a number is an integer */
+    if (number == round(number)) {
+        /* fraction is number/1 */
+        frac.numerator = (int_least64_t)number;
+        frac.denominator = 1;
+        
+        /* if a number is not an integer */
+    } else {
+        Fraction fractions[2];
+        fractions[0] = (Fraction) {1, 0};
+        fractions[1] = (Fraction) {0, 1};
+        
+        /* approximation always convert to postive */
+        double approximation = (number < 0) ? -number : number;
+        int_least64_t integerPart = (int_least64_t)approximation;
+        
+        while (fractions[0].denominator * integerPart + fractions[1].denominator <= NIB_MAX_DENOMINATOR) {
+            int_least64_t temp;
+            temp = fractions[0].numerator * integerPart + fractions[1].numerator;
+            fractions[1].numerator = fractions[0].numerator;
+            fractions[0].numerator = temp;
+            temp = fractions[0].denominator * integerPart + fractions[1].denominator;
+            fractions[1].denominator = fractions[0].denominator;
+            fractions[0].denominator = temp;
+            
+            /* if approximation is perfect */
+            if (approximation == integerPart) {
+                break;
+            
+            /* if approximation is acceptable with an error */
+            } else if (approximation - integerPart <= NIB_APPROX_ERROR) {
+                break;
+                
+            /* if the number can not be represented as rational form */
+            } else if ( NIBIsNegativeFraction(fractions[0]) || NIBIsNegativeFraction(fractions[1]) ) {
+                fractions[0] = (Fraction) {1, 0};
+                break;
+            }
+                
+            /* update approximation and integer part */
+            approximation = 1.0/(approximation - integerPart);
+            integerPart = (int_least64_t)approximation;
+            
+            if (approximation > (double)0x7FFFFFFF) {
+                break;
+            }
+        }
+        
+        /* get the fraction of a number */
+        frac = fractions[0];
+        
+        /* if valid fraction */
+        if (frac.denominator != 0) {
+            /* find GCD of numerator and denominator of the fraction */
+            int_least64_t greatCommondDivisor = NIBGreatCommonDivisor((uint_least64_t)frac.numerator, (uint_least64_t)frac.denominator);
+            
+            /* reduce the fraction to simplest form */
+            frac.numerator = frac.numerator/greatCommondDivisor;
+            frac.denominator = frac.denominator/greatCommondDivisor;
+            
+            /* return the sign of the fraction if negative */
+            if (number < 0) {
+                frac.numerator = -frac.numerator;
+            }
+        }
+        
+    }
+    
+    return frac;
+}
+
+/**
+ Convert from double number to Fraction, reusing the fraction of the last
+ power on the thread. A negative base is usually raised to the same power
+ again, such as a root applied to one number after another.
+ 
+ @param number The double number.
+ 
+ @return Returns the fraction with numerator and denominator representing the number.
+ */
+static Fraction NIBCachedFractionFromDouble(double number) {
+    
+    /* if the number is not the last one, convert it and keep the fraction */
+    if (NIBNegativeBasePowerCache.power != number) {
+        NIBNegativeBasePowerCache.fraction = NIBFractionFromDouble(number);
+        NIBNegativeBasePowerCache.power = number;
+    }
+    
+    return NIBNegativeBasePowerCache.fraction;
+}
+
+/**
+ Check if a fraction is negative.
+ 
+ @param frac The fraction to check.
+ 
+ @return Returns YES if the fraction is negative, otherwise NO.
+ */
+static BOOL NIBIsNegativeFraction(Fraction frac) {
+    BOOL isNegativeFraction = NO;
+    
+    if ((frac.numerator < 0 && frac.denominator > 0) ||
+        (frac.numerator > 0 && frac.denominator < 0)) {
+        isNegativeFraction = YES;
+    }
+    
+    return isNegativeFraction;
+}
+
+/**
+ Find the great common divisor of two positive integers.
+ 
+ @param number1 The first number.
+ @param number2 The second number.
+ 
+ @return Returns the great common divisor of two numbers.
+ */
+static int_least64_t NIBGreatCommonDivisor(uint_least64_t number1, uint_least64_t number2) {
+    uint_least64_t temp;
+    
+    while (number2 != 0) {
+        temp = number1 % number2;
+        number1 = number2;
+        number2 = temp;
+    }
+    
+    return (int_least64_t)number1;
+}
+
+/**
+ Check if the result of a unary operator is worth keeping in the unary memo.
+ The percentage, the square, the cube and the inverse are a few instructions
+ in binary floating point, which is cheaper than a lookup of the memo.
+ 
+ @param operatorTag     The tag of the unary operator.
+ @param isDecimalMode   YES if the operator is performed in decimal.
+ 
+ @return Returns YES if the result is kept in the memo, otherwise NO.
+ */
+static BOOL NIBIsMemoizedUnaryOperator(NIBButtonTag operatorTag, BOOL isDecimalMode) {
+    
+    /* if the operator is performed in decimal, the conversions alone are worth it */
+    if (isDecimalMode) {
+        return YES;
+    }
+    
+    switch (operatorTag) {
+        case NIBButtonPercentage:
+        case NIBButtonXSquared:
+        case NIBButtonXCubed:
+        case NIBButtonOneOverX:
+            return NO;
+        
+        default:
+            return YES;
+    }
+}
+
+/**
+ Find the set of the unary memo for an operand and a key. The bits are mixed
+ by a multiplicative hash, so the operands close to each other, which differ in
+ the low bits of their mantissas, are spread over the memo.
+ 
+ @param operandBits The bits of the operand.
+ @param key         The operator and the modes.
+ 
+ @return Returns the index of the set.
+ */
+static NSUInteger NIBUnaryMemoIndex(uint64_t operandBits, uint32_t key) {
+    uint64_t hash = (operandBits ^ (operandBits >> 32) ^ ((uint64_t)key << 40)) * 0x9E3779B97F4A7C15ull;
+    
+    return (NSUInteger)(hash >> (64 - NIB_UNARY_MEMO_INDEX_BITS));
+}
+
+/**
+ Calculate the digamma function, the derivative of ln(Gamma(x)). A small
+ argument is raised by the recurrence digamma(x) = digamma(x + 1) - 1/x until
+ the asymptotic series is accurate, and a negative one is reflected.
+ 
+ @param operand The operand.
+ 
+ @return Returns the digamma of the operand, NAN at its poles.
+ */
+static double NIBDigamma(double operand) {
+    double x = operand;
+    double result = 0;
+    
+    /* if the operand is zero or a negative integer, where digamma has poles */
+    if (isnan(x) || (x <= 0 && x == round(x))) {
+        return NAN;
+    }
+    
+    /* if the operand is negative, reflect it by digamma(1 - x) - digamma(x) = Pi/tan(Pi*x) */
+    if (x < 0) {
+        return NIBDigamma(1 - x) - M_PI/tan(M_PI*x);
+    }
+    
+    while (x < 10) {
+        result -= 1/x;
+        x += 1;
+    }
+    
+    double s = 1/(x*x);
+    
+    result += log(x) - 0.5/x - s*(1.0/12 - s*(1.0/120 - s*(1.0/252 - s*(1.0/240 - s/132))));
+    
+    return result;
+}
+
+/**
+ Calculate the derivative of a power, base^power, of dual numbers. The term of
+ the base is p*b^(p - 1)*b', and the term of the power is b^p*ln(b)*p', which
+ is real only for a positive base.
+ 
+ @param base    The base.
+ @param power   The power.
+ @param value   The value of the power, base^power.
+ 
+ @return Returns the derivative of the power, NAN if it is not defined.
+ */
+static double NIBDerivativeOfPower(NIBDual base, NIBDual power, double value) {
+    double baseTerm = 0;
+    double powerTerm = 0;
+    
+    /* if the base depends on the unknown */
+    if (base.derivative != 0) {
+        /* if the base is not zero, b^(p - 1) = value/b */
+        if (base.value != 0) {
+            baseTerm = power.value*value/base.value*base.derivative;
+        
+        /* if the base is zero, the derivative is defined only for p >= 1 */
+        } else if (power.value == 1) {
+            baseTerm = base.derivative;
+        } else if (power.value > 1) {
+            baseTerm = 0;
+        } else {
+            baseTerm = NAN;
+        }
+    }
+    
+    /* if the power depends on the unknown */
+    if (power.derivative != 0) {
+        /* if the base is positive */
+        if (base.value > 0) {
+            powerTerm = value*log(base.value)*power.derivative;
+        
+        /* if the base is zero, the power stays zero for p > 0 */
+        } else if (base.value == 0 && power.value > 0) {
+            powerTerm = 0;
+        } else {
+            powerTerm = NAN;
+        }
+    }
+    
+    return baseTerm + powerTerm;
+}
+
+/**
+ Evaluate the residual of a solve, the value of the expression minus the
+ target, with its derivative. The evaluation is counted, and the unknown is
+ recorded as the end of the bracket which has the sign of its residual.
+ 
+ @param problem The problem to solve.
+ @param unknown The value of the unknown.
+ 
+ @return Returns the residual at the unknown, NAN with a NAN derivative if the
+ expression has no result.
+ */
+static NIBDual NIBEvaluateSolveResidual(NIBSolveProblem *problem, double unknown) {
+    NIBDual residual = NIBDualMake(NAN, NAN);
+    
+    problem->passCount++;
+    
+    /* if the expression has a result, the residual is its difference with the target */
+    if (NIBEvaluateDualPostfixExpression(problem->postfixExp, problem->count, problem->unknownIndex, unknown, problem->isRadianMode, &residual)) {
+        residual.value -= problem->target;
+    }
+    
+    /* if the residual is negative, the unknown is the negative end of the bracket */
+    if (residual.value < 0) {
+        problem->negativePoint = unknown;
+        problem->negativeResidual = residual;
+    
+    /* if the residual is positive, the unknown is the positive end of the bracket */
+    } else if (residual.value > 0) {
+        problem->positivePoint = unknown;
+        problem->positiveResidual = residual;
+    }
+    
+    return residual;
+}
+
+/**
+ Check if the root of a solve is bracketed, by an unknown with a negative
+ residual and one with a positive residual.
+ 
+ @param problem The problem to solve.
+ 
+ @return Returns YES if the root is bracketed, otherwise NO.
+ */
+static BOOL NIBIsSolveBracketed(const NIBSolveProblem *problem) {
+    return !isnan(problem->negativePoint) && !isnan(problem->positivePoint);
+}
+
+/**
+ Take Newton steps in a solve, each halved until the residual decreases, until
+ they converge, stall or the residual changes sign.
+ 
+ @param problem     The problem to solve.
+ @param unknown     The unknown to start from, and the last unknown the steps
+                    reach.
+ @param residual    The residual at the unknown to start from, and the one at
+                    the last unknown.
+ 
+ @return Returns YES if the steps converge, otherwise NO.
+ */
+static BOOL NIBTakeSolveNewtonSteps(NIBSolveProblem *problem, double *unknown, NIBDual *residual) {
+    BOOL isConverged = NO;
+    
+    while (!isConverged && !NIBIsSolveBracketed(problem) && problem->passCount < NIB_SOLVE_MAX_PASSES) {
+        double step = residual->value/residual->derivative;
+        
+        /* if the residual or its derivative is not a number, or the derivative is zero, the steps stall */
+        if (!isfinite(step)) break;
+        
+        NIBDual trial = *residual;
+        double trialUnknown = *unknown;
+        BOOL isDecreased = NO;
+        
+        for (NSUInteger halving = 0; halving <= NIB_SOLVE_MAX_HALVINGS && !isDecreased && problem->passCount < NIB_SOLVE_MAX_PASSES; halving++) {
+            trialUnknown = *unknown - step;
+            trial = NIBEvaluateSolveResidual(problem, trialUnknown);
+            isDecreased = (fabs(trial.value) < fabs(residual->value));
+            step /= 2;
+            
+            /* if the residual changes sign, the root is bracketed */
+            if (NIBIsSolveBracketed(problem)) break;
+        }
+        
+        /* if no step decreases the residual, the steps stall */
+        if (!isDecreased) break;
+        
+        double lastStep = fabs(trialUnknown - *unknown);
+        
+        *unknown = trialUnknown;
+        *residual = trial;
+        isConverged = (residual->value == 0 || lastStep <= NIB_SOLVE_TOLERANCE * fmax(fabs(*unknown), DBL_MIN));
+    }
+    
+    return isConverged;
+}
@@ -0,0 +1,109 @@
+//
+//  NIBCalculatorProgram.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "NIBToken.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ `NIBCalculatorProgram` is an immutable compiled expression of the calculator.
+ The program keeps the postfix form of an expression, so it can be evaluated
+ against new operands again and again without parsing the expression.
+ 
+ The operands of a program are numbered in order of appearance in the
+ expression. For example, the program of the expression 2x(3+4) has the
+ operands 2, 3 and 4 at the index 0, 1 and 2.
+ 
+ @note A program is created by -[NIBCalculatorBrain programWithInfixExpression:count:].
+ The program is safe to evaluate from multiple threads.
+ */
+@interface NIBCalculatorProgram : NSObject <NSCopying>
+
+/// ----------------
+/// @name Properties
+/// ----------------
+
+/** The number of operands of the program. */
+@property (readonly, assign, nonatomic) NSUInteger numberOfOperands;
+
+/// -------------------------
+/// @name Unavailable Methods
+/// -------------------------
+
+/**
+ The init method is unavailable.
+ */
+- (instancetype)init __attribute__((unavailable("use +programWithPostfixExpression:count: method")));
+
+/// --------------------
+/// @name Initialization
+/// --------------------
+
+/**
+ Create the program with a postfix expression.
+ 
+ @param postfixExp  The tokens of the postfix expression. The tokens are copied.
+ @param count       The number of tokens.
+ 
+ @return Returns the NIBCalculatorProgram instance.
+ */
++ (instancetype)programWithPostfixExpression:(const NIBToken *_Nullable)postfixExp count:(NSUInteger)count;
+
+/// ----------------
+/// @name Evaluation
+/// ----------------
+
+/**
+ Get the operands which the program was compiled with.
+ 
+ @param operands    The buffer with room for numberOfOperands values to store
+                    the operands.
+ */
+- (void)getOperands:(double *)operands;
+
+/**
+ Evaluate the program.
+ 
+ @param operands    The numberOfOperands values of the operands, or NULL to use
+                    the operands which the program was compiled with.
+ @param result      The result of the program. The result is NAN if the
+                    evaluation is not successful.
+ 
+ @return Returns YES if the program has a result, otherwise NO.
+ */
+- (BOOL)evaluateWithOperands:(const double *_Nullable)operands result:(double *)result;
+
+/**
+ Evaluate the program over many sets of operands.
+ 
+ @param operands    The operands of all evaluations, one set of
+                    numberOfOperands values after another.
+ @param count       The number of evaluations.
+ @param results     The buffer with room for count values to store the results.
+                    The result of an evaluation without result is NAN.
+ */
+- (void)evaluateWithOperands:(const double *)operands
+                       count:(NSUInteger)count
+                     results:(double *)results;
+
+/**
+ Evaluate the program as the calculator brain does.
+ 
+ @param operands    The numberOfOperands values of the operands, or NULL to use
+                    the operands which the program was compiled with.
+ 
+ @return Returns the number object if the program can be evaluated successfully,
+ `[NSDecimalNumber notANumber]` if the evaluation is not successful, otherwise
+ nil.
+ */
+- (NSNumber *_Nullable)resultWithOperands:(const double *_Nullable)operands;
+
+@end
+
+NS_ASSUME_NONNULL_END
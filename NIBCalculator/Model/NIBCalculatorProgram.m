@@ -0,0 +1,193 @@
+//
+//  NIBCalculatorProgram.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBCalculatorProgram.h"
+#import "NIBCalculatorKernels.h"
+#import "NIBCalculatorStack.h"
+#import "NIBOperator.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Extension
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBCalculatorProgram () {
+    /** The tokens of the postfix expression. */
+    NIBToken *_postfixExpression;
+    
+    /** The number of tokens of the postfix expression. */
+    NSUInteger _count;
+}
+
+@property (readwrite, assign, nonatomic) NSUInteger numberOfOperands;
+
+/**
+ Initialize the program with a postfix expression.
+ 
+ @param postfixExp  The tokens of the postfix expression.
+ @param count       The number of tokens.
+ 
+ @return Returns the NIBCalculatorProgram instance.
+ */
+- (instancetype)initWithPostfixExpression:(const NIBToken *_Nullable)postfixExp count:(NSUInteger)count;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Implementation
+
+
+@implementation NIBCalculatorProgram
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Public Methods
+
+#pragma mark Create A Program
+
++ (instancetype)programWithPostfixExpression:(const NIBToken *)postfixExp count:(NSUInteger)count
+{
+    NIBCalculatorProgram *program = [[self alloc] initWithPostfixExpression:postfixExp count:count];
+    
+    return program;
+}
+
+#pragma mark Evaluation
+
+- (void)getOperands:(double *)operands
+{
+    NSUInteger operandIdx = 0;
+    
+    for (NSUInteger i = 0; i < _count; i++) {
+        if (_postfixExpression[i].kind == NIBTokenKindOperand) {
+            operands[operandIdx++] = _postfixExpression[i].operand;
+        }
+    }
+}
+
+- (BOOL)evaluateWithOperands:(const double *)operands result:(double *)result
+{
+    BOOL hasResult = NIBEvaluatePostfixExpression(_postfixExpression, _count, operands, NULL, result);
+    
+    /* if there is no result, result is not a number */
+    if (!hasResult) *result = NAN;
+    
+    return hasResult;
+}
+
+- (void)evaluateWithOperands:(const double *)operands
+                       count:(NSUInteger)count
+                     results:(double *)results
+{
+    /* one calculation stack for all evaluations */
+    NIBDoubleStack calStack;
+    
+    NIBDoubleStackInit(&calStack);
+    NIBDoubleStackReserve(&calStack, _count);
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        /* if there is no result, result is not a number */
+        if (!NIBEvaluatePostfixExpression(_postfixExpression, _count, operands + i * self.numberOfOperands, NIBDoubleStackValues(&calStack), &results[i])) {
+            results[i] = NAN;
+        }
+    }
+    
+    NIBDoubleStackFree(&calStack);
+}
+
+- (NSNumber *)resultWithOperands:(const double *)operands
+{
+    double result = NAN;
+    
+    /* if there is no result, return nil */
+    if (![self evaluateWithOperands:operands result:&result]) {
+        return nil;
+    }
+    
+    /* if result is not a number, return not a number */
+    if (isnan(result)) {
+        return [NSDecimalNumber notANumber];
+    }
+    
+    return [[NSNumber alloc] initWithDouble:result];
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Methods
+
+
+#pragma mark Initialize
+
+- (instancetype)initWithPostfixExpression:(const NIBToken *)postfixExp count:(NSUInteger)count
+{
+    self = [super init];
+    
+    if (self) {
+        _postfixExpression = malloc(MAX(count, 1) * sizeof(NIBToken));
+        
+        /* if the postfix expression can not be allocated */
+        if (_postfixExpression == NULL) {
+            [NSException raise:NSMallocException format:@"Can not allocate program of %lu tokens", (unsigned long)count];
+        }
+        
+        if (count > 0) memcpy(_postfixExpression, postfixExp, count * sizeof(NIBToken));
+        _count = count;
+        
+        /* count the operands of the program */
+        for (NSUInteger i = 0; i < count; i++) {
+            if (postfixExp[i].kind == NIBTokenKindOperand) _numberOfOperands++;
+        }
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_postfixExpression);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - NSCopying
+
+
+- (id)copyWithZone:(NSZone *__unused)zone
+{
+    /* the program is immutable, share the instance */
+    return self;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - NSObject
+
+
+- (NSString *)description
+{
+    NSMutableArray<NSString *> *tokens = [[NSMutableArray alloc] initWithCapacity:_count];
+    
+    for (NSUInteger i = 0; i < _count; i++) {
+        NIBToken token = _postfixExpression[i];
+        
+        if (token.kind == NIBTokenKindOperand) {
+            [tokens addObject:[[NSNumber numberWithDouble:token.operand] description]];
+        } else {
+            [tokens addObject:[[NIBOperator operatorWithTag:token.tag] description]];
+        }
+    }
+    
+    return [tokens componentsJoinedByString:@" "];
+}
+
+@end
@@ -0,0 +1,188 @@
+//
+//  NIBCalculatorSnapshot.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "NIBToken.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Types, Enumeration and Options
+
+
+/** Values to identify the fields of a snapshot. */
+typedef NS_ENUM(uint16_t, NIBSnapshotField) {
+    /** The angle mode and the number mode of the calculator, one byte of NIBSnapshotModes. */
+    NIBSnapshotFieldModes = 1,
+    /** The memory of the calculator as a double, empty if there is no memory. */
+    NIBSnapshotFieldMemory,
+    /** The tokens of the infix expression of the calculator. */
+    NIBSnapshotFieldInfixExpression,
+    /** The tokens of the arithmetic cache of the calculator. */
+    NIBSnapshotFieldArithmeticCache,
+    /** The first field which is free for the users of a snapshot. */
+    NIBSnapshotFieldFirstCustom = 0x100
+};
+
+/** Values to indicate the modes in the modes field of a snapshot. */
+typedef NS_OPTIONS(uint8_t, NIBSnapshotModes) {
+    /** The angles are in radian. */
+    NIBSnapshotModeRadian = 1 << 0,
+    /** The numbers are in decimal. */
+    NIBSnapshotModeDecimal = 1 << 1
+};
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Token Encoding
+
+
+/** The length of an encoded token, its kind and the bits of its operand or its tag. */
+FOUNDATION_EXPORT const NSUInteger NIBSnapshotTokenLength;
+
+/**
+ Encode tokens into bytes, NIBSnapshotTokenLength bytes a token.
+ 
+ @param tokens  The tokens.
+ @param count   The number of tokens.
+ @param bytes   The bytes to write the tokens to, at least
+                count * NIBSnapshotTokenLength bytes.
+ */
+FOUNDATION_EXPORT void NIBSnapshotEncodeTokens(const NIBToken *_Nullable tokens, NSUInteger count, uint8_t *bytes);
+
+/**
+ Decode the tokens of bytes.
+ 
+ @param bytes   The encoded tokens.
+ @param length  The length of the bytes.
+ @param tokens  The buffer to append the tokens to. It is not modified if the
+                bytes are not encoded tokens.
+ 
+ @return Returns YES if the bytes are encoded tokens of known operators,
+ otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBSnapshotDecodeTokens(const uint8_t *_Nullable bytes, NSUInteger length, NIBTokenBuffer *tokens);
+
+/**
+ Encode tokens for a field of a snapshot. Each token takes 9 bytes, its kind
+ and the bits of its operand or its tag.
+ 
+ @param tokens  The tokens.
+ @param count   The number of tokens.
+ 
+ @return Returns the encoded tokens.
+ */
+FOUNDATION_EXPORT NSData *NIBSnapshotDataFromTokens(const NIBToken *_Nullable tokens, NSUInteger count);
+
+/**
+ Decode the tokens of a field of a snapshot.
+ 
+ @param data    The encoded tokens.
+ @param tokens  The buffer to append the tokens to. It is not modified if the
+                data is not encoded tokens.
+ 
+ @return Returns YES if the data is encoded tokens of known operators,
+ otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBSnapshotGetTokens(NSData *data, NIBTokenBuffer *tokens);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Interface
+
+
+/**
+ `NIBCalculatorSnapshot` is the state of the calculator saved in a compact,
+ versioned binary file. The file is a header and a log of records, each record
+ is a field with its length and checksum. A field is read from the last record
+ of it, so a save appends only the fields which change since the last save.
+ The log is rewritten as a new file when it grows several times larger than
+ its fields.
+ 
+ The file is mapped into memory when the snapshot is loaded. A record which is
+ cut short or corrupted ends the log and is overwritten by the next save. A
+ file with another version is ignored.
+ 
+ @note The fields are set and the saves are started on one thread, usually the
+ main thread. The files are written on a serial queue of the snapshot.
+ */
+@interface NIBCalculatorSnapshot : NSObject
+
+/// ----------------
+/// @name Properties
+/// ----------------
+
+/** The path of the file of the snapshot. */
+@property (readonly, copy, nonatomic) NSString *path;
+
+/// -------------------------
+/// @name Unavailable Methods
+/// -------------------------
+
+/**
+ The init method is unavailable.
+ */
+- (instancetype)init __attribute__((unavailable("use +snapshotWithContentsOfFile: method")));
+
+/// --------------------
+/// @name Initialization
+/// --------------------
+
+/**
+ Create the snapshot of a file. The fields are loaded from the file if it is
+ a snapshot, otherwise the snapshot has no fields and the first save creates
+ the file.
+ 
+ @param path    The path of the file.
+ 
+ @return Returns the NIBCalculatorSnapshot instance.
+ */
++ (instancetype)snapshotWithContentsOfFile:(NSString *)path;
+
+/// ------------
+/// @name Fields
+/// ------------
+
+/**
+ Get a field of the snapshot.
+ 
+ @param field   The field.
+ 
+ @return Returns the data of the field, or nil if the snapshot does not have
+ the field.
+ */
+- (NSData *_Nullable)dataOfField:(NIBSnapshotField)field;
+
+/**
+ Set a field of the snapshot. The field is saved by the next save if its data
+ is not the data which is saved last.
+ 
+ @param data    The data of the field.
+ @param field   The field.
+ */
+- (void)setData:(NSData *)data ofField:(NIBSnapshotField)field;
+
+/// ------------
+/// @name Saving
+/// ------------
+
+/**
+ Save the fields which change since the last save. The file is written in the
+ background and the method returns immediately.
+ */
+- (void)save;
+
+/**
+ Wait until the saves which are started are written to the file.
+ */
+- (void)waitUntilSaved;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,423 @@
+//
+//  NIBCalculatorSnapshot.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBCalculatorSnapshot.h"
+#import <fcntl.h>
+#import <stdatomic.h>
+#import <unistd.h>
+#import "NIBOperator.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ @struct NIBSnapshotHeader.
+ 
+ The header of the file of a snapshot. The file is in the byte order of the
+ device, which writes and reads it.
+ 
+ @field magic   The magic number of a snapshot.
+ @field version The version of the format of the file.
+ */
+typedef struct NIBSnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+} NIBSnapshotHeader;
+
+/**
+ @struct NIBSnapshotRecordHeader.
+ 
+ The header of a record, which is followed by the data of the field.
+ 
+ @field field       The field of the record.
+ @field reserved    Reserved, 0.
+ @field length      The length of the data of the field.
+ @field checksum    The checksum of the field, the length and the data.
+ */
+typedef struct NIBSnapshotRecordHeader {
+    uint16_t field;
+    uint16_t reserved;
+    uint32_t length;
+    uint32_t checksum;
+} NIBSnapshotRecordHeader;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The magic number of a snapshot, `NIBS` in the file. */
+static const uint32_t NIB_SNAPSHOT_MAGIC = 0x5342494E;
+
+/** The version of the format of the file. */
+static const uint32_t NIB_SNAPSHOT_VERSION = 1;
+
+/** The ratio of the length of the file to the length of its fields which makes a save rewrite the file. */
+static const uint64_t NIB_SNAPSHOT_COMPACTION_RATIO = 4;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static uint32_t NIBSnapshotChecksum(uint16_t, const void *, uint32_t);
+static void NIBSnapshotAppendRecord(NSMutableData *, uint16_t, NSData *);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Token Encoding
+
+
+const NSUInteger NIBSnapshotTokenLength = 9;
+    
+void NIBSnapshotEncodeTokens(const NIBToken *tokens, NSUInteger count, uint8_t *bytes) {
+    for (NSUInteger i = 0; i < count; i++) {
+        uint64_t bits = 0;
+        
+        /* if a token is an operand, keep the bits of the operand, otherwise the tag */
+        if (tokens[i].kind == NIBTokenKindOperand) {
+            memcpy(&bits, &tokens[i].operand, sizeof(bits));
+        } else {
+            bits = (uint64_t)tokens[i].tag;
+        }
+        
+        bytes[0] = (uint8_t)tokens[i].kind;
+        memcpy(bytes + 1, &bits, sizeof(bits));
+        bytes += NIBSnapshotTokenLength;
+    }
+}
+
+BOOL NIBSnapshotDecodeTokens(const uint8_t *bytes, NSUInteger length, NIBTokenBuffer *tokens) {
+    
+    /* if the length is not of whole tokens, the bytes are not encoded tokens */
+    if (length % NIBSnapshotTokenLength != 0) {
+        return NO;
+    }
+    
+    NSUInteger originalCount = tokens->count;
+    
+    for (NSUInteger i = 0; i < length / NIBSnapshotTokenLength; i++) {
+        uint8_t kind = bytes[0];
+        uint64_t bits = 0;
+        
+        memcpy(&bits, bytes + 1, sizeof(bits));
+        bytes += NIBSnapshotTokenLength;
+        
+        /* if a token is an operand */
+        if (kind == NIBTokenKindOperand) {
+            double operand = 0;
+            
+            memcpy(&operand, &bits, sizeof(operand));
+            NIBTokenBufferAppend(tokens, NIBTokenMakeOperand(operand));
+        
+        /* if a token is an operator which can be in an expression */
+        } else if (kind == NIBTokenKindOperator && bits <= NIBButtonDeg &&
+                   (NIBIsBinaryOperatorTag((NSInteger)bits) || NIBIsUnaryOperatorTag((NSInteger)bits) ||
+                    NIBIsParenthesisOperatorTag((NSInteger)bits))) {
+            NIBTokenBufferAppend(tokens, NIBTokenMakeOperator((NIBButtonTag)bits));
+        
+        /* otherwise, the bytes are not encoded tokens */
+        } else {
+            NIBTokenBufferTruncate(tokens, originalCount);
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+NSData *NIBSnapshotDataFromTokens(const NIBToken *tokens, NSUInteger count) {
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:count * NIBSnapshotTokenLength];
+    
+    NIBSnapshotEncodeTokens(tokens, count, data.mutableBytes);
+    
+    return data;
+}
+
+BOOL NIBSnapshotGetTokens(NSData *data, NIBTokenBuffer *tokens) {
+    return NIBSnapshotDecodeTokens(data.bytes, data.length, tokens);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Extension
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBCalculatorSnapshot () {
+    /** The fields as they are saved last. */
+    NSMutableDictionary<NSNumber *, NSData *> *_savedFields;
+    
+    /** The fields which change since the last save. */
+    NSMutableDictionary<NSNumber *, NSData *> *_changedFields;
+    
+    /** The length of the file after the saves which are started, 0 if the next save rewrites the file. */
+    uint64_t _fileLength;
+    
+    /** The serial queue which writes the file. */
+    dispatch_queue_t _queue;
+    
+    /** The boolean value to indicate if a write fails, so the next save rewrites the file. */
+    atomic_bool _needsRewrite;
+}
+
+@property (readwrite, copy, nonatomic) NSString *path;
+
+/**
+ Initialize the snapshot of a file.
+ 
+ @param path    The path of the file.
+ 
+ @return Returns the NIBCalculatorSnapshot instance.
+ */
+- (instancetype)initWithContentsOfFile:(NSString *)path;
+
+/**
+ Load the fields from the last record of each of them in the file.
+ */
+- (void)loadFile;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Implementation
+
+
+@implementation NIBCalculatorSnapshot
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Public Methods
+
+#pragma mark Create A Snapshot
+
++ (instancetype)snapshotWithContentsOfFile:(NSString *)path
+{
+    NIBCalculatorSnapshot *snapshot = [[self alloc] initWithContentsOfFile:path];
+    
+    return snapshot;
+}
+
+#pragma mark Fields
+
+- (NSData *)dataOfField:(NIBSnapshotField)field
+{
+    NSData *data = _changedFields[@(field)];
+    
+    return data ? data : _savedFields[@(field)];
+}
+
+- (void)setData:(NSData *)data ofField:(NIBSnapshotField)field
+{
+    /* if the data is saved last, the field does not change */
+    if ([_savedFields[@(field)] isEqualToData:data]) {
+        [_changedFields removeObjectForKey:@(field)];
+    } else {
+        _changedFields[@(field)] = [data copy];
+    }
+}
+
+#pragma mark Saving
+
+- (void)save
+{
+    /* if no field changes, there is nothing to save */
+    if (_changedFields.count == 0) {
+        return;
+    }
+    
+    NSMutableData *records = [[NSMutableData alloc] init];
+    uint64_t fieldsLength = sizeof(NIBSnapshotHeader);
+    
+    for (NSNumber *field in _changedFields) {
+        NIBSnapshotAppendRecord(records, field.unsignedShortValue, _changedFields[field]);
+    }
+    
+    [_savedFields addEntriesFromDictionary:_changedFields];
+    [_changedFields removeAllObjects];
+    
+    for (NSNumber *field in _savedFields) {
+        fieldsLength += sizeof(NIBSnapshotRecordHeader) + _savedFields[field].length;
+    }
+    
+    // the changed fields are appended to the log, unless there is no file to
+    // append to or the log grows too large for its fields, then the file is
+    // rewritten with the last record of every field
+    BOOL isRewriting = atomic_exchange(&_needsRewrite, NO) || _fileLength == 0 ||
+                       _fileLength + records.length > NIB_SNAPSHOT_COMPACTION_RATIO * fieldsLength;
+    uint64_t offset = _fileLength;
+    
+    if (isRewriting) {
+        NIBSnapshotHeader header = {NIB_SNAPSHOT_MAGIC, NIB_SNAPSHOT_VERSION};
+        NSArray<NSNumber *> *fields = [_savedFields.allKeys sortedArrayUsingSelector:@selector(compare:)];
+        
+        records = [[NSMutableData alloc] initWithBytes:&header length:sizeof(header)];
+        
+        for (NSNumber *field in fields) {
+            NIBSnapshotAppendRecord(records, field.unsignedShortValue, _savedFields[field]);
+        }
+        
+        offset = 0;
+    }
+    
+    _fileLength = offset + records.length;
+    
+    NSString *path = self.path;
+    
+    dispatch_async(_queue, ^{
+        BOOL isWritten = NO;
+        
+        /* if the file is rewritten, replace it at once, so it is never half written */
+        if (isRewriting) {
+            isWritten = [records writeToFile:path options:NSDataWritingAtomic error:NULL];
+        
+        /* otherwise, append the records over any record cut short */
+        } else {
+            int fileDescriptor = open(path.fileSystemRepresentation, O_WRONLY);
+            
+            isWritten = (fileDescriptor >= 0 &&
+                         pwrite(fileDescriptor, records.bytes, records.length, (off_t)offset) == (ssize_t)records.length &&
+                         ftruncate(fileDescriptor, (off_t)(offset + records.length)) == 0);
+            
+            if (fileDescriptor >= 0) close(fileDescriptor);
+        }
+        
+        /* if the file is not written, the next save rewrites it */
+        if (!isWritten) {
+            NSLog(@"Can not save snapshot: %@", path);
+            atomic_store(&self->_needsRewrite, YES);
+        }
+    });
+}
+
+- (void)waitUntilSaved
+{
+    dispatch_sync(_queue, ^{});
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Methods
+
+
+#pragma mark Initialize
+
+- (instancetype)initWithContentsOfFile:(NSString *)path
+{
+    self = [super init];
+    
+    if (self) {
+        _path = [path copy];
+        _savedFields = [[NSMutableDictionary alloc] init];
+        _changedFields = [[NSMutableDictionary alloc] init];
+        _fileLength = 0;
+        _queue = dispatch_queue_create("com.lv.NIBCalculator.snapshot", DISPATCH_QUEUE_SERIAL);
+        atomic_init(&_needsRewrite, NO);
+        
+        [self loadFile];
+    }
+    
+    return self;
+}
+
+#pragma mark Loading
+
+- (void)loadFile
+{
+    NSData *contents = [NSData dataWithContentsOfFile:self.path options:NSDataReadingMappedAlways error:NULL];
+    const uint8_t *bytes = contents.bytes;
+    NSUInteger length = contents.length;
+    NIBSnapshotHeader header;
+    
+    /* if the file is not a snapshot of this version, the first save rewrites it */
+    if (length < sizeof(header)) {
+        return;
+    }
+    
+    memcpy(&header, bytes, sizeof(header));
+    
+    if (header.magic != NIB_SNAPSHOT_MAGIC || header.version != NIB_SNAPSHOT_VERSION) {
+        return;
+    }
+    
+    NSUInteger offset = sizeof(header);
+    
+    while (length - offset >= sizeof(NIBSnapshotRecordHeader)) {
+        NIBSnapshotRecordHeader record;
+        
+        memcpy(&record, bytes + offset, sizeof(record));
+        
+        const uint8_t *data = bytes + offset + sizeof(record);
+        
+        /* if a record is cut short or corrupted, the log ends before it */
+        if (record.length > length - offset - sizeof(record) ||
+            record.checksum != NIBSnapshotChecksum(record.field, data, record.length)) {
+            break;
+        }
+        
+        _savedFields[@(record.field)] = [contents subdataWithRange:NSMakeRange(offset + sizeof(record), record.length)];
+        offset += sizeof(record) + record.length;
+    }
+    
+    _fileLength = offset;
+}
+
+@end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Calculate the checksum of a record, the 32-bit FNV-1a hash of its field, its
+ length and its data.
+ 
+ @param field   The field.
+ @param data    The data of the field.
+ @param length  The length of the data.
+ 
+ @return Returns the checksum.
+ */
+static uint32_t NIBSnapshotChecksum(uint16_t field, const void *data, uint32_t length) {
+    const uint8_t *bytes = data;
+    uint32_t hash = 2166136261u;
+    uint8_t prefix[6];
+    
+    memcpy(prefix, &field, sizeof(field));
+    memcpy(prefix + sizeof(field), &length, sizeof(length));
+    
+    for (NSUInteger i = 0; i < sizeof(prefix); i++) {
+        hash = (hash ^ prefix[i]) * 16777619u;
+    }
+    
+    for (uint32_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    
+    return hash;
+}
+
+/**
+ Append the record of a field to the records.
+ 
+ @param records The records.
+ @param field   The field.
+ @param data    The data of the field.
+ */
+static void NIBSnapshotAppendRecord(NSMutableData *records, uint16_t field, NSData *data) {
+    uint32_t length = (uint32_t)data.length;
+    NIBSnapshotRecordHeader record = {field, 0, length, NIBSnapshotChecksum(field, data.bytes, length)};
+    
+    [records appendBytes:&record length:sizeof(record)];
+    [records appendData:data];
+}
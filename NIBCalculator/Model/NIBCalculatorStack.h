@@ -10,11 +10,147 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Constants
+
+
+/** The number of entries a stack holds in its inline storage without allocation. */
+#define NIB_STACK_INLINE_CAPACITY 32
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Types, Enumeration and Options
+
+
+/**
+ @struct NIBDoubleStack
+ 
+ A stack of doubles, the primitive specialization of `NIBCalculatorStack` for
+ the calculation stack. The first NIB_STACK_INLINE_CAPACITY values are in the
+ inline storage, so a stack on the call stack allocates nothing until it grows
+ beyond it. A stack must be initialized with NIBDoubleStackInit() and its
+ storage must be released with NIBDoubleStackFree(). A stack must not be
+ copied by assignment once it has values.
+ 
+ @field heapValues      The values when they are beyond the inline storage,
+                        otherwise NULL.
+ @field count           The number of values on the stack.
+ @field capacity        The number of values the stack can hold without growing.
+ @field inlineValues    The inline storage of the values.
+ */
+typedef struct NIBDoubleStack {
+    double *_Nullable heapValues;
+    NSUInteger count;
+    NSUInteger capacity;
+    double inlineValues[NIB_STACK_INLINE_CAPACITY];
+} NIBDoubleStack;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Double Stack
+
+
+/**
+ Grow the storage of a stack to hold at least a number of values. The capacity
+ is doubled so pushing is amortized constant time.
+ 
+ @param stack       The stack.
+ @param capacity    The minimum number of values to hold.
+ */
+FOUNDATION_EXPORT void NIBDoubleStackReserve(NIBDoubleStack *stack, NSUInteger capacity);
+
+/**
+ Release the storage of a stack and reset it to an empty stack.
+ 
+ @param stack   The stack.
+ */
+FOUNDATION_EXPORT void NIBDoubleStackFree(NIBDoubleStack *stack);
+
+/**
+ Initialize an empty stack on its inline storage.
+ 
+ @param stack   The stack.
+ */
+NS_INLINE void NIBDoubleStackInit(NIBDoubleStack *stack) {
+    stack->heapValues = NULL;
+    stack->count = 0;
+    stack->capacity = NIB_STACK_INLINE_CAPACITY;
+}
+
+/**
+ Get the values of a stack, from the bottom to the top. The values move when
+ the stack grows.
+ 
+ @param stack   The stack.
+ 
+ @return Returns the values.
+ */
+NS_INLINE double *NIBDoubleStackValues(NIBDoubleStack *stack) {
+    return (stack->heapValues != NULL) ? stack->heapValues : stack->inlineValues;
+}
+
+/**
+ Push a value to a stack.
+ 
+ @param stack   The stack.
+ @param value   The value to push to the stack.
+ */
+NS_INLINE void NIBDoubleStackPush(NIBDoubleStack *stack, double value) {
+    if (stack->count == stack->capacity) {
+        NIBDoubleStackReserve(stack, stack->count + 1);
+    }
+    
+    NIBDoubleStackValues(stack)[stack->count++] = value;
+}
+
+/**
+ Pop a value of a stack.
+ 
+ @param stack   The stack.
+ 
+ @return Returns the value at the top of the stack, or not a number if the stack
+ is empty.
+ */
+NS_INLINE double NIBDoubleStackPop(NIBDoubleStack *stack) {
+    return (stack->count > 0) ? NIBDoubleStackValues(stack)[--stack->count] : NAN;
+}
+
+/**
+ Peek a value of a stack without removing it from the stack.
+ 
+ @param stack   The stack.
+ 
+ @return Returns the value at the top of the stack, or not a number if the stack
+ is empty.
+ */
+NS_INLINE double NIBDoubleStackPeek(NIBDoubleStack *stack) {
+    return (stack->count > 0) ? NIBDoubleStackValues(stack)[stack->count - 1] : NAN;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Interface
+
+
 /**
  `NIBCalculatorStack` acts as the stack data structure.
+ 
+ The first NIB_STACK_INLINE_CAPACITY objects are kept in the inline storage of
+ the stack, the storage is allocated only when the stack grows beyond it and
+ it is kept for reuse when the stack is popped or cleared. A push or a pop
+ costs an assignment of a strong reference, there is no message to a
+ collection. `NIBDoubleStack` is the specialization for doubles.
  */
 @interface NIBCalculatorStack<ObjectType> : NSObject <NSCopying>
 
+/// ----------------
+/// @name Properties
+/// ----------------
+
+/** The number of objects on the stack. */
+@property (readonly, assign, nonatomic) NSUInteger count;
+
 /// -----------------
 /// @name Utitilities
 /// -----------------
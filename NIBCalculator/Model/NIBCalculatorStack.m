@@ -7,6 +7,46 @@
 //
 
 #import "NIBCalculatorStack.h"
+#import "NIBInstrumentation.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Double Stack
+
+
+void NIBDoubleStackReserve(NIBDoubleStack *stack, NSUInteger capacity) {
+    if (capacity <= stack->capacity) {
+        return;
+    }
+    
+    NSUInteger newCapacity = stack->capacity;
+    
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+    
+    double *values = realloc(stack->heapValues, newCapacity * sizeof(double));
+    
+    NIB_COUNT_ALLOCATION(NIBInstrumentationAllocationEvaluationStack, newCapacity * sizeof(double));
+    
+    /* if the storage can not be grown */
+    if (values == NULL) {
+        [NSException raise:NSMallocException format:@"Can not grow calculation stack to %lu values", (unsigned long)newCapacity];
+    }
+    
+    /* if the values move from the inline storage */
+    if (stack->heapValues == NULL) {
+        memcpy(values, stack->inlineValues, stack->count * sizeof(double));
+    }
+    
+    stack->heapValues = values;
+    stack->capacity = newCapacity;
+}
+
+void NIBDoubleStackFree(NIBDoubleStack *stack) {
+    free(stack->heapValues);
+    NIBDoubleStackInit(stack);
+}
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -15,10 +55,27 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-@interface NIBCalculatorStack ()
+@interface NIBCalculatorStack () {
+    /** The objects from the bottom to the top, in the inline storage or beyond it. */
+    __strong id *_objects;
+
+    /** The number of objects the stack can hold without growing. */
+    NSUInteger _capacity;
+    
+    /** The inline storage of the objects. */
+    __strong id _inlineObjects[NIB_STACK_INLINE_CAPACITY];
+}
+
+/** The number of objects on the stack. */
+@property (readwrite, assign, nonatomic) NSUInteger count;
 
-/** The stack. */
-@property (readwrite, strong, nonatomic) NSMutableArray *stack;
+/**
+ Grow the storage of the stack to hold at least a number of objects. The
+ capacity is doubled so pushing is amortized constant time.
+ 
+ @param capacity The minimum number of objects to hold.
+ */
+- (void)reserveCapacity:(NSUInteger)capacity;
 
 @end
 
@@ -39,13 +96,7 @@ NS_ASSUME_NONNULL_END
 
 + (instancetype)stack
 {
-    NIBCalculatorStack *stack = [[self alloc] init];
-    
-    if (stack) {
-        stack.stack = [[NSMutableArray alloc] init];
-    }
-    
-    return stack;
+    return [[self alloc] init];
 }
 
 - (instancetype)init
@@ -53,34 +104,97 @@ NS_ASSUME_NONNULL_END
     self = [super init];
     
     if (self) {
-        _stack = [[NSMutableArray alloc] init];
+        _objects = _inlineObjects;
+        _capacity = NIB_STACK_INLINE_CAPACITY;
     }
     
     return self;
 }
 
+- (void)dealloc
+{
+    // the inline objects are released with the instance, the objects beyond
+    // it are released by hand before their storage
+    [self clear];
+    
+    if (_objects != _inlineObjects) free((void *)_objects);
+}
+
 #pragma mark Utilities
 
 - (void)push:(id)object
 {
-    [self.stack addObject:object];
+    if (_count == _capacity) {
+        [self reserveCapacity:_count + 1];
+    }
+    
+    _objects[_count++] = object;
 }
 
 - (id)pop
 {
-    id topOfStack = self.stack.lastObject;
-    [self.stack removeLastObject];
+    /* if the stack is empty */
+    if (_count == 0) {
+        return nil;
+    }
+    
+    id topOfStack = _objects[--_count];
+    
+    _objects[_count] = nil;
+    
     return topOfStack;
 }
 
 - (id)peek
 {
-    return self.stack.lastObject;
+    return (_count > 0) ? _objects[_count - 1] : nil;
 }
 
 - (void)clear
 {
-    [self.stack removeAllObjects];
+    while (_count > 0) {
+        _objects[--_count] = nil;
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Methods
+
+#pragma mark Storage
+
+- (void)reserveCapacity:(NSUInteger)capacity
+{
+    if (capacity <= _capacity) {
+        return;
+    }
+    
+    NSUInteger newCapacity = _capacity;
+    
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+    
+    // the strong references are moved bitwise, which keeps their ownership,
+    // and the new slots are zeroed so the assignments to them release nothing
+    BOOL isInline = (_objects == _inlineObjects);
+    __strong id *objects = (__strong id *)realloc(isInline ? NULL : (void *)_objects, newCapacity * sizeof(id));
+    
+    /* if the storage can not be grown */
+    if (objects == NULL) {
+        [NSException raise:NSMallocException format:@"Can not grow stack to %lu objects", (unsigned long)newCapacity];
+    }
+    
+    /* if the objects move from the inline storage, the inline slots give up their ownership */
+    if (isInline) {
+        memcpy((void *)objects, (const void *)_inlineObjects, _count * sizeof(id));
+        memset((void *)_inlineObjects, 0, _count * sizeof(id));
+    }
+    
+    memset((void *)(objects + _count), 0, (newCapacity - _count) * sizeof(id));
+    
+    _objects = objects;
+    _capacity = newCapacity;
 }
 
 
@@ -91,8 +205,8 @@ NS_ASSUME_NONNULL_END
 - (NSString *)description
 {
     NSMutableString *description = [NSMutableString stringWithString:@"NIBCalculatorStack: {\n"];
-    for (id obj in self.stack) {
-        [description appendString:[obj description]];
+    for (NSUInteger i = 0; i < _count; i++) {
+        [description appendString:[_objects[i] description]];
         [description appendString:@"\n"];
     }
     [description appendString:@"}"];
@@ -109,11 +223,14 @@ NS_ASSUME_NONNULL_END
 {
     NIBCalculatorStack *newStack = [[[self class] allocWithZone:zone] init];
     
-    for (id obj in self.stack) {
-        [newStack.stack addObject:obj];
+    [newStack reserveCapacity:_count];
+    
+    for (NSUInteger i = 0; i < _count; i++) {
+        [newStack push:_objects[i]];
     }
     
     return newStack;
 }
 
 @end
+
@@ -0,0 +1,143 @@
+//
+//  NIBCalculatorTape.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "NIBToken.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A block which is called with an entry of a tape.
+ 
+ @param tokens  The tokens of the expression of the entry, NULL if there is
+                no token.
+ @param count   The number of tokens.
+ @param result  The result of the expression.
+ @param stop    A reference to a boolean value, set it to YES to stop the
+                enumeration.
+ */
+typedef void (^NIBCalculatorTapeEntryBlock)(const NIBToken *_Nullable tokens, NSUInteger count, double result, BOOL *stop);
+
+/**
+ `NIBCalculatorTape` is the history of the calculations, the expressions which
+ are completed and their results. The last entries are kept in a fixed-size
+ ring buffer in memory, the older entries are dropped from it as the new ones
+ are appended.
+ 
+ The entries are also logged to an append-only binary file which is mapped
+ into memory, so millions of them can be kept. The file is a header and the
+ records of the entries, each record ends with its length so the log can be
+ read from either end. The file is opened without reading the records before
+ the last ones, and it grows by doubling, so an append costs the same however
+ long the log is. A record which is cut short or corrupted ends the log.
+ 
+ @note The tape is not safe to use from multiple threads. It is used on the
+ thread of the calculator which records to it.
+ */
+@interface NIBCalculatorTape : NSObject
+
+/// ----------------
+/// @name Properties
+/// ----------------
+
+/** The path of the file of the log, nil if the tape is only in memory. */
+@property (readonly, copy, nonatomic) NSString *_Nullable path;
+
+/** The number of entries the ring buffer can keep. */
+@property (readonly, assign, nonatomic) NSUInteger capacity;
+
+/** The number of entries in the ring buffer. */
+@property (readonly, assign, nonatomic) NSUInteger count;
+
+/** The number of entries in the log. */
+@property (readonly, assign, nonatomic) uint64_t loggedCount;
+
+/// -------------------------
+/// @name Unavailable Methods
+/// -------------------------
+
+/**
+ The init method is unavailable.
+ */
+- (instancetype)init __attribute__((unavailable("use +tapeWithCapacity:contentsOfFile: method")));
+
+/// --------------------
+/// @name Initialization
+/// --------------------
+
+/**
+ Create a tape. The log is opened from the file if it is a log, otherwise the
+ file is created, and the ring buffer is filled with the last entries of it.
+ If the file can not be opened, the tape is only in memory.
+ 
+ @param capacity    The number of entries the ring buffer can keep, at least 1.
+ @param path        The path of the file of the log, or nil to keep the tape
+                    only in memory.
+ 
+ @return Returns the NIBCalculatorTape instance.
+ */
++ (instancetype)tapeWithCapacity:(NSUInteger)capacity contentsOfFile:(NSString *_Nullable)path;
+
+/// -------------
+/// @name Entries
+/// -------------
+
+/**
+ Append an entry to the ring buffer and the log. An expression which is longer
+ than the ring buffer can keep is only logged.
+ 
+ @param tokens  The tokens of the expression.
+ @param count   The number of tokens.
+ @param result  The result of the expression.
+ */
+- (void)appendExpression:(const NIBToken *_Nullable)tokens count:(NSUInteger)count result:(double)result;
+
+/**
+ Get an entry of the ring buffer.
+ 
+ @param index       The index of the entry, 0 is the oldest entry.
+ @param expression  The buffer to append the tokens of the expression to.
+ @param result      The reference to the result of the expression.
+ 
+ @return Returns YES if there is the entry, otherwise NO and the buffer and the
+ result are not modified.
+ */
+- (BOOL)getEntryAtIndex:(NSUInteger)index
+             expression:(NIBTokenBuffer *_Nullable)expression
+                 result:(double *_Nullable)result;
+
+/**
+ Enumerate the entries of the log, without any object per entry.
+ 
+ @param options The options, NSEnumerationReverse to enumerate from the last
+                entry.
+ @param block   The block to call with each entry. The tokens are valid only
+                during the call.
+ */
+- (void)enumerateLoggedEntriesWithOptions:(NSEnumerationOptions)options
+                               usingBlock:(NIBCalculatorTapeEntryBlock)block;
+
+/**
+ Remove all entries from the ring buffer and the log.
+ */
+- (void)removeAllEntries;
+
+/// -------------
+/// @name Syncing
+/// -------------
+
+/**
+ Start writing the log to the file. The appended entries are in the file even
+ if the app is terminated, but they may be lost if the device stops before
+ they are written.
+ */
+- (void)synchronize;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,678 @@
+//
+//  NIBCalculatorTape.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBCalculatorTape.h"
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+#import "NIBCalculatorSnapshot.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ @struct NIBTapeHeader.
+ 
+ The header of the file of a log. The file is in the byte order of the device,
+ which writes and reads it.
+ 
+ @field magic   The magic number of a log.
+ @field version The version of the format of the file.
+ @field length  The length of the log, the header and the records. The file
+                is longer, the rest of it is for the next records.
+ @field count   The number of records of the log.
+ */
+typedef struct NIBTapeHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t length;
+    uint64_t count;
+} NIBTapeHeader;
+
+/**
+ @struct NIBTapeRecordHeader.
+ 
+ The header of a record, which is followed by the encoded tokens of the
+ expression and the length of the whole record.
+ 
+ @field count       The number of tokens of the expression.
+ @field checksum    The checksum of the count, the result and the tokens.
+ @field result      The bits of the result.
+ */
+typedef struct NIBTapeRecordHeader {
+    uint32_t count;
+    uint32_t checksum;
+    uint64_t result;
+} NIBTapeRecordHeader;
+
+/**
+ @struct NIBTapeRecord.
+ 
+ A record which is read from a log.
+ 
+ @field offset  The offset of the record in the log.
+ @field length  The length of the record.
+ @field tokens  The encoded tokens of the expression.
+ @field count   The number of tokens.
+ @field result  The result of the expression.
+ */
+typedef struct NIBTapeRecord {
+    uint64_t offset;
+    uint64_t length;
+    const uint8_t *tokens;
+    uint32_t count;
+    double result;
+} NIBTapeRecord;
+
+/**
+ @struct NIBTapeEntry.
+ 
+ An entry of the ring buffer. The tokens of the expression are in the ring of
+ tokens, from the position of the first token.
+ 
+ @field firstToken  The position of the first token, counting all the tokens
+                    ever appended to the ring.
+ @field count       The number of tokens.
+ @field result      The result of the expression.
+ */
+typedef struct NIBTapeEntry {
+    uint64_t firstToken;
+    NSUInteger count;
+    double result;
+} NIBTapeEntry;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The magic number of a log, `NIBT` in the file. */
+static const uint32_t NIB_TAPE_MAGIC = 0x5442494E;
+
+/** The version of the format of the file. */
+static const uint32_t NIB_TAPE_VERSION = 1;
+
+/** The length of the file of a new log. */
+static const uint64_t NIB_TAPE_INITIAL_FILE_LENGTH = 64 * 1024;
+
+/** The number of tokens the ring buffer keeps for each of its entries. */
+static const NSUInteger NIB_TAPE_TOKENS_PER_ENTRY = 32;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static uint32_t NIBTapeChecksum(uint32_t, uint64_t, const uint8_t *);
+static uint64_t NIBTapeRecordLength(NSUInteger);
+static BOOL NIBTapeGetRecordAtOffset(const uint8_t *, uint64_t, uint64_t, NIBTapeRecord *);
+static BOOL NIBTapeGetRecordBeforeOffset(const uint8_t *, uint64_t, NIBTapeRecord *);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Extension
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBCalculatorTape () {
+    /** The entries of the ring buffer. */
+    NIBTapeEntry *_entries;
+    
+    /** The index of the oldest entry of the ring buffer. */
+    NSUInteger _firstEntry;
+    
+    /** The ring of the tokens of the entries. */
+    NIBToken *_tokens;
+    
+    /** The number of tokens the ring of tokens can hold. */
+    NSUInteger _tokenCapacity;
+    
+    /** The position after the last token, counting all the tokens ever appended to the ring. */
+    uint64_t _endToken;
+    
+    /** The file descriptor of the file of the log, -1 if there is no log. */
+    int _fileDescriptor;
+    
+    /** The file of the log mapped into memory, NULL if there is no log. */
+    uint8_t *_Nullable _map;
+    
+    /** The length of the mapped file. */
+    uint64_t _mapLength;
+    
+    /** The tokens of the entry which is enumerated, reused by every entry. */
+    NIBTokenBuffer _enumeratedTokens;
+}
+
+@property (readwrite, copy, nonatomic) NSString *_Nullable path;
+@property (readwrite, assign, nonatomic) NSUInteger capacity;
+@property (readwrite, assign, nonatomic) NSUInteger count;
+
+/**
+ Initialize a tape.
+ 
+ @param capacity    The number of entries the ring buffer can keep.
+ @param path        The path of the file of the log, or nil.
+ 
+ @return Returns the NIBCalculatorTape instance.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity contentsOfFile:(NSString *_Nullable)path;
+
+/**
+ Open the log from the file, or create it if the file is not a log.
+ 
+ @return Returns YES if the log is opened, otherwise NO.
+ */
+- (BOOL)openLog;
+
+/**
+ Close the log. The file is cut to the length of the log.
+ */
+- (void)closeLog;
+
+/**
+ Map the file of the log into memory with a length, the file is extended to
+ the length.
+ 
+ @param length  The length.
+ 
+ @return Returns YES if the file is mapped, otherwise NO and the file is not
+ mapped.
+ */
+- (BOOL)mapFileWithLength:(uint64_t)length;
+
+/**
+ Append an entry to the ring buffer.
+ 
+ @param tokens  The tokens of the expression.
+ @param count   The number of tokens.
+ @param result  The result of the expression.
+ */
+- (void)keepExpression:(const NIBToken *_Nullable)tokens count:(NSUInteger)count result:(double)result;
+
+/**
+ Append an entry to the log.
+ 
+ @param tokens  The tokens of the expression.
+ @param count   The number of tokens.
+ @param result  The result of the expression.
+ */
+- (void)logExpression:(const NIBToken *_Nullable)tokens count:(NSUInteger)count result:(double)result;
+
+/**
+ Fill the ring buffer with the last entries of the log.
+ */
+- (void)keepLastLoggedEntries;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Implementation
+
+
+@implementation NIBCalculatorTape
+
+- (void)dealloc
+{
+    [self closeLog];
+    free(_entries);
+    free(_tokens);
+    NIBTokenBufferFree(&_enumeratedTokens);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Public Methods
+
+#pragma mark Create A Tape
+
++ (instancetype)tapeWithCapacity:(NSUInteger)capacity contentsOfFile:(NSString *)path
+{
+    NIBCalculatorTape *tape = [[self alloc] initWithCapacity:capacity contentsOfFile:path];
+    
+    return tape;
+}
+
+#pragma mark Getters
+
+- (uint64_t)loggedCount
+{
+    return _map ? ((const NIBTapeHeader *)_map)->count : 0;
+}
+
+#pragma mark Entries
+
+- (void)appendExpression:(const NIBToken *)tokens count:(NSUInteger)count result:(double)result
+{
+    [self keepExpression:tokens count:count result:result];
+    [self logExpression:tokens count:count result:result];
+}
+
+- (BOOL)getEntryAtIndex:(NSUInteger)index expression:(NIBTokenBuffer *)expression result:(double *)result
+{
+    /* if there is no entry at the index, return immediately */
+    if (index >= self.count) {
+        return NO;
+    }
+    
+    NIBTapeEntry entry = _entries[(_firstEntry + index) % self.capacity];
+    
+    if (expression) {
+        NSUInteger firstToken = (NSUInteger)(entry.firstToken % _tokenCapacity);
+        NSUInteger countBeforeWrapping = MIN(entry.count, _tokenCapacity - firstToken);
+        
+        NIBTokenBufferAppendTokens(expression, _tokens + firstToken, countBeforeWrapping);
+        NIBTokenBufferAppendTokens(expression, _tokens, entry.count - countBeforeWrapping);
+    }
+    
+    if (result) {
+        *result = entry.result;
+    }
+    
+    return YES;
+}
+
+- (void)enumerateLoggedEntriesWithOptions:(NSEnumerationOptions)options
+                               usingBlock:(NIBCalculatorTapeEntryBlock)block
+{
+    /* if there is no log, there is no entry */
+    if (!_map) {
+        return;
+    }
+    
+    uint64_t logLength = ((const NIBTapeHeader *)_map)->length;
+    BOOL isReverse = (options & NSEnumerationReverse) != 0;
+    uint64_t offset = isReverse ? logLength : sizeof(NIBTapeHeader);
+    NIBTapeRecord record;
+    BOOL stop = NO;
+    
+    while (!stop) {
+        /* if there is no valid record next, the enumeration ends */
+        if (isReverse ? !NIBTapeGetRecordBeforeOffset(_map, offset, &record)
+                      : !NIBTapeGetRecordAtOffset(_map, offset, logLength, &record)) {
+            break;
+        }
+        
+        offset = isReverse ? record.offset : record.offset + record.length;
+        
+        NIBTokenBufferTruncate(&_enumeratedTokens, 0);
+        
+        /* if the tokens are not known operators, the entry is from a later version and skipped */
+        if (NIBSnapshotDecodeTokens(record.tokens, record.count * NIBSnapshotTokenLength, &_enumeratedTokens)) {
+            block(_enumeratedTokens.tokens, _enumeratedTokens.count, record.result, &stop);
+        }
+    }
+}
+
+- (void)removeAllEntries
+{
+    _firstEntry = 0;
+    _endToken = 0;
+    self.count = 0;
+    
+    if (_map) {
+        NIBTapeHeader *header = (NIBTapeHeader *)_map;
+        
+        header->length = sizeof(NIBTapeHeader);
+        header->count = 0;
+    }
+}
+
+#pragma mark Syncing
+
+- (void)synchronize
+{
+    if (_map) {
+        msync(_map, (size_t)((const NIBTapeHeader *)_map)->length, MS_ASYNC);
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Methods
+
+
+#pragma mark Initialize
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity contentsOfFile:(NSString *)path
+{
+    self = [super init];
+    
+    if (self) {
+        _capacity = MAX(capacity, 1);
+        _count = 0;
+        _entries = calloc(_capacity, sizeof(NIBTapeEntry));
+        _firstEntry = 0;
+        _tokenCapacity = _capacity * NIB_TAPE_TOKENS_PER_ENTRY;
+        _tokens = calloc(_tokenCapacity, sizeof(NIBToken));
+        _endToken = 0;
+        _fileDescriptor = -1;
+        _map = NULL;
+        _mapLength = 0;
+        _enumeratedTokens = (NIBTokenBuffer){NULL, 0, 0};
+        _path = [path copy];
+        
+        /* if the log is opened, keep its last entries in memory */
+        if (path && [self openLog]) {
+            [self keepLastLoggedEntries];
+        }
+    }
+    
+    return self;
+}
+
+#pragma mark Log File
+
+- (BOOL)openLog
+{
+    _fileDescriptor = open(self.path.fileSystemRepresentation, O_RDWR | O_CREAT, 0644);
+    
+    struct stat status;
+    
+    /* if the file can not be opened, the tape is only in memory */
+    if (_fileDescriptor < 0 || fstat(_fileDescriptor, &status) != 0) {
+        NSLog(@"Can not open tape: %@", self.path);
+        [self closeLog];
+        return NO;
+    }
+    
+    /* if the file may be a log, map it as it is */
+    if ((uint64_t)status.st_size >= sizeof(NIBTapeHeader) && [self mapFileWithLength:(uint64_t)status.st_size]) {
+        NIBTapeHeader *header = (NIBTapeHeader *)_map;
+        
+        /* if the file is a log of this version */
+        if (header->magic == NIB_TAPE_MAGIC && header->version == NIB_TAPE_VERSION &&
+            header->length >= sizeof(NIBTapeHeader) && header->length <= _mapLength) {
+            NIBTapeRecord record;
+            
+            // only the last record is checked, so the log is opened at once.
+            // If it is corrupted, the log is read from the start and ends
+            // before the first record which is corrupted
+            if (header->count > 0 && !NIBTapeGetRecordBeforeOffset(_map, header->length, &record)) {
+                uint64_t offset = sizeof(NIBTapeHeader);
+                uint64_t count = 0;
+                
+                while (NIBTapeGetRecordAtOffset(_map, offset, header->length, &record)) {
+                    offset += record.length;
+                    count++;
+                }
+                
+                header->length = offset;
+                header->count = count;
+            }
+            
+            return YES;
+        }
+        
+        munmap(_map, (size_t)_mapLength);
+        _map = NULL;
+    }
+    
+    /* otherwise, the file is overwritten with an empty log */
+    if (![self mapFileWithLength:NIB_TAPE_INITIAL_FILE_LENGTH]) {
+        NSLog(@"Can not create tape: %@", self.path);
+        [self closeLog];
+        return NO;
+    }
+    
+    *(NIBTapeHeader *)_map = (NIBTapeHeader){NIB_TAPE_MAGIC, NIB_TAPE_VERSION, sizeof(NIBTapeHeader), 0};
+    
+    return YES;
+}
+
+- (void)closeLog
+{
+    if (_map) {
+        uint64_t logLength = ((const NIBTapeHeader *)_map)->length;
+        
+        munmap(_map, (size_t)_mapLength);
+        ftruncate(_fileDescriptor, (off_t)logLength);
+        _map = NULL;
+        _mapLength = 0;
+    }
+    
+    if (_fileDescriptor >= 0) {
+        close(_fileDescriptor);
+        _fileDescriptor = -1;
+    }
+}
+
+- (BOOL)mapFileWithLength:(uint64_t)length
+{
+    /* if the file can not be extended to the length, it is not mapped */
+    if (ftruncate(_fileDescriptor, (off_t)length) != 0) {
+        return NO;
+    }
+    
+    void *map = mmap(NULL, (size_t)length, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+    
+    if (map == MAP_FAILED) {
+        return NO;
+    }
+    
+    /* if the file is mapped before, the old mapping is replaced */
+    if (_map) {
+        munmap(_map, (size_t)_mapLength);
+    }
+    
+    _map = map;
+    _mapLength = length;
+    
+    return YES;
+}
+
+#pragma mark Appending Entries
+
+- (void)keepExpression:(const NIBToken *)tokens count:(NSUInteger)count result:(double)result
+{
+    /* if the expression is longer than the ring of tokens, it is only logged */
+    if (count > _tokenCapacity) {
+        return;
+    }
+    
+    /* drop the oldest entries until the entry and its tokens fit in */
+    while (self.count > 0 &&
+           (self.count == self.capacity || _endToken + count - _entries[_firstEntry].firstToken > _tokenCapacity)) {
+        _firstEntry = (_firstEntry + 1) % self.capacity;
+        self.count--;
+    }
+    
+    NSUInteger firstToken = (NSUInteger)(_endToken % _tokenCapacity);
+    NSUInteger countBeforeWrapping = MIN(count, _tokenCapacity - firstToken);
+    
+    if (count > 0) {
+        memcpy(_tokens + firstToken, tokens, countBeforeWrapping * sizeof(NIBToken));
+        memcpy(_tokens, tokens + countBeforeWrapping, (count - countBeforeWrapping) * sizeof(NIBToken));
+    }
+    
+    _entries[(_firstEntry + self.count) % self.capacity] = (NIBTapeEntry){_endToken, count, result};
+    _endToken += count;
+    self.count++;
+}
+
+- (void)logExpression:(const NIBToken *)tokens count:(NSUInteger)count result:(double)result
+{
+    /* if there is no log, the entry is only in memory */
+    if (!_map) {
+        return;
+    }
+    
+    uint64_t offset = ((const NIBTapeHeader *)_map)->length;
+    uint64_t recordLength = NIBTapeRecordLength(count);
+    
+    // the file grows by doubling, so the remapping costs a constant time per
+    // append on average however long the log is
+    if (offset + recordLength > _mapLength &&
+        ![self mapFileWithLength:MAX(2 * _mapLength, offset + recordLength)]) {
+        NSLog(@"Can not extend tape: %@", self.path);
+        [self closeLog];
+        return;
+    }
+    
+    uint8_t *bytes = _map + offset;
+    NIBTapeRecordHeader record = {(uint32_t)count, 0, 0};
+    uint32_t length = (uint32_t)recordLength;
+    
+    memcpy(&record.result, &result, sizeof(result));
+    NIBSnapshotEncodeTokens(tokens, count, bytes + sizeof(record));
+    record.checksum = NIBTapeChecksum(record.count, record.result, bytes + sizeof(record));
+    memcpy(bytes, &record, sizeof(record));
+    memcpy(bytes + recordLength - sizeof(length), &length, sizeof(length));
+    
+    /* the record is in the log only when the header counts it */
+    NIBTapeHeader *header = (NIBTapeHeader *)_map;
+    
+    header->length = offset + recordLength;
+    header->count++;
+}
+
+- (void)keepLastLoggedEntries
+{
+    uint64_t logLength = ((const NIBTapeHeader *)_map)->length;
+    uint64_t offset = logLength;
+    NIBTapeRecord record;
+    
+    /* find the first of the last entries which the ring buffer can keep */
+    for (NSUInteger i = 0; i < self.capacity && NIBTapeGetRecordBeforeOffset(_map, offset, &record); i++) {
+        offset = record.offset;
+    }
+    
+    /* keep the entries in order */
+    while (NIBTapeGetRecordAtOffset(_map, offset, logLength, &record)) {
+        NIBTokenBufferTruncate(&_enumeratedTokens, 0);
+        
+        if (NIBSnapshotDecodeTokens(record.tokens, record.count * NIBSnapshotTokenLength, &_enumeratedTokens)) {
+            [self keepExpression:_enumeratedTokens.tokens count:_enumeratedTokens.count result:record.result];
+        }
+        
+        offset += record.length;
+    }
+}
+
+@end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Calculate the checksum of a record, the 32-bit FNV-1a hash of its count, its
+ result and its encoded tokens.
+ 
+ @param count   The number of tokens.
+ @param result  The bits of the result.
+ @param tokens  The encoded tokens.
+ 
+ @return Returns the checksum.
+ */
+static uint32_t NIBTapeChecksum(uint32_t count, uint64_t result, const uint8_t *tokens) {
+    uint32_t hash = 2166136261u;
+    uint8_t prefix[12];
+    
+    memcpy(prefix, &count, sizeof(count));
+    memcpy(prefix + sizeof(count), &result, sizeof(result));
+    
+    for (NSUInteger i = 0; i < sizeof(prefix); i++) {
+        hash = (hash ^ prefix[i]) * 16777619u;
+    }
+    
+    for (uint64_t i = 0; i < (uint64_t)count * NIBSnapshotTokenLength; i++) {
+        hash = (hash ^ tokens[i]) * 16777619u;
+    }
+    
+    return hash;
+}
+
+/**
+ Get the length of a record.
+ 
+ @param count   The number of tokens of the expression.
+ 
+ @return Returns the length of the header, the encoded tokens and the length
+ at the end of the record.
+ */
+static uint64_t NIBTapeRecordLength(NSUInteger count) {
+    return sizeof(NIBTapeRecordHeader) + (uint64_t)count * NIBSnapshotTokenLength + sizeof(uint32_t);
+}
+
+/**
+ Get the record at an offset of a log.
+ 
+ @param bytes       The bytes of the log.
+ @param offset      The offset of the record.
+ @param logLength   The length of the log.
+ @param record      The reference to the record.
+ 
+ @return Returns YES if there is a valid record at the offset, otherwise NO.
+ */
+static BOOL NIBTapeGetRecordAtOffset(const uint8_t *bytes, uint64_t offset, uint64_t logLength, NIBTapeRecord *record) {
+    NIBTapeRecordHeader header;
+    uint32_t length = 0;
+    
+    /* if the header is cut short, there is no record */
+    if (offset < sizeof(NIBTapeHeader) || logLength < offset || logLength - offset < NIBTapeRecordLength(0)) {
+        return NO;
+    }
+    
+    memcpy(&header, bytes + offset, sizeof(header));
+    
+    uint64_t recordLength = NIBTapeRecordLength(header.count);
+    
+    /* if the record is cut short or corrupted, there is no record */
+    if (logLength - offset < recordLength) {
+        return NO;
+    }
+    
+    memcpy(&length, bytes + offset + recordLength - sizeof(length), sizeof(length));
+    
+    if (length != recordLength ||
+        header.checksum != NIBTapeChecksum(header.count, header.result, bytes + offset + sizeof(header))) {
+        return NO;
+    }
+    
+    record->offset = offset;
+    record->length = recordLength;
+    record->tokens = bytes + offset + sizeof(header);
+    record->count = header.count;
+    memcpy(&record->result, &header.result, sizeof(record->result));
+    
+    return YES;
+}
+
+/**
+ Get the record which ends at an offset of a log, from the length at the end
+ of it.
+ 
+ @param bytes   The bytes of the log.
+ @param offset  The offset after the record.
+ @param record  The reference to the record.
+ 
+ @return Returns YES if there is a valid record before the offset, otherwise NO.
+ */
+static BOOL NIBTapeGetRecordBeforeOffset(const uint8_t *bytes, uint64_t offset, NIBTapeRecord *record) {
+    uint32_t length = 0;
+    
+    /* if there is no room for a record, there is no record */
+    if (offset < sizeof(NIBTapeHeader) + NIBTapeRecordLength(0)) {
+        return NO;
+    }
+    
+    memcpy(&length, bytes + offset - sizeof(length), sizeof(length));
+    
+    if (length > offset - sizeof(NIBTapeHeader)) {
+        return NO;
+    }
+    
+    return NIBTapeGetRecordAtOffset(bytes, offset - length, offset, record);
+}
@@ -0,0 +1,175 @@
+//
+//  NIBDecimal128.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Types, Enumeration and Options
+
+
+/**
+ @struct NIBDecimal128
+ 
+ A decimal floating point number of 128 bits in the class of IEEE 754
+ decimal128: a coefficient of up to 34 decimal digits, an exponent from -6176
+ to 6111 and a sign. The coefficient takes the low 113 bits, the biased
+ exponent the next 14 bits and the sign the top bit. An exponent field of all
+ ones is not a number.
+ 
+ Every operation rounds its exact result to 34 digits, half to even. A result
+ which overflows or has no value, such as a division by zero, is not a number,
+ as the kernels of the calculator report their errors.
+ 
+ @field low     The low 64 bits of the coefficient.
+ @field high    The high 49 bits of the coefficient, the biased exponent and
+                the sign.
+ */
+typedef struct NIBDecimal128 {
+    uint64_t low;
+    uint64_t high;
+} NIBDecimal128;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Creating Decimals
+
+
+/**
+ Create a decimal of coefficient x 10^exponent.
+ 
+ @param coefficient The coefficient.
+ @param exponent    The exponent.
+ @param isNegative  YES if the decimal is negative, otherwise NO.
+ 
+ @return Returns the decimal, rounded to 34 digits if it has to.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128Make(uint64_t coefficient, int exponent, BOOL isNegative);
+
+/**
+ Create a decimal of the shortest decimal string which reads back to a double,
+ so the double of a typed number, such as 0.1, is the typed number.
+ 
+ @param value   The double.
+ 
+ @return Returns the decimal, or not a number if the double is not a number or
+ infinity.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128FromDouble(double value);
+
+/**
+ Create a decimal which is not a number.
+ 
+ @return Returns the decimal which is not a number.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128NotANumber(void);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Converting Decimals
+
+
+/**
+ Convert a decimal to the nearest double.
+ 
+ @param decimal The decimal.
+ 
+ @return Returns the nearest double, or NAN if the decimal is not a number.
+ */
+FOUNDATION_EXPORT double NIBDecimal128ToDouble(NIBDecimal128 decimal);
+
+/**
+ Get the integer of a decimal.
+ 
+ @param decimal The decimal.
+ @param integer The integer of the decimal.
+ 
+ @return Returns YES if the decimal is an integer which fits in 64 bits,
+ otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBDecimal128GetInteger(NIBDecimal128 decimal, int64_t *integer);
+
+/**
+ Check if a decimal is not a number.
+ 
+ @param decimal The decimal.
+ 
+ @return Returns YES if the decimal is not a number, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBDecimal128IsNaN(NIBDecimal128 decimal);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Arithmetic
+
+
+/**
+ Add two decimals.
+ 
+ @param leftOperand     The left operand.
+ @param rightOperand    The right operand.
+ 
+ @return Returns the sum.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128Add(NIBDecimal128 leftOperand, NIBDecimal128 rightOperand);
+
+/**
+ Subtract a decimal from another.
+ 
+ @param leftOperand     The left operand.
+ @param rightOperand    The right operand.
+ 
+ @return Returns the difference.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128Subtract(NIBDecimal128 leftOperand, NIBDecimal128 rightOperand);
+
+/**
+ Multiply two decimals.
+ 
+ @param leftOperand     The left operand.
+ @param rightOperand    The right operand.
+ 
+ @return Returns the product.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128Multiply(NIBDecimal128 leftOperand, NIBDecimal128 rightOperand);
+
+/**
+ Divide a decimal by another.
+ 
+ @param leftOperand     The dividend.
+ @param rightOperand    The divisor.
+ 
+ @return Returns the quotient, or not a number if the divisor is zero.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128Divide(NIBDecimal128 leftOperand, NIBDecimal128 rightOperand);
+
+/**
+ Raise a decimal to an integer power by squaring.
+ 
+ @param base    The base.
+ @param power   The power.
+ 
+ @return Returns the power of the base, or not a number if it overflows or the
+ base is zero and the power is negative.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128RaiseToIntegerPower(NIBDecimal128 base, int64_t power);
+
+/**
+ Multiply a decimal by a power of ten. Only the exponent changes, so the result
+ is exact unless it overflows or underflows.
+ 
+ @param decimal The decimal.
+ @param power   The power of ten.
+ 
+ @return Returns decimal x 10^power.
+ */
+FOUNDATION_EXPORT NIBDecimal128 NIBDecimal128ScaleByPowerOfTen(NIBDecimal128 decimal, int64_t power);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,844 @@
+//
+//  NIBDecimal128.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBDecimal128.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ @struct NIBDecimalParts.
+ 
+ The unpacked fields of a decimal.
+ 
+ @field coefficient The coefficient.
+ @field exponent    The exponent.
+ @field isNegative  The boolean value to indicate if the decimal is negative.
+ @field isNaN       The boolean value to indicate if the decimal is not a number.
+ */
+typedef struct NIBDecimalParts {
+    unsigned __int128 coefficient;
+    int_least64_t exponent;
+    BOOL isNegative;
+    BOOL isNaN;
+} NIBDecimalParts;
+
+/**
+ @struct NIBUInt256.
+ 
+ An unsigned integer of 256 bits which holds the exact results of the
+ operations before they are rounded.
+ 
+ @field words   The words from the least significant one.
+ */
+typedef struct NIBUInt256 {
+    uint64_t words[4];
+} NIBUInt256;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The number of digits of a coefficient. */
+#define NIB_DECIMAL_DIGITS 34
+
+/** The smallest exponent. */
+#define NIB_DECIMAL_MIN_EXPONENT -6176
+
+/** The largest exponent. */
+#define NIB_DECIMAL_MAX_EXPONENT 6111
+
+/** The exponent field of not a number. */
+#define NIB_DECIMAL_NAN_EXPONENT_FIELD 0x3FFF
+
+/** The number of bits of the coefficient. */
+#define NIB_DECIMAL_COEFFICIENT_BITS 113
+
+/** The powers of ten 10^0 to 10^19 which fit in 64 bits. */
+static const uint64_t NIB_POWERS_OF_TEN_64[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+/** The power of ten 10^19 times a power of ten of 64 bits. */
+#define NIB_POWER_OF_TEN_ABOVE_19(power) ((unsigned __int128)10000000000000000000ULL * (power))
+
+/** The powers of ten 10^0 to 10^38 which fit in 128 bits. */
+static const unsigned __int128 NIB_POWERS_OF_TEN_128[39] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL,
+    NIB_POWER_OF_TEN_ABOVE_19(10ULL), NIB_POWER_OF_TEN_ABOVE_19(100ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(1000ULL), NIB_POWER_OF_TEN_ABOVE_19(10000ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(100000ULL), NIB_POWER_OF_TEN_ABOVE_19(1000000ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(10000000ULL), NIB_POWER_OF_TEN_ABOVE_19(100000000ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(1000000000ULL), NIB_POWER_OF_TEN_ABOVE_19(10000000000ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(100000000000ULL), NIB_POWER_OF_TEN_ABOVE_19(1000000000000ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(10000000000000ULL), NIB_POWER_OF_TEN_ABOVE_19(100000000000000ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(1000000000000000ULL), NIB_POWER_OF_TEN_ABOVE_19(10000000000000000ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(100000000000000000ULL), NIB_POWER_OF_TEN_ABOVE_19(1000000000000000000ULL),
+    NIB_POWER_OF_TEN_ABOVE_19(10000000000000000000ULL)
+};
+
+/** The powers of ten 10^0 to 10^22, each exact in a double. */
+static const double NIB_DOUBLE_POWERS_OF_TEN[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/** The largest integer a double holds exactly. */
+static const double NIB_MAX_EXACT_DOUBLE_INTEGER = 9007199254740992.0; // 2^53
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static NIBDecimalParts NIBDecimalUnpack(NIBDecimal128);
+static NIBDecimal128 NIBDecimalPack(unsigned __int128, int_least64_t, BOOL);
+static NIBDecimal128 NIBDecimalRound(NIBUInt256, int_least64_t, BOOL, BOOL);
+static NIBDecimal128 NIBDecimalAddParts(NIBDecimalParts, NIBDecimalParts);
+static NSUInteger NIBDigitsOfUInt128(unsigned __int128);
+static NIBUInt256 NIBUInt256FromUInt128(unsigned __int128);
+static NIBUInt256 NIBUInt256Multiply(unsigned __int128, unsigned __int128);
+static void NIBUInt256MultiplyByPowerOfTen(NIBUInt256 *, NSUInteger);
+static uint64_t NIBUInt256DivideByWord(NIBUInt256 *, uint64_t);
+static BOOL NIBUInt256DivideByPowerOfTen(NIBUInt256 *, NSUInteger);
+static unsigned __int128 NIBUInt256Divide(NIBUInt256, unsigned __int128, BOOL *);
+static NSUInteger NIBUInt256BitLength(NIBUInt256);
+static BOOL NIBUInt256IsUInt128(NIBUInt256);
+static unsigned __int128 NIBUInt256ToUInt128(NIBUInt256);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Creating Decimals
+
+
+NIBDecimal128 NIBDecimal128Make(uint64_t coefficient, int exponent, BOOL isNegative) {
+    return NIBDecimalRound(NIBUInt256FromUInt128(coefficient), exponent, isNegative, NO);
+}
+
+NIBDecimal128 NIBDecimal128FromDouble(double value) {
+    
+    /* if the value is not a number or infinity */
+    if (isnan(value) || isinf(value)) {
+        return NIBDecimal128NotANumber();
+    }
+    
+    BOOL isNegative = signbit(value);
+    double magnitude = fabs(value);
+    
+    // most numbers of the calculator are typed with a few fraction digits. The
+    // fewest fraction digits whose integer reads back to the value exactly,
+    // dividing by an exact power of ten with one rounding, are the shortest
+    // decimal, which takes neither formatting nor parsing
+    for (NSUInteger fractionDigits = 0; fractionDigits < 23; fractionDigits++) {
+        double scaled = round(magnitude * NIB_DOUBLE_POWERS_OF_TEN[fractionDigits]);
+        
+        /* if the integer is not exact in a double any more, stop */
+        if (scaled >= NIB_MAX_EXACT_DOUBLE_INTEGER) {
+            break;
+        }
+        
+        /* if the integer reads back to the value */
+        if (scaled / NIB_DOUBLE_POWERS_OF_TEN[fractionDigits] == magnitude) {
+            return NIBDecimalPack((unsigned __int128)scaled, -(int_least64_t)fractionDigits, isNegative);
+        }
+    }
+    
+    /* otherwise, find the shortest digits of 15 to 17 which read back to the value */
+    char buffer[32];
+    
+    for (int precision = 15; precision <= 17; precision++) {
+        snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, magnitude);
+        
+        if (precision == 17 || strtod(buffer, NULL) == magnitude) {
+            break;
+        }
+    }
+    
+    /* read the digits and the exponent of d.ddddde±x */
+    unsigned __int128 coefficient = 0;
+    int_least64_t fractionDigits = 0;
+    BOOL isFraction = NO;
+    const char *character = buffer;
+    
+    for (; *character != 'e'; character++) {
+        if (*character == '.') {
+            isFraction = YES;
+        } else {
+            coefficient = coefficient * 10 + (unsigned)(*character - '0');
+            fractionDigits += isFraction ? 1 : 0;
+        }
+    }
+    
+    int_least64_t exponent = strtol(character + 1, NULL, 10);
+    
+    return NIBDecimalRound(NIBUInt256FromUInt128(coefficient), exponent - fractionDigits, isNegative, NO);
+}
+
+NIBDecimal128 NIBDecimal128NotANumber(void) {
+    NIBDecimal128 decimal;
+    decimal.low = 0;
+    decimal.high = (uint64_t)NIB_DECIMAL_NAN_EXPONENT_FIELD << (NIB_DECIMAL_COEFFICIENT_BITS - 64);
+    return decimal;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Converting Decimals
+
+
+double NIBDecimal128ToDouble(NIBDecimal128 decimal) {
+    NIBDecimalParts parts = NIBDecimalUnpack(decimal);
+    
+    /* if the decimal is not a number */
+    if (parts.isNaN) {
+        return NAN;
+    }
+    
+    double result = NAN;
+    
+    // a coefficient exact in a double multiplied or divided by an exact power
+    // of ten is rounded once, which is the nearest double
+    if (parts.coefficient < (unsigned __int128)NIB_MAX_EXACT_DOUBLE_INTEGER &&
+        parts.exponent >= -22 && parts.exponent <= 22) {
+        
+        double coefficient = (double)parts.coefficient;
+        
+        if (parts.exponent < 0) {
+            result = coefficient / NIB_DOUBLE_POWERS_OF_TEN[-parts.exponent];
+        } else {
+            result = coefficient * NIB_DOUBLE_POWERS_OF_TEN[parts.exponent];
+        }
+    
+    /* otherwise, let the parser of the C library round the digits */
+    } else {
+        char buffer[64];
+        char digits[40];
+        NSUInteger digitCount = 0;
+        unsigned __int128 coefficient = parts.coefficient;
+        
+        do {
+            digits[digitCount++] = (char)('0' + (unsigned)(coefficient % 10));
+            coefficient /= 10;
+        } while (coefficient != 0);
+        
+        /* write the digits from the most significant one */
+        for (NSUInteger i = 0; i < digitCount; i++) {
+            buffer[i] = digits[digitCount - 1 - i];
+        }
+        
+        snprintf(buffer + digitCount, sizeof(buffer) - digitCount, "e%lld", (long long)parts.exponent);
+        result = strtod(buffer, NULL);
+    }
+    
+    return parts.isNegative ? -result : result;
+}
+
+BOOL NIBDecimal128GetInteger(NIBDecimal128 decimal, int64_t *integer) {
+    NIBDecimalParts parts = NIBDecimalUnpack(decimal);
+    unsigned __int128 magnitude = parts.coefficient;
+    
+    /* if the decimal is not a number */
+    if (parts.isNaN) {
+        return NO;
+    }
+    
+    /* if the decimal has fraction digits, they must be zeros */
+    if (parts.exponent < 0) {
+        /* if the exponent is below the digits of a coefficient, only zero is an integer */
+        if (parts.exponent < -NIB_DECIMAL_DIGITS) {
+            if (magnitude != 0) return NO;
+        } else {
+            unsigned __int128 divisor = NIB_POWERS_OF_TEN_128[-parts.exponent];
+            
+            if (magnitude % divisor != 0) return NO;
+            magnitude /= divisor;
+        }
+    
+    /* otherwise, the decimal is an integer with trailing zeros */
+    } else if (magnitude != 0) {
+        /* if the trailing zeros alone do not fit in 64 bits */
+        if (parts.exponent > 18) return NO;
+        
+        unsigned __int128 scaled = magnitude * NIB_POWERS_OF_TEN_128[parts.exponent];
+        
+        /* if the multiplication overflows */
+        if (scaled / NIB_POWERS_OF_TEN_128[parts.exponent] != magnitude) return NO;
+        magnitude = scaled;
+    }
+    
+    /* if the integer does not fit in 64 bits */
+    if (magnitude > (unsigned __int128)INT64_MAX) {
+        return NO;
+    }
+    
+    *integer = parts.isNegative ? -(int64_t)magnitude : (int64_t)magnitude;
+    
+    return YES;
+}
+
+BOOL NIBDecimal128IsNaN(NIBDecimal128 decimal) {
+    return NIBDecimalUnpack(decimal).isNaN;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Arithmetic
+
+
+NIBDecimal128 NIBDecimal128Add(NIBDecimal128 leftOperand, NIBDecimal128 rightOperand) {
+    return NIBDecimalAddParts(NIBDecimalUnpack(leftOperand), NIBDecimalUnpack(rightOperand));
+}
+
+NIBDecimal128 NIBDecimal128Subtract(NIBDecimal128 leftOperand, NIBDecimal128 rightOperand) {
+    NIBDecimalParts rightParts = NIBDecimalUnpack(rightOperand);
+    
+    /* subtraction is the addition of the opposite */
+    rightParts.isNegative = !rightParts.isNegative;
+    
+    return NIBDecimalAddParts(NIBDecimalUnpack(leftOperand), rightParts);
+}
+
+NIBDecimal128 NIBDecimal128Multiply(NIBDecimal128 leftOperand, NIBDecimal128 rightOperand) {
+    NIBDecimalParts left = NIBDecimalUnpack(leftOperand);
+    NIBDecimalParts right = NIBDecimalUnpack(rightOperand);
+    
+    /* if an operand is not a number */
+    if (left.isNaN || right.isNaN) {
+        return NIBDecimal128NotANumber();
+    }
+    
+    /* the product of two coefficients of 113 bits fits in 256 bits */
+    return NIBDecimalRound(NIBUInt256Multiply(left.coefficient, right.coefficient),
+                           left.exponent + right.exponent,
+                           left.isNegative != right.isNegative,
+                           NO);
+}
+
+NIBDecimal128 NIBDecimal128Divide(NIBDecimal128 leftOperand, NIBDecimal128 rightOperand) {
+    NIBDecimalParts left = NIBDecimalUnpack(leftOperand);
+    NIBDecimalParts right = NIBDecimalUnpack(rightOperand);
+    
+    /* if an operand is not a number or the divisor is zero */
+    if (left.isNaN || right.isNaN || right.coefficient == 0) {
+        return NIBDecimal128NotANumber();
+    }
+    
+    BOOL isNegative = (left.isNegative != right.isNegative);
+    
+    /* if the dividend is zero, the quotient is zero */
+    if (left.coefficient == 0) {
+        return NIBDecimalPack(0, left.exponent - right.exponent, isNegative);
+    }
+    
+    // the dividend is scaled to have 35 digits more than the divisor, so the
+    // quotient has 35 or 36 digits, one more than a coefficient to round it,
+    // and the remainder tells if the dropped part is zero
+    NSUInteger scale = NIBDigitsOfUInt128(right.coefficient) + NIB_DECIMAL_DIGITS + 1 - NIBDigitsOfUInt128(left.coefficient);
+    NIBUInt256 dividend = NIBUInt256FromUInt128(left.coefficient);
+    unsigned __int128 quotient = 0;
+    BOOL isInexact = NO;
+    
+    NIBUInt256MultiplyByPowerOfTen(&dividend, scale);
+    
+    /* if the divisor fits in a word, which is the case of typed numbers, divide word by word */
+    if ((right.coefficient >> 64) == 0) {
+        isInexact = (NIBUInt256DivideByWord(&dividend, (uint64_t)right.coefficient) != 0);
+        quotient = NIBUInt256ToUInt128(dividend);
+    } else {
+        quotient = NIBUInt256Divide(dividend, right.coefficient, &isInexact);
+    }
+    
+    return NIBDecimalRound(NIBUInt256FromUInt128(quotient),
+                           left.exponent - right.exponent - (int_least64_t)scale,
+                           isNegative,
+                           isInexact);
+}
+
+NIBDecimal128 NIBDecimal128RaiseToIntegerPower(NIBDecimal128 base, int64_t power) {
+    
+    /* if the base is not a number */
+    if (NIBDecimal128IsNaN(base)) {
+        return base;
+    }
+    
+    uint64_t exponent = (power < 0) ? -(uint64_t)power : (uint64_t)power;
+    NIBDecimal128 result = NIBDecimal128Make(1, 0, NO);
+    NIBDecimal128 squaredBase = base;
+    
+    while (exponent != 0) {
+        /* if the bit of the exponent is set, multiply the result by the squared base */
+        if (exponent & 1) {
+            result = NIBDecimal128Multiply(result, squaredBase);
+        }
+        
+        exponent >>= 1;
+        
+        /* if the exponent has more bits, square the base */
+        if (exponent != 0) {
+            squaredBase = NIBDecimal128Multiply(squaredBase, squaredBase);
+            
+            /* if the squared base overflows, so does the result */
+            if (NIBDecimal128IsNaN(squaredBase)) {
+                return squaredBase;
+            }
+        }
+    }
+    
+    /* if the power is negative, take the reciprocal */
+    if (power < 0) {
+        result = NIBDecimal128Divide(NIBDecimal128Make(1, 0, NO), result);
+    }
+    
+    return result;
+}
+
+NIBDecimal128 NIBDecimal128ScaleByPowerOfTen(NIBDecimal128 decimal, int64_t power) {
+    NIBDecimalParts parts = NIBDecimalUnpack(decimal);
+    
+    /* if the decimal is not a number */
+    if (parts.isNaN) {
+        return decimal;
+    }
+    
+    // a power beyond twice the range of the exponents overflows or underflows
+    // as well as the limit, which keeps the sum of the exponents small
+    const int_least64_t limit = 2 * (NIB_DECIMAL_MAX_EXPONENT - NIB_DECIMAL_MIN_EXPONENT);
+    power = MAX(MIN(power, limit), -limit);
+    
+    return NIBDecimalRound(NIBUInt256FromUInt128(parts.coefficient), parts.exponent + power, parts.isNegative, NO);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Unpack the fields of a decimal.
+ 
+ @param decimal The decimal.
+ 
+ @return Returns the fields of the decimal.
+ */
+static NIBDecimalParts NIBDecimalUnpack(NIBDecimal128 decimal) {
+    NIBDecimalParts parts;
+    uint64_t exponentField = (decimal.high >> (NIB_DECIMAL_COEFFICIENT_BITS - 64)) & NIB_DECIMAL_NAN_EXPONENT_FIELD;
+    uint64_t coefficientHigh = decimal.high & ((1ULL << (NIB_DECIMAL_COEFFICIENT_BITS - 64)) - 1);
+    
+    parts.coefficient = ((unsigned __int128)coefficientHigh << 64) | decimal.low;
+    parts.exponent = (int_least64_t)exponentField + NIB_DECIMAL_MIN_EXPONENT;
+    parts.isNegative = (decimal.high >> 63) != 0;
+    parts.isNaN = (exponentField == NIB_DECIMAL_NAN_EXPONENT_FIELD);
+    
+    return parts;
+}
+
+/**
+ Pack the fields of a decimal. The coefficient has at most 34 digits and the
+ exponent is in the range of the exponents.
+ 
+ @param coefficient The coefficient.
+ @param exponent    The exponent.
+ @param isNegative  YES if the decimal is negative, otherwise NO.
+ 
+ @return Returns the decimal.
+ */
+static NIBDecimal128 NIBDecimalPack(unsigned __int128 coefficient, int_least64_t exponent, BOOL isNegative) {
+    NIBDecimal128 decimal;
+    uint64_t exponentField = (uint64_t)(exponent - NIB_DECIMAL_MIN_EXPONENT);
+    
+    decimal.low = (uint64_t)coefficient;
+    decimal.high = (uint64_t)(coefficient >> 64) |
+                   (exponentField << (NIB_DECIMAL_COEFFICIENT_BITS - 64)) |
+                   ((uint64_t)(isNegative ? 1 : 0) << 63);
+    
+    return decimal;
+}
+
+/**
+ Round an exact result to a decimal of 34 digits, half to even. The exponent is
+ raised if it is below the smallest one, and the result is not a number if the
+ exponent is above the largest one.
+ 
+ @param value       The coefficient of the exact result.
+ @param exponent    The exponent of the exact result.
+ @param isNegative  YES if the result is negative, otherwise NO.
+ @param isInexact   YES if nonzero digits below the coefficient were already
+                    dropped, otherwise NO. The coefficient has more than 34
+                    digits then.
+ 
+ @return Returns the decimal.
+ */
+static NIBDecimal128 NIBDecimalRound(NIBUInt256 value, int_least64_t exponent, BOOL isNegative, BOOL isInexact) {
+    
+    // a coefficient of more than 128 bits has at least 39 digits. The digits
+    // which surely are below the digit after the 34th one are dropped first,
+    // so 35 or 36 digits are left and fit in 128 bits
+    if (!NIBUInt256IsUInt128(value)) {
+        NSUInteger leastDigitCount = ((NIBUInt256BitLength(value) - 1) * 1233 >> 12) + 1;
+        NSUInteger droppedDigitCount = leastDigitCount - (NIB_DECIMAL_DIGITS + 1);
+        
+        isInexact |= NIBUInt256DivideByPowerOfTen(&value, droppedDigitCount);
+        exponent += (int_least64_t)droppedDigitCount;
+    }
+    
+    unsigned __int128 coefficient = NIBUInt256ToUInt128(value);
+    NSUInteger digitCount = NIBDigitsOfUInt128(coefficient);
+    int_least64_t droppedDigitCount = (int_least64_t)digitCount - NIB_DECIMAL_DIGITS;
+    
+    /* if the exponent is below the smallest one, drop more digits */
+    if (exponent + droppedDigitCount < NIB_DECIMAL_MIN_EXPONENT) {
+        droppedDigitCount = NIB_DECIMAL_MIN_EXPONENT - exponent;
+    }
+    
+    /* if some digits are dropped, round the coefficient */
+    if (droppedDigitCount > (int_least64_t)digitCount) {
+        // every digit is dropped and the coefficient is less than a tenth of
+        // the last kept digit, which rounds to zero
+        coefficient = 0;
+        exponent += droppedDigitCount;
+    
+    } else if (droppedDigitCount > 0) {
+        unsigned __int128 divisor = NIB_POWERS_OF_TEN_128[droppedDigitCount];
+        unsigned __int128 remainder = coefficient % divisor;
+        unsigned __int128 half = divisor / 2;
+        
+        coefficient /= divisor;
+        exponent += droppedDigitCount;
+        
+        /* if the dropped part is above the half, or it is the half and the coefficient is odd */
+        if (remainder > half || (remainder == half && (isInexact || (coefficient & 1)))) {
+            coefficient++;
+            
+            /* if the rounding carries to a new digit, drop the trailing zero */
+            if (coefficient == NIB_POWERS_OF_TEN_128[NIB_DECIMAL_DIGITS]) {
+                coefficient /= 10;
+                exponent++;
+            }
+        }
+    }
+    
+    /* if the exponent is above the largest one, append zeros to the coefficient while it has room */
+    while (exponent > NIB_DECIMAL_MAX_EXPONENT && coefficient != 0 &&
+           coefficient < NIB_POWERS_OF_TEN_128[NIB_DECIMAL_DIGITS - 1]) {
+        coefficient *= 10;
+        exponent--;
+    }
+    
+    /* if the exponent is still above the largest one */
+    if (exponent > NIB_DECIMAL_MAX_EXPONENT) {
+        /* zero keeps its value with any exponent, otherwise the decimal overflows */
+        if (coefficient != 0) return NIBDecimal128NotANumber();
+        exponent = NIB_DECIMAL_MAX_EXPONENT;
+    }
+    
+    return NIBDecimalPack(coefficient, exponent, isNegative);
+}
+
+/**
+ Add the fields of two decimals.
+ 
+ @param left    The left operand.
+ @param right   The right operand.
+ 
+ @return Returns the sum.
+ */
+static NIBDecimal128 NIBDecimalAddParts(NIBDecimalParts left, NIBDecimalParts right) {
+    
+    /* if an operand is not a number */
+    if (left.isNaN || right.isNaN) {
+        return NIBDecimal128NotANumber();
+    }
+    
+    /* if an operand is zero, the sum is the other one */
+    if (left.coefficient == 0 && right.coefficient == 0) {
+        return NIBDecimalPack(0, MIN(left.exponent, right.exponent), left.isNegative && right.isNegative);
+    } else if (right.coefficient == 0) {
+        return NIBDecimalPack(left.coefficient, left.exponent, left.isNegative);
+    } else if (left.coefficient == 0) {
+        return NIBDecimalPack(right.coefficient, right.exponent, right.isNegative);
+    }
+    
+    /* the larger operand is the one with the larger exponent */
+    NIBDecimalParts larger = (left.exponent >= right.exponent) ? left : right;
+    NIBDecimalParts smaller = (left.exponent >= right.exponent) ? right : left;
+    
+    // the coefficient of the larger operand is scaled to the exponent of the
+    // smaller one as far as 76 digits, which fit in 256 bits. The digits of
+    // the smaller operand below the scaled coefficient are dropped, then the
+    // larger operand has 76 digits and the dropped part only tells if the
+    // result is inexact
+    NSUInteger exponentDifference = (NSUInteger)(larger.exponent - smaller.exponent);
+    NSUInteger scale = MIN(exponentDifference, 76 - NIBDigitsOfUInt128(larger.coefficient));
+    NSUInteger droppedDigitCount = exponentDifference - scale;
+    NIBUInt256 largerValue = NIBUInt256FromUInt128(larger.coefficient);
+    unsigned __int128 smallerValue = smaller.coefficient;
+    BOOL isInexact = NO;
+    
+    NIBUInt256MultiplyByPowerOfTen(&largerValue, scale);
+    
+    /* if the smaller operand is below the digits of the larger one, drop its digits */
+    if (droppedDigitCount > 38) {
+        smallerValue = 0;
+        isInexact = YES;
+    } else if (droppedDigitCount > 0) {
+        isInexact = (smallerValue % NIB_POWERS_OF_TEN_128[droppedDigitCount] != 0);
+        smallerValue /= NIB_POWERS_OF_TEN_128[droppedDigitCount];
+    }
+    
+    NIBUInt256 result = largerValue;
+    BOOL isNegative = larger.isNegative;
+    int_least64_t exponent = larger.exponent - (int_least64_t)scale;
+    
+    /* if the operands have the same sign, add the magnitudes */
+    if (larger.isNegative == smaller.isNegative) {
+        unsigned __int128 low = ((unsigned __int128)result.words[1] << 64 | result.words[0]) + smallerValue;
+        BOOL hasCarry = (low < smallerValue);
+        
+        result.words[0] = (uint64_t)low;
+        result.words[1] = (uint64_t)(low >> 64);
+        
+        for (NSUInteger i = 2; i < 4 && hasCarry; i++) {
+            result.words[i]++;
+            hasCarry = (result.words[i] == 0);
+        }
+    
+    /* otherwise, subtract the smaller magnitude from the larger one */
+    } else {
+        // a dropped part of the smaller operand makes the difference less than
+        // the difference of the kept digits, so one more is subtracted and the
+        // result is inexact
+        unsigned __int128 subtrahend = smallerValue + (isInexact ? 1 : 0);
+        
+        /* if the magnitude of the smaller operand is the larger one, which happens when no digit is dropped */
+        if (NIBUInt256IsUInt128(result) && NIBUInt256ToUInt128(result) < subtrahend) {
+            result = NIBUInt256FromUInt128(subtrahend - NIBUInt256ToUInt128(result));
+            isNegative = smaller.isNegative;
+        } else {
+            unsigned __int128 low = (unsigned __int128)result.words[1] << 64 | result.words[0];
+            BOOL hasBorrow = (low < subtrahend);
+            
+            low -= subtrahend;
+            result.words[0] = (uint64_t)low;
+            result.words[1] = (uint64_t)(low >> 64);
+            
+            for (NSUInteger i = 2; i < 4 && hasBorrow; i++) {
+                hasBorrow = (result.words[i] == 0);
+                result.words[i]--;
+            }
+        }
+        
+        /* if the magnitudes are equal, the difference is positive zero */
+        if (NIBUInt256IsUInt128(result) && NIBUInt256ToUInt128(result) == 0) {
+            isNegative = NO;
+        }
+    }
+    
+    return NIBDecimalRound(result, exponent, isNegative, isInexact);
+}
+
+/**
+ Count the decimal digits of an integer of 128 bits.
+ 
+ @param value   The integer.
+ 
+ @return Returns the number of digits, 1 for zero.
+ */
+static NSUInteger NIBDigitsOfUInt128(unsigned __int128 value) {
+    uint64_t high = (uint64_t)(value >> 64);
+    uint64_t low = (uint64_t)value;
+    NSUInteger bitLength = (high != 0) ? 128 - (NSUInteger)__builtin_clzll(high) : (low != 0) ? 64 - (NSUInteger)__builtin_clzll(low) : 1;
+    
+    /* log10(2) is about 1233/4096, so the estimate is the digit count or one less */
+    NSUInteger estimate = (bitLength * 1233) >> 12;
+    
+    return estimate + (value >= NIB_POWERS_OF_TEN_128[estimate] ? 1 : 0);
+}
+
+/**
+ Extend an integer of 128 bits to 256 bits.
+ 
+ @param value   The integer.
+ 
+ @return Returns the integer of 256 bits.
+ */
+static NIBUInt256 NIBUInt256FromUInt128(unsigned __int128 value) {
+    NIBUInt256 result = {{(uint64_t)value, (uint64_t)(value >> 64), 0, 0}};
+    return result;
+}
+
+/**
+ Multiply two integers of 128 bits.
+ 
+ @param multiplicand    The multiplicand.
+ @param multiplier      The multiplier.
+ 
+ @return Returns the product of 256 bits.
+ */
+static NIBUInt256 NIBUInt256Multiply(unsigned __int128 multiplicand, unsigned __int128 multiplier) {
+    uint64_t a[2] = {(uint64_t)multiplicand, (uint64_t)(multiplicand >> 64)};
+    uint64_t b[2] = {(uint64_t)multiplier, (uint64_t)(multiplier >> 64)};
+    NIBUInt256 result = {{0, 0, 0, 0}};
+    
+    /* schoolbook multiplication of 64 bit words */
+    for (NSUInteger i = 0; i < 2; i++) {
+        uint64_t carry = 0;
+        
+        for (NSUInteger j = 0; j < 2; j++) {
+            unsigned __int128 product = (unsigned __int128)a[i] * b[j] + result.words[i + j] + carry;
+            result.words[i + j] = (uint64_t)product;
+            carry = (uint64_t)(product >> 64);
+        }
+        
+        result.words[i + 2] = carry;
+    }
+    
+    return result;
+}
+
+/**
+ Multiply an integer of 256 bits by a power of ten. The product must fit in
+ 256 bits.
+ 
+ @param value   The integer to multiply in place.
+ @param power   The power of ten.
+ */
+static void NIBUInt256MultiplyByPowerOfTen(NIBUInt256 *value, NSUInteger power) {
+    while (power > 0) {
+        NSUInteger step = MIN(power, (NSUInteger)19);
+        uint64_t multiplier = NIB_POWERS_OF_TEN_64[step];
+        uint64_t carry = 0;
+        
+        for (NSUInteger i = 0; i < 4; i++) {
+            unsigned __int128 product = (unsigned __int128)value->words[i] * multiplier + carry;
+            value->words[i] = (uint64_t)product;
+            carry = (uint64_t)(product >> 64);
+        }
+        
+        power -= step;
+    }
+}
+
+/**
+ Divide an integer of 256 bits by a word.
+ 
+ @param value   The integer to divide in place.
+ @param divisor The divisor.
+ 
+ @return Returns the remainder.
+ */
+static uint64_t NIBUInt256DivideByWord(NIBUInt256 *value, uint64_t divisor) {
+    unsigned __int128 remainder = 0;
+    
+    for (NSInteger i = 3; i >= 0; i--) {
+        unsigned __int128 dividend = (remainder << 64) | value->words[i];
+        value->words[i] = (uint64_t)(dividend / divisor);
+        remainder = dividend % divisor;
+    }
+    
+    return (uint64_t)remainder;
+}
+
+/**
+ Divide an integer of 256 bits by a power of ten, dropping the remainder.
+ 
+ @param value   The integer to divide in place.
+ @param power   The power of ten.
+ 
+ @return Returns YES if the remainder is not zero, otherwise NO.
+ */
+static BOOL NIBUInt256DivideByPowerOfTen(NIBUInt256 *value, NSUInteger power) {
+    BOOL hasRemainder = NO;
+    
+    while (power > 0) {
+        NSUInteger step = MIN(power, (NSUInteger)19);
+        
+        hasRemainder |= (NIBUInt256DivideByWord(value, NIB_POWERS_OF_TEN_64[step]) != 0);
+        power -= step;
+    }
+    
+    return hasRemainder;
+}
+
+/**
+ Divide an integer of 256 bits by an integer of 128 bits whose quotient fits in
+ 128 bits, one bit of the quotient at a time.
+ 
+ @param dividend        The dividend.
+ @param divisor         The divisor, which is less than 2^127.
+ @param hasRemainder    YES if the remainder is not zero, otherwise NO.
+ 
+ @return Returns the quotient.
+ */
+static unsigned __int128 NIBUInt256Divide(NIBUInt256 dividend, unsigned __int128 divisor, BOOL *hasRemainder) {
+    NSUInteger bitLength = NIBUInt256BitLength(dividend);
+    unsigned __int128 quotient = 0;
+    unsigned __int128 remainder = 0;
+    
+    for (NSInteger bit = (NSInteger)bitLength - 1; bit >= 0; bit--) {
+        remainder = (remainder << 1) | ((dividend.words[bit / 64] >> (bit % 64)) & 1);
+        quotient <<= 1;
+        
+        if (remainder >= divisor) {
+            remainder -= divisor;
+            quotient |= 1;
+        }
+    }
+    
+    *hasRemainder = (remainder != 0);
+    
+    return quotient;
+}
+
+/**
+ Get the number of significant bits of an integer of 256 bits.
+ 
+ @param value   The integer.
+ 
+ @return Returns the number of bits, 0 for zero.
+ */
+static NSUInteger NIBUInt256BitLength(NIBUInt256 value) {
+    for (NSInteger i = 3; i >= 0; i--) {
+        if (value.words[i] != 0) {
+            return (NSUInteger)i * 64 + 64 - (NSUInteger)__builtin_clzll(value.words[i]);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Check if an integer of 256 bits fits in 128 bits.
+ 
+ @param value   The integer.
+ 
+ @return Returns YES if the integer fits in 128 bits, otherwise NO.
+ */
+static BOOL NIBUInt256IsUInt128(NIBUInt256 value) {
+    return value.words[2] == 0 && value.words[3] == 0;
+}
+
+/**
+ Truncate an integer of 256 bits to 128 bits.
+ 
+ @param value   The integer.
+ 
+ @return Returns the low 128 bits of the integer.
+ */
+static unsigned __int128 NIBUInt256ToUInt128(NIBUInt256 value) {
+    return (unsigned __int128)value.words[1] << 64 | value.words[0];
+}
@@ -0,0 +1,82 @@
+//
+//  NIBExpressionTokenizer.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "NIBToken.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Types, Enumeration and Options
+
+
+/**
+ @struct NIBNumberSeparators
+ 
+ The separators of the numbers of a text in UTF-8.
+ 
+ @field decimalSeparator    The decimal separator.
+ @field groupingSeparator   The grouping separator, empty if the numbers are
+                            not grouped.
+ */
+typedef struct NIBNumberSeparators {
+    char decimalSeparator[8];
+    char groupingSeparator[8];
+} NIBNumberSeparators;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Number Separators
+
+
+/**
+ Get the separators of the numbers of a locale.
+ 
+ @param locale  The locale, or nil for a decimal point without grouping.
+ 
+ @return Returns the separators of the locale.
+ */
+FOUNDATION_EXPORT NIBNumberSeparators NIBNumberSeparatorsOfLocale(NSLocale *_Nullable locale);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Tokenizing Expressions
+
+
+/**
+ Read the tokens of an expression from a text in UTF-8 in one pass, without
+ copying the text.
+ 
+ The tokens are in the order of the keys which calculate the expression, as
+ the description of a program prints them, such as `2 + 9 sqrt x 3 =`. The
+ operators are spelled as their descriptions, and `*`, `×`, `÷` and `−` are
+ also read. A function can be written before its operand too, as `sqrt 9` or
+ `sqrt(2 + 7)`, and its token is put after the operand.
+ 
+ A number may have a sign where an operand is expected, the separators of the
+ numbers and an exponent, as `-1,234.5e-3`. Where an operand is not expected,
+ a description starting with a digit is read as the operator, so `3 2^` is two
+ to the power of three and `2^3` is two to the power of three as well.
+ 
+ @param text        The text, which does not need to end with a null character.
+ @param length      The length of the text in bytes.
+ @param separators  The separators of the numbers.
+ @param tokens      The buffer to append the tokens to. It is not modified if
+                    the text is not an expression.
+ @param errorOffset The offset in bytes of the text which can not be read.
+ 
+ @return Returns YES if the text is an expression, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBTokenizeExpression(const char *text,
+                                             NSUInteger length,
+                                             const NIBNumberSeparators *separators,
+                                             NIBTokenBuffer *tokens,
+                                             NSUInteger *_Nullable errorOffset);
+
+NS_ASSUME_NONNULL_END
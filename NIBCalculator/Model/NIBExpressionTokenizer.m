@@ -0,0 +1,386 @@
+//
+//  NIBExpressionTokenizer.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBExpressionTokenizer.h"
+#import "NIBOperator.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ @struct NIBOperatorAlias
+ 
+ A spelling of an operator which is not its description.
+ 
+ @field text    The spelling in UTF-8.
+ @field tag     The tag of the operator.
+ */
+typedef struct NIBOperatorAlias {
+    const char *text;
+    NIBButtonTag tag;
+} NIBOperatorAlias;
+
+/**
+ @struct NIBPendingFunction
+ 
+ A function written before its operand, which waits for the operand to end.
+ 
+ @field tag     The tag of the function.
+ @field depth   The depth of parentheses of the operand.
+ */
+typedef struct NIBPendingFunction {
+    NIBButtonTag tag;
+    NSUInteger depth;
+} NIBPendingFunction;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The spellings of the operators which are not their descriptions. */
+static const NIBOperatorAlias NIBOperatorAliases[] = {
+    {"*", NIBButtonMultiplication},
+    {"×", NIBButtonMultiplication},
+    {"÷", NIBButtonDivision},
+    {"−", NIBButtonSubstraction}
+};
+
+/** The longest number in a text. */
+#define NIB_TOKENIZER_MAX_NUMBER_LENGTH 64
+
+/** The most functions which wait for their operands at once. */
+#define NIB_TOKENIZER_MAX_PENDING_FUNCTIONS 32
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static NSUInteger NIBReadNumber(const char *, const char *, const NIBNumberSeparators *, BOOL, double *);
+static NSInteger NIBReadOperator(const char *, const char *, NSUInteger *);
+static BOOL NIBIsPostfixOperatorTag(NSInteger);
+static NSUInteger NIBPrefixLength(const char *, const char *, const char *);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Number Separators
+
+
+NIBNumberSeparators NIBNumberSeparatorsOfLocale(NSLocale *locale) {
+    NIBNumberSeparators separators = {".", ""};
+    
+    /* if there is no locale, use a decimal point without grouping */
+    if (locale == nil) {
+        return separators;
+    }
+    
+    NSString *decimalSeparator = [locale objectForKey:NSLocaleDecimalSeparator];
+    NSString *groupingSeparator = [locale objectForKey:NSLocaleGroupingSeparator];
+    
+    if (decimalSeparator.length > 0) {
+        snprintf(separators.decimalSeparator, sizeof(separators.decimalSeparator), "%s", decimalSeparator.UTF8String);
+    }
+    
+    if (groupingSeparator.length > 0) {
+        snprintf(separators.groupingSeparator, sizeof(separators.groupingSeparator), "%s", groupingSeparator.UTF8String);
+    }
+    
+    return separators;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Tokenizing Expressions
+
+
+BOOL NIBTokenizeExpression(const char *text,
+                           NSUInteger length,
+                           const NIBNumberSeparators *separators,
+                           NIBTokenBuffer *tokens,
+                           NSUInteger *errorOffset) {
+    NIBPendingFunction pendingFunctions[NIB_TOKENIZER_MAX_PENDING_FUNCTIONS];
+    NSUInteger pendingFunctionCount = 0;
+    NSUInteger depth = 0;
+    NSUInteger firstTokenIdx = tokens->count;
+    BOOL isExpectingOperand = YES;
+    const char *cursor = text;
+    const char *end = text + length;
+    
+    while (cursor < end) {
+        /* skip the spaces between the tokens */
+        if (isspace((unsigned char)*cursor)) {
+            cursor++;
+            continue;
+        }
+        
+        NSUInteger tokenLength = 0;
+        NSInteger tag = -1;
+        double operand = NAN;
+        
+        // where an operand is expected a digit starts a number, otherwise it
+        // may start an operator, as 2^ or 1/
+        if (isExpectingOperand) {
+            tokenLength = NIBReadNumber(cursor, end, separators, YES, &operand);
+        }
+        
+        if (tokenLength == 0) {
+            tag = NIBReadOperator(cursor, end, &tokenLength);
+        }
+        
+        if (tokenLength == 0) {
+            tokenLength = NIBReadNumber(cursor, end, separators, NO, &operand);
+        }
+        
+        /* if the token is neither a number nor an operator, the text is not an expression */
+        if (tokenLength == 0) {
+            break;
+        }
+        
+        cursor += tokenLength;
+        
+        /* if the token is a function before its operand, wait for the operand */
+        if (tag >= 0 && isExpectingOperand && NIBIsUnaryOperatorTag(tag) && !NIBIsPostfixOperatorTag(tag)) {
+            if (pendingFunctionCount == NIB_TOKENIZER_MAX_PENDING_FUNCTIONS) {
+                cursor -= tokenLength;
+                break;
+            }
+            
+            pendingFunctions[pendingFunctionCount++] = (NIBPendingFunction){(NIBButtonTag)tag, depth};
+            continue;
+        }
+        
+        /* if the token is an openning parenthesis, an operand is expected inside it */
+        if (tag == NIBButtonOpenningParenthesis) {
+            NIBTokenBufferAppend(tokens, NIBTokenMakeOperator(NIBButtonOpenningParenthesis));
+            depth++;
+            isExpectingOperand = YES;
+            continue;
+        }
+        
+        /* if the token is a closing parenthesis, it must close an openning one */
+        if (tag == NIBButtonClosingParenthesis) {
+            if (depth == 0) {
+                cursor -= tokenLength;
+                break;
+            }
+            
+            NIBTokenBufferAppend(tokens, NIBTokenMakeOperator(NIBButtonClosingParenthesis));
+            depth--;
+        
+        /* if the token is a binary operator, an operand is expected after it */
+        } else if (tag >= 0 && NIBIsBinaryOperatorTag(tag)) {
+            NIBTokenBufferAppend(tokens, NIBTokenMakeOperator((NIBButtonTag)tag));
+            isExpectingOperand = YES;
+            continue;
+        
+        /* if the token is an unary operator or the equality, it is after its operand */
+        } else if (tag >= 0) {
+            NIBTokenBufferAppend(tokens, NIBTokenMakeOperator((NIBButtonTag)tag));
+        
+        /* otherwise, the token is a number */
+        } else {
+            NIBTokenBufferAppend(tokens, NIBTokenMakeOperand(operand));
+        }
+        
+        isExpectingOperand = NO;
+        
+        /* the functions which wait for the operand which ends here follow it */
+        while (pendingFunctionCount > 0 && pendingFunctions[pendingFunctionCount - 1].depth == depth) {
+            NIBTokenBufferAppend(tokens, NIBTokenMakeOperator(pendingFunctions[--pendingFunctionCount].tag));
+        }
+    }
+    
+    /* if the text is read to the end and no function waits for its operand, it is an expression */
+    if (cursor == end && pendingFunctionCount == 0) {
+        return YES;
+    }
+    
+    if (errorOffset) *errorOffset = (NSUInteger)(cursor - text);
+    NIBTokenBufferTruncate(tokens, firstTokenIdx);
+    
+    return NO;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Read a number at the start of a text. The grouping separators are skipped,
+ and the decimal separator is read as a decimal point, so the number is copied
+ to a small buffer to convert it.
+ 
+ @param text        The text.
+ @param end         The end of the text.
+ @param separators  The separators of the numbers.
+ @param allowsSign  YES if the number may start with a minus sign, otherwise NO.
+ @param number      The number.
+ 
+ @return Returns the length of the number in bytes, or 0 if the text does not
+ start with a number.
+ */
+static NSUInteger NIBReadNumber(const char *text, const char *end, const NIBNumberSeparators *separators,
+                                BOOL allowsSign, double *number) {
+    char buffer[NIB_TOKENIZER_MAX_NUMBER_LENGTH + 1];
+    NSUInteger bufferLength = 0;
+    NSUInteger separatorLength = 0;
+    BOOL hasDigits = NO;
+    BOOL hasDecimalSeparator = NO;
+    const char *cursor = text;
+    
+    /* read the sign */
+    if (allowsSign) {
+        NSUInteger signLength = NIBPrefixLength(cursor, end, "-");
+        
+        if (signLength == 0) signLength = NIBPrefixLength(cursor, end, "−");
+        
+        if (signLength > 0) {
+            buffer[bufferLength++] = '-';
+            cursor += signLength;
+        }
+    }
+    
+    /* read the digits and the separators */
+    while (cursor < end && bufferLength < NIB_TOKENIZER_MAX_NUMBER_LENGTH) {
+        if (isdigit((unsigned char)*cursor)) {
+            buffer[bufferLength++] = *cursor++;
+            hasDigits = YES;
+        
+        /* if the decimal separator is followed by a digit or ends the digits, it is a decimal point */
+        } else if (!hasDecimalSeparator &&
+                   (separatorLength = NIBPrefixLength(cursor, end, separators->decimalSeparator)) > 0 &&
+                   (hasDigits || (cursor + separatorLength < end && isdigit((unsigned char)cursor[separatorLength])))) {
+            buffer[bufferLength++] = '.';
+            cursor += separatorLength;
+            hasDecimalSeparator = YES;
+        
+        /* if the grouping separator is between digits of the integer part, skip it */
+        } else if (hasDigits && !hasDecimalSeparator &&
+                   (separatorLength = NIBPrefixLength(cursor, end, separators->groupingSeparator)) > 0 &&
+                   cursor + separatorLength < end && isdigit((unsigned char)cursor[separatorLength])) {
+            cursor += separatorLength;
+        
+        } else {
+            break;
+        }
+    }
+    
+    /* if there is no digit or the number is too long, the text does not start with a number */
+    if (!hasDigits || bufferLength == NIB_TOKENIZER_MAX_NUMBER_LENGTH) {
+        return 0;
+    }
+    
+    /* read the exponent if the e is followed by digits, so e^ is not an exponent */
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        const char *exponent = cursor + 1;
+        
+        if (exponent < end && (*exponent == '+' || *exponent == '-')) exponent++;
+        
+        if (exponent < end && isdigit((unsigned char)*exponent)) {
+            /* if the exponent does not fit in the buffer, the number is too long */
+            if (bufferLength + (NSUInteger)(exponent - cursor) >= NIB_TOKENIZER_MAX_NUMBER_LENGTH) {
+                return 0;
+            }
+            
+            while (cursor < exponent) {
+                buffer[bufferLength++] = *cursor++;
+            }
+            
+            while (cursor < end && isdigit((unsigned char)*cursor) && bufferLength < NIB_TOKENIZER_MAX_NUMBER_LENGTH) {
+                buffer[bufferLength++] = *cursor++;
+            }
+            
+            if (bufferLength == NIB_TOKENIZER_MAX_NUMBER_LENGTH) {
+                return 0;
+            }
+        }
+    }
+    
+    buffer[bufferLength] = '\0';
+    *number = strtod(buffer, NULL);
+    
+    return (NSUInteger)(cursor - text);
+}
+
+/**
+ Read an operator at the start of a text, as its description or an alias.
+ 
+ @param text    The text.
+ @param end     The end of the text.
+ @param length  The length of the operator in bytes, 0 if the text does not
+                start with an operator.
+ 
+ @return Returns the tag of the operator, or -1 if the text does not start with
+ an operator.
+ */
+static NSInteger NIBReadOperator(const char *text, const char *end, NSUInteger *length) {
+    NSUInteger textLength = (NSUInteger)(end - text);
+    NSInteger tag = NIBOperatorTagOfDescriptionPrefix(text, textLength, length);
+    
+    // a description ending with a digit does not take the first digit of a
+    // number, so 2^25 is 2 ^ 25 rather than 2 ^2 5, and a shorter description
+    // is looked for
+    while (tag >= 0 && *length < textLength &&
+           isdigit((unsigned char)text[*length - 1]) && isdigit((unsigned char)text[*length])) {
+        tag = NIBOperatorTagOfDescriptionPrefix(text, *length - 1, length);
+    }
+    
+    if (tag >= 0) {
+        return tag;
+    }
+    
+    for (NSUInteger i = 0; i < sizeof(NIBOperatorAliases) / sizeof(NIBOperatorAliases[0]); i++) {
+        NSUInteger aliasLength = NIBPrefixLength(text, end, NIBOperatorAliases[i].text);
+        
+        if (aliasLength > 0) {
+            *length = aliasLength;
+            return NIBOperatorAliases[i].tag;
+        }
+    }
+    
+    *length = 0;
+    
+    return -1;
+}
+
+/**
+ Check if an unary operator is written after its operand only, as x² or x!.
+ 
+ @param tag The tag of the operator.
+ 
+ @return Returns YES if the operator is written after its operand only,
+ otherwise NO.
+ */
+static BOOL NIBIsPostfixOperatorTag(NSInteger tag) {
+    return (tag == NIBButtonPercentage || tag == NIBButtonXSquared ||
+            tag == NIBButtonXCubed || tag == NIBButtonXFactorial);
+}
+
+/**
+ Get the length of a string which prefixes a text.
+ 
+ @param text    The text.
+ @param end     The end of the text.
+ @param prefix  The string, which ends with a null character.
+ 
+ @return Returns the length of the string in bytes if it is not empty and
+ prefixes the text, otherwise 0.
+ */
+static NSUInteger NIBPrefixLength(const char *text, const char *end, const char *prefix) {
+    NSUInteger prefixLength = strlen(prefix);
+    
+    if (prefixLength == 0 || prefixLength > (NSUInteger)(end - text) || memcmp(text, prefix, prefixLength) != 0) {
+        return 0;
+    }
+    
+    return prefixLength;
+}
@@ -0,0 +1,272 @@
+//
+//  NIBInstrumentation.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "NIBToken.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Compile Switch
+
+
+// the instrumentation is compiled in when NIB_INSTRUMENTATION is 1, with
+// GCC_PREPROCESSOR_DEFINITIONS in Xcode or INSTRUMENTATION=1 with make.
+// Otherwise the macros below are empty and the measured code is unchanged
+#ifndef NIB_INSTRUMENTATION
+#define NIB_INSTRUMENTATION 0
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Types, Enumeration and Options
+
+
+/** Values to identify the stages of a keypress which are measured. */
+typedef NS_ENUM(NSUInteger, NIBInstrumentationStage) {
+    /** The action of a key in the controller, on the main thread. */
+    NIBInstrumentationStageKeyAction,
+    /** An operator performed by the calculator. */
+    NIBInstrumentationStageEvaluation,
+    /** The formatting of the texts of a result for the main displays. */
+    NIBInstrumentationStageFormatting,
+    /** The fitting of the font size of a main display to its text. */
+    NIBInstrumentationStageFontFitting,
+    /** The time from the action of a key until its result is displayed. */
+    NIBInstrumentationStageKeyToDisplay,
+    /** The number of stages. */
+    NIBInstrumentationStageCount
+};
+
+/** Values to identify the counters of operators. */
+typedef NS_ENUM(NSUInteger, NIBInstrumentationOperatorCounter) {
+    /** The unary operators performed on an operand. */
+    NIBInstrumentationOperatorCounterUnary,
+    /** The operators of the evaluated postfix expressions. */
+    NIBInstrumentationOperatorCounterPostfix,
+    /** The number of counters of operators. */
+    NIBInstrumentationOperatorCounterCount
+};
+
+/** Values to identify the kinds of allocations which are counted. */
+typedef NS_ENUM(NSUInteger, NIBInstrumentationAllocation) {
+    /** The growth of the storage of a token buffer. */
+    NIBInstrumentationAllocationTokenBuffer,
+    /** The stack of an evaluation which is deeper than the stack on the call stack. */
+    NIBInstrumentationAllocationEvaluationStack,
+    /** The number object of a result of the calculator. */
+    NIBInstrumentationAllocationNumber,
+    /** The texts of a result for the main displays. */
+    NIBInstrumentationAllocationDisplayTexts,
+    /** The number of kinds of allocations. */
+    NIBInstrumentationAllocationCount
+};
+
+/**
+ @struct NIBInstrumentationInterval
+ 
+ An interval of a stage which is being measured.
+ 
+ @field stage   The stage.
+ @field start   The time when the interval starts, in nanoseconds.
+ */
+typedef struct NIBInstrumentationInterval {
+    NIBInstrumentationStage stage;
+    uint64_t start;
+} NIBInstrumentationInterval;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Recording
+
+
+/**
+ Get the time of the monotonic clock.
+ 
+ @return Returns the time in nanoseconds.
+ */
+FOUNDATION_EXPORT uint64_t NIBInstrumentationTime(void);
+
+/**
+ Start an interval of a stage.
+ 
+ @param stage   The stage.
+ 
+ @return Returns the interval.
+ */
+FOUNDATION_EXPORT NIBInstrumentationInterval NIBInstrumentationBeginInterval(NIBInstrumentationStage stage);
+
+/**
+ End an interval, its duration is recorded in the histogram of its stage and
+ as an event of the trace.
+ 
+ @param interval    The interval.
+ */
+FOUNDATION_EXPORT void NIBInstrumentationEndInterval(NIBInstrumentationInterval *interval);
+
+/**
+ Record an interval of a stage which is measured by its caller.
+ 
+ @param stage   The stage.
+ @param start   The time when the interval starts, in nanoseconds.
+ @param end     The time when the interval ends, in nanoseconds.
+ */
+FOUNDATION_EXPORT void NIBInstrumentationRecordInterval(NIBInstrumentationStage stage, uint64_t start, uint64_t end);
+
+/**
+ Count the operators of tokens.
+ 
+ @param counter The counter.
+ @param tokens  The tokens, the operands are not counted.
+ @param count   The number of tokens.
+ */
+FOUNDATION_EXPORT void NIBInstrumentationCountOperators(NIBInstrumentationOperatorCounter counter, const NIBToken *_Nullable tokens, NSUInteger count);
+
+/**
+ Count an operator.
+ 
+ @param counter     The counter.
+ @param operatorTag The tag of the operator.
+ */
+FOUNDATION_EXPORT void NIBInstrumentationCountOperator(NIBInstrumentationOperatorCounter counter, NIBButtonTag operatorTag);
+
+/**
+ Count an allocation.
+ 
+ @param allocation  The kind of the allocation.
+ @param bytes       The number of bytes which are allocated, 0 for an object.
+ */
+FOUNDATION_EXPORT void NIBInstrumentationCountAllocation(NIBInstrumentationAllocation allocation, NSUInteger bytes);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Recording Macros
+
+
+#define NIB_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define NIB_INSTRUMENTATION_CONCAT(a, b) NIB_INSTRUMENTATION_CONCAT_(a, b)
+
+#if NIB_INSTRUMENTATION
+
+/** Measure the rest of the scope as an interval of a stage. */
+#define NIB_MEASURE_SCOPE(stage) \
+    NIBInstrumentationInterval NIB_INSTRUMENTATION_CONCAT(nibInterval, __LINE__) \
+    __attribute__((cleanup(NIBInstrumentationEndInterval), unused)) = NIBInstrumentationBeginInterval(stage)
+
+/** Get the time to start an interval which is recorded with NIB_RECORD_INTERVAL. */
+#define NIB_INSTRUMENTATION_TIME() NIBInstrumentationTime()
+
+/** Record an interval of a stage from a time of NIB_INSTRUMENTATION_TIME until now. */
+#define NIB_RECORD_INTERVAL(stage, start) \
+    NIBInstrumentationRecordInterval((stage), (start), NIBInstrumentationTime())
+
+/** Count an operator. */
+#define NIB_COUNT_OPERATOR(counter, operatorTag) NIBInstrumentationCountOperator((counter), (operatorTag))
+
+/** Count the operators of tokens. */
+#define NIB_COUNT_OPERATORS(counter, tokens, count) NIBInstrumentationCountOperators((counter), (tokens), (count))
+
+/** Count an allocation. */
+#define NIB_COUNT_ALLOCATION(allocation, bytes) NIBInstrumentationCountAllocation((allocation), (bytes))
+
+#else
+
+#define NIB_MEASURE_SCOPE(stage)
+#define NIB_INSTRUMENTATION_TIME() ((uint64_t)0)
+#define NIB_RECORD_INTERVAL(stage, start) ((void)(start))
+#define NIB_COUNT_OPERATOR(counter, operatorTag) ((void)0)
+#define NIB_COUNT_OPERATORS(counter, tokens, count) ((void)0)
+#define NIB_COUNT_ALLOCATION(allocation, bytes) ((void)0)
+
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Interface
+
+
+/**
+ `NIBInstrumentation` exports what the instrumentation records: a latency
+ histogram of each stage of a keypress, the counts of the operators and the
+ counts of the allocations, and the last intervals as a trace.
+ 
+ The histograms are log-linear like HDR histograms, each power of two is split
+ into 16 buckets, so a value is recorded within 1/16 of it from 1 nanosecond to
+ the longest interval with a fixed memory. The recording is lock-free, with
+ relaxed atomic counters, and it keeps the last 16384 intervals for the trace.
+ 
+ @note When NIB_INSTRUMENTATION is 0, nothing is recorded and the exports are
+ empty.
+ */
+@interface NIBInstrumentation : NSObject
+
+/// -------------------------
+/// @name Unavailable Methods
+/// -------------------------
+
+/**
+ The init method is unavailable.
+ */
+- (instancetype)init __attribute__((unavailable("use the class methods")));
+
+/// ---------------
+/// @name Exporting
+/// ---------------
+
+/**
+ Boolean value indicating if the instrumentation is compiled in.
+ 
+ @return Returns YES if NIB_INSTRUMENTATION is 1, otherwise NO.
+ */
++ (BOOL)isEnabled;
+
+/**
+ Get a snapshot of what is recorded. The snapshot has the count, the minimum,
+ the mean, the maximum and the percentiles of the latency of each stage in
+ nanoseconds, the counts of the operators by their tags and the counts and
+ bytes of the allocations.
+ 
+ @return Returns the snapshot, which can be written as JSON.
+ */
++ (NSDictionary<NSString *, id> *)snapshot;
+
+/**
+ Get the last intervals which are recorded as a trace of the Trace Event
+ Format, which is opened by chrome://tracing and Perfetto.
+ 
+ @return Returns the JSON data of the trace.
+ */
++ (NSData *)chromeTraceData;
+
+/**
+ Write the snapshot to a file as JSON.
+ 
+ @param path    The path of the file.
+ 
+ @return Returns YES if the file is written, otherwise NO.
+ */
++ (BOOL)writeSnapshotToFile:(NSString *)path;
+
+/**
+ Write the trace to a file as JSON.
+ 
+ @param path    The path of the file.
+ 
+ @return Returns YES if the file is written, otherwise NO.
+ */
++ (BOOL)writeChromeTraceToFile:(NSString *)path;
+
+/**
+ Clear what is recorded.
+ */
++ (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
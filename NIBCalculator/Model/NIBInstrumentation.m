@@ -0,0 +1,453 @@
+//
+//  NIBInstrumentation.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBInstrumentation.h"
+#import <stdatomic.h>
+#import <time.h>
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The number of bits of a value below its highest bit which select its bucket. */
+#define NIB_HISTOGRAM_SUB_BUCKET_BITS 4
+
+/** The number of buckets of a histogram, 16 for each power of two of 64-bit values. */
+#define NIB_HISTOGRAM_BUCKET_COUNT ((64 - NIB_HISTOGRAM_SUB_BUCKET_BITS + 1) << NIB_HISTOGRAM_SUB_BUCKET_BITS)
+
+/** The number of intervals which are kept for the trace. */
+#define NIB_TRACE_EVENT_CAPACITY 16384
+
+/** The number of operator tags which are counted. */
+#define NIB_OPERATOR_TAG_COUNT (NIBButtonDeg + 1)
+
+/** The percentiles of the latencies in a snapshot. */
+static const double NIBInstrumentationPercentiles[] = {50, 90, 99, 99.9};
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ @struct NIBInstrumentationHistogram
+ 
+ The latency histogram of a stage.
+ 
+ @field buckets The counts of the buckets.
+ @field count   The number of recorded values.
+ @field sum     The sum of the values.
+ @field minimum One more than the minimum value, 0 if there is no value.
+ @field maximum The maximum value.
+ */
+typedef struct NIBInstrumentationHistogram {
+    _Atomic uint64_t buckets[NIB_HISTOGRAM_BUCKET_COUNT];
+    _Atomic uint64_t count;
+    _Atomic uint64_t sum;
+    _Atomic uint64_t minimum;
+    _Atomic uint64_t maximum;
+} NIBInstrumentationHistogram;
+
+/**
+ @struct NIBInstrumentationTraceEvent
+ 
+ An interval which is kept for the trace.
+ 
+ @field start       The time when the interval starts, in nanoseconds.
+ @field duration    The duration of the interval, in nanoseconds.
+ @field thread      The number of the thread which records the interval.
+ @field stage       The stage of the interval.
+ */
+typedef struct NIBInstrumentationTraceEvent {
+    uint64_t start;
+    uint64_t duration;
+    uint32_t thread;
+    uint32_t stage;
+} NIBInstrumentationTraceEvent;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Variables
+
+
+/** Class variable the histograms of the stages. */
+static NIBInstrumentationHistogram histograms[NIBInstrumentationStageCount];
+
+/** Class variable the counts of the operators by their tags. */
+static _Atomic uint64_t operatorCounts[NIBInstrumentationOperatorCounterCount][NIB_OPERATOR_TAG_COUNT];
+
+/** Class variable the counts of the allocations. */
+static _Atomic uint64_t allocationCounts[NIBInstrumentationAllocationCount];
+
+/** Class variable the bytes of the allocations. */
+static _Atomic uint64_t allocationBytes[NIBInstrumentationAllocationCount];
+
+/** Class variable the ring of the last intervals for the trace. */
+static NIBInstrumentationTraceEvent traceEvents[NIB_TRACE_EVENT_CAPACITY];
+
+/** Class variable the number of intervals ever kept for the trace. */
+static _Atomic uint64_t traceEventCount;
+
+/** Class variable the number of threads which record intervals. */
+static _Atomic uint32_t threadCount;
+
+/** Class variable the number of the thread, 0 until it records an interval. */
+static _Thread_local uint32_t threadNumber;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static NSUInteger NIBHistogramBucketOfValue(uint64_t);
+static uint64_t NIBHistogramHighestValueOfBucket(NSUInteger);
+static NSDictionary<NSString *, id> *NIBHistogramSummary(NIBInstrumentationHistogram *);
+static NSString *NIBInstrumentationNameOfStage(NIBInstrumentationStage);
+static NSString *NIBInstrumentationNameOfOperatorCounter(NIBInstrumentationOperatorCounter);
+static NSString *NIBInstrumentationNameOfAllocation(NIBInstrumentationAllocation);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Recording
+
+
+uint64_t NIBInstrumentationTime(void) {
+    struct timespec time;
+    
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+}
+
+NIBInstrumentationInterval NIBInstrumentationBeginInterval(NIBInstrumentationStage stage) {
+    return (NIBInstrumentationInterval){stage, NIBInstrumentationTime()};
+}
+
+void NIBInstrumentationEndInterval(NIBInstrumentationInterval *interval) {
+    NIBInstrumentationRecordInterval(interval->stage, interval->start, NIBInstrumentationTime());
+}
+
+void NIBInstrumentationRecordInterval(NIBInstrumentationStage stage, uint64_t start, uint64_t end) {
+    NIBInstrumentationHistogram *histogram = &histograms[stage];
+    uint64_t duration = (end > start) ? end - start : 0;
+    uint64_t minimum = atomic_load_explicit(&histogram->minimum, memory_order_relaxed);
+    uint64_t maximum = atomic_load_explicit(&histogram->maximum, memory_order_relaxed);
+    
+    atomic_fetch_add_explicit(&histogram->buckets[NIBHistogramBucketOfValue(duration)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->sum, duration, memory_order_relaxed);
+    
+    // the minimum of an empty histogram is 0 as all the counters, so it is
+    // kept one more than the minimum duration
+    while ((minimum == 0 || duration + 1 < minimum) &&
+           !atomic_compare_exchange_weak_explicit(&histogram->minimum, &minimum, duration + 1,
+                                                  memory_order_relaxed, memory_order_relaxed));
+    
+    while (duration > maximum &&
+           !atomic_compare_exchange_weak_explicit(&histogram->maximum, &maximum, duration,
+                                                  memory_order_relaxed, memory_order_relaxed));
+    
+    /* if the thread has no number yet, give it the next one */
+    if (threadNumber == 0) {
+        threadNumber = atomic_fetch_add_explicit(&threadCount, 1, memory_order_relaxed) + 1;
+    }
+    
+    uint64_t index = atomic_fetch_add_explicit(&traceEventCount, 1, memory_order_relaxed);
+    
+    traceEvents[index % NIB_TRACE_EVENT_CAPACITY] = (NIBInstrumentationTraceEvent){start, duration, threadNumber, (uint32_t)stage};
+}
+
+void NIBInstrumentationCountOperators(NIBInstrumentationOperatorCounter counter, const NIBToken *tokens, NSUInteger count) {
+    for (NSUInteger i = 0; i < count; i++) {
+        if (tokens[i].kind == NIBTokenKindOperator) {
+            NIBInstrumentationCountOperator(counter, tokens[i].tag);
+        }
+    }
+}
+
+void NIBInstrumentationCountOperator(NIBInstrumentationOperatorCounter counter, NIBButtonTag operatorTag) {
+    
+    /* if the tag is not of a button, it is not counted */
+    if (operatorTag < 0 || (NSUInteger)operatorTag >= NIB_OPERATOR_TAG_COUNT) {
+        return;
+    }
+    
+    atomic_fetch_add_explicit(&operatorCounts[counter][operatorTag], 1, memory_order_relaxed);
+}
+
+void NIBInstrumentationCountAllocation(NIBInstrumentationAllocation allocation, NSUInteger bytes) {
+    atomic_fetch_add_explicit(&allocationCounts[allocation], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&allocationBytes[allocation], bytes, memory_order_relaxed);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Implementation
+
+
+@implementation NIBInstrumentation
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Public Methods
+
+#pragma mark Exporting
+
++ (BOOL)isEnabled
+{
+    return NIB_INSTRUMENTATION != 0;
+}
+
++ (NSDictionary<NSString *, id> *)snapshot
+{
+    NSMutableDictionary<NSString *, id> *stages = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary<NSString *, id> *operators = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary<NSString *, id> *allocations = [[NSMutableDictionary alloc] init];
+    
+    for (NSUInteger stage = 0; stage < NIBInstrumentationStageCount; stage++) {
+        stages[NIBInstrumentationNameOfStage(stage)] = NIBHistogramSummary(&histograms[stage]);
+    }
+    
+    for (NSUInteger counter = 0; counter < NIBInstrumentationOperatorCounterCount; counter++) {
+        NSMutableDictionary<NSString *, NSNumber *> *counts = [[NSMutableDictionary alloc] init];
+        
+        for (NSUInteger tag = 0; tag < NIB_OPERATOR_TAG_COUNT; tag++) {
+            uint64_t count = atomic_load_explicit(&operatorCounts[counter][tag], memory_order_relaxed);
+            
+            /* only the operators which are counted are in the snapshot */
+            if (count > 0) {
+                counts[[NSString stringWithFormat:@"%lu", (unsigned long)tag]] = @(count);
+            }
+        }
+        
+        operators[NIBInstrumentationNameOfOperatorCounter(counter)] = counts;
+    }
+    
+    for (NSUInteger allocation = 0; allocation < NIBInstrumentationAllocationCount; allocation++) {
+        allocations[NIBInstrumentationNameOfAllocation(allocation)] = @{
+            @"count" : @(atomic_load_explicit(&allocationCounts[allocation], memory_order_relaxed)),
+            @"bytes" : @(atomic_load_explicit(&allocationBytes[allocation], memory_order_relaxed))
+        };
+    }
+    
+    return @{ @"enabled" : @([self isEnabled]),
+              @"latency_ns" : stages,
+              @"operators" : operators,
+              @"allocations" : allocations };
+}
+
++ (NSData *)chromeTraceData
+{
+    uint64_t count = atomic_load_explicit(&traceEventCount, memory_order_relaxed);
+    uint64_t first = (count > NIB_TRACE_EVENT_CAPACITY) ? count - NIB_TRACE_EVENT_CAPACITY : 0;
+    NSMutableArray<NSDictionary<NSString *, id> *> *events = [[NSMutableArray alloc] init];
+    
+    // the events are complete events, their times are in microseconds, and
+    // each thread which records them is a thread of the trace
+    for (uint64_t i = first; i < count; i++) {
+        NIBInstrumentationTraceEvent event = traceEvents[i % NIB_TRACE_EVENT_CAPACITY];
+        
+        [events addObject:@{ @"name" : NIBInstrumentationNameOfStage(event.stage),
+                             @"cat" : @"NIBCalculator",
+                             @"ph" : @"X",
+                             @"ts" : @(event.start / 1000.0),
+                             @"dur" : @(event.duration / 1000.0),
+                             @"pid" : @1,
+                             @"tid" : @(event.thread) }];
+    }
+    
+    NSDictionary<NSString *, id> *trace = @{ @"traceEvents" : events, @"displayTimeUnit" : @"ns" };
+    
+    return [NSJSONSerialization dataWithJSONObject:trace options:0 error:NULL];
+}
+
++ (BOOL)writeSnapshotToFile:(NSString *)path
+{
+    NSData *data = [NSJSONSerialization dataWithJSONObject:[self snapshot] options:NSJSONWritingPrettyPrinted error:NULL];
+    
+    return [data writeToFile:path atomically:YES];
+}
+
++ (BOOL)writeChromeTraceToFile:(NSString *)path
+{
+    return [[self chromeTraceData] writeToFile:path atomically:YES];
+}
+
++ (void)reset
+{
+    for (NSUInteger stage = 0; stage < NIBInstrumentationStageCount; stage++) {
+        for (NSUInteger i = 0; i < NIB_HISTOGRAM_BUCKET_COUNT; i++) {
+            atomic_store_explicit(&histograms[stage].buckets[i], 0, memory_order_relaxed);
+        }
+        
+        atomic_store_explicit(&histograms[stage].count, 0, memory_order_relaxed);
+        atomic_store_explicit(&histograms[stage].sum, 0, memory_order_relaxed);
+        atomic_store_explicit(&histograms[stage].minimum, 0, memory_order_relaxed);
+        atomic_store_explicit(&histograms[stage].maximum, 0, memory_order_relaxed);
+    }
+    
+    for (NSUInteger counter = 0; counter < NIBInstrumentationOperatorCounterCount; counter++) {
+        for (NSUInteger tag = 0; tag < NIB_OPERATOR_TAG_COUNT; tag++) {
+            atomic_store_explicit(&operatorCounts[counter][tag], 0, memory_order_relaxed);
+        }
+    }
+    
+    for (NSUInteger allocation = 0; allocation < NIBInstrumentationAllocationCount; allocation++) {
+        atomic_store_explicit(&allocationCounts[allocation], 0, memory_order_relaxed);
+        atomic_store_explicit(&allocationBytes[allocation], 0, memory_order_relaxed);
+    }
+    
+    atomic_store_explicit(&traceEventCount, 0, memory_order_relaxed);
+}
+
+@end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Get the bucket of a value. The values below 16 have a bucket each, the other
+ values are bucketed by their highest bit and the 4 bits below it.
+ 
+ @param value   The value.
+ 
+ @return Returns the index of the bucket.
+ */
+static NSUInteger NIBHistogramBucketOfValue(uint64_t value) {
+    if (value < (1u << NIB_HISTOGRAM_SUB_BUCKET_BITS)) {
+        return (NSUInteger)value;
+    }
+    
+    unsigned highestBit = 63 - (unsigned)__builtin_clzll(value);
+    unsigned shift = highestBit - NIB_HISTOGRAM_SUB_BUCKET_BITS;
+    NSUInteger subBucket = (NSUInteger)((value >> shift) & ((1u << NIB_HISTOGRAM_SUB_BUCKET_BITS) - 1));
+    
+    return (shift + 1) * (1u << NIB_HISTOGRAM_SUB_BUCKET_BITS) + subBucket;
+}
+
+/**
+ Get the highest value of a bucket.
+ 
+ @param bucket  The index of the bucket.
+ 
+ @return Returns the highest value which is recorded in the bucket.
+ */
+static uint64_t NIBHistogramHighestValueOfBucket(NSUInteger bucket) {
+    NSUInteger subBucketCount = 1u << NIB_HISTOGRAM_SUB_BUCKET_BITS;
+    
+    if (bucket < subBucketCount) {
+        return bucket;
+    }
+    
+    unsigned shift = (unsigned)(bucket / subBucketCount) - 1;
+    uint64_t lowestValue = (uint64_t)(subBucketCount + bucket % subBucketCount) << shift;
+    
+    return lowestValue + ((1ull << shift) - 1);
+}
+
+/**
+ Summarize a histogram.
+ 
+ @param histogram   The histogram.
+ 
+ @return Returns the count, the minimum, the mean, the maximum and the
+ percentiles of the histogram. A percentile is the highest value of its
+ bucket, but not above the maximum.
+ */
+static NSDictionary<NSString *, id> *NIBHistogramSummary(NIBInstrumentationHistogram *histogram) {
+    uint64_t buckets[NIB_HISTOGRAM_BUCKET_COUNT];
+    uint64_t count = 0;
+    uint64_t maximum = atomic_load_explicit(&histogram->maximum, memory_order_relaxed);
+    uint64_t minimum = atomic_load_explicit(&histogram->minimum, memory_order_relaxed);
+    uint64_t sum = atomic_load_explicit(&histogram->sum, memory_order_relaxed);
+    NSMutableDictionary<NSString *, id> *summary = [[NSMutableDictionary alloc] init];
+    
+    // the buckets are counted as they are copied, so the percentiles agree
+    // with the buckets while the other threads are recording
+    for (NSUInteger i = 0; i < NIB_HISTOGRAM_BUCKET_COUNT; i++) {
+        buckets[i] = atomic_load_explicit(&histogram->buckets[i], memory_order_relaxed);
+        count += buckets[i];
+    }
+    
+    summary[@"count"] = @(count);
+    summary[@"min"] = @(minimum > 0 ? minimum - 1 : 0);
+    summary[@"max"] = @(maximum);
+    summary[@"mean"] = @(count > 0 ? (double)sum / count : 0);
+    
+    for (NSUInteger i = 0; i < sizeof(NIBInstrumentationPercentiles) / sizeof(NIBInstrumentationPercentiles[0]); i++) {
+        double percentile = NIBInstrumentationPercentiles[i];
+        uint64_t rank = (uint64_t)ceil(percentile / 100 * count);
+        uint64_t seen = 0;
+        uint64_t value = 0;
+        
+        for (NSUInteger bucket = 0; bucket < NIB_HISTOGRAM_BUCKET_COUNT && count > 0; bucket++) {
+            seen += buckets[bucket];
+            
+            if (seen >= MAX(rank, 1)) {
+                value = MIN(NIBHistogramHighestValueOfBucket(bucket), maximum);
+                break;
+            }
+        }
+        
+        summary[[NSString stringWithFormat:@"p%g", percentile]] = @(value);
+    }
+    
+    return summary;
+}
+
+/**
+ Get the name of a stage.
+ 
+ @param stage   The stage.
+ 
+ @return Returns the name.
+ */
+static NSString *NIBInstrumentationNameOfStage(NIBInstrumentationStage stage) {
+    switch (stage) {
+        case NIBInstrumentationStageKeyAction:      return @"key_action";
+        case NIBInstrumentationStageEvaluation:     return @"evaluation";
+        case NIBInstrumentationStageFormatting:     return @"formatting";
+        case NIBInstrumentationStageFontFitting:    return @"font_fitting";
+        case NIBInstrumentationStageKeyToDisplay:   return @"key_to_display";
+        default:                                    return @"unknown";
+    }
+}
+
+/**
+ Get the name of a counter of operators.
+ 
+ @param counter The counter.
+ 
+ @return Returns the name.
+ */
+static NSString *NIBInstrumentationNameOfOperatorCounter(NIBInstrumentationOperatorCounter counter) {
+    switch (counter) {
+        case NIBInstrumentationOperatorCounterUnary:    return @"unary";
+        case NIBInstrumentationOperatorCounterPostfix:  return @"postfix";
+        default:                                        return @"unknown";
+    }
+}
+
+/**
+ Get the name of a kind of allocations.
+ 
+ @param allocation  The kind of allocations.
+ 
+ @return Returns the name.
+ */
+static NSString *NIBInstrumentationNameOfAllocation(NIBInstrumentationAllocation allocation) {
+    switch (allocation) {
+        case NIBInstrumentationAllocationTokenBuffer:       return @"token_buffer";
+        case NIBInstrumentationAllocationEvaluationStack:   return @"evaluation_stack";
+        case NIBInstrumentationAllocationNumber:            return @"number";
+        case NIBInstrumentationAllocationDisplayTexts:      return @"display_texts";
+        default:                                            return @"unknown";
+    }
+}
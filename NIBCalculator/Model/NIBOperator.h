@@ -11,13 +11,24 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/** Values to indicate the number of operands of an operator. */
+typedef NS_ENUM(uint8_t, NIBOperatorArity) {
+    /** The operator takes one operand. A tag which is not an operator is unary. */
+    NIBOperatorArityUnary,
+    /** The operator takes two operands. */
+    NIBOperatorArityBinary,
+    /** The operator does not take operands, as parentheses. */
+    NIBOperatorArityNone
+};
+
 /**
  `NIBOperator` is a class to wrap the operators of calculation and provide
  some utilities methods to query the type of operators or compare the priority
  of two operators.
  
  @note The class can not be instantiated and will generate an __error__ if doing
- so. The class includes only class methods.
+ so. The class includes only class methods. There is one shared operator per
+ button tag, so creating an operator does not allocate.
  */
 @interface NIBOperator : NSObject
 
@@ -105,4 +116,72 @@ The init method is unavailable.
 
 @end
 
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Operator Tag Utilities
+
+
+/**
+ Check if an operator tag is a parenthesis.
+ 
+ @param tag The tag of the operator.
+ 
+ @return Returns YES if the operator is a parenthesis, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBIsParenthesisOperatorTag(NSInteger tag);
+
+/**
+ Check if an operator tag is a binary operator.
+ 
+ @param tag The tag of the operator.
+ 
+ @return Returns YES if the operator is a binary operator, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBIsBinaryOperatorTag(NSInteger tag);
+
+/**
+ Check if an operator tag is an unary operator.
+ 
+ @param tag The tag of the operator.
+ 
+ @return Returns YES if the operator is an unary operator, otherwise NO.
+ */
+FOUNDATION_EXPORT BOOL NIBIsUnaryOperatorTag(NSInteger tag);
+
+/**
+ Get the precedence of an operator tag.
+ 
+ @param tag The tag of the operator.
+ 
+ @return Returns the precedence of a binary operator or 0 if the operator is
+ not a binary operator.
+ */
+FOUNDATION_EXPORT NSInteger NIBPrecedenceOfOperatorTag(NSInteger tag);
+
+/**
+ Compare the priority of two binary operator tags.
+ 
+ @param tag         The tag of the operator.
+ @param otherTag    The tag of the operator to check against to.
+ 
+ @return Returns a @b NSComparisonResult value that indicates the operator
+ priority ordering as -comparePriorityWithOperator: does.
+ */
+FOUNDATION_EXPORT NSComparisonResult NIBComparePriorityOfOperatorTags(NSInteger tag, NSInteger otherTag);
+
+/**
+ Find the operator whose description is the longest prefix of a text. Of the
+ operators which share a description, as x^y and y^x do, the one of the lower
+ tag is found.
+ 
+ @param text                The text in UTF-8, which does not need to end with
+                            a null character.
+ @param length              The length of the text in bytes.
+ @param descriptionLength   The length of the description in bytes.
+ 
+ @return Returns the tag of the operator, or -1 if no description of an
+ operator prefixes the text.
+ */
+FOUNDATION_EXPORT NSInteger NIBOperatorTagOfDescriptionPrefix(const char *text, NSUInteger length, NSUInteger *_Nullable descriptionLength);
+
 NS_ASSUME_NONNULL_END
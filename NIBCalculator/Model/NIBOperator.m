@@ -9,21 +9,110 @@
 #import "NIBOperator.h"
 
 
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ @struct NIBOperatorInfo.
+ 
+ @field arity           The number of operands of an operator.
+ @field precedence      The precedence of a binary operator, 0 for others.
+ @field description     The description of an operator.
+ */
+typedef struct NIBOperatorInfo {
+    NIBOperatorArity arity;
+    uint8_t precedence;
+    __unsafe_unretained NSString *_Nullable description;
+} NIBOperatorInfo;
+
+/**
+ @struct NIBOperatorSpelling.
+ 
+ @field text    The description of an operator in UTF-8.
+ @field length  The length of the description in bytes.
+ @field tag     The tag of the operator.
+ */
+typedef struct NIBOperatorSpelling {
+    const char *text;
+    NSUInteger length;
+    NSInteger tag;
+} NIBOperatorSpelling;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The number of button tags. */
+#define NIB_OPERATOR_TABLE_SIZE (NIBButtonDeg + 1)
+
+// The operator table is addressed by the button tag. The tags which are not
+// operators are unary operators without description, as an unknown operator
+// is performed as an unary operator which results not a number.
+static const NIBOperatorInfo NIBOperatorTable[NIB_OPERATOR_TABLE_SIZE] = {
+    [NIBButtonDivision]            = { NIBOperatorArityBinary, 2, @"/" },
+    [NIBButtonMultiplication]      = { NIBOperatorArityBinary, 2, @"x" },
+    [NIBButtonSubstraction]        = { NIBOperatorArityBinary, 1, @"-" },
+    [NIBButtonAddition]            = { NIBOperatorArityBinary, 1, @"+" },
+    [NIBButtonEquality]            = { NIBOperatorArityUnary,  0, @"=" },
+    [NIBButtonPercentage]          = { NIBOperatorArityUnary,  0, @"%" },
+    [NIBButtonOpenningParenthesis] = { NIBOperatorArityNone,   0, @"(" },
+    [NIBButtonClosingParenthesis]  = { NIBOperatorArityNone,   0, @")" },
+    [NIBButtonXSquared]            = { NIBOperatorArityUnary,  0, @"^2" },
+    [NIBButtonXCubed]              = { NIBOperatorArityUnary,  0, @"^3" },
+    [NIBButtonXPowerY]             = { NIBOperatorArityBinary, 3, @"^" },
+    [NIBButtonYPowerX]             = { NIBOperatorArityBinary, 3, @"^" },
+    [NIBButtonTwoPowerX]           = { NIBOperatorArityUnary,  0, @"2^" },
+    [NIBButtonEulerNumberPowerX]   = { NIBOperatorArityUnary,  0, @"e^" },
+    [NIBButtonTenPowerX]           = { NIBOperatorArityUnary,  0, @"10^" },
+    [NIBButtonOneOverX]            = { NIBOperatorArityUnary,  0, @"1/" },
+    [NIBButtonSquareRootOfX]       = { NIBOperatorArityUnary,  0, @"sqrt" },
+    [NIBButtonCubicRootOfX]        = { NIBOperatorArityUnary,  0, @"cbrt" },
+    [NIBButtonYthRootOfX]          = { NIBOperatorArityBinary, 3, @"root" },
+    [NIBButtonNaturalLogarithm]    = { NIBOperatorArityUnary,  0, @"ln" },
+    [NIBButtonCommonLogarithm]     = { NIBOperatorArityUnary,  0, @"log10" },
+    [NIBButtonLogarithmBaseYOfX]   = { NIBOperatorArityBinary, 3, @"log" },
+    [NIBButtonLogarithmBaseTwo]    = { NIBOperatorArityUnary,  0, @"log2" },
+    [NIBButtonXFactorial]          = { NIBOperatorArityUnary,  0, @"!" },
+    [NIBButtonSin]                 = { NIBOperatorArityUnary,  0, @"sin" },
+    [NIBButtonCos]                 = { NIBOperatorArityUnary,  0, @"cos" },
+    [NIBButtonTan]                 = { NIBOperatorArityUnary,  0, @"tan" },
+    [NIBButtonArcSin]              = { NIBOperatorArityUnary,  0, @"arcsin" },
+    [NIBButtonArcCos]              = { NIBOperatorArityUnary,  0, @"arccos" },
+    [NIBButtonArcTan]              = { NIBOperatorArityUnary,  0, @"arctan" },
+    [NIBButtonEE]                  = { NIBOperatorArityBinary, 3, @"x10^" },
+    [NIBButtonSinh]                = { NIBOperatorArityUnary,  0, @"sinh" },
+    [NIBButtonCosh]                = { NIBOperatorArityUnary,  0, @"cosh" },
+    [NIBButtonTanh]                = { NIBOperatorArityUnary,  0, @"tanh" },
+    [NIBButtonArcSinh]             = { NIBOperatorArityUnary,  0, @"arcsinh" },
+    [NIBButtonArcCosh]             = { NIBOperatorArityUnary,  0, @"arccosh" },
+    [NIBButtonArcTanh]             = { NIBOperatorArityUnary,  0, @"arctanh" }
+};
+
+/** The information of a tag out of the operator table. */
+static const NIBOperatorInfo NIBUnknownOperatorInfo = { NIBOperatorArityUnary, 0, nil };
+
+
 /////////////////////////////////////////////////////////////////////////////
 #pragma mark - Class Variables
 
 
-/** Class variable  binary operators. */
-static NSSet<NSNumber *> *binaryOperators;
+/** Class variable interned operators, one per button tag. */
+static NIBOperator *operators[NIB_OPERATOR_TABLE_SIZE];
 
-/** Class variable parenthesis operators. */
-static NSSet<NSNumber *> *parenthesisOperators;
+/** Class variable descriptions of the operators, the longest first. */
+static NIBOperatorSpelling spellings[NIB_OPERATOR_TABLE_SIZE];
 
-/** Class variable operator description. */
-static NSDictionary<NSNumber *, NSString *> *operatorDescriptions;
+/** Class variable number of descriptions of the operators. */
+static NSUInteger spellingCount = 0;
 
-/** The precedence of operator precedence. */
-static NSDictionary<NSNumber *, NSNumber *> *operatorPrecedence;
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static const NIBOperatorInfo * NIBInfoOfOperatorTag(NSInteger);
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -55,66 +144,39 @@ NS_ASSUME_NONNULL_END
 + (void)initialize
 {
     if (self == [NIBOperator class]) {
-        binaryOperators = [[NSSet alloc] initWithArray:@[@(NIBButtonDivision),
-                                                         @(NIBButtonMultiplication),
-                                                         @(NIBButtonSubstraction),
-                                                         @(NIBButtonAddition),
-                                                         @(NIBButtonYthRootOfX),
-                                                         @(NIBButtonXPowerY),
-                                                         @(NIBButtonYPowerX),
-                                                         @(NIBButtonLogarithmBaseYOfX),
-                                                         @(NIBButtonEE)]];
-        
-        parenthesisOperators = [[NSSet alloc] initWithArray:@[@(NIBButtonOpenningParenthesis),
-                                                              @(NIBButtonClosingParenthesis)]];
-        
-        operatorDescriptions = @{ @(NIBButtonDivision) : @"/",
-                                  @(NIBButtonMultiplication) : @"x",
-                                  @(NIBButtonSubstraction) : @"-",
-                                  @(NIBButtonAddition) : @"+",
-                                  @(NIBButtonEquality) : @"=",
-                                  @(NIBButtonPercentage) : @"%",
-                                  @(NIBButtonOpenningParenthesis) : @"(",
-                                  @(NIBButtonClosingParenthesis) : @")",
-                                  @(NIBButtonXSquared) : @"^2",
-                                  @(NIBButtonXCubed) : @"^3",
-                                  @(NIBButtonXPowerY) : @"^",
-                                  @(NIBButtonYPowerX) : @"^",
-                                  @(NIBButtonTwoPowerX) : @"2^",
-                                  @(NIBButtonEulerNumberPowerX) : @"e^",
-                                  @(NIBButtonTenPowerX) : @"10^",
-                                  @(NIBButtonOneOverX) : @"1/",
-                                  @(NIBButtonSquareRootOfX) : @"sqrt",
-                                  @(NIBButtonCubicRootOfX) : @"cbrt",
-                                  @(NIBButtonYthRootOfX) : @"root",
-                                  @(NIBButtonNaturalLogarithm) : @"ln",
-                                  @(NIBButtonCommonLogarithm) : @"log10",
-                                  @(NIBButtonLogarithmBaseYOfX) : @"log",
-                                  @(NIBButtonLogarithmBaseTwo) : @"log2",
-                                  @(NIBButtonXFactorial) : @"!",
-                                  @(NIBButtonSin) : @"sin",
-                                  @(NIBButtonCos) : @"cos",
-                                  @(NIBButtonTan) : @"tan",
-                                  @(NIBButtonArcSin) : @"arcsin",
-                                  @(NIBButtonArcCos) : @"arccos",
-                                  @(NIBButtonArcTan) : @"arctan",
-                                  @(NIBButtonEE) : @"x10^",
-                                  @(NIBButtonSinh) : @"sinh",
-                                  @(NIBButtonCosh) : @"cosh",
-                                  @(NIBButtonTanh) : @"tanh",
-                                  @(NIBButtonArcSinh) : @"arcsinh",
-                                  @(NIBButtonArcCosh) : @"arccosh",
-                                  @(NIBButtonArcTanh) : @"arctanh" };
+        for (NSInteger tag = 0; tag < NIB_OPERATOR_TABLE_SIZE; tag++) {
+            NIBOperator *operator = [[NIBOperator alloc] init];
+            operator.idx = tag;
+            operators[tag] = operator;
+        }
         
-        operatorPrecedence = @{ @(NIBButtonAddition) : @(1),
-                                @(NIBButtonSubstraction) : @(1),
-                                @(NIBButtonDivision) : @(2),
-                                @(NIBButtonMultiplication) : @(2),
-                                @(NIBButtonXPowerY) : @(3),
-                                @(NIBButtonYPowerX) : @(3),
-                                @(NIBButtonYthRootOfX) : @(3),
-                                @(NIBButtonLogarithmBaseYOfX) : @(3),
-                                @(NIBButtonEE) : @(3) };
+        // the descriptions are sorted from the longest, so the first one
+        // which prefixes a text is the longest, as x10^ before x, and a
+        // description shared by two operators is kept for the first tag
+        for (NSInteger tag = 0; tag < NIB_OPERATOR_TABLE_SIZE; tag++) {
+            NSString *description = NIBOperatorTable[tag].description;
+            
+            if (description == nil) continue;
+            
+            const char *text = description.UTF8String;
+            NSUInteger length = strlen(text);
+            NSUInteger idx = spellingCount;
+            BOOL isDuplicate = NO;
+            
+            for (NSUInteger i = 0; i < spellingCount; i++) {
+                if (strcmp(spellings[i].text, text) == 0) isDuplicate = YES;
+            }
+            
+            if (isDuplicate) continue;
+            
+            while (idx > 0 && spellings[idx - 1].length < length) {
+                spellings[idx] = spellings[idx - 1];
+                idx--;
+            }
+            
+            spellings[idx] = (NIBOperatorSpelling){strdup(text), length, tag};
+            spellingCount++;
+        }
     }
 }
 
@@ -122,6 +184,12 @@ NS_ASSUME_NONNULL_END
 
 + (instancetype)operatorWithTag:(NSInteger)tag
 {
+    /* if the tag is in the operator table, share the interned operator */
+    if (tag >= 0 && tag < NIB_OPERATOR_TABLE_SIZE && self == [NIBOperator class]) {
+        return operators[tag];
+    }
+    
+    /* otherwise, create a new operator */
     NIBOperator *operation = [[self alloc] init];
     
     if (operation) {
@@ -150,27 +218,17 @@ NS_ASSUME_NONNULL_END
 
 - (BOOL)isUnaryOperator
 {
-    return [binaryOperators containsObject:@(self.idx)] || [parenthesisOperators containsObject:@(self.idx)] ? NO : YES;
+    return NIBIsUnaryOperatorTag(self.idx);
 }
 
 - (BOOL)isBinaryOperator
 {
-    return [binaryOperators containsObject:@(self.idx)] ? YES : NO;
+    return NIBIsBinaryOperatorTag(self.idx);
 }
 
 - (NSComparisonResult)comparePriorityWithOperator:(NIBOperator *)aOperator
 {
-    NSComparisonResult result;
-    
-    if (operatorPrecedence[@(self.idx)].integerValue < operatorPrecedence[@(aOperator.idx)].integerValue) {
-        result = NSOrderedAscending;
-    } else if (operatorPrecedence[@(self.idx)].integerValue > operatorPrecedence[@(aOperator.idx)].integerValue) {
-        result = NSOrderedDescending;
-    } else {
-        result = NSOrderedSame;
-    }
-    
-    return result;
+    return NIBComparePriorityOfOperatorTags(self.idx, aOperator.idx);
 }
 
 
@@ -180,7 +238,7 @@ NS_ASSUME_NONNULL_END
 
 - (NSString *)description
 {
-    return operatorDescriptions[@(self.idx)];
+    return NIBInfoOfOperatorTag(self.idx)->description;
 }
 
 //- (BOOL)isEqual:(id)object
@@ -202,3 +260,75 @@ NS_ASSUME_NONNULL_END
 //}
 
 @end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Operator Tag Utilities
+
+
+BOOL NIBIsParenthesisOperatorTag(NSInteger tag) {
+    return tag == NIBButtonOpenningParenthesis || tag == NIBButtonClosingParenthesis;
+}
+
+BOOL NIBIsBinaryOperatorTag(NSInteger tag) {
+    return NIBInfoOfOperatorTag(tag)->arity == NIBOperatorArityBinary;
+}
+
+BOOL NIBIsUnaryOperatorTag(NSInteger tag) {
+    return NIBInfoOfOperatorTag(tag)->arity == NIBOperatorArityUnary;
+}
+
+NSInteger NIBPrecedenceOfOperatorTag(NSInteger tag) {
+    return NIBInfoOfOperatorTag(tag)->precedence;
+}
+
+NSInteger NIBOperatorTagOfDescriptionPrefix(const char *text, NSUInteger length, NSUInteger *descriptionLength) {
+    /* make sure the descriptions are sorted */
+    [NIBOperator class];
+    
+    for (NSUInteger i = 0; i < spellingCount; i++) {
+        if (spellings[i].length <= length && memcmp(spellings[i].text, text, spellings[i].length) == 0) {
+            if (descriptionLength) *descriptionLength = spellings[i].length;
+            return spellings[i].tag;
+        }
+    }
+    
+    return -1;
+}
+
+NSComparisonResult NIBComparePriorityOfOperatorTags(NSInteger tag, NSInteger otherTag) {
+    NSInteger precedence = NIBInfoOfOperatorTag(tag)->precedence;
+    NSInteger otherPrecedence = NIBInfoOfOperatorTag(otherTag)->precedence;
+    NSComparisonResult result;
+    
+    if (precedence < otherPrecedence) {
+        result = NSOrderedAscending;
+    } else if (precedence > otherPrecedence) {
+        result = NSOrderedDescending;
+    } else {
+        result = NSOrderedSame;
+    }
+    
+    return result;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Get the information of an operator tag.
+ 
+ @param tag The tag of the operator.
+ 
+ @return Returns the entry of the operator table if the tag is in the table,
+ otherwise the information of an unknown operator.
+ */
+static const NIBOperatorInfo * NIBInfoOfOperatorTag(NSInteger tag) {
+    if (tag < 0 || tag >= NIB_OPERATOR_TABLE_SIZE) {
+        return &NIBUnknownOperatorInfo;
+    }
+    
+    return &NIBOperatorTable[tag];
+}
@@ -0,0 +1,148 @@
+//
+//  NIBShuntingYard.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "NIBConstants.h"
+#import "NIBToken.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Types, Enumeration and Options
+
+
+/**
+ @struct NIBShuntingYard
+ 
+ A streaming shunting-yard evaluator. The tokens of an infix expression are
+ pushed one by one, and a binary operator reduces the operators of equal or
+ higher priority on the stack as soon as it arrives. So the value of the
+ expression is always one reduction away, without parsing the expression
+ again. A zeroed shunting yard is a valid empty one. The storage must be
+ released with NIBShuntingYardFree().
+ 
+ @field values      The operands and reduced values.
+ @field operators   The binary operators and openning parentheses waiting for
+                    their right operand.
+ */
+typedef struct NIBShuntingYard {
+    NIBTokenBuffer values;
+    NIBTokenBuffer operators;
+} NIBShuntingYard;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Pushing Tokens
+
+
+/**
+ Push an operand to a shunting yard.
+ 
+ @param yard    The shunting yard.
+ @param operand The operand.
+ */
+FOUNDATION_EXPORT void NIBShuntingYardPushOperand(NIBShuntingYard *yard, double operand);
+
+/**
+ Push an operator to a shunting yard. A binary operator reduces the operators
+ which have higher priority, or equal priority and group from the left. An
+ openning parenthesis is pushed as is.
+ 
+ @param yard        The shunting yard.
+ @param operatorTag The tag of the binary operator or openning parenthesis.
+ */
+FOUNDATION_EXPORT void NIBShuntingYardPushOperator(NIBShuntingYard *yard, NIBButtonTag operatorTag);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Reducing
+
+
+/**
+ Reduce the binary operators on the top of a shunting yard while they have a
+ precedence equal or higher than a given one. The reduction stops at an
+ openning parenthesis.
+ 
+ @param yard        The shunting yard.
+ @param precedence  The lowest precedence to reduce. 1 reduces every binary
+                    operator back to the last openning parenthesis.
+ 
+ @return Returns the value on the top of the shunting yard after reduction,
+ or NAN if there is no value.
+ */
+FOUNDATION_EXPORT double NIBShuntingYardReduce(NIBShuntingYard *yard, NSInteger precedence);
+
+/**
+ Get the value a shunting yard would have after a reduction, without reducing
+ it. The shunting yard is not modified.
+ 
+ @param yard        The shunting yard.
+ @param precedence  The lowest precedence to reduce, as NIBShuntingYardReduce().
+ 
+ @return Returns the value on the top of the shunting yard after reduction,
+ or NAN if there is no value.
+ */
+FOUNDATION_EXPORT double NIBShuntingYardPeek(const NIBShuntingYard *yard, NSInteger precedence);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Removing Tokens
+
+
+/**
+ Remove the last operand of a shunting yard.
+ 
+ @param yard    The shunting yard.
+ */
+FOUNDATION_EXPORT void NIBShuntingYardPopOperand(NIBShuntingYard *yard);
+
+/**
+ Remove the last operator of a shunting yard.
+ 
+ @param yard    The shunting yard.
+ */
+FOUNDATION_EXPORT void NIBShuntingYardPopOperator(NIBShuntingYard *yard);
+
+/**
+ Remove the last parenthesized group of a shunting yard, from the last
+ openning parenthesis to the end.
+ 
+ @param yard    The shunting yard.
+ */
+FOUNDATION_EXPORT void NIBShuntingYardRemoveGroup(NIBShuntingYard *yard);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Managing Storage
+
+
+/**
+ Replace the content of a shunting yard with the content of another one.
+ 
+ @param yard    The shunting yard to replace.
+ @param source  The shunting yard to copy.
+ */
+FOUNDATION_EXPORT void NIBShuntingYardSetShuntingYard(NIBShuntingYard *yard, const NIBShuntingYard *source);
+
+/**
+ Remove every value and operator of a shunting yard. The storage is kept for
+ reuse.
+ 
+ @param yard    The shunting yard.
+ */
+FOUNDATION_EXPORT void NIBShuntingYardReset(NIBShuntingYard *yard);
+
+/**
+ Release the storage of a shunting yard and reset it to an empty one.
+ 
+ @param yard    The shunting yard.
+ */
+FOUNDATION_EXPORT void NIBShuntingYardFree(NIBShuntingYard *yard);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,171 @@
+//
+//  NIBShuntingYard.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBShuntingYard.h"
+#import "NIBCalculatorKernels.h"
+#import "NIBOperator.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static void NIBShuntingYardReduceOperator(NIBShuntingYard *);
+static double NIBShuntingYardOperate(NIBButtonTag, const double *_Nullable, double);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Pushing Tokens
+
+
+void NIBShuntingYardPushOperand(NIBShuntingYard *yard, double operand) {
+    NIBTokenBufferAppend(&yard->values, NIBTokenMakeOperand(operand));
+}
+
+void NIBShuntingYardPushOperator(NIBShuntingYard *yard, NIBButtonTag operatorTag) {
+    /* if the operator is a binary operator, reduce the operators it follows */
+    if (NIBIsBinaryOperatorTag(operatorTag)) {
+        NIBShuntingYardReduce(yard, NIBPrecedenceOfOperatorTag(operatorTag));
+    }
+    
+    NIBTokenBufferAppend(&yard->operators, NIBTokenMakeOperator(operatorTag));
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Reducing
+
+
+double NIBShuntingYardReduce(NIBShuntingYard *yard, NSInteger precedence) {
+    while (yard->operators.count > 0) {
+        NIBButtonTag topTag = yard->operators.tokens[yard->operators.count - 1].tag;
+        
+        /* if the top operator is an openning parenthesis or has lower precedence, stop */
+        if (!NIBIsBinaryOperatorTag(topTag) || NIBPrecedenceOfOperatorTag(topTag) < precedence) {
+            break;
+        }
+        
+        NIBShuntingYardReduceOperator(yard);
+    }
+    
+    /* the value on the top is the value of the reduced expression */
+    return (yard->values.count > 0) ? yard->values.tokens[yard->values.count - 1].operand : NAN;
+}
+
+double NIBShuntingYardPeek(const NIBShuntingYard *yard, NSInteger precedence) {
+    NSUInteger valueCount = yard->values.count;
+    NSUInteger operatorCount = yard->operators.count;
+    double value = (valueCount > 0) ? yard->values.tokens[--valueCount].operand : NAN;
+    
+    // fold the operators from the top into a running right operand, as the
+    // reduction does, but leave the stacks as they are
+    while (operatorCount > 0) {
+        NIBButtonTag topTag = yard->operators.tokens[operatorCount - 1].tag;
+        
+        /* if the top operator is an openning parenthesis or has lower precedence, stop */
+        if (!NIBIsBinaryOperatorTag(topTag) || NIBPrecedenceOfOperatorTag(topTag) < precedence) {
+            break;
+        }
+        
+        const double *leftOperand = (valueCount > 0) ? &yard->values.tokens[--valueCount].operand : NULL;
+        
+        value = NIBShuntingYardOperate(topTag, leftOperand, value);
+        operatorCount--;
+    }
+    
+    return value;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Removing Tokens
+
+
+void NIBShuntingYardPopOperand(NIBShuntingYard *yard) {
+    if (yard->values.count > 0) {
+        NIBTokenBufferTruncate(&yard->values, yard->values.count - 1);
+    }
+}
+
+void NIBShuntingYardPopOperator(NIBShuntingYard *yard) {
+    if (yard->operators.count > 0) {
+        NIBTokenBufferTruncate(&yard->operators, yard->operators.count - 1);
+    }
+}
+
+void NIBShuntingYardRemoveGroup(NIBShuntingYard *yard) {
+    /* reduce the group to one value, then remove the value and the parenthesis */
+    NIBShuntingYardReduce(yard, 1);
+    NIBShuntingYardPopOperand(yard);
+    NIBShuntingYardPopOperator(yard);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Managing Storage
+
+
+void NIBShuntingYardSetShuntingYard(NIBShuntingYard *yard, const NIBShuntingYard *source) {
+    NIBTokenBufferSetBuffer(&yard->values, &source->values);
+    NIBTokenBufferSetBuffer(&yard->operators, &source->operators);
+}
+
+void NIBShuntingYardReset(NIBShuntingYard *yard) {
+    NIBTokenBufferTruncate(&yard->values, 0);
+    NIBTokenBufferTruncate(&yard->operators, 0);
+}
+
+void NIBShuntingYardFree(NIBShuntingYard *yard) {
+    NIBTokenBufferFree(&yard->values);
+    NIBTokenBufferFree(&yard->operators);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Reduce the binary operator on the top of a shunting yard with its two
+ operands.
+ 
+ @param yard    The shunting yard.
+ */
+static void NIBShuntingYardReduceOperator(NIBShuntingYard *yard) {
+    NIBTokenBuffer *values = &yard->values;
+    NIBButtonTag operatorTag = yard->operators.tokens[--yard->operators.count].tag;
+    
+    double rightOperand = (values->count > 0) ? values->tokens[--values->count].operand : NAN;
+    const double *leftOperand = (values->count > 0) ? &values->tokens[--values->count].operand : NULL;
+    
+    NIBTokenBufferAppend(values, NIBTokenMakeOperand(NIBShuntingYardOperate(operatorTag, leftOperand, rightOperand)));
+}
+
+/**
+ Perform a binary operator of a shunting yard. A missing operand is NAN except
+ the first summand of an addition, as the postfix evaluation does.
+ 
+ @param operatorTag     The tag of the binary operator.
+ @param leftOperand     The left operand, or NULL if it is missing.
+ @param rightOperand    The right operand.
+ 
+ @return Returns the result of the binary operator.
+ */
+static double NIBShuntingYardOperate(NIBButtonTag operatorTag, const double *leftOperand, double rightOperand) {
+    double left = NAN;
+    
+    if (leftOperand != NULL) {
+        left = *leftOperand;
+    
+    /* if there is no first summand, the sole summand is the sum */
+    } else if (operatorTag == NIBButtonAddition) {
+        left = 0;
+    }
+    
+    return NIBPerformBinaryOperator(operatorTag, left, rightOperand);
+}
@@ -0,0 +1,153 @@
+//
+//  NIBToken.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "NIBConstants.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Types, Enumeration and Options
+
+
+/** Values to indicate which kind of value a token holds. */
+typedef NS_ENUM(uint8_t, NIBTokenKind) {
+    /** The token is an operand. */
+    NIBTokenKindOperand,
+    /** The token is an operator. */
+    NIBTokenKindOperator
+};
+
+/**
+ @struct NIBToken
+ 
+ A token of an expression. The token is a plain value that holds either an
+ operand or the tag of an operator, so expressions can be stored in contiguous
+ buffers without any object per token.
+ 
+ @field kind    The kind of the token.
+ @field operand The operand if the kind is NIBTokenKindOperand.
+ @field tag     The operator tag if the kind is NIBTokenKindOperator.
+ */
+typedef struct NIBToken {
+    NIBTokenKind kind;
+    union {
+        double operand;
+        NIBButtonTag tag;
+    };
+} NIBToken;
+
+/**
+ @struct NIBTokenBuffer
+ 
+ A growable contiguous buffer of tokens. A zeroed buffer is a valid empty
+ buffer. The storage must be released with NIBTokenBufferFree().
+ 
+ @field tokens      The tokens.
+ @field count       The number of tokens in the buffer.
+ @field capacity    The number of tokens the buffer can hold without growing.
+ */
+typedef struct NIBTokenBuffer {
+    NIBToken *_Nullable tokens;
+    NSUInteger count;
+    NSUInteger capacity;
+} NIBTokenBuffer;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Creating Tokens
+
+
+/**
+ Create an operand token.
+ 
+ @param operand The operand.
+ 
+ @return Returns the operand token.
+ */
+NS_INLINE NIBToken NIBTokenMakeOperand(double operand) {
+    NIBToken token;
+    token.kind = NIBTokenKindOperand;
+    token.operand = operand;
+    return token;
+}
+
+/**
+ Create an operator token.
+ 
+ @param tag The tag of the operator.
+ 
+ @return Returns the operator token.
+ */
+NS_INLINE NIBToken NIBTokenMakeOperator(NIBButtonTag tag) {
+    NIBToken token;
+    token.kind = NIBTokenKindOperator;
+    token.tag = tag;
+    return token;
+}
+
+/**
+ Check if a token is an operator with a given tag.
+ 
+ @param token   The token to check.
+ @param tag     The tag of the operator.
+ 
+ @return Returns YES if the token is the operator, otherwise NO.
+ */
+NS_INLINE BOOL NIBTokenIsOperatorWithTag(NIBToken token, NIBButtonTag tag) {
+    return token.kind == NIBTokenKindOperator && token.tag == tag;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Token Buffer
+
+
+/**
+ Append a token to the end of a buffer.
+ 
+ @param buffer  The buffer.
+ @param token   The token to append.
+ */
+FOUNDATION_EXPORT void NIBTokenBufferAppend(NIBTokenBuffer *buffer, NIBToken token);
+
+/**
+ Append tokens to the end of a buffer.
+ 
+ @param buffer  The buffer.
+ @param tokens  The tokens to append.
+ @param count   The number of tokens to append.
+ */
+FOUNDATION_EXPORT void NIBTokenBufferAppendTokens(NIBTokenBuffer *buffer, const NIBToken *_Nullable tokens, NSUInteger count);
+
+/**
+ Remove tokens from the end of a buffer so that it keeps a given number of
+ tokens. The storage of the buffer is kept for reuse.
+ 
+ @param buffer  The buffer.
+ @param count   The number of tokens to keep.
+ */
+FOUNDATION_EXPORT void NIBTokenBufferTruncate(NIBTokenBuffer *buffer, NSUInteger count);
+
+/**
+ Replace the content of a buffer with the content of another buffer.
+ 
+ @param buffer  The buffer to replace.
+ @param source  The buffer to copy.
+ */
+FOUNDATION_EXPORT void NIBTokenBufferSetBuffer(NIBTokenBuffer *buffer, const NIBTokenBuffer *source);
+
+/**
+ Release the storage of a buffer and reset it to an empty buffer.
+ 
+ @param buffer  The buffer.
+ */
+FOUNDATION_EXPORT void NIBTokenBufferFree(NIBTokenBuffer *buffer);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,102 @@
+//
+//  NIBToken.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBToken.h"
+#import "NIBInstrumentation.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The initial capacity of a token buffer. */
+static const NSUInteger NIBTokenBufferInitialCapacity = 16;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static void NIBTokenBufferReserve(NIBTokenBuffer *, NSUInteger);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Token Buffer
+
+
+void NIBTokenBufferAppend(NIBTokenBuffer *buffer, NIBToken token) {
+    if (buffer->count == buffer->capacity) {
+        NIBTokenBufferReserve(buffer, buffer->count + 1);
+    }
+    
+    buffer->tokens[buffer->count++] = token;
+}
+
+void NIBTokenBufferAppendTokens(NIBTokenBuffer *buffer, const NIBToken *tokens, NSUInteger count) {
+    if (count == 0) {
+        return;
+    }
+    
+    NIBTokenBufferReserve(buffer, buffer->count + count);
+    memcpy(buffer->tokens + buffer->count, tokens, count * sizeof(NIBToken));
+    buffer->count += count;
+}
+
+void NIBTokenBufferTruncate(NIBTokenBuffer *buffer, NSUInteger count) {
+    if (count < buffer->count) {
+        buffer->count = count;
+    }
+}
+
+void NIBTokenBufferSetBuffer(NIBTokenBuffer *buffer, const NIBTokenBuffer *source) {
+    buffer->count = 0;
+    NIBTokenBufferAppendTokens(buffer, source->tokens, source->count);
+}
+
+void NIBTokenBufferFree(NIBTokenBuffer *buffer) {
+    free(buffer->tokens);
+    buffer->tokens = NULL;
+    buffer->count = 0;
+    buffer->capacity = 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Grow the storage of a buffer to hold at least a number of tokens. The capacity
+ is doubled so appending is amortized constant time.
+ 
+ @param buffer      The buffer.
+ @param capacity    The minimum number of tokens to hold.
+ */
+static void NIBTokenBufferReserve(NIBTokenBuffer *buffer, NSUInteger capacity) {
+    if (capacity <= buffer->capacity) {
+        return;
+    }
+    
+    NSUInteger newCapacity = (buffer->capacity > 0) ? buffer->capacity : NIBTokenBufferInitialCapacity;
+    
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+    
+    NIBToken *tokens = realloc(buffer->tokens, newCapacity * sizeof(NIBToken));
+    
+    NIB_COUNT_ALLOCATION(NIBInstrumentationAllocationTokenBuffer, newCapacity * sizeof(NIBToken));
+    
+    /* if the storage can not be grown */
+    if (tokens == NULL) {
+        [NSException raise:NSMallocException format:@"Can not grow token buffer to %lu tokens", (unsigned long)newCapacity];
+    }
+    
+    buffer->tokens = tokens;
+    buffer->capacity = newCapacity;
+}
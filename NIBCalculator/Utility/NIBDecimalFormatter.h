@@ -0,0 +1,129 @@
+//
+//  NIBDecimalFormatter.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ `NIBDecimalFormatter` formats and parses numbers of the decimal style of a
+ locale without `NSNumberFormatter`. A double is converted to its shortest
+ decimal which reads back to the same double, rounded half to even and written
+ with the separators of the locale in one pass.
+ 
+ The formatter checks its output against `NSNumberFormatter` when it is
+ created. If the locale has symbols the formatter can not reproduce, such as
+ native digits, every method falls back to the formatters of
+ `NIBNumberFormatterPool`, so the results are always the same as the ones of
+ `NSNumberFormatter`.
+ 
+ A formatter is immutable and can be used from any thread.
+ */
+@interface NIBDecimalFormatter : NSObject
+
+/// -----------------
+/// @name Properties
+/// -----------------
+
+/** The locale of the formatter. */
+@property (readonly, strong, nonatomic) NSLocale *locale;
+
+/** The decimal separator of the locale. */
+@property (readonly, copy, nonatomic) NSString *decimalSeparator;
+
+/** The grouping separator of the locale. */
+@property (readonly, copy, nonatomic) NSString *groupingSeparator;
+
+/** The minus sign of the locale. */
+@property (readonly, copy, nonatomic) NSString *minusSign;
+
+/** The boolean value to indicate if the formatter reproduces `NSNumberFormatter` without it. */
+@property (readonly, assign, nonatomic) BOOL isCompatible;
+
+/// ------------------------------
+/// @name Creating a Formatter
+/// ------------------------------
+
+/**
+ Create a formatter of a locale.
+ 
+ @param locale  The locale.
+ 
+ @return Returns the formatter of the locale.
+ */
++ (instancetype)formatterWithLocale:(NSLocale *)locale;
+
+/// -----------------------
+/// @name Formatting Numbers
+/// -----------------------
+
+/**
+ Create a string of a number with a maximum number of fraction digits, as a
+ formatter of the decimal style does.
+ 
+ @param value                   The number.
+ @param maximumFractionDigits   The maximum number of fraction digits.
+ 
+ @return Returns the string of the number.
+ */
+- (NSString *)stringFromDouble:(double)value maximumFractionDigits:(NSUInteger)maximumFractionDigits;
+
+/**
+ Create a string of a number rounded to a maximum number of significant
+ digits, as a formatter of the decimal style with grouping does.
+ 
+ @param value                       The number.
+ @param maximumSignificantDigits    The maximum number of significant digits.
+ 
+ @return Returns the string of the number.
+ */
+- (NSString *)stringFromDouble:(double)value maximumSignificantDigits:(NSUInteger)maximumSignificantDigits;
+
+/**
+ Count the digits of the string of a number with a maximum number of fraction
+ digits without creating the string.
+ 
+ @param value                   The number.
+ @param maximumFractionDigits   The maximum number of fraction digits.
+ 
+ @return Returns the number of digits.
+ */
+- (NSUInteger)digitsOfDouble:(double)value maximumFractionDigits:(NSUInteger)maximumFractionDigits;
+
+/**
+ Count the characters before the decimal separator of the string of a number
+ with a maximum number of fraction digits, once the grouping separators and the
+ hyphen minus are removed, without creating the string. If the string has no
+ decimal separator, the digits are counted.
+ 
+ @param value                   The number.
+ @param maximumFractionDigits   The maximum number of fraction digits.
+ 
+ @return Returns the number of characters of the integer part.
+ */
+- (NSUInteger)digitsOfIntegerPartOfDouble:(double)value maximumFractionDigits:(NSUInteger)maximumFractionDigits;
+
+/// ---------------------
+/// @name Parsing Numbers
+/// ---------------------
+
+/**
+ Parse a string of the decimal style: an optional minus sign, digits with
+ grouping separators and an optional decimal separator followed by digits.
+ 
+ @param value   The parsed number.
+ @param string  The string to parse.
+ 
+ @return Returns YES if the string is parsed, or NO if it is not a string of
+ the decimal style, such as a string in scientific notation.
+ */
+- (BOOL)getDouble:(double *)value fromString:(NSString *)string;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,750 @@
+//
+//  NIBDecimalFormatter.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBDecimalFormatter.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ @struct NIBDecimal
+ 
+ A decimal number 0.d1d2...dn x 10^exponent of at most 17 significant digits,
+ the digits of a double.
+ 
+ @field digits      The ASCII digits without trailing zeros.
+ @field count       The number of digits. 0 is the number zero.
+ @field exponent    The power of ten of the number.
+ @field isNegative  The boolean value to indicate if the number is negative.
+ */
+typedef struct NIBDecimal {
+    char digits[20];
+    NSInteger count;
+    NSInteger exponent;
+    BOOL isNegative;
+} NIBDecimal;
+
+/**
+ @struct NIBCharacterBuffer
+ 
+ A buffer of characters on the stack which grows on the heap when needed. The
+ storage must be released with NIBCharacterBufferFree().
+ 
+ @field inlineCharacters    The storage on the stack.
+ @field characters          The characters.
+ @field length              The number of characters.
+ @field capacity            The number of characters the storage can hold.
+ */
+typedef struct NIBCharacterBuffer {
+    unichar inlineCharacters[128];
+    unichar *characters;
+    NSUInteger length;
+    NSUInteger capacity;
+} NIBCharacterBuffer;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The maximum number of digits of a double to read back the same double. */
+static const int NIBMaxRoundTripDigits = 17;
+
+/** The maximum length of a string the fast parser reads. */
+static const NSUInteger NIBMaxParsingLength = 64;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static void NIBDecimalFromDouble(double, NIBDecimal *);
+static void NIBDecimalRoundToDigits(NIBDecimal *, NSInteger);
+static void NIBCharacterBufferReserve(NIBCharacterBuffer *, NSUInteger);
+static void NIBCharacterBufferAppendString(NIBCharacterBuffer *, NSString *);
+static void NIBCharacterBufferFree(NIBCharacterBuffer *);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Extension
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBDecimalFormatter ()
+
+/** The prefix of positive numbers. */
+@property (readwrite, copy, nonatomic) NSString *positivePrefix;
+
+/** The suffix of positive numbers. */
+@property (readwrite, copy, nonatomic) NSString *positiveSuffix;
+
+/** The prefix of negative numbers. */
+@property (readwrite, copy, nonatomic) NSString *negativePrefix;
+
+/** The suffix of negative numbers. */
+@property (readwrite, copy, nonatomic) NSString *negativeSuffix;
+
+/** The number of digits of the first group from the decimal separator. */
+@property (readwrite, assign, nonatomic) NSUInteger groupingSize;
+
+/** The number of digits of the other groups. */
+@property (readwrite, assign, nonatomic) NSUInteger secondaryGroupingSize;
+
+/** The minimum number of digits of the integer part beyond the first group to group it. */
+@property (readwrite, assign, nonatomic) NSUInteger minimumGroupingDigits;
+
+/** The number formatters of the locale which the formatter falls back on, keyed by their configuration. */
+@property (readwrite, strong, nonatomic) NSMutableDictionary<NSString *, NSNumberFormatter *> *fallbackFormatters;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Category
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBDecimalFormatter (Private)
+
+/**
+ Check the output of the formatter against `NSNumberFormatter` of the locale.
+ 
+ @return Returns YES if the formatter formats and parses the probe numbers as
+ `NSNumberFormatter` does. Otherwise, NO.
+ */
+- (BOOL)reproducesNumberFormatter;
+
+/**
+ Get the number formatter of the decimal style of the locale which the
+ formatter falls back on.
+ 
+ @param maximumFractionDigits       The maximum number of fraction digits, or
+                                    NSNotFound if it rounds to significant digits.
+ @param maximumSignificantDigits    The maximum number of significant digits.
+ 
+ @return Returns the number formatter of the configuration.
+ */
+- (NSNumberFormatter *)fallbackFormatterWithMaximumFractionDigits:(NSUInteger)maximumFractionDigits
+                                         maximumSignificantDigits:(NSUInteger)maximumSignificantDigits;
+
+/**
+ Write a rounded decimal number in the decimal style of the locale.
+ 
+ @param buffer  The buffer to write to.
+ @param decimal The rounded decimal number.
+ 
+ @return Returns YES if the number is written, or NO if the formatter must fall
+ back on `NSNumberFormatter`, such as for a negative number rounded to zero.
+ */
+- (BOOL)writeToBuffer:(NIBCharacterBuffer *)buffer decimal:(const NIBDecimal *)decimal;
+
+/**
+ Write a number with a maximum number of fraction digits in the decimal style
+ of the locale, falling back on `NSNumberFormatter` if needed.
+ 
+ @param buffer                  The buffer to write to.
+ @param value                   The number.
+ @param maximumFractionDigits   The maximum number of fraction digits.
+ */
+- (void)writeToBuffer:(NIBCharacterBuffer *)buffer
+               double:(double)value
+maximumFractionDigits:(NSUInteger)maximumFractionDigits;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Implementation
+
+
+@implementation NIBDecimalFormatter
+
+#pragma mark Creating a Formatter
+
++ (instancetype)formatterWithLocale:(NSLocale *)locale
+{
+    return [[self alloc] initWithLocale:locale];
+}
+
+- (instancetype)initWithLocale:(NSLocale *)locale
+{
+    self = [super init];
+    
+    if (self) {
+        NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
+        numberFormatter.locale = locale;
+        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+        
+        _locale = locale;
+        _decimalSeparator = [numberFormatter.decimalSeparator copy];
+        _groupingSeparator = [numberFormatter.groupingSeparator copy];
+        _minusSign = [numberFormatter.minusSign copy];
+        _positivePrefix = [numberFormatter.positivePrefix copy] ?: @"";
+        _positiveSuffix = [numberFormatter.positiveSuffix copy] ?: @"";
+        _negativePrefix = [numberFormatter.negativePrefix copy] ?: @"";
+        _negativeSuffix = [numberFormatter.negativeSuffix copy] ?: @"";
+        _groupingSize = numberFormatter.usesGroupingSeparator ? numberFormatter.groupingSize : 0;
+        _secondaryGroupingSize = numberFormatter.secondaryGroupingSize ?: _groupingSize;
+        _fallbackFormatters = [[NSMutableDictionary alloc] init];
+        
+        /* a locale may not group a number which is only one digit longer than a group */
+        _minimumGroupingDigits = 1;
+        
+        if (_groupingSize > 0 && _groupingSeparator.length > 0) {
+            NSString *numStr = [numberFormatter stringFromNumber:@(pow(10, _groupingSize))];
+            
+            if (![numStr containsString:_groupingSeparator]) {
+                _minimumGroupingDigits = 2;
+            }
+        }
+        
+        _isCompatible = (_decimalSeparator.length > 0 && [self reproducesNumberFormatter]);
+    }
+    
+    return self;
+}
+
+#pragma mark Formatting Numbers
+
+- (NSString *)stringFromDouble:(double)value maximumFractionDigits:(NSUInteger)maximumFractionDigits
+{
+    NIBCharacterBuffer buffer = {0};
+    
+    [self writeToBuffer:&buffer double:value maximumFractionDigits:maximumFractionDigits];
+    
+    NSString *result = [[NSString alloc] initWithCharacters:buffer.characters length:buffer.length];
+    
+    NIBCharacterBufferFree(&buffer);
+    
+    return result;
+}
+
+- (NSString *)stringFromDouble:(double)value maximumSignificantDigits:(NSUInteger)maximumSignificantDigits
+{
+    NIBCharacterBuffer buffer = {0};
+    NSString *result = nil;
+    
+    /* if the formatter reproduces the number formatter, write the rounded number */
+    if (_isCompatible && isfinite(value)) {
+        NIBDecimal decimal;
+        
+        NIBDecimalFromDouble(value, &decimal);
+        NIBDecimalRoundToDigits(&decimal, (NSInteger)maximumSignificantDigits);
+        
+        if ([self writeToBuffer:&buffer decimal:&decimal]) {
+            result = [[NSString alloc] initWithCharacters:buffer.characters length:buffer.length];
+        }
+        
+        NIBCharacterBufferFree(&buffer);
+    }
+    
+    /* otherwise, fall back on the number formatter */
+    if (result == nil) {
+        NSNumberFormatter *numberFormatter = [self fallbackFormatterWithMaximumFractionDigits:NSNotFound
+                                                                     maximumSignificantDigits:maximumSignificantDigits];
+        
+        result = [numberFormatter stringFromNumber:@(value)];
+    }
+    
+    return result;
+}
+
+- (NSUInteger)digitsOfDouble:(double)value maximumFractionDigits:(NSUInteger)maximumFractionDigits
+{
+    NIBCharacterBuffer buffer = {0};
+    NSUInteger digitsCount = 0;
+    
+    [self writeToBuffer:&buffer double:value maximumFractionDigits:maximumFractionDigits];
+    
+    for (NSUInteger i = 0; i < buffer.length; i++) {
+        if (buffer.characters[i] >= '0' && buffer.characters[i] <= '9') {
+            digitsCount++;
+        }
+    }
+    
+    NIBCharacterBufferFree(&buffer);
+    
+    return digitsCount;
+}
+
+- (NSUInteger)digitsOfIntegerPartOfDouble:(double)value maximumFractionDigits:(NSUInteger)maximumFractionDigits
+{
+    NIBCharacterBuffer buffer = {0};
+    NSUInteger groupingSeparatorLength = _groupingSeparator.length;
+    NSUInteger decimalSeparatorLength = _decimalSeparator.length;
+    unichar groupingSeparator[groupingSeparatorLength + 1];
+    unichar decimalSeparator[decimalSeparatorLength + 1];
+    NSUInteger digitsCount = 0, position = 0;
+    NSUInteger digitsOfIntegerPart = NSNotFound;
+    
+    [_groupingSeparator getCharacters:groupingSeparator range:NSMakeRange(0, groupingSeparatorLength)];
+    [_decimalSeparator getCharacters:decimalSeparator range:NSMakeRange(0, decimalSeparatorLength)];
+    
+    [self writeToBuffer:&buffer double:value maximumFractionDigits:maximumFractionDigits];
+    
+    // count the characters before the decimal separator, skipping the
+    // grouping separators and the hyphen minus as the string would be
+    // without them
+    for (NSUInteger i = 0; i < buffer.length; ) {
+        const unichar *characters = buffer.characters + i;
+        NSUInteger remaining = buffer.length - i;
+        
+        /* if the characters are a grouping separator, skip it */
+        if (groupingSeparatorLength > 0 && remaining >= groupingSeparatorLength &&
+            memcmp(characters, groupingSeparator, groupingSeparatorLength * sizeof(unichar)) == 0) {
+            i += groupingSeparatorLength;
+            continue;
+        }
+        
+        /* if the character is a hyphen minus, skip it */
+        if (characters[0] == '-') {
+            i++;
+            continue;
+        }
+        
+        /* if the characters are the decimal separator, the integer part ends */
+        if (digitsOfIntegerPart == NSNotFound && decimalSeparatorLength > 0 && remaining >= decimalSeparatorLength &&
+            memcmp(characters, decimalSeparator, decimalSeparatorLength * sizeof(unichar)) == 0) {
+            digitsOfIntegerPart = position;
+        }
+        
+        if (characters[0] >= '0' && characters[0] <= '9') {
+            digitsCount++;
+        }
+        
+        position++;
+        i++;
+    }
+    
+    NIBCharacterBufferFree(&buffer);
+    
+    /* if there is no decimal separator, the digits of the string are counted */
+    return (digitsOfIntegerPart == NSNotFound) ? digitsCount : digitsOfIntegerPart;
+}
+
+#pragma mark Parsing Numbers
+
+- (BOOL)getDouble:(double *)value fromString:(NSString *)string
+{
+    NSUInteger length = string.length;
+    
+    /* if the formatter does not reproduce the number formatter or the string is too long, give up */
+    if (!_isCompatible || length == 0 || length > NIBMaxParsingLength) {
+        return NO;
+    }
+    
+    unichar characters[NIBMaxParsingLength];
+    char asciiStr[NIBMaxParsingLength + 8];
+    NSUInteger asciiLength = 0, i = 0;
+    NSUInteger groupingSeparatorLength = _groupingSeparator.length;
+    NSUInteger decimalSeparatorLength = _decimalSeparator.length;
+    unichar groupingSeparator[groupingSeparatorLength + 1];
+    unichar decimalSeparator[decimalSeparatorLength + 1];
+    NSUInteger digitsCount = 0, fractionDigitsCount = 0;
+    BOOL hasDecimalSeparator = NO;
+    
+    [string getCharacters:characters range:NSMakeRange(0, length)];
+    [_groupingSeparator getCharacters:groupingSeparator range:NSMakeRange(0, groupingSeparatorLength)];
+    [_decimalSeparator getCharacters:decimalSeparator range:NSMakeRange(0, decimalSeparatorLength)];
+    
+    /* if the string starts with the minus sign of the locale or a hyphen minus, the number is negative */
+    NSUInteger minusSignLength = _minusSign.length;
+    
+    if (minusSignLength > 0 && minusSignLength <= length && [string hasPrefix:_minusSign]) {
+        asciiStr[asciiLength++] = '-';
+        i = minusSignLength;
+    } else if (characters[0] == '-') {
+        asciiStr[asciiLength++] = '-';
+        i = 1;
+    }
+    
+    while (i < length) {
+        unichar character = characters[i];
+        NSUInteger remaining = length - i;
+        
+        /* if the character is a digit, keep it */
+        if (character >= '0' && character <= '9') {
+            asciiStr[asciiLength++] = (char)character;
+            digitsCount++;
+            if (hasDecimalSeparator) fractionDigitsCount++;
+            i++;
+        
+        /* if the characters are the first decimal separator, the fraction starts */
+        } else if (!hasDecimalSeparator && remaining >= decimalSeparatorLength &&
+                   memcmp(characters + i, decimalSeparator, decimalSeparatorLength * sizeof(unichar)) == 0) {
+            hasDecimalSeparator = YES;
+            i += decimalSeparatorLength;
+        
+        /* if the characters are a grouping separator of the integer part, skip it */
+        } else if (!hasDecimalSeparator && groupingSeparatorLength > 0 && remaining >= groupingSeparatorLength &&
+                   memcmp(characters + i, groupingSeparator, groupingSeparatorLength * sizeof(unichar)) == 0) {
+            i += groupingSeparatorLength;
+        
+        /* otherwise, it is not a string of the decimal style */
+        } else {
+            return NO;
+        }
+    }
+    
+    if (digitsCount == 0) {
+        return NO;
+    }
+    
+    // the digits are read as an integer scaled by a power of ten, so the
+    // conversion does not depend on the decimal point of the C locale
+    snprintf(asciiStr + asciiLength, sizeof(asciiStr) - asciiLength, "e-%lu", (unsigned long)fractionDigitsCount);
+    
+    *value = strtod(asciiStr, NULL);
+    
+    return YES;
+}
+
+@end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Category Implementation
+
+
+@implementation NIBDecimalFormatter (Private)
+
+- (BOOL)reproducesNumberFormatter
+{
+    const double probes[] = {0, 7, -7, 0.5, -0.5, 0.1 + 0.2, 2.675, -2.675, 9.9999999, 123.456, 1234, -1234,
+                             12345, -123456.789, 1234567, 123456789.125, -9999999999999999, 1e20};
+    const NSUInteger fractionDigits[] = {3, 8, 15};
+    const NSUInteger significantDigits[] = {9, 16};
+    
+    NSNumberFormatter *lenientFormatter = [[NSNumberFormatter alloc] init];
+    lenientFormatter.locale = _locale;
+    lenientFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+    lenientFormatter.lenient = YES;
+    
+    // the formatter is compatible while checking it, so the methods do not
+    // fall back on the number formatter they are checked against
+    _isCompatible = YES;
+    
+    for (NSUInteger i = 0; i < sizeof(probes) / sizeof(probes[0]); i++) {
+        NSNumber *number = @(probes[i]);
+        
+        for (NSUInteger j = 0; j < sizeof(fractionDigits) / sizeof(fractionDigits[0]); j++) {
+            NSNumberFormatter *numberFormatter = [self fallbackFormatterWithMaximumFractionDigits:fractionDigits[j]
+                                                                         maximumSignificantDigits:0];
+            NSString *expectedStr = [numberFormatter stringFromNumber:number];
+            NSString *numStr = [self stringFromDouble:probes[i] maximumFractionDigits:fractionDigits[j]];
+            
+            if (![numStr isEqualToString:expectedStr]) {
+                return NO;
+            }
+            
+            /* the parsed string must be the number the lenient formatter parses */
+            double parsedValue = 0;
+            NSNumber *expectedNumber = [lenientFormatter numberFromString:expectedStr];
+            
+            if (expectedNumber && (![self getDouble:&parsedValue fromString:expectedStr] ||
+                                   parsedValue != expectedNumber.doubleValue)) {
+                return NO;
+            }
+        }
+        
+        for (NSUInteger j = 0; j < sizeof(significantDigits) / sizeof(significantDigits[0]); j++) {
+            NSNumberFormatter *numberFormatter = [self fallbackFormatterWithMaximumFractionDigits:NSNotFound
+                                                                         maximumSignificantDigits:significantDigits[j]];
+            NSString *expectedStr = [numberFormatter stringFromNumber:number];
+            NSString *numStr = [self stringFromDouble:probes[i] maximumSignificantDigits:significantDigits[j]];
+            
+            if (![numStr isEqualToString:expectedStr]) {
+                return NO;
+            }
+        }
+    }
+    
+    return YES;
+}
+
+- (NSNumberFormatter *)fallbackFormatterWithMaximumFractionDigits:(NSUInteger)maximumFractionDigits
+                                         maximumSignificantDigits:(NSUInteger)maximumSignificantDigits
+{
+    NSString *key = (maximumFractionDigits == NSNotFound)
+        ? [NSString stringWithFormat:@"significant.%lu", (unsigned long)maximumSignificantDigits]
+        : [NSString stringWithFormat:@"fraction.%lu", (unsigned long)maximumFractionDigits];
+    
+    @synchronized (_fallbackFormatters) {
+        NSNumberFormatter *numberFormatter = _fallbackFormatters[key];
+        
+        /* if the formatter is not created yet, create it */
+        if (numberFormatter == nil) {
+            numberFormatter = [[NSNumberFormatter alloc] init];
+            numberFormatter.locale = _locale;
+            numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+            
+            if (maximumFractionDigits == NSNotFound) {
+                numberFormatter.usesGroupingSeparator = YES;
+                numberFormatter.usesSignificantDigits = YES;
+                numberFormatter.maximumSignificantDigits = maximumSignificantDigits;
+            } else {
+                numberFormatter.maximumFractionDigits = maximumFractionDigits;
+            }
+            
+            _fallbackFormatters[key] = numberFormatter;
+        }
+        
+        return numberFormatter;
+    }
+}
+
+- (BOOL)writeToBuffer:(NIBCharacterBuffer *)buffer decimal:(const NIBDecimal *)decimal
+{
+    /* if a negative number is rounded to zero, the sign depends on the number formatter */
+    if (decimal->isNegative && decimal->count == 0) {
+        return NO;
+    }
+    
+    NSString *prefix = decimal->isNegative ? _negativePrefix : _positivePrefix;
+    NSString *suffix = decimal->isNegative ? _negativeSuffix : _positiveSuffix;
+    NSInteger integerDigits = MAX(decimal->exponent, 1);
+    NSInteger fractionDigits = MAX(decimal->count - decimal->exponent, 0);
+    NSUInteger groupingSeparatorLength = _groupingSeparator.length;
+    NSUInteger capacity = prefix.length + suffix.length + _decimalSeparator.length + (NSUInteger)fractionDigits
+                          + (NSUInteger)integerDigits * (1 + groupingSeparatorLength);
+    
+    NIBCharacterBufferReserve(buffer, capacity);
+    NIBCharacterBufferAppendString(buffer, prefix);
+    
+    BOOL isGrouping = (_groupingSize > 0 && groupingSeparatorLength > 0 &&
+                       integerDigits >= (NSInteger)(_groupingSize + _minimumGroupingDigits));
+    
+    /* write the integer part, grouping the digits from the decimal separator */
+    for (NSInteger i = 0; i < integerDigits; i++) {
+        NSInteger distance = integerDigits - i;
+        
+        if (isGrouping && i > 0 &&
+            (distance == (NSInteger)_groupingSize ||
+             (distance > (NSInteger)_groupingSize && (distance - (NSInteger)_groupingSize) % (NSInteger)_secondaryGroupingSize == 0))) {
+            NIBCharacterBufferAppendString(buffer, _groupingSeparator);
+        }
+        
+        unichar digit = (decimal->exponent > 0 && i < decimal->count) ? (unichar)decimal->digits[i] : '0';
+        buffer->characters[buffer->length++] = digit;
+    }
+    
+    /* write the fraction part */
+    if (fractionDigits > 0) {
+        NIBCharacterBufferAppendString(buffer, _decimalSeparator);
+        
+        for (NSInteger i = decimal->exponent; i < decimal->count; i++) {
+            buffer->characters[buffer->length++] = (i < 0) ? '0' : (unichar)decimal->digits[i];
+        }
+    }
+    
+    NIBCharacterBufferAppendString(buffer, suffix);
+    
+    return YES;
+}
+
+- (void)writeToBuffer:(NIBCharacterBuffer *)buffer
+               double:(double)value
+maximumFractionDigits:(NSUInteger)maximumFractionDigits
+{
+    /* if the formatter reproduces the number formatter, write the rounded number */
+    if (_isCompatible && isfinite(value)) {
+        NIBDecimal decimal;
+        
+        NIBDecimalFromDouble(value, &decimal);
+        NIBDecimalRoundToDigits(&decimal, decimal.exponent + (NSInteger)maximumFractionDigits);
+        
+        if ([self writeToBuffer:buffer decimal:&decimal]) {
+            return;
+        }
+        
+        buffer->length = 0;
+    }
+    
+    /* otherwise, fall back on the number formatter */
+    NSNumberFormatter *numberFormatter = [self fallbackFormatterWithMaximumFractionDigits:maximumFractionDigits
+                                                                 maximumSignificantDigits:0];
+    
+    NIBCharacterBufferAppendString(buffer, [numberFormatter stringFromNumber:@(value)] ?: @"");
+}
+
+@end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Convert a finite double to the shortest decimal number which reads back to
+ the same double.
+ 
+ @param value   The double.
+ @param decimal The decimal number.
+ */
+static void NIBDecimalFromDouble(double value, NIBDecimal *decimal) {
+    decimal->isNegative = (signbit(value) != 0);
+    decimal->count = 0;
+    decimal->exponent = 0;
+    
+    value = fabs(value);
+    
+    if (value == 0) {
+        return;
+    }
+    
+    char numStr[32];
+    
+    /* find the fewest digits which read back to the same double */
+    for (int precision = 0; precision < NIBMaxRoundTripDigits; precision++) {
+        snprintf(numStr, sizeof(numStr), "%.*e", precision, value);
+        
+        if (strtod(numStr, NULL) == value) {
+            break;
+        }
+    }
+    
+    // the string is d[.ddd]e±xx, so keep the digits of the mantissa whatever
+    // the decimal point of the C locale is
+    const char *character = numStr;
+    
+    while (*character != 'e') {
+        if (*character >= '0' && *character <= '9') {
+            decimal->digits[decimal->count++] = *character;
+        }
+        character++;
+    }
+    
+    decimal->exponent = strtol(character + 1, NULL, 10) + 1;
+    
+    /* remove the trailing zeros */
+    while (decimal->count > 0 && decimal->digits[decimal->count - 1] == '0') {
+        decimal->count--;
+    }
+}
+
+/**
+ Round a decimal number half to even to a number of leading digits.
+ 
+ @param decimal The decimal number.
+ @param digits  The number of leading digits to keep. It may be negative or
+                larger than the digits of the number.
+ */
+static void NIBDecimalRoundToDigits(NIBDecimal *decimal, NSInteger digits) {
+    if (digits >= decimal->count) {
+        return;
+    }
+    
+    /* if the number is smaller than half of the last kept digit, it is zero */
+    if (digits < 0) {
+        decimal->count = 0;
+        decimal->exponent = 0;
+        return;
+    }
+    
+    char nextDigit = decimal->digits[digits];
+    BOOL roundsUp = (nextDigit > '5');
+    
+    /* if the number is halfway, round to the even digit */
+    if (nextDigit == '5') {
+        roundsUp = (digits + 1 < decimal->count) || (digits > 0 && (decimal->digits[digits - 1] - '0') % 2 == 1);
+    }
+    
+    decimal->count = digits;
+    
+    if (roundsUp) {
+        NSInteger i = digits - 1;
+        
+        /* carry the nines over */
+        while (i >= 0 && decimal->digits[i] == '9') {
+            i--;
+        }
+        
+        if (i < 0) {
+            decimal->digits[0] = '1';
+            decimal->count = 1;
+            decimal->exponent++;
+        } else {
+            decimal->digits[i]++;
+            decimal->count = i + 1;
+        }
+    }
+    
+    /* remove the trailing zeros */
+    while (decimal->count > 0 && decimal->digits[decimal->count - 1] == '0') {
+        decimal->count--;
+    }
+    
+    if (decimal->count == 0) {
+        decimal->exponent = 0;
+    }
+}
+
+/**
+ Make sure a buffer of characters can hold more characters.
+ 
+ @param buffer      The buffer.
+ @param additional  The number of characters to add.
+ */
+static void NIBCharacterBufferReserve(NIBCharacterBuffer *buffer, NSUInteger additional) {
+    if (buffer->characters == NULL) {
+        buffer->characters = buffer->inlineCharacters;
+        buffer->capacity = sizeof(buffer->inlineCharacters) / sizeof(unichar);
+    }
+    
+    /* if the characters do not fit, grow the storage on the heap */
+    if (buffer->length + additional > buffer->capacity) {
+        NSUInteger capacity = MAX(buffer->capacity * 2, buffer->length + additional);
+        
+        if (buffer->characters == buffer->inlineCharacters) {
+            buffer->characters = malloc(capacity * sizeof(unichar));
+            memcpy(buffer->characters, buffer->inlineCharacters, buffer->length * sizeof(unichar));
+        } else {
+            buffer->characters = realloc(buffer->characters, capacity * sizeof(unichar));
+        }
+        
+        buffer->capacity = capacity;
+    }
+}
+
+/**
+ Append the characters of a string to a buffer of characters.
+ 
+ @param buffer  The buffer.
+ @param string  The string.
+ */
+static void NIBCharacterBufferAppendString(NIBCharacterBuffer *buffer, NSString *string) {
+    NSUInteger length = string.length;
+    
+    NIBCharacterBufferReserve(buffer, length);
+    
+    [string getCharacters:buffer->characters + buffer->length range:NSMakeRange(0, length)];
+    buffer->length += length;
+}
+
+/**
+ Release the storage of a buffer of characters.
+ 
+ @param buffer  The buffer.
+ */
+static void NIBCharacterBufferFree(NIBCharacterBuffer *buffer) {
+    if (buffer->characters != buffer->inlineCharacters) {
+        free(buffer->characters);
+    }
+    
+    buffer->characters = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
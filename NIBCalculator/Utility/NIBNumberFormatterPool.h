@@ -0,0 +1,107 @@
+//
+//  NIBNumberFormatterPool.h
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class NIBDecimalFormatter;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ `NIBNumberFormatterPool` provides number formatters of the current locale
+ which are created once per configuration and shared. The pool is emptied when
+ the current locale changes, so the next formatters follow the new locale.
+ 
+ The shared formatters can be used from any thread but must not be modified.
+ 
+ @note The class can not be instantiated and will generate an __error__ if doing
+ so. The class includes only class methods.
+ */
+@interface NIBNumberFormatterPool : NSObject
+
+/// -------------------------
+/// @name Unavailable Methods
+/// -------------------------
+
+/**
+ The init method is unavailable.
+ */
+- (instancetype) init __attribute__((unavailable("utility class")));
+
+/// -----------------------
+/// @name Number Formatters
+/// -----------------------
+
+/**
+ Get a formatter of the current locale without style. It parses the strings of
+ the main display.
+ */
++ (NSNumberFormatter *)plainFormatter;
+
+/**
+ Get a formatter of the decimal style of the current locale.
+ */
++ (NSNumberFormatter *)decimalFormatter;
+
+/**
+ Get a lenient formatter of the decimal style of the current locale. It parses
+ the operands of the main display.
+ */
++ (NSNumberFormatter *)lenientDecimalFormatter;
+
+/**
+ Get a formatter of the decimal style of the current locale with a maximum
+ number of fraction digits.
+ 
+ @param maximumFractionDigits   The maximum number of fraction digits.
+ */
++ (NSNumberFormatter *)decimalFormatterWithMaximumFractionDigits:(NSUInteger)maximumFractionDigits;
+
+/**
+ Get a formatter of the decimal style of the current locale which groups the
+ integer part and rounds to a maximum number of significant digits.
+ 
+ @param maximumSignificantDigits    The maximum number of significant digits.
+ */
++ (NSNumberFormatter *)decimalFormatterWithMaximumSignificantDigits:(NSUInteger)maximumSignificantDigits;
+
+/**
+ Get a formatter of the current locale with formats.
+ 
+ @param positiveFormat  The format of positive numbers.
+ @param negativeFormat  The format of negative numbers.
+ @param exponentSymbol  The exponent symbol, or nil for the default one.
+ */
++ (NSNumberFormatter *)formatterWithPositiveFormat:(NSString *)positiveFormat
+                                    negativeFormat:(NSString *)negativeFormat
+                                    exponentSymbol:(NSString *_Nullable)exponentSymbol;
+
+/// ------------------------
+/// @name Decimal Formatters
+/// ------------------------
+
+/**
+ Get a formatter of the decimal style of the current locale which formats and
+ parses numbers without `NSNumberFormatter`. It formats and parses the numbers
+ of the main display.
+ */
++ (NIBDecimalFormatter *)fastDecimalFormatter;
+
+/// ------------------
+/// @name Invalidation
+/// ------------------
+
+/**
+ Remove every formatter of the pool. It is called when the current locale
+ changes.
+ */
++ (void)removeAllFormatters;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,183 @@
+//
+//  NIBNumberFormatterPool.m
+//  NIBCalculator
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import "NIBNumberFormatterPool.h"
+#import "NIBDecimalFormatter.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Variables
+
+
+/** Class variable formatters of the pool, keyed by their configuration. */
+static NSMutableDictionary<NSString *, NSNumberFormatter *> *formatters = nil;
+
+/** Class variable decimal formatter of the current locale. */
+static NIBDecimalFormatter *fastDecimalFormatter = nil;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Category
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NIBNumberFormatterPool (Private)
+
+/**
+ Get the formatter of a configuration from the pool, or create it and add it to
+ the pool if it is not in the pool.
+ 
+ @param key             The key of the configuration.
+ @param configuration   The block to configure a new formatter of the current
+                        locale.
+ 
+ @return Returns the formatter of the configuration.
+ */
++ (NSNumberFormatter *)formatterForKey:(NSString *)key
+                         configuration:(void (^_Nullable)(NSNumberFormatter *numberFormatter))configuration;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Implementation
+
+
+@implementation NIBNumberFormatterPool
+
+#pragma mark Initialize
+
++ (void)initialize
+{
+    if (self == [NIBNumberFormatterPool class]) {
+        formatters = [[NSMutableDictionary alloc] init];
+        
+        /* empty the pool when the current locale changes */
+        [[NSNotificationCenter defaultCenter] addObserverForName:NSCurrentLocaleDidChangeNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:^(NSNotification *notification) {
+            [NIBNumberFormatterPool removeAllFormatters];
+        }];
+    }
+}
+
+#pragma mark Number Formatters
+
++ (NSNumberFormatter *)plainFormatter
+{
+    return [self formatterForKey:@"plain" configuration:nil];
+}
+
++ (NSNumberFormatter *)decimalFormatter
+{
+    return [self formatterForKey:@"decimal" configuration:^(NSNumberFormatter *numberFormatter) {
+        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+    }];
+}
+
++ (NSNumberFormatter *)lenientDecimalFormatter
+{
+    return [self formatterForKey:@"decimal.lenient" configuration:^(NSNumberFormatter *numberFormatter) {
+        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+        numberFormatter.lenient = YES;
+    }];
+}
+
++ (NSNumberFormatter *)decimalFormatterWithMaximumFractionDigits:(NSUInteger)maximumFractionDigits
+{
+    NSString *key = [NSString stringWithFormat:@"decimal.fraction.%lu", (unsigned long)maximumFractionDigits];
+    
+    return [self formatterForKey:key configuration:^(NSNumberFormatter *numberFormatter) {
+        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+        numberFormatter.maximumFractionDigits = maximumFractionDigits;
+    }];
+}
+
++ (NSNumberFormatter *)decimalFormatterWithMaximumSignificantDigits:(NSUInteger)maximumSignificantDigits
+{
+    NSString *key = [NSString stringWithFormat:@"decimal.significant.%lu", (unsigned long)maximumSignificantDigits];
+    
+    return [self formatterForKey:key configuration:^(NSNumberFormatter *numberFormatter) {
+        numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+        numberFormatter.usesGroupingSeparator = YES;
+        numberFormatter.usesSignificantDigits = YES;
+        numberFormatter.maximumSignificantDigits = maximumSignificantDigits;
+    }];
+}
+
++ (NSNumberFormatter *)formatterWithPositiveFormat:(NSString *)positiveFormat
+                                    negativeFormat:(NSString *)negativeFormat
+                                    exponentSymbol:(NSString *)exponentSymbol
+{
+    NSString *key = [NSString stringWithFormat:@"format.%@.%@.%@", positiveFormat, negativeFormat, exponentSymbol ?: @""];
+    
+    return [self formatterForKey:key configuration:^(NSNumberFormatter *numberFormatter) {
+        if (exponentSymbol) numberFormatter.exponentSymbol = exponentSymbol;
+        numberFormatter.positiveFormat = positiveFormat;
+        numberFormatter.negativeFormat = negativeFormat;
+    }];
+}
+
+#pragma mark Decimal Formatters
+
++ (NIBDecimalFormatter *)fastDecimalFormatter
+{
+    @synchronized (formatters) {
+        /* if the formatter is not in the pool, create it */
+        if (fastDecimalFormatter == nil) {
+            fastDecimalFormatter = [NIBDecimalFormatter formatterWithLocale:[NSLocale currentLocale]];
+        }
+        
+        return fastDecimalFormatter;
+    }
+}
+
+#pragma mark Invalidation
+
++ (void)removeAllFormatters
+{
+    @synchronized (formatters) {
+        [formatters removeAllObjects];
+        fastDecimalFormatter = nil;
+    }
+}
+
+@end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Category Implementation
+
+
+@implementation NIBNumberFormatterPool (Private)
+
++ (NSNumberFormatter *)formatterForKey:(NSString *)key
+                         configuration:(void (^)(NSNumberFormatter *numberFormatter))configuration
+{
+    @synchronized (formatters) {
+        NSNumberFormatter *numberFormatter = formatters[key];
+        
+        /* if the formatter is not in the pool, create it */
+        if (numberFormatter == nil) {
+            numberFormatter = [[NSNumberFormatter alloc] init];
+            numberFormatter.locale = [NSLocale currentLocale];
+            
+            if (configuration) configuration(numberFormatter);
+            
+            formatters[key] = numberFormatter;
+        }
+        
+        return numberFormatter;
+    }
+}
+
+@end
@@ -8,6 +8,7 @@
 
 #import "NIBViewUtilities.h"
 #import "NIBButton.h"
+#import "NIBInstrumentation.h"
 
 /////////////////////////////////////////////////////////////////////////////
 #pragma mark - Private Constants
@@ -42,6 +43,8 @@ const CGFloat NIBDisplayMainLabelMaxFontSize = 100.0f;
 
 + (void)adjustFontSizeOfMainDisplay:(UILabel *)mainDisplay
 {
+    NIB_MEASURE_SCOPE(NIBInstrumentationStageFontFitting);
+    
     UIFont *adaptiveFont = nil;
     CGFloat minFontSize = NIBDisplayMainLabelMinFontSize;
     CGFloat maxFontSize = NIBDisplayMainLabelMaxFontSize;
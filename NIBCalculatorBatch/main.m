@@ -0,0 +1,1043 @@
+//
+//  main.m
+//  NIBCalculatorBatch
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+/**
+ `NIBCalculatorBatch` evaluates expressions with the calculator brain outside
+ the app. Every line of the input is a sequence of keys separated by spaces,
+ such as `2 + 3 x 4 = =`, which are pressed as the keypad of the calculator
+ presses them. The display after the last key is written as one line of the
+ output, or `Error` if it is not a number.
+ 
+ Usage: NIBCalculatorBatch [-input file] [-jobs count] [-radian YES] [-decimal YES]
+                           [-expressions YES]
+ 
+ Without an input file, the lines are read from the standard input. The input
+ file is mapped into memory. Every line is independent: it starts with a
+ cleared arithmetic, a cleared memory, a display of 0 and the angle mode of the
+ arguments. The number of lines, the throughput and the hit rate of the unary
+ memo of the workers are reported on the standard error.
+ 
+ The lines are read in blocks and every block is evaluated by as many workers
+ as the jobs, by default one for each core. Each worker runs on a thread of its
+ own for the whole input and has its own calculator, since the brain is not
+ thread safe. The lines of a block are split into chunks on a deque for each
+ worker, a worker which runs out of chunks steals half of the chunks left on
+ the deque of another, and a worker formats the results of a chunk into the
+ output of the chunk. The main thread writes the outputs of a block in the
+ order of the lines while the workers evaluate the next block.
+ 
+ The keys are the numbers, the operators `+ - x * / = % ( )`, the functions
+ `x^2 x^3 x^y y^x e^x 10^x 2^x 1/x sqrt cbrt root ln log10 logy log2 x! EE`,
+ `sin cos tan arcsin arccos arctan sinh cosh tanh arcsinh arccosh arctanh`,
+ the constants `pi e rand`, the memory keys `mc m+ m- mr` and the keys
+ `+/- ac c rad deg`.
+ 
+ With `-expressions YES`, every line is an expression instead, such as
+ `2 + sqrt(9) x 3 =`, which is read by the expression tokenizer and performed
+ by the calculator in one call.
+ */
+
+#import <Foundation/Foundation.h>
+#import <fcntl.h>
+#import <pthread.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <time.h>
+#import <unistd.h>
+#import "NIBCalculatorBrain.h"
+#import "NIBCalculatorKernels.h"
+#import "NIBConstants.h"
+#import "NIBExpressionTokenizer.h"
+#import "NIBOperator.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ @struct NIBBatchKey
+ 
+ A key of the keypad and its name in the input.
+ 
+ @field name    The name of the key.
+ @field tag     The tag of the button of the key.
+ */
+typedef struct NIBBatchKey {
+    const char *name;
+    NIBButtonTag tag;
+} NIBBatchKey;
+
+/**
+ @struct NIBKeypadState
+ 
+ The state of the keypad which the view controller keeps between the keys.
+ 
+ @field display                         The number on the display, NAN if
+                                        the display shows an error.
+ @field canBinaryOperatorPushOperand    The boolean value to indicate if the
+                                        next binary operator pushes the
+                                        display to the calculator.
+ */
+typedef struct NIBKeypadState {
+    double display;
+    BOOL canBinaryOperatorPushOperand;
+} NIBKeypadState;
+
+
+/**
+ @struct NIBBatchLine
+ 
+ A line of the input, which does not end with a null character.
+ 
+ @field text    The first character of the line.
+ @field length  The length of the line without its new line.
+ */
+typedef struct NIBBatchLine {
+    const char *text;
+    size_t length;
+} NIBBatchLine;
+
+/**
+ @struct NIBBatchDeque
+ 
+ The chunks of lines left to a worker. The worker takes the chunks from the
+ head, the other workers steal them from the tail.
+ 
+ @field lock    The lock of the deque.
+ @field head    The index of the next chunk of the worker.
+ @field tail    The index after the last chunk of the worker.
+ */
+typedef struct NIBBatchDeque {
+    pthread_mutex_t lock;
+    NSUInteger head;
+    NSUInteger tail;
+} NIBBatchDeque;
+
+/**
+ @struct NIBBatchWorker
+ 
+ A worker which evaluates the lines of the blocks on a thread of its own.
+ 
+ @field thread          The thread of the worker.
+ @field calculator      The calculator of the worker, which is only used by it.
+ @field deque           The chunks left to the worker.
+ @field tokens          The tokens of the expression of a line, which are
+                        reused from line to line.
+ @field index           The index of the worker.
+ @field pool            The pool of the worker.
+ @field block           The block of lines which the worker evaluates.
+ @field memoStatistics  The counters of the unary memo of the thread of the
+                        worker, which are set when the thread exits.
+ */
+typedef struct NIBBatchWorker {
+    pthread_t thread;
+    __unsafe_unretained NIBCalculatorBrain *calculator;
+    NIBBatchDeque deque;
+    NIBTokenBuffer tokens;
+    NSUInteger index;
+    struct NIBBatchPool *pool;
+    struct NIBBatchBlock *block;
+    NIBUnaryMemoStatistics memoStatistics;
+} NIBBatchWorker;
+
+/**
+ @struct NIBBatchBlock
+ 
+ A block of lines which is evaluated by the workers.
+ 
+ @field lines               The lines.
+ @field count               The number of lines.
+ @field outputs             The output of every chunk of lines, which has room
+                            for NIB_BATCH_CHUNK_OUTPUT_SIZE characters.
+ @field outputLengths       The length of the output of every chunk.
+ @field errorCounts         The number of lines of every chunk which can not be
+                            read.
+ @field isRadianMode        The angle mode which every line starts with.
+ @field isExpressionMode    YES if the lines are expressions, otherwise NO.
+ @field workers             The workers.
+ @field workerCount         The number of workers.
+ */
+typedef struct NIBBatchBlock {
+    NIBBatchLine *lines;
+    NSUInteger count;
+    char *outputs;
+    size_t *outputLengths;
+    NSUInteger *errorCounts;
+    BOOL isRadianMode;
+    BOOL isExpressionMode;
+    NIBBatchWorker *workers;
+    NSUInteger workerCount;
+} NIBBatchBlock;
+
+/**
+ @struct NIBBatchPool
+ 
+ The threads of the workers, which wait for a block, evaluate it and wait for
+ the next one until the pool stops.
+ 
+ @field lock                The lock of the pool.
+ @field startCondition      The condition signaled when a block is started or
+                            the pool stops.
+ @field finishCondition     The condition signaled when every worker finishes
+                            the block.
+ @field block               The block which the workers evaluate.
+ @field generation          The number of blocks started, which tells a worker
+                            that there is a new block.
+ @field runningCount        The number of workers which have not finished the
+                            block.
+ @field isStopping          YES if the workers exit, otherwise NO.
+ */
+typedef struct NIBBatchPool {
+    pthread_mutex_t lock;
+    pthread_cond_t startCondition;
+    pthread_cond_t finishCondition;
+    NIBBatchBlock *block;
+    NSUInteger generation;
+    NSUInteger runningCount;
+    BOOL isStopping;
+} NIBBatchPool;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The keys of the keypad. */
+static const NIBBatchKey NIB_BATCH_KEYS[] = {
+    {"+", NIBButtonAddition}, {"-", NIBButtonSubstraction}, {"x", NIBButtonMultiplication},
+    {"*", NIBButtonMultiplication}, {"/", NIBButtonDivision}, {"=", NIBButtonEquality},
+    {"%", NIBButtonPercentage}, {"(", NIBButtonOpenningParenthesis}, {")", NIBButtonClosingParenthesis},
+    {"x^2", NIBButtonXSquared}, {"x^3", NIBButtonXCubed}, {"x^y", NIBButtonXPowerY},
+    {"y^x", NIBButtonYPowerX}, {"e^x", NIBButtonEulerNumberPowerX}, {"10^x", NIBButtonTenPowerX},
+    {"2^x", NIBButtonTwoPowerX}, {"1/x", NIBButtonOneOverX}, {"sqrt", NIBButtonSquareRootOfX},
+    {"cbrt", NIBButtonCubicRootOfX}, {"root", NIBButtonYthRootOfX}, {"ln", NIBButtonNaturalLogarithm},
+    {"log10", NIBButtonCommonLogarithm}, {"logy", NIBButtonLogarithmBaseYOfX}, {"log2", NIBButtonLogarithmBaseTwo},
+    {"x!", NIBButtonXFactorial}, {"EE", NIBButtonEE},
+    {"sin", NIBButtonSin}, {"cos", NIBButtonCos}, {"tan", NIBButtonTan},
+    {"arcsin", NIBButtonArcSin}, {"arccos", NIBButtonArcCos}, {"arctan", NIBButtonArcTan},
+    {"sinh", NIBButtonSinh}, {"cosh", NIBButtonCosh}, {"tanh", NIBButtonTanh},
+    {"arcsinh", NIBButtonArcSinh}, {"arccosh", NIBButtonArcCosh}, {"arctanh", NIBButtonArcTanh},
+    {"pi", NIBButtonPi}, {"e", NIBButtonEulerNumber}, {"rand", NIBButtonRand},
+    {"mc", NIBButtonMemoryClear}, {"m+", NIBButtonMemoryPlus}, {"m-", NIBButtonMemoryMinus},
+    {"mr", NIBButtonMemoryRead}, {"+/-", NIBButtonSignToggle}, {"ac", NIBButtonArithmeticClear},
+    {"c", NIBButtonClear}, {"rad", NIBButtonRad}, {"deg", NIBButtonDeg}
+};
+
+/** The longest key or number in the input. */
+#define NIB_BATCH_MAX_TOKEN_LENGTH 64
+
+/** The size of the buffer of the standard output. */
+#define NIB_BATCH_OUTPUT_BUFFER_SIZE (1 << 20)
+
+/** The number of lines which are read and evaluated together. */
+#define NIB_BATCH_BLOCK_SIZE 65536
+
+/** The number of lines in a chunk, which a worker evaluates at once. */
+#define NIB_BATCH_CHUNK_SIZE 256
+
+/** The longest output of a line, which is a result formatted with %.17g or Error and a new line. */
+#define NIB_BATCH_MAX_OUTPUT_LENGTH 32
+
+/** The size of the output of a chunk. */
+#define NIB_BATCH_CHUNK_OUTPUT_SIZE (NIB_BATCH_CHUNK_SIZE * NIB_BATCH_MAX_OUTPUT_LENGTH)
+
+/** The number of chunks in a block. */
+#define NIB_BATCH_BLOCK_CHUNK_COUNT ((NIB_BATCH_BLOCK_SIZE + NIB_BATCH_CHUNK_SIZE - 1) / NIB_BATCH_CHUNK_SIZE)
+
+/** The size of the buffer of the standard input. */
+#define NIB_BATCH_INPUT_BUFFER_SIZE (4 << 20)
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static uint64_t NIBBatchNow(void);
+static NSUInteger NIBBatchSplitLines(const char *, size_t, BOOL, NIBBatchLine *, NSUInteger, size_t *);
+static NSUInteger NIBBatchEvaluateBlock(NIBBatchPool *, NIBBatchBlock *, const NIBBatchBlock *, FILE *);
+static void NIBBatchStartBlock(NIBBatchPool *, NIBBatchBlock *);
+static void NIBBatchFinishBlock(NIBBatchPool *);
+static NSUInteger NIBBatchWriteBlock(FILE *, const NIBBatchBlock *);
+static void NIBBatchStopPool(NIBBatchPool *, NIBBatchWorker *, NSUInteger);
+static void *NIBBatchRunWorker(void *);
+static void NIBBatchEvaluateChunks(NIBBatchWorker *);
+static BOOL NIBBatchTakeChunk(NIBBatchWorker *, NSUInteger *);
+static BOOL NIBBatchEvaluateLine(NIBCalculatorBrain *, const char *, size_t, BOOL, double *);
+static BOOL NIBBatchEvaluateExpressionLine(NIBCalculatorBrain *, NIBTokenBuffer *, const char *, size_t, BOOL, double *);
+static BOOL NIBBatchTagOfKey(const char *, size_t, NIBButtonTag *);
+static void NIBBatchPressKey(NIBCalculatorBrain *, NIBKeypadState *, NIBButtonTag);
+static size_t NIBBatchFormatResult(char *, BOOL, double);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Main
+
+
+int main(int argc, const char * argv[]) {
+    @autoreleasepool {
+        NSUserDefaults *arguments = [NSUserDefaults standardUserDefaults];
+        NSString *inputPath = [arguments stringForKey:@"input"];
+        NSInteger jobCount = [arguments integerForKey:@"jobs"];
+        BOOL isRadianMode = [arguments boolForKey:@"radian"];
+        BOOL isDecimalMode = [arguments boolForKey:@"decimal"];
+        BOOL isExpressionMode = [arguments boolForKey:@"expressions"];
+        uint64_t lineCount = 0;
+        uint64_t errorCount = 0;
+        
+        /* if the jobs are not given, run a worker on each core */
+        if (jobCount <= 0) {
+            jobCount = MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+        }
+        
+        /* every worker has its own calculator, which the array keeps alive */
+        NSMutableArray<NIBCalculatorBrain *> *calculators = [[NSMutableArray alloc] initWithCapacity:jobCount];
+        NIBBatchWorker *workers = calloc((size_t)jobCount, sizeof(NIBBatchWorker));
+        NIBBatchPool pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0, 0, NO};
+        
+        // a block is evaluated while the outputs of the block before it are
+        // written, so there are two blocks which take turns
+        NIBBatchBlock blocks[2];
+        
+        for (NSUInteger i = 0; i < 2; i++) {
+            blocks[i] = (NIBBatchBlock){
+                malloc(NIB_BATCH_BLOCK_SIZE * sizeof(NIBBatchLine)), 0,
+                malloc(NIB_BATCH_BLOCK_CHUNK_COUNT * NIB_BATCH_CHUNK_OUTPUT_SIZE),
+                calloc(NIB_BATCH_BLOCK_CHUNK_COUNT, sizeof(size_t)),
+                calloc(NIB_BATCH_BLOCK_CHUNK_COUNT, sizeof(NSUInteger)),
+                isRadianMode, isExpressionMode, workers, (NSUInteger)jobCount
+            };
+        }
+        
+        NIBBatchBlock *block = &blocks[0];
+        NIBBatchBlock *lastBlock = NULL;
+        
+        for (NSInteger i = 0; i < jobCount; i++) {
+            NIBCalculatorBrain *calculator = [[NIBCalculatorBrain alloc] init];
+            
+            if (isDecimalMode) [calculator toggleDecimalMode];
+            [calculators addObject:calculator];
+            
+            workers[i].calculator = calculator;
+            workers[i].index = (NSUInteger)i;
+            workers[i].pool = &pool;
+            pthread_mutex_init(&workers[i].deque.lock, NULL);
+        }
+        
+        /* the workers wait on their threads for the first block */
+        for (NSInteger i = 0; i < jobCount; i++) {
+            pthread_create(&workers[i].thread, NULL, NIBBatchRunWorker, &workers[i]);
+        }
+        
+        /* the results are written in large blocks instead of line by line */
+        static char outputBuffer[NIB_BATCH_OUTPUT_BUFFER_SIZE];
+        setvbuf(stdout, outputBuffer, _IOFBF, sizeof(outputBuffer));
+        
+        uint64_t startTime = NIBBatchNow();
+        
+        /* if there is an input file, map it and evaluate its lines in place */
+        if (inputPath) {
+            int fileDescriptor = open(inputPath.fileSystemRepresentation, O_RDONLY);
+            struct stat fileStatus;
+            
+            if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStatus) != 0) {
+                fprintf(stderr, "Can not open %s\n", inputPath.UTF8String);
+                return 1;
+            }
+            
+            size_t length = (size_t)fileStatus.st_size;
+            const char *input = (length > 0) ? mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) : NULL;
+            
+            close(fileDescriptor);
+            
+            if (input == MAP_FAILED) {
+                fprintf(stderr, "Can not map %s\n", inputPath.UTF8String);
+                return 1;
+            }
+            
+            if (length > 0) madvise((void *)input, length, MADV_SEQUENTIAL);
+            
+            for (size_t offset = 0; offset < length; ) {
+                size_t consumedLength = 0;
+                
+                block->count = NIBBatchSplitLines(input + offset, length - offset, YES,
+                                                  block->lines, NIB_BATCH_BLOCK_SIZE, &consumedLength);
+                offset += consumedLength;
+                
+                errorCount += NIBBatchEvaluateBlock(&pool, block, lastBlock, stdout);
+                lineCount += lastBlock ? lastBlock->count : 0;
+                
+                /* the block is written with the next block, which takes the turn of the last one */
+                lastBlock = block;
+                block = (block == &blocks[0]) ? &blocks[1] : &blocks[0];
+            }
+            
+            /* write the last block */
+            if (lastBlock) {
+                errorCount += NIBBatchWriteBlock(stdout, lastBlock);
+                lineCount += lastBlock->count;
+            }
+            
+            if (length > 0) munmap((void *)input, length);
+        
+        /* otherwise, read the standard input into a buffer and evaluate its whole lines */
+        } else {
+            size_t capacity = NIB_BATCH_INPUT_BUFFER_SIZE;
+            char *buffer = malloc(capacity);
+            size_t bufferLength = 0;
+            BOOL isEndOfInput = NO;
+            
+            while (!isEndOfInput || bufferLength > 0) {
+                /* if the input is not read up, fill the buffer, which grows for a line longer than it */
+                if (!isEndOfInput) {
+                    if (bufferLength == capacity) {
+                        capacity *= 2;
+                        buffer = realloc(buffer, capacity);
+                    }
+                    
+                    size_t readLength = fread(buffer + bufferLength, 1, capacity - bufferLength, stdin);
+                    
+                    bufferLength += readLength;
+                    isEndOfInput = (readLength == 0);
+                }
+                
+                size_t consumedLength = 0;
+                
+                block->count = NIBBatchSplitLines(buffer, bufferLength, isEndOfInput,
+                                                  block->lines, NIB_BATCH_BLOCK_SIZE, &consumedLength);
+                
+                if (block->count == 0) continue;
+                
+                // the block is evaluated when the call returns, so its lines
+                // are not read anymore and the buffer can be moved
+                errorCount += NIBBatchEvaluateBlock(&pool, block, lastBlock, stdout);
+                lineCount += lastBlock ? lastBlock->count : 0;
+                
+                /* the block is written with the next block, which takes the turn of the last one */
+                lastBlock = block;
+                block = (block == &blocks[0]) ? &blocks[1] : &blocks[0];
+                
+                /* keep the part of a line which is not read up */
+                memmove(buffer, buffer + consumedLength, bufferLength - consumedLength);
+                bufferLength -= consumedLength;
+            }
+            
+            /* write the last block */
+            if (lastBlock) {
+                errorCount += NIBBatchWriteBlock(stdout, lastBlock);
+                lineCount += lastBlock->count;
+            }
+            
+            free(buffer);
+        }
+        
+        fflush(stdout);
+        NIBBatchStopPool(&pool, workers, (NSUInteger)jobCount);
+        
+        double elapsedSeconds = (double)(NIBBatchNow() - startTime) / 1e9;
+        uint64_t memoHitCount = 0;
+        uint64_t memoLookupCount = 0;
+        
+        for (NSInteger i = 0; i < jobCount; i++) {
+            memoHitCount += workers[i].memoStatistics.hitCount;
+            memoLookupCount += workers[i].memoStatistics.hitCount + workers[i].memoStatistics.missCount;
+        }
+        
+        fprintf(stderr, "%llu lines, %llu not read, %ld jobs, %.3f s, %.0f lines/s, %.1f%% unary memo hits\n",
+                (unsigned long long)lineCount, (unsigned long long)errorCount, (long)jobCount, elapsedSeconds,
+                (elapsedSeconds > 0) ? lineCount / elapsedSeconds : 0,
+                (memoLookupCount > 0) ? 100.0 * memoHitCount / memoLookupCount : 0);
+        
+        for (NSInteger i = 0; i < jobCount; i++) {
+            pthread_mutex_destroy(&workers[i].deque.lock);
+            NIBTokenBufferFree(&workers[i].tokens);
+        }
+        
+        for (NSUInteger i = 0; i < 2; i++) {
+            free(blocks[i].errorCounts);
+            free(blocks[i].outputLengths);
+            free(blocks[i].outputs);
+            free(blocks[i].lines);
+        }
+        
+        pthread_cond_destroy(&pool.finishCondition);
+        pthread_cond_destroy(&pool.startCondition);
+        pthread_mutex_destroy(&pool.lock);
+        free(workers);
+        
+        return 0;
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Get the time of the monotonic clock.
+ 
+ @return Returns the time in nanoseconds.
+ */
+static uint64_t NIBBatchNow(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+/**
+ Split the lines of a text.
+ 
+ @param text            The text.
+ @param length          The length of the text.
+ @param isEndOfInput    YES if the text ends the input, so its characters after
+                        the last new line are a line, otherwise NO.
+ @param lines           The lines of the text.
+ @param capacity        The most lines to split.
+ @param consumedLength  The length of the text which is split into the lines.
+ 
+ @return Returns the number of lines.
+ */
+static NSUInteger NIBBatchSplitLines(const char *text, size_t length, BOOL isEndOfInput,
+                                     NIBBatchLine *lines, NSUInteger capacity, size_t *consumedLength) {
+    const char *cursor = text;
+    const char *end = text + length;
+    NSUInteger count = 0;
+    
+    while (cursor < end && count < capacity) {
+        const char *lineEnd = memchr(cursor, '\n', (size_t)(end - cursor));
+        
+        /* if there is no new line, the rest is a line only at the end of the input */
+        if (lineEnd == NULL) {
+            if (!isEndOfInput) break;
+            lineEnd = end;
+        }
+        
+        lines[count++] = (NIBBatchLine){cursor, (size_t)(lineEnd - cursor)};
+        cursor = (lineEnd < end) ? lineEnd + 1 : end;
+    }
+    
+    *consumedLength = (size_t)(cursor - text);
+    
+    return count;
+}
+
+/**
+ Evaluate the lines of a block with the workers of a pool, and write the
+ outputs of the last block while they evaluate it.
+ 
+ @param pool        The pool.
+ @param block       The block.
+ @param lastBlock   The block evaluated before, or NULL if there is none.
+ @param output      The output.
+ 
+ @return Returns the number of lines of the last block which can not be read.
+ */
+static NSUInteger NIBBatchEvaluateBlock(NIBBatchPool *pool, NIBBatchBlock *block, const NIBBatchBlock *lastBlock, FILE *output) {
+    NSUInteger errorCount = 0;
+    
+    NIBBatchStartBlock(pool, block);
+    
+    if (lastBlock) errorCount = NIBBatchWriteBlock(output, lastBlock);
+    
+    NIBBatchFinishBlock(pool);
+    
+    return errorCount;
+}
+
+/**
+ Start evaluating a block on the workers of a pool, which are waiting for it.
+ The chunks of lines are dealt evenly to the deques of the workers.
+ 
+ @param pool    The pool.
+ @param block   The block.
+ */
+static void NIBBatchStartBlock(NIBBatchPool *pool, NIBBatchBlock *block) {
+    NSUInteger chunkCount = (block->count + NIB_BATCH_CHUNK_SIZE - 1) / NIB_BATCH_CHUNK_SIZE;
+    NSUInteger activeCount = MAX(MIN(block->workerCount, chunkCount), 1);
+    
+    /* deal the chunks to the active workers, the others only steal */
+    for (NSUInteger i = 0; i < block->workerCount; i++) {
+        NIBBatchDeque *deque = &block->workers[i].deque;
+        
+        pthread_mutex_lock(&deque->lock);
+        deque->head = (i < activeCount) ? i * chunkCount / activeCount : 0;
+        deque->tail = (i < activeCount) ? (i + 1) * chunkCount / activeCount : 0;
+        pthread_mutex_unlock(&deque->lock);
+    }
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->block = block;
+    pool->generation++;
+    pool->runningCount = block->workerCount;
+    pthread_cond_broadcast(&pool->startCondition);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ Wait until every worker of a pool finishes the block.
+ 
+ @param pool    The pool.
+ */
+static void NIBBatchFinishBlock(NIBBatchPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    
+    while (pool->runningCount > 0) {
+        pthread_cond_wait(&pool->finishCondition, &pool->lock);
+    }
+    
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ Write the outputs of the chunks of a block in the order of its lines.
+ 
+ @param output  The output.
+ @param block   The block.
+ 
+ @return Returns the number of lines which can not be read.
+ */
+static NSUInteger NIBBatchWriteBlock(FILE *output, const NIBBatchBlock *block) {
+    NSUInteger chunkCount = (block->count + NIB_BATCH_CHUNK_SIZE - 1) / NIB_BATCH_CHUNK_SIZE;
+    NSUInteger errorCount = 0;
+    
+    for (NSUInteger i = 0; i < chunkCount; i++) {
+        fwrite(block->outputs + i * NIB_BATCH_CHUNK_OUTPUT_SIZE, 1, block->outputLengths[i], output);
+        errorCount += block->errorCounts[i];
+    }
+    
+    return errorCount;
+}
+
+/**
+ Stop the workers of a pool, which exit once they finish the block, and wait
+ for their threads.
+ 
+ @param pool        The pool.
+ @param workers     The workers.
+ @param workerCount The number of workers.
+ */
+static void NIBBatchStopPool(NIBBatchPool *pool, NIBBatchWorker *workers, NSUInteger workerCount) {
+    pthread_mutex_lock(&pool->lock);
+    pool->isStopping = YES;
+    pthread_cond_broadcast(&pool->startCondition);
+    pthread_mutex_unlock(&pool->lock);
+    
+    for (NSUInteger i = 0; i < workerCount; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+}
+
+/**
+ Run a worker on its thread. The worker evaluates every block which the pool
+ starts until the pool stops.
+ 
+ @param argument    The worker.
+ 
+ @return Returns NULL.
+ */
+static void *NIBBatchRunWorker(void *argument) {
+    NIBBatchWorker *worker = argument;
+    NIBBatchPool *pool = worker->pool;
+    NIBUnaryMemoStatistics startMemoStatistics = NIBUnaryMemoStatisticsOfCurrentThread();
+    NSUInteger generation = 0;
+    
+#ifdef GNUSTEP
+    /* a thread which is not an NSThread has to be known to GNUstep before it uses Foundation */
+    BOOL isRegistered = GSRegisterCurrentThread();
+#endif
+    
+    while (YES) {
+        pthread_mutex_lock(&pool->lock);
+        
+        /* wait for a new block or the pool to stop */
+        while (pool->generation == generation && !pool->isStopping) {
+            pthread_cond_wait(&pool->startCondition, &pool->lock);
+        }
+        
+        if (pool->generation == generation) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        
+        generation = pool->generation;
+        worker->block = pool->block;
+        pthread_mutex_unlock(&pool->lock);
+        
+        NIBBatchEvaluateChunks(worker);
+        
+        /* if the worker is the last one to finish the block, tell the main thread */
+        pthread_mutex_lock(&pool->lock);
+        
+        if (--pool->runningCount == 0) {
+            pthread_cond_signal(&pool->finishCondition);
+        }
+        
+        pthread_mutex_unlock(&pool->lock);
+    }
+    
+    /* count the lookups of the memo on the thread of the worker */
+    NIBUnaryMemoStatistics memoStatistics = NIBUnaryMemoStatisticsOfCurrentThread();
+    
+    worker->memoStatistics.hitCount = memoStatistics.hitCount - startMemoStatistics.hitCount;
+    worker->memoStatistics.missCount = memoStatistics.missCount - startMemoStatistics.missCount;
+    
+#ifdef GNUSTEP
+    if (isRegistered) GSUnregisterCurrentThread();
+#endif
+    
+    return NULL;
+}
+
+/**
+ Evaluate the chunks of a worker until there are no chunks left to take or
+ steal. The results of the lines of a chunk are formatted into the output of
+ the chunk.
+ 
+ @param worker  The worker.
+ */
+static void NIBBatchEvaluateChunks(NIBBatchWorker *worker) {
+    NIBBatchBlock *block = worker->block;
+    NSUInteger chunk = 0;
+    
+    while (NIBBatchTakeChunk(worker, &chunk)) {
+        NSUInteger start = chunk * NIB_BATCH_CHUNK_SIZE;
+        NSUInteger end = MIN(start + NIB_BATCH_CHUNK_SIZE, block->count);
+        char *output = block->outputs + chunk * NIB_BATCH_CHUNK_OUTPUT_SIZE;
+        size_t outputLength = 0;
+        NSUInteger errorCount = 0;
+        
+        @autoreleasepool {
+            for (NSUInteger i = start; i < end; i++) {
+                const NIBBatchLine *line = &block->lines[i];
+                double result = NAN;
+                BOOL isValid = NO;
+                
+                if (block->isExpressionMode) {
+                    isValid = NIBBatchEvaluateExpressionLine(worker->calculator, &worker->tokens, line->text,
+                                                             line->length, block->isRadianMode, &result);
+                } else {
+                    isValid = NIBBatchEvaluateLine(worker->calculator, line->text, line->length,
+                                                   block->isRadianMode, &result);
+                }
+                
+                if (!isValid) errorCount++;
+                outputLength += NIBBatchFormatResult(output + outputLength, isValid, result);
+            }
+        }
+        
+        block->outputLengths[chunk] = outputLength;
+        block->errorCounts[chunk] = errorCount;
+    }
+}
+
+/**
+ Take the next chunk of a worker. The worker takes the chunk at the head of its
+ own deque. If its deque is empty, it steals half of the chunks at the tail of
+ the first other deque which has any, keeps the first of them and puts the rest
+ on its own deque.
+ 
+ @param worker  The worker.
+ @param chunk   The index of the chunk.
+ 
+ @return Returns YES if a chunk is taken, otherwise NO, when every deque is
+ empty.
+ */
+static BOOL NIBBatchTakeChunk(NIBBatchWorker *worker, NSUInteger *chunk) {
+    NIBBatchBlock *block = worker->block;
+    NIBBatchDeque *deque = &worker->deque;
+    
+    /* if the own deque has a chunk, take it */
+    pthread_mutex_lock(&deque->lock);
+    
+    if (deque->head < deque->tail) {
+        *chunk = deque->head++;
+        pthread_mutex_unlock(&deque->lock);
+        return YES;
+    }
+    
+    pthread_mutex_unlock(&deque->lock);
+    
+    /* otherwise, steal from the other deques, starting at the next worker */
+    for (NSUInteger i = 1; i < block->workerCount; i++) {
+        NIBBatchDeque *victim = &block->workers[(worker->index + i) % block->workerCount].deque;
+        
+        pthread_mutex_lock(&victim->lock);
+        
+        NSUInteger leftCount = victim->tail - victim->head;
+        
+        if (leftCount == 0) {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+        
+        NSUInteger stolenHead = victim->tail - (leftCount + 1) / 2;
+        NSUInteger stolenTail = victim->tail;
+        
+        victim->tail = stolenHead;
+        pthread_mutex_unlock(&victim->lock);
+        
+        pthread_mutex_lock(&deque->lock);
+        deque->head = stolenHead + 1;
+        deque->tail = stolenTail;
+        pthread_mutex_unlock(&deque->lock);
+        
+        *chunk = stolenHead;
+        return YES;
+    }
+    
+    return NO;
+}
+
+/**
+ Press the keys of a line on a calculator, which starts with a cleared
+ arithmetic, a cleared memory and a display of 0.
+ 
+ @param calculator      The calculator.
+ @param line            The keys separated by spaces. It does not need to end
+                        with a null character.
+ @param length          The length of the line.
+ @param isRadianMode    The angle mode which the line starts with.
+ @param result          The display after the last key.
+ 
+ @return Returns YES if every key of the line is known, otherwise NO.
+ */
+static BOOL NIBBatchEvaluateLine(NIBCalculatorBrain *calculator, const char *line, size_t length,
+                                 BOOL isRadianMode, double *result) {
+    NIBKeypadState state = {0, YES};
+    size_t i = 0;
+    
+    [calculator clearArithmetic];
+    [calculator clearMemory];
+    
+    if (calculator.isRadianMode != isRadianMode) [calculator toggleRadianMode];
+    
+    while (i < length) {
+        /* skip the spaces between the keys */
+        if (isspace((unsigned char)line[i])) {
+            i++;
+            continue;
+        }
+        
+        size_t start = i;
+        
+        while (i < length && !isspace((unsigned char)line[i])) i++;
+        
+        size_t tokenLength = i - start;
+        NIBButtonTag tag;
+        
+        /* if the token is a key, press it */
+        if (NIBBatchTagOfKey(line + start, tokenLength, &tag)) {
+            NIBBatchPressKey(calculator, &state, tag);
+            continue;
+        }
+        
+        /* otherwise, the token must be a number, which is typed on the display */
+        char number[NIB_BATCH_MAX_TOKEN_LENGTH + 1];
+        char *numberEnd = NULL;
+        
+        if (tokenLength > NIB_BATCH_MAX_TOKEN_LENGTH) {
+            return NO;
+        }
+        
+        memcpy(number, line + start, tokenLength);
+        number[tokenLength] = '\0';
+        
+        double value = strtod(number, &numberEnd);
+        
+        if (numberEnd != number + tokenLength || isnan(value) || isinf(value)) {
+            return NO;
+        }
+        
+        state.display = value;
+        state.canBinaryOperatorPushOperand = YES;
+    }
+    
+    *result = state.display;
+    
+    return YES;
+}
+
+/**
+ Perform the expression of a line on a calculator, which starts with a cleared
+ arithmetic, a cleared memory and a display of 0.
+ 
+ @param calculator      The calculator.
+ @param tokens          The buffer of the tokens of the expression.
+ @param line            The expression. It does not need to end with a null
+                        character.
+ @param length          The length of the line.
+ @param isRadianMode    The angle mode which the line starts with.
+ @param result          The display after the expression.
+ 
+ @return Returns YES if the line is an expression, otherwise NO.
+ */
+static BOOL NIBBatchEvaluateExpressionLine(NIBCalculatorBrain *calculator, NIBTokenBuffer *tokens, const char *line,
+                                           size_t length, BOOL isRadianMode, double *result) {
+    static const NIBNumberSeparators separators = {".", ""};
+    
+    NIBTokenBufferTruncate(tokens, 0);
+    
+    if (!NIBTokenizeExpression(line, length, &separators, tokens, NULL)) {
+        return NO;
+    }
+    
+    [calculator clearArithmetic];
+    [calculator clearMemory];
+    
+    if (calculator.isRadianMode != isRadianMode) [calculator toggleRadianMode];
+    
+    NSNumber *display = [calculator performExpression:tokens->tokens count:tokens->count];
+    
+    *result = display ? display.doubleValue : 0;
+    
+    return YES;
+}
+
+/**
+ Find the tag of a key.
+ 
+ @param key     The name of the key.
+ @param length  The length of the name.
+ @param tag     The tag of the key.
+ 
+ @return Returns YES if the key is known, otherwise NO.
+ */
+static BOOL NIBBatchTagOfKey(const char *key, size_t length, NIBButtonTag *tag) {
+    for (NSUInteger i = 0; i < sizeof(NIB_BATCH_KEYS) / sizeof(NIB_BATCH_KEYS[0]); i++) {
+        if (strncmp(NIB_BATCH_KEYS[i].name, key, length) == 0 && NIB_BATCH_KEYS[i].name[length] == '\0') {
+            *tag = NIB_BATCH_KEYS[i].tag;
+            return YES;
+        }
+    }
+    
+    return NO;
+}
+
+/**
+ Press a key on a calculator as the actions of the view controller do.
+ 
+ @param calculator  The calculator.
+ @param state       The state of the keypad.
+ @param tag         The tag of the key.
+ */
+static void NIBBatchPressKey(NIBCalculatorBrain *calculator, NIBKeypadState *state, NIBButtonTag tag) {
+    NSNumber *number = nil;
+    
+    switch (tag) {
+        /* the equality and the closing parenthesis push the display */
+        case NIBButtonEquality:
+        case NIBButtonClosingParenthesis:
+            [calculator pushOperand:state->display];
+            number = [calculator performOperator:[NIBOperator operatorWithTag:tag]];
+            break;
+        
+        /* the openning parenthesis pushes nothing */
+        case NIBButtonOpenningParenthesis:
+            number = [calculator performOperator:[NIBOperator operatorWithTag:tag]];
+            break;
+        
+        /* the memory keys do nothing on an error */
+        case NIBButtonMemoryClear:
+            if (!isnan(state->display)) [calculator clearMemory];
+            break;
+        
+        case NIBButtonMemoryPlus:
+            if (!isnan(state->display)) [calculator addToMemory:state->display];
+            break;
+        
+        case NIBButtonMemoryMinus:
+            if (!isnan(state->display)) [calculator subtractFromMemory:state->display];
+            break;
+        
+        case NIBButtonMemoryRead:
+            if (!isnan(state->display)) {
+                number = calculator.memory;
+                state->canBinaryOperatorPushOperand = YES;
+            }
+            break;
+        
+        /* the constants are typed on the display */
+        case NIBButtonPi:
+        case NIBButtonEulerNumber:
+        case NIBButtonRand:
+            number = [calculator constantNumber:[NIBOperator operatorWithTag:tag]];
+            state->canBinaryOperatorPushOperand = YES;
+            break;
+        
+        /* the sign toggle edits the display */
+        case NIBButtonSignToggle:
+            state->display = -state->display;
+            state->canBinaryOperatorPushOperand = YES;
+            break;
+        
+        /* the arithmetic clear clears the calculator and the display */
+        case NIBButtonArithmeticClear:
+            [calculator clearArithmetic];
+            state->display = 0;
+            state->canBinaryOperatorPushOperand = YES;
+            break;
+        
+        /* the clear clears the display */
+        case NIBButtonClear:
+            state->display = 0;
+            state->canBinaryOperatorPushOperand = YES;
+            break;
+        
+        /* the angle mode keys switch to their mode */
+        case NIBButtonRad:
+        case NIBButtonDeg:
+            if (calculator.isRadianMode != (tag == NIBButtonRad)) [calculator toggleRadianMode];
+            break;
+        
+        default:
+            /* if the key is a binary operator, it pushes the display once after a number is typed */
+            if (NIBIsBinaryOperatorTag(tag)) {
+                if (state->canBinaryOperatorPushOperand) {
+                    [calculator pushOperand:state->display];
+                    state->canBinaryOperatorPushOperand = NO;
+                }
+            
+            /* otherwise, the key is an unary operator, which pushes the display */
+            } else {
+                [calculator pushOperand:state->display];
+            }
+            
+            number = [calculator performOperator:[NIBOperator operatorWithTag:tag]];
+            break;
+    }
+    
+    /* if the key has a result, show it on the display */
+    if (number) state->display = number.doubleValue;
+}
+
+/**
+ Format the result of a line with its new line.
+ 
+ @param buffer  The buffer with room for NIB_BATCH_MAX_OUTPUT_LENGTH characters.
+ @param isValid YES if the line can be read, otherwise NO.
+ @param result  The result.
+ 
+ @return Returns the length of the output, which does not end with a null
+ character.
+ */
+static size_t NIBBatchFormatResult(char *buffer, BOOL isValid, double result) {
+    
+    /* if the line can not be read or the result is not a number, it is an error */
+    if (!isValid || isnan(result)) {
+        memcpy(buffer, "Error\n", 6);
+        return 6;
+    }
+    
+    // the null character which snprintf() adds is overwritten by the next
+    // line, a result takes at most 25 characters with it
+    int length = snprintf(buffer, NIB_BATCH_MAX_OUTPUT_LENGTH, "%.17g\n", result);
+    
+    return (size_t)length;
+}
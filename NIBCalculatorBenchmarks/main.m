@@ -0,0 +1,500 @@
+//
+//  main.m
+//  NIBCalculatorBenchmarks
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+/**
+ `NIBCalculatorBenchmarks` measures the hot paths of the model layer and prints
+ one JSON object per benchmark with the time and the allocations per operation.
+ 
+ Usage: NIBCalculatorBenchmarks [-filter name] [-baseline file] [-tolerance ratio]
+                                 [-instrumentation file] [-trace file]
+ 
+ With a baseline, which is the output of an earlier run, the tool exits with
+ status 1 if a benchmark is slower than the baseline by more than the tolerance
+ (0.25 by default) or allocates more per operation.
+ 
+ When the tool is built with the instrumentation, the snapshot of what it
+ records over all the benchmarks is written to the instrumentation file, and
+ the last intervals to the trace file.
+ */
+
+#import <Foundation/Foundation.h>
+#import <time.h>
+#import "NIBCalculatorBrain.h"
+#import "NIBCalculatorKernels.h"
+#import "NIBCalculatorStack.h"
+#import "NIBExpressionTokenizer.h"
+#import "NIBInstrumentation.h"
+#import "NIBOperator.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ A benchmark body. It runs the operations once on a calculator.
+ 
+ @param calculator  The calculator of the benchmark.
+ 
+ @return Returns the number of operations which are run.
+ */
+typedef NSUInteger (^NIBBenchmarkBody)(NIBCalculatorBrain *calculator);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The minimum duration to run a benchmark, in nanoseconds. */
+static const uint64_t NIBBenchmarkMinimumDuration = 200000000;
+
+/** The default tolerance of the time per operation against a baseline. */
+static const double NIBBenchmarkDefaultTolerance = 0.25;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Class Variables
+
+
+/** Class variable number of allocations since the start of the tool. */
+static uint64_t allocationCount = 0;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static uint64_t NIBBenchmarkNow(void);
+static BOOL NIBBenchmarkCountsAllocations(void);
+static NSDictionary<NSString *, id> *NIBBenchmarkRun(NSString *, NIBBenchmarkBody);
+static NSDictionary<NSString *, NIBBenchmarkBody> *NIBBenchmarkBodies(void);
+static NSUInteger NIBBenchmarkPerformTags(NIBCalculatorBrain *, const NIBButtonTag *, NSUInteger);
+static NIBBenchmarkBody NIBBenchmarkUnaryFamily(const NIBButtonTag *, NSUInteger);
+static BOOL NIBBenchmarkIsRegression(NSDictionary<NSString *, id> *, NSDictionary<NSString *, id> *, double);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Allocation Counting
+
+
+#if defined(__GLIBC__)
+
+// the allocator of glibc is wrapped by the tool, so the allocations of the
+// Objective-C runtime and Foundation are counted as well
+
+extern void *__libc_malloc(size_t);
+extern void *__libc_calloc(size_t, size_t);
+extern void *__libc_realloc(void *, size_t);
+
+void *malloc(size_t size) {
+    __atomic_fetch_add(&allocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    __atomic_fetch_add(&allocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+    __atomic_fetch_add(&allocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(pointer, size);
+}
+
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Main
+
+
+int main(int argc, const char * argv[]) {
+    @autoreleasepool {
+        NSUserDefaults *arguments = [NSUserDefaults standardUserDefaults];
+        NSString *filter = [arguments stringForKey:@"filter"];
+        NSString *baselinePath = [arguments stringForKey:@"baseline"];
+        double tolerance = [arguments objectForKey:@"tolerance"] ? [arguments doubleForKey:@"tolerance"] : NIBBenchmarkDefaultTolerance;
+        NSString *instrumentationPath = [arguments stringForKey:@"instrumentation"];
+        NSString *tracePath = [arguments stringForKey:@"trace"];
+        NSMutableDictionary<NSString *, NSDictionary<NSString *, id> *> *baseline = [[NSMutableDictionary alloc] init];
+        BOOL hasRegression = NO;
+        
+        /* read the results of the baseline, one JSON object per line */
+        if (baselinePath) {
+            NSString *content = [NSString stringWithContentsOfFile:baselinePath encoding:NSUTF8StringEncoding error:NULL];
+            
+            for (NSString *line in [content componentsSeparatedByString:@"\n"]) {
+                NSData *data = [line dataUsingEncoding:NSUTF8StringEncoding];
+                NSDictionary<NSString *, id> *result = (line.length > 0) ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL] : nil;
+                
+                if ([result isKindOfClass:[NSDictionary class]] && result[@"name"]) {
+                    baseline[result[@"name"]] = result;
+                }
+            }
+        }
+        
+        NSDictionary<NSString *, NIBBenchmarkBody> *bodies = NIBBenchmarkBodies();
+        
+        for (NSString *name in [bodies.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+            /* if the benchmark is filtered out, skip it */
+            if (filter && ![name containsString:filter]) {
+                continue;
+            }
+            
+            NSDictionary<NSString *, id> *result = NIBBenchmarkRun(name, bodies[name]);
+            NSDictionary<NSString *, id> *baselineResult = baseline[name];
+            NSMutableDictionary<NSString *, id> *output = [result mutableCopy];
+            
+            if (baselineResult) {
+                BOOL isRegression = NIBBenchmarkIsRegression(result, baselineResult, tolerance);
+                
+                output[@"baseline_ns_per_op"] = baselineResult[@"ns_per_op"];
+                output[@"regression"] = @(isRegression);
+                hasRegression = hasRegression || isRegression;
+            }
+            
+            NSData *data = [NSJSONSerialization dataWithJSONObject:output options:0 error:NULL];
+            
+            printf("%s\n", [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding].UTF8String);
+            fflush(stdout);
+        }
+        
+        /* write what the instrumentation records, if it is compiled in */
+        if (instrumentationPath) {
+            [NIBInstrumentation writeSnapshotToFile:instrumentationPath];
+        }
+        
+        if (tracePath) {
+            [NIBInstrumentation writeChromeTraceToFile:tracePath];
+        }
+        
+        return hasRegression ? 1 : 0;
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Get the time of the monotonic clock.
+ 
+ @return Returns the time in nanoseconds.
+ */
+static uint64_t NIBBenchmarkNow(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+/**
+ Check if the allocations are counted on the platform.
+ 
+ @return Returns YES if the allocations are counted. Otherwise, NO.
+ */
+static BOOL NIBBenchmarkCountsAllocations(void) {
+#if defined(__GLIBC__)
+    return YES;
+#else
+    return NO;
+#endif
+}
+
+/**
+ Run a benchmark on a new calculator until it lasts the minimum duration. The
+ body runs once first to warm up the calculator.
+ 
+ @param name    The name of the benchmark.
+ @param body    The body of the benchmark.
+ 
+ @return Returns the result with the name, the number of operations, the time
+ and the allocations per operation. The allocations are null if they are not
+ counted on the platform.
+ */
+static NSDictionary<NSString *, id> *NIBBenchmarkRun(NSString *name, NIBBenchmarkBody body) {
+    NIBCalculatorBrain *calculator = [[NIBCalculatorBrain alloc] init];
+    uint64_t operationCount = 0;
+    
+    @autoreleasepool {
+        body(calculator);
+    }
+    
+    uint64_t startAllocationCount = __atomic_load_n(&allocationCount, __ATOMIC_RELAXED);
+    uint64_t startTime = NIBBenchmarkNow();
+    uint64_t elapsedTime = 0;
+    
+    while (elapsedTime < NIBBenchmarkMinimumDuration) {
+        @autoreleasepool {
+            operationCount += body(calculator);
+        }
+        elapsedTime = NIBBenchmarkNow() - startTime;
+    }
+    
+    uint64_t allocations = __atomic_load_n(&allocationCount, __ATOMIC_RELAXED) - startAllocationCount;
+    
+    return @{@"name": name,
+             @"operations": @(operationCount),
+             @"ns_per_op": @((double)elapsedTime / operationCount),
+             @"allocs_per_op": NIBBenchmarkCountsAllocations() ? @((double)allocations / operationCount) : [NSNull null]};
+}
+
+/**
+ Create the bodies of the benchmarks.
+ 
+ @return Returns the bodies keyed by the names of the benchmarks.
+ */
+static NSDictionary<NSString *, NIBBenchmarkBody> *NIBBenchmarkBodies(void) {
+    NSMutableDictionary<NSString *, NIBBenchmarkBody> *bodies = [[NSMutableDictionary alloc] init];
+    
+    /* 1 + 2 x 3 - 4 / 5 ^ 2 =, one operation per key */
+    bodies[@"interactive.mixed_expression"] = ^ NSUInteger (NIBCalculatorBrain *calculator) {
+        const NIBButtonTag tags[] = {NIBButtonAddition, NIBButtonMultiplication, NIBButtonSubstraction,
+                                     NIBButtonDivision, NIBButtonXPowerY};
+        NSUInteger operationCount = 0;
+        
+        [calculator clearArithmetic];
+        
+        for (NSUInteger i = 0; i < sizeof(tags) / sizeof(tags[0]); i++) {
+            [calculator pushOperand:i + 1];
+            [calculator performOperator:[NIBOperator operatorWithTag:tags[i]]];
+            operationCount += 2;
+        }
+        
+        [calculator pushOperand:2];
+        [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+        
+        return operationCount + 2;
+    };
+    
+    /* the mixed expression in decimal mode, to compare with the binary floating point one */
+    bodies[@"interactive.mixed_expression_decimal"] = ^ NSUInteger (NIBCalculatorBrain *calculator) {
+        const NIBButtonTag tags[] = {NIBButtonAddition, NIBButtonMultiplication, NIBButtonSubstraction,
+                                     NIBButtonDivision, NIBButtonXPowerY};
+        NSUInteger operationCount = 0;
+        
+        /* toggling the mode clears the arithmetic */
+        if (!calculator.isDecimalMode) {
+            [calculator toggleDecimalMode];
+        } else {
+            [calculator clearArithmetic];
+        }
+        
+        for (NSUInteger i = 0; i < sizeof(tags) / sizeof(tags[0]); i++) {
+            [calculator pushOperand:i + 1];
+            [calculator performOperator:[NIBOperator operatorWithTag:tags[i]]];
+            operationCount += 2;
+        }
+        
+        [calculator pushOperand:2];
+        [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+        
+        return operationCount + 2;
+    };
+    
+    /* the mixed expression read from its text and performed in one call, one operation per token */
+    bodies[@"bulk.mixed_expression"] = ^ NSUInteger (NIBCalculatorBrain *calculator) {
+        static const char text[] = "1 + 2 x 3 - 4 / 5 ^ 2 =";
+        NIBNumberSeparators separators = NIBNumberSeparatorsOfLocale(nil);
+        NIBTokenBuffer tokens = {0};
+        
+        [calculator clearArithmetic];
+        NIBTokenizeExpression(text, sizeof(text) - 1, &separators, &tokens, NULL);
+        [calculator performExpression:tokens.tokens count:tokens.count];
+        
+        NSUInteger operationCount = tokens.count;
+        NIBTokenBufferFree(&tokens);
+        
+        return operationCount;
+    };
+    
+    /* ((((...(1 + 1) + 1)...) + 1) = with 32 levels of parentheses, one operation per key */
+    bodies[@"interactive.deep_parentheses"] = ^ NSUInteger (NIBCalculatorBrain *calculator) {
+        const NSUInteger depth = 32;
+        NSUInteger operationCount = 0;
+        
+        [calculator clearArithmetic];
+        
+        for (NSUInteger i = 0; i < depth; i++) {
+            [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis]];
+            operationCount++;
+        }
+        
+        [calculator pushOperand:1];
+        operationCount++;
+        
+        for (NSUInteger i = 0; i < depth; i++) {
+            [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+            [calculator pushOperand:1];
+            [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonClosingParenthesis]];
+            operationCount += 3;
+        }
+        
+        [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+        
+        return operationCount + 1;
+    };
+    
+    /* 1.0001 x 1.0001 = = = ... with 256 repeated equalities, one operation per equality */
+    bodies[@"interactive.repeated_equality"] = ^ NSUInteger (NIBCalculatorBrain *calculator) {
+        const NSUInteger repeatCount = 256;
+        NIBOperator *equality = [NIBOperator operatorWithTag:NIBButtonEquality];
+        
+        [calculator clearArithmetic];
+        [calculator pushOperand:1.0001];
+        [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+        [calculator pushOperand:1.0001];
+        
+        for (NSUInteger i = 0; i < repeatCount; i++) {
+            [calculator performOperator:equality];
+        }
+        
+        return repeatCount;
+    };
+    
+    /* the unary functions family by family, one operation per function */
+    const NIBButtonTag powers[] = {NIBButtonXSquared, NIBButtonXCubed, NIBButtonEulerNumberPowerX,
+                                   NIBButtonTenPowerX, NIBButtonTwoPowerX};
+    const NIBButtonTag roots[] = {NIBButtonSquareRootOfX, NIBButtonCubicRootOfX, NIBButtonOneOverX};
+    const NIBButtonTag logarithms[] = {NIBButtonNaturalLogarithm, NIBButtonCommonLogarithm, NIBButtonLogarithmBaseTwo};
+    const NIBButtonTag factorials[] = {NIBButtonXFactorial};
+    const NIBButtonTag trigonometrics[] = {NIBButtonSin, NIBButtonCos, NIBButtonTan};
+    const NIBButtonTag inverseTrigonometrics[] = {NIBButtonArcSin, NIBButtonArcCos, NIBButtonArcTan};
+    const NIBButtonTag hyperbolics[] = {NIBButtonSinh, NIBButtonCosh, NIBButtonTanh};
+    const NIBButtonTag inverseHyperbolics[] = {NIBButtonArcSinh, NIBButtonArcCosh, NIBButtonArcTanh};
+    
+    bodies[@"unary.powers"] = NIBBenchmarkUnaryFamily(powers, sizeof(powers) / sizeof(powers[0]));
+    bodies[@"unary.roots"] = NIBBenchmarkUnaryFamily(roots, sizeof(roots) / sizeof(roots[0]));
+    bodies[@"unary.logarithms"] = NIBBenchmarkUnaryFamily(logarithms, sizeof(logarithms) / sizeof(logarithms[0]));
+    bodies[@"unary.factorial"] = NIBBenchmarkUnaryFamily(factorials, sizeof(factorials) / sizeof(factorials[0]));
+    bodies[@"unary.trigonometric"] = NIBBenchmarkUnaryFamily(trigonometrics, sizeof(trigonometrics) / sizeof(trigonometrics[0]));
+    bodies[@"unary.inverse_trigonometric"] = NIBBenchmarkUnaryFamily(inverseTrigonometrics, sizeof(inverseTrigonometrics) / sizeof(inverseTrigonometrics[0]));
+    bodies[@"unary.hyperbolic"] = NIBBenchmarkUnaryFamily(hyperbolics, sizeof(hyperbolics) / sizeof(hyperbolics[0]));
+    bodies[@"unary.inverse_hyperbolic"] = NIBBenchmarkUnaryFamily(inverseHyperbolics, sizeof(inverseHyperbolics) / sizeof(inverseHyperbolics[0]));
+    
+    // the powers with a fractional exponent go through the conversion of the
+    // exponent to a fraction, one operation per power
+    bodies[@"kernel.fractional_power"] = ^ NSUInteger (NIBCalculatorBrain *__unused calculator) {
+        const double exponents[] = {0.5, 1.0 / 3, 2.5, 0.7, -1.25, 3.14159};
+        volatile double result = 0;
+        
+        for (NSUInteger i = 0; i < sizeof(exponents) / sizeof(exponents[0]); i++) {
+            result = NIBRaiseToPower(exponents[i], 2.0 + i);
+        }
+        
+        (void)result;
+        
+        return sizeof(exponents) / sizeof(exponents[0]);
+    };
+    
+    /* push and pop of the operator stack, one operation per push or pop */
+    bodies[@"stack.push_pop"] = ^ NSUInteger (NIBCalculatorBrain *__unused calculator) {
+        const NSUInteger depth = 64;
+        NIBCalculatorStack<NIBOperator *> *stack = [[NIBCalculatorStack alloc] init];
+        NIBOperator *operator = [NIBOperator operatorWithTag:NIBButtonAddition];
+        
+        for (NSUInteger i = 0; i < depth; i++) {
+            [stack push:operator];
+        }
+        
+        for (NSUInteger i = 0; i < depth; i++) {
+            [stack pop];
+        }
+        
+        return depth * 2;
+    };
+    
+    /* push and pop of the calculation stack, one operation per push or pop */
+    bodies[@"stack.double_push_pop"] = ^ NSUInteger (NIBCalculatorBrain *__unused calculator) {
+        const NSUInteger depth = 64;
+        NIBDoubleStack stack;
+        volatile double result = 0;
+        
+        NIBDoubleStackInit(&stack);
+        
+        for (NSUInteger i = 0; i < depth; i++) {
+            NIBDoubleStackPush(&stack, i);
+        }
+        
+        for (NSUInteger i = 0; i < depth; i++) {
+            result = NIBDoubleStackPop(&stack);
+        }
+        
+        (void)result;
+        NIBDoubleStackFree(&stack);
+        
+        return depth * 2;
+    };
+    
+    return bodies;
+}
+
+/**
+ Push an operand and perform each unary operator of a list on it.
+ 
+ @param calculator  The calculator.
+ @param tags        The tags of the unary operators.
+ @param count       The number of tags.
+ 
+ @return Returns the number of performed operators.
+ */
+static NSUInteger NIBBenchmarkPerformTags(NIBCalculatorBrain *calculator, const NIBButtonTag *tags, NSUInteger count) {
+    for (NSUInteger i = 0; i < count; i++) {
+        [calculator clearArithmetic];
+        [calculator pushOperand:0.5];
+        [calculator performOperator:[NIBOperator operatorWithTag:tags[i]]];
+    }
+    
+    return count;
+}
+
+/**
+ Create the body of a benchmark of a family of unary operators.
+ 
+ @param tags    The tags of the unary operators.
+ @param count   The number of tags.
+ 
+ @return Returns the body of the benchmark.
+ */
+static NIBBenchmarkBody NIBBenchmarkUnaryFamily(const NIBButtonTag *tags, NSUInteger count) {
+    NSData *tagsData = [[NSData alloc] initWithBytes:tags length:count * sizeof(NIBButtonTag)];
+    
+    return ^ NSUInteger (NIBCalculatorBrain *calculator) {
+        return NIBBenchmarkPerformTags(calculator, tagsData.bytes, count);
+    };
+}
+
+/**
+ Compare a result with the result of a baseline.
+ 
+ @param result          The result.
+ @param baselineResult  The result of the baseline.
+ @param tolerance       The ratio the time per operation may exceed the baseline.
+ 
+ @return Returns YES if the result is slower than the baseline by more than the
+ tolerance or allocates more per operation. Otherwise, NO.
+ */
+static BOOL NIBBenchmarkIsRegression(NSDictionary<NSString *, id> *result, NSDictionary<NSString *, id> *baselineResult, double tolerance) {
+    double time = [result[@"ns_per_op"] doubleValue];
+    double baselineTime = [baselineResult[@"ns_per_op"] doubleValue];
+    id allocations = result[@"allocs_per_op"];
+    id baselineAllocations = baselineResult[@"allocs_per_op"];
+    
+    /* if the time exceeds the tolerance, it is a regression */
+    if (time > baselineTime * (1 + tolerance)) {
+        return YES;
+    }
+    
+    /* if both runs counted the allocations, compare them to the nearest allocation */
+    if ([allocations isKindOfClass:[NSNumber class]] && [baselineAllocations isKindOfClass:[NSNumber class]]) {
+        return round([allocations doubleValue]) > round([baselineAllocations doubleValue]);
+    }
+    
+    return NO;
+}
@@ -0,0 +1,133 @@
+//
+//  NIBReferenceCalculatorBrain.h
+//  NIBCalculatorFuzzer
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "NIBConstants.h"
+
+@class NIBOperator;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ `NIBReferenceCalculatorBrain` is a frozen copy of the calculator brain before
+ its fast paths, which the fuzzer checks `NIBCalculatorBrain` against. It keeps
+ the infix expression and the arithmetic cache as arrays of number and
+ operator objects, converts the infix expression to a postfix expression on a
+ stack for every evaluation and evaluates it with number objects, as the brain
+ did at first.
+ 
+ The reference keeps its own copy of everything the brain has reworked since:
+ the functional operations, which raise to a power through a fraction, loop
+ the factorial and test the tangent for odd multiples of pi/2, the precedence
+ of the operators and a stack of a mutable array. Only the tags and the
+ indexes of `NIBOperator` are shared, so the fuzzer compares the new kernels
+ with the old calculations and not with themselves.
+ 
+ @warning Do not optimize this class. It is the reference which the optimized
+ brain is compared with, every change of its behavior changes what the
+ fuzzer accepts.
+ */
+@interface NIBReferenceCalculatorBrain : NSObject
+
+/// ----------------
+/// @name Properties
+/// ----------------
+
+/** The memory. */
+@property (readonly, strong, nonatomic) NSNumber *memory;
+
+/** The trigonometric mode for angle. */
+@property (readonly, assign, nonatomic) BOOL isRadianMode;
+
+/// ----------------------------
+/// @name Interactive Operations
+/// ----------------------------
+
+/**
+ Push an operand to the calculator.
+ 
+ @param operand The operand as double number.
+ */
+- (void)pushOperand:(double)operand;
+
+/**
+ Perform calculation of the operation. This method will call the method
+ performOperator:withExpreimentalModeOn: with the experimental mode is NO.
+ 
+ @param operator                The operator to calculate.
+ 
+ @return Returns the number object if the operation can be executed sucessfully,
+ otherwise `[NSDecimalNumber notANumber]`.
+ */
+- (NSNumber *_Nullable)performOperator:(NIBOperator *)operator;
+
+/**
+ Perform calculation of the operation.
+ 
+ @param operator                The operator to calculate.
+ @param isExperimentalModeOn    The boolean value to indicate
+                                if the experimental mode is on. If the value is
+                                YES, the calculation does not modify the infix
+                                expression of the calculator. Otherwise, the
+                                calculation modifies the infix expression.
+ 
+ @return Returns the number object if the operation can be executed sucessfully,
+ otherwise `[NSDecimalNumber notANumber]`.
+ */
+- (NSNumber *_Nullable)performOperator:(NIBOperator *)operator withExperimentalModeOn:(BOOL)isExperimentalModeOn;
+
+/**
+ Add a value to the memory of the calculator.
+ 
+ @param value The value to add to the memory.
+ */
+- (void)addToMemory:(double)value;
+
+/**
+ Subtract a value from the memory of the calculator.
+ 
+ @param value The value to subtract from the memory.
+ */
+- (void)subtractFromMemory:(double)value;
+
+/**
+ Clear the memory.
+ */
+- (void)clearMemory;
+
+/**
+ Clear arithmetic operations of the calculator.
+ */
+- (void)clearArithmetic;
+
+/**
+ Toggle radian mode of calculator. The default mode is degree.
+ */
+- (void)toggleRadianMode;
+
+/**
+ Get a constant number.
+ 
+ @param operator The operation to trigger a constant.
+ 
+ @return Returns the number object of the constant number.
+ */
+- (NSNumber *_Nullable)constantNumber:(NIBOperator *)operator;
+
+/// ---------------
+/// @name Utilities
+/// ---------------
+
+/**
+ Check if the calculator brain is waiting for an operand in binary operation.
+ */
+- (BOOL)isWaitingForOperandInInfixExpression;
+
+@end
+
+NS_ASSUME_NONNULL_END
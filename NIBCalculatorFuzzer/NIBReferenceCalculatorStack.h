@@ -0,0 +1,56 @@
+//
+//  NIBReferenceCalculatorStack.h
+//  NIBCalculatorFuzzer
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ `NIBReferenceCalculatorStack` is a frozen copy of the stack of the calculator
+ before it was reworked, a mutable array of objects, which the reference brain
+ evaluates its expressions on.
+ 
+ @warning Do not optimize this class, for the same reason as the reference
+ brain.
+ */
+@interface NIBReferenceCalculatorStack<ObjectType> : NSObject <NSCopying>
+
+/// -----------------
+/// @name Utitilities
+/// -----------------
+
+/**
+ Push object to stack.
+ 
+ @param object The object to push to the stack.
+ */
+- (void)push:(ObjectType)object;
+
+/**
+ Pop object to stack.
+ 
+ @return Returns the object at the top of the stack.
+ */
+- (ObjectType _Nullable)pop;
+
+/**
+ Peek object of stack. It is used to look at the top of the stack
+ without removing it from the stack.
+ 
+ @return Returns the object at the top of the stack.
+ */
+- (ObjectType _Nullable)peek;
+
+/**
+ Clear the stack.
+ */
+- (void)clear;
+
+@end
+
+NS_ASSUME_NONNULL_END
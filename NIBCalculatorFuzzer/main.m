@@ -0,0 +1,1461 @@
+//
+//  main.m
+//  NIBCalculatorFuzzer
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+/**
+ `NIBCalculatorFuzzer` presses random sequences of keys on the calculator brain
+ and on `NIBReferenceCalculatorBrain`, the brain before its fast paths, and
+ reports the sequences after which they disagree. After every key the result
+ of the key, the display, the memory and whether the brain waits for an
+ operand are compared.
+ 
+ The brain is meant to differ from the reference in a few operators, whose
+ differences are listed in `NIBFuzzerIntendedDifference`: the powers and the
+ exponentials by ulps, sin, cos and tan in degree by the rounding of the
+ reference, and the factorials, which are Gamma for non-integers. A key after
+ which the numbers differ only so ends the comparison of its sequence without
+ a divergence, since the keys after it start from different numbers. A sin,
+ cos or tan on an angle larger than a million is not pressed at all, since the
+ reference loses the angle in degree and stalls on it for tan.
+ 
+ Usage: NIBCalculatorFuzzer [-count sequences] [-duration seconds] [-seed number]
+                            [-length keys] [-jobs count] [-tolerance relative]
+                            [-reports count]
+        NIBCalculatorFuzzer -replay "keys"
+ 
+ The sequences are generated from the seed and their index, so a run with the
+ same seed and count generates the same sequences whatever the jobs are. By
+ default a million sequences of at most 24 keys are pressed by a worker on
+ each core, the seed is taken from the clock and the numbers must be equal.
+ With a duration, the run stops after the seconds, or after the count if it
+ is given as well. Every sequence starts with a cleared arithmetic, a cleared
+ memory, a display of 0 and the degree mode. An exception of either brain is
+ a divergence.
+ 
+ A divergent sequence is minimized on new calculators: the keys after the
+ first divergent key are dropped, then every chunk of keys and every key which
+ can be removed while the brains still disagree is removed, and the numbers are
+ made as simple as they can be. The minimized sequences are written to the
+ standard output once each, up to the reports, with what each brain shows at
+ the first divergent key. The number of sequences and the throughput are
+ reported on the standard error, and the exit status is 1 if a sequence is
+ divergent.
+ 
+ The keys are written as the input of `NIBCalculatorBatch`, and a key with a
+ leading `?`, such as `?+`, peeks the operator as the keypad does to size the
+ display, without performing it. With `-replay`, the keys are pressed on new
+ calculators and what both brains show after every key is written.
+ 
+ The key `rand` is not generated, since the brains can not agree on it, and
+ the brains are fuzzed in the binary mode only, since the reference has no
+ decimal mode.
+ */
+
+#import <Foundation/Foundation.h>
+#import <math.h>
+#import <pthread.h>
+#import <stdatomic.h>
+#import <time.h>
+#import <unistd.h>
+#import "NIBCalculatorBrain.h"
+#import "NIBConstants.h"
+#import "NIBOperator.h"
+#import "NIBReferenceCalculatorBrain.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Types, Enumeration and Options
+
+
+/**
+ The kinds of key of a sequence.
+ */
+typedef NS_ENUM(NSInteger, NIBFuzzerKeyKind) {
+    /** A number which is typed on the display. */
+    NIBFuzzerKeyKindNumber,
+    /** A button which is pressed. */
+    NIBFuzzerKeyKindPress,
+    /** An operator which is peeked without performing it. */
+    NIBFuzzerKeyKindPeek
+};
+
+/**
+ The outcomes of pressing a sequence of keys on both calculators.
+ */
+typedef NS_ENUM(NSInteger, NIBFuzzerComparison) {
+    /** The calculators agree after every key. */
+    NIBFuzzerComparisonSame,
+    /** The calculators disagree after a key. */
+    NIBFuzzerComparisonDivergent,
+    /** The calculators differ after a key as the brain is meant to, and the
+        keys after it are not compared. */
+    NIBFuzzerComparisonIntended,
+    /** A key is not pressed, since the reference stalls on or loses its
+        angle, and neither are the keys after it. */
+    NIBFuzzerComparisonSkipped
+};
+
+/**
+ The differences which the brain is meant to have from the reference.
+ */
+typedef NS_OPTIONS(NSUInteger, NIBFuzzerIntendedDifference) {
+    /** No difference. */
+    NIBFuzzerIntendedDifferenceNone = 0,
+    /** Integer powers raised by squaring, e^x and 2^x from exp() and exp2()
+        and the exact powers of ten of 10^x and EE differ by ulps. */
+    NIBFuzzerIntendedDifferencePower = 1 << 0,
+    /** The angles in degree are reduced exactly, so sin, cos and tan differ
+        by the rounding of the reference. */
+    NIBFuzzerIntendedDifferenceDegreeAngle = 1 << 1,
+    /** The factorials of integers come from a correctly rounded table and the
+        factorials of non-integers are Gamma, where the reference has errors. */
+    NIBFuzzerIntendedDifferenceFactorial = 1 << 2
+};
+
+/**
+ @struct NIBFuzzerKey
+ 
+ A key of a sequence.
+ 
+ @field kind    The kind of the key.
+ @field tag     The tag of the button of the key, which is pressed or peeked.
+ @field operand The number of the key, which is typed.
+ */
+typedef struct NIBFuzzerKey {
+    NIBFuzzerKeyKind kind;
+    NIBButtonTag tag;
+    double operand;
+} NIBFuzzerKey;
+
+/**
+ @struct NIBFuzzerKeyName
+ 
+ A key of the keypad and its name in a sequence.
+ 
+ @field name    The name of the key.
+ @field tag     The tag of the button of the key.
+ */
+typedef struct NIBFuzzerKeyName {
+    const char *name;
+    NIBButtonTag tag;
+} NIBFuzzerKeyName;
+
+/**
+ @struct NIBKeypadState
+ 
+ The state of the keypad which the view controller keeps between the keys.
+ 
+ @field display                         The number on the display, NAN if
+                                        the display shows an error.
+ @field canBinaryOperatorPushOperand    The boolean value to indicate if the
+                                        next binary operator pushes the
+                                        display to the calculator.
+ */
+typedef struct NIBKeypadState {
+    double display;
+    BOOL canBinaryOperatorPushOperand;
+} NIBKeypadState;
+
+/**
+ @struct NIBFuzzerObservation
+ 
+ What a calculator shows after a key.
+ 
+ @field result              The number which the key returns.
+ @field hasResult           YES if the key returns a number, otherwise NO.
+ @field display             The number on the display.
+ @field memory              The number in the memory.
+ @field hasMemory           YES if the memory has a number, otherwise NO.
+ @field isWaitingForOperand YES if the calculator waits for an operand.
+ @field isException         YES if the key raises an exception.
+ */
+typedef struct NIBFuzzerObservation {
+    double result;
+    BOOL hasResult;
+    double display;
+    double memory;
+    BOOL hasMemory;
+    BOOL isWaitingForOperand;
+    BOOL isException;
+} NIBFuzzerObservation;
+
+/**
+ @struct NIBFuzzerRun
+ 
+ A run of the fuzzer, which is shared by its workers.
+ 
+ @field seed                The seed of the sequences.
+ @field sequenceCount       The number of sequences to press.
+ @field deadline            The time to stop at in nanoseconds, or 0.
+ @field maxLength           The most keys of a sequence.
+ @field tolerance           The relative difference allowed between numbers.
+ @field nextSequence        The index of the next sequence to take.
+ @field lock                The lock of the reports.
+ @field reportedSequences   The minimized sequences which are reported.
+ @field reportLimit         The most sequences to report.
+ */
+typedef struct NIBFuzzerRun {
+    uint64_t seed;
+    uint64_t sequenceCount;
+    uint64_t deadline;
+    NSUInteger maxLength;
+    double tolerance;
+    _Atomic uint64_t nextSequence;
+    pthread_mutex_t lock;
+    __unsafe_unretained NSMutableSet<NSString *> *reportedSequences;
+    NSUInteger reportLimit;
+} NIBFuzzerRun;
+
+/**
+ @struct NIBFuzzerWorker
+ 
+ A worker which presses sequences on its own calculators.
+ 
+ @field thread          The thread of the worker.
+ @field run             The run of the worker.
+ @field sequenceCount   The number of sequences the worker pressed.
+ @field keyCount        The number of keys the worker pressed.
+ @field divergenceCount The number of divergent sequences the worker found.
+ */
+typedef struct NIBFuzzerWorker {
+    pthread_t thread;
+    NIBFuzzerRun *run;
+    uint64_t sequenceCount;
+    uint64_t keyCount;
+    uint64_t divergenceCount;
+} NIBFuzzerWorker;
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Constants
+
+
+/** The keys of the keypad. */
+static const NIBFuzzerKeyName NIB_FUZZER_KEYS[] = {
+    {"+", NIBButtonAddition}, {"-", NIBButtonSubstraction}, {"x", NIBButtonMultiplication},
+    {"*", NIBButtonMultiplication}, {"/", NIBButtonDivision}, {"=", NIBButtonEquality},
+    {"%", NIBButtonPercentage}, {"(", NIBButtonOpenningParenthesis}, {")", NIBButtonClosingParenthesis},
+    {"x^2", NIBButtonXSquared}, {"x^3", NIBButtonXCubed}, {"x^y", NIBButtonXPowerY},
+    {"y^x", NIBButtonYPowerX}, {"e^x", NIBButtonEulerNumberPowerX}, {"10^x", NIBButtonTenPowerX},
+    {"2^x", NIBButtonTwoPowerX}, {"1/x", NIBButtonOneOverX}, {"sqrt", NIBButtonSquareRootOfX},
+    {"cbrt", NIBButtonCubicRootOfX}, {"root", NIBButtonYthRootOfX}, {"ln", NIBButtonNaturalLogarithm},
+    {"log10", NIBButtonCommonLogarithm}, {"logy", NIBButtonLogarithmBaseYOfX}, {"log2", NIBButtonLogarithmBaseTwo},
+    {"x!", NIBButtonXFactorial}, {"EE", NIBButtonEE},
+    {"sin", NIBButtonSin}, {"cos", NIBButtonCos}, {"tan", NIBButtonTan},
+    {"arcsin", NIBButtonArcSin}, {"arccos", NIBButtonArcCos}, {"arctan", NIBButtonArcTan},
+    {"sinh", NIBButtonSinh}, {"cosh", NIBButtonCosh}, {"tanh", NIBButtonTanh},
+    {"arcsinh", NIBButtonArcSinh}, {"arccosh", NIBButtonArcCosh}, {"arctanh", NIBButtonArcTanh},
+    {"pi", NIBButtonPi}, {"e", NIBButtonEulerNumber}, {"rand", NIBButtonRand},
+    {"mc", NIBButtonMemoryClear}, {"m+", NIBButtonMemoryPlus}, {"m-", NIBButtonMemoryMinus},
+    {"mr", NIBButtonMemoryRead}, {"+/-", NIBButtonSignToggle}, {"ac", NIBButtonArithmeticClear},
+    {"c", NIBButtonClear}, {"rad", NIBButtonRad}, {"deg", NIBButtonDeg}
+};
+
+/** The arithmetic operators which are generated. */
+static const NIBButtonTag NIB_FUZZER_ARITHMETIC_TAGS[] = {
+    NIBButtonAddition, NIBButtonSubstraction, NIBButtonMultiplication, NIBButtonDivision
+};
+
+/** The binary operators other than the arithmetic operators which are generated. */
+static const NIBButtonTag NIB_FUZZER_POWER_TAGS[] = {
+    NIBButtonXPowerY, NIBButtonYPowerX, NIBButtonYthRootOfX, NIBButtonLogarithmBaseYOfX, NIBButtonEE
+};
+
+/** The unary operators which are generated. */
+static const NIBButtonTag NIB_FUZZER_UNARY_TAGS[] = {
+    NIBButtonPercentage, NIBButtonXSquared, NIBButtonXCubed, NIBButtonEulerNumberPowerX,
+    NIBButtonTenPowerX, NIBButtonTwoPowerX, NIBButtonOneOverX, NIBButtonSquareRootOfX,
+    NIBButtonCubicRootOfX, NIBButtonNaturalLogarithm, NIBButtonCommonLogarithm, NIBButtonLogarithmBaseTwo,
+    NIBButtonXFactorial, NIBButtonSin, NIBButtonCos, NIBButtonTan, NIBButtonArcSin, NIBButtonArcCos,
+    NIBButtonArcTan, NIBButtonSinh, NIBButtonCosh, NIBButtonTanh, NIBButtonArcSinh, NIBButtonArcCosh,
+    NIBButtonArcTanh
+};
+
+/** The keys other than the operators which are generated. */
+static const NIBButtonTag NIB_FUZZER_OTHER_TAGS[] = {
+    NIBButtonSignToggle, NIBButtonArithmeticClear, NIBButtonClear, NIBButtonMemoryClear,
+    NIBButtonMemoryPlus, NIBButtonMemoryMinus, NIBButtonMemoryRead, NIBButtonPi, NIBButtonEulerNumber,
+    NIBButtonRad, NIBButtonDeg
+};
+
+/** The numbers which are generated for the edges of the operators. */
+static const double NIB_FUZZER_SPECIAL_OPERANDS[] = {
+    0, 1, 0.5, 0.1, 30, 45, 60, 90, 180, 270, 360, 170, 171, 1e15, 1e-15, 1e300
+};
+
+/** The relative difference allowed between numbers which differ as intended. */
+static const double NIB_FUZZER_INTENDED_TOLERANCE = 1e-9;
+
+/** The largest angle which sin, cos and tan are compared on, the reference
+    loses larger angles in degree and steps through the multiples of pi/2 up
+    to them for tan. */
+static const double NIB_FUZZER_MAX_ANGLE = 1e6;
+
+/** The number of sequences which a worker takes at once. */
+#define NIB_FUZZER_CHUNK_SIZE 1024
+
+/** The longest key or number in a sequence. */
+#define NIB_FUZZER_MAX_TOKEN_LENGTH 64
+
+/** The length of a number or an observation which is written. */
+#define NIB_FUZZER_TEXT_LENGTH 160
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Calculator Protocol
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The methods which the fuzzer calls on both brains.
+ */
+@protocol NIBFuzzerCalculator <NSObject>
+
+@property (readonly, strong, nonatomic) NSNumber *memory;
+@property (readonly, assign, nonatomic) BOOL isRadianMode;
+
+- (void)pushOperand:(double)operand;
+- (NSNumber *_Nullable)performOperator:(NIBOperator *)operator;
+- (NSNumber *_Nullable)performOperator:(NIBOperator *)operator withExperimentalModeOn:(BOOL)isExperimentalModeOn;
+- (void)addToMemory:(double)value;
+- (void)subtractFromMemory:(double)value;
+- (void)clearMemory;
+- (void)clearArithmetic;
+- (void)toggleRadianMode;
+- (NSNumber *_Nullable)constantNumber:(NIBOperator *)operator;
+- (BOOL)isWaitingForOperandInInfixExpression;
+
+@end
+
+@interface NIBCalculatorBrain (NIBFuzzer) <NIBFuzzerCalculator>
+@end
+
+@interface NIBReferenceCalculatorBrain (NIBFuzzer) <NIBFuzzerCalculator>
+@end
+
+NS_ASSUME_NONNULL_END
+
+@implementation NIBCalculatorBrain (NIBFuzzer)
+@end
+
+@implementation NIBReferenceCalculatorBrain (NIBFuzzer)
+@end
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Declaration of Private Functions
+
+
+static uint64_t NIBFuzzerNow(void);
+static uint64_t NIBFuzzerNextRandom(uint64_t *);
+static NSUInteger NIBFuzzerRandomIndex(uint64_t *, NSUInteger);
+static double NIBFuzzerRandomOperand(uint64_t *);
+static NSUInteger NIBFuzzerGenerateSequence(uint64_t, uint64_t, NIBFuzzerKey *, NSUInteger);
+static void *NIBFuzzerRunWorker(void *);
+static NIBFuzzerComparison NIBFuzzerPressSequence(id<NIBFuzzerCalculator>, id<NIBFuzzerCalculator>, const NIBFuzzerKey *,
+                                                  NSUInteger, double, NSUInteger *, NIBFuzzerObservation *,
+                                                  NIBFuzzerObservation *);
+static NIBFuzzerComparison NIBFuzzerCompareSequence(const NIBFuzzerKey *, NSUInteger, double, NSUInteger *,
+                                                    NIBFuzzerObservation *, NIBFuzzerObservation *);
+static void NIBFuzzerResetCalculator(id<NIBFuzzerCalculator>);
+static void NIBFuzzerPressKey(id<NIBFuzzerCalculator>, NIBKeypadState *, NIBFuzzerKey, NIBFuzzerObservation *);
+static NSNumber *NIBFuzzerPressButton(id<NIBFuzzerCalculator>, NIBKeypadState *, NIBButtonTag);
+static BOOL NIBFuzzerIsSameObservation(const NIBFuzzerObservation *, const NIBFuzzerObservation *, double);
+static BOOL NIBFuzzerIsSameNumber(double, double, double);
+static BOOL NIBFuzzerIsUnaryTag(NIBButtonTag);
+static BOOL NIBFuzzerIsSkippedAngle(NIBButtonTag, double, BOOL);
+static NIBFuzzerIntendedDifference NIBFuzzerIntendedDifferenceOfTag(NIBButtonTag, BOOL);
+static BOOL NIBFuzzerIsIntendedObservation(const NIBFuzzerObservation *, const NIBFuzzerObservation *,
+                                           NIBFuzzerIntendedDifference);
+static BOOL NIBFuzzerIsIntendedNumber(double, double, NIBFuzzerIntendedDifference);
+static NSUInteger NIBFuzzerMinimizeSequence(NIBFuzzerKey *, NSUInteger, double);
+static void NIBFuzzerReportSequence(NIBFuzzerRun *, uint64_t, const NIBFuzzerKey *, NSUInteger);
+static BOOL NIBFuzzerParseSequence(const char *, NIBFuzzerKey *, NSUInteger *);
+static int NIBFuzzerReplaySequence(const char *, double);
+static NSString *NIBFuzzerDescriptionOfSequence(const NIBFuzzerKey *, NSUInteger);
+static NSString *NIBFuzzerDescriptionOfKey(NIBFuzzerKey);
+static NSString *NIBFuzzerDescriptionOfObservation(const NIBFuzzerObservation *);
+static void NIBFuzzerFormatNumber(char *, size_t, double);
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Main
+
+
+int main(int argc, const char * argv[]) {
+    @autoreleasepool {
+        NSUserDefaults *arguments = [NSUserDefaults standardUserDefaults];
+        NSString *replayedSequence = [arguments stringForKey:@"replay"];
+        NSString *seedArgument = [arguments stringForKey:@"seed"];
+        NSInteger sequenceCount = [arguments integerForKey:@"count"];
+        double duration = [arguments doubleForKey:@"duration"];
+        NSInteger maxLength = [arguments integerForKey:@"length"];
+        NSInteger jobCount = [arguments integerForKey:@"jobs"];
+        NSInteger reportLimit = [arguments objectForKey:@"reports"] ? [arguments integerForKey:@"reports"] : 10;
+        double tolerance = MAX([arguments doubleForKey:@"tolerance"], 0);
+        
+        /* if a sequence is given, replay it instead of fuzzing */
+        if (replayedSequence) {
+            return NIBFuzzerReplaySequence(replayedSequence.UTF8String, tolerance);
+        }
+        
+        /* if the jobs are not given, run a worker on each core */
+        if (jobCount <= 0) {
+            jobCount = MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+        }
+        
+        /* if the count is not given, run a million sequences or until the duration */
+        if (sequenceCount <= 0) {
+            sequenceCount = (duration > 0) ? NSIntegerMax : 1000000;
+        }
+        
+        if (maxLength <= 0) maxLength = 24;
+        
+        uint64_t startTime = NIBFuzzerNow();
+        NSMutableSet<NSString *> *reportedSequences = [[NSMutableSet alloc] init];
+        NIBFuzzerRun run = {
+            .seed = seedArgument ? strtoull(seedArgument.UTF8String, NULL, 0) : startTime,
+            .sequenceCount = (uint64_t)sequenceCount,
+            .deadline = (duration > 0) ? startTime + (uint64_t)(duration * 1e9) : 0,
+            .maxLength = (NSUInteger)maxLength,
+            .tolerance = tolerance,
+            .reportedSequences = reportedSequences,
+            .reportLimit = (NSUInteger)MAX(reportLimit, 0)
+        };
+        NIBFuzzerWorker *workers = calloc((size_t)jobCount, sizeof(NIBFuzzerWorker));
+        
+        atomic_init(&run.nextSequence, 0);
+        pthread_mutex_init(&run.lock, NULL);
+        
+        /* the first worker runs on the calling thread and every other worker on a thread of its own */
+        for (NSInteger i = 0; i < jobCount; i++) {
+            workers[i].run = &run;
+        }
+        
+        for (NSInteger i = 1; i < jobCount; i++) {
+            pthread_create(&workers[i].thread, NULL, NIBFuzzerRunWorker, &workers[i]);
+        }
+        
+        NIBFuzzerRunWorker(&workers[0]);
+        
+        for (NSInteger i = 1; i < jobCount; i++) {
+            pthread_join(workers[i].thread, NULL);
+        }
+        
+        fflush(stdout);
+        
+        double elapsedSeconds = (double)(NIBFuzzerNow() - startTime) / 1e9;
+        uint64_t pressedSequenceCount = 0;
+        uint64_t keyCount = 0;
+        uint64_t divergenceCount = 0;
+        
+        for (NSInteger i = 0; i < jobCount; i++) {
+            pressedSequenceCount += workers[i].sequenceCount;
+            keyCount += workers[i].keyCount;
+            divergenceCount += workers[i].divergenceCount;
+        }
+        
+        fprintf(stderr, "%llu sequences, %llu keys, %llu divergent, %lu reported, seed %llu, %ld jobs, %.3f s, %.0f sequences/s\n",
+                (unsigned long long)pressedSequenceCount, (unsigned long long)keyCount,
+                (unsigned long long)divergenceCount, (unsigned long)reportedSequences.count,
+                (unsigned long long)run.seed, (long)jobCount, elapsedSeconds,
+                (elapsedSeconds > 0) ? pressedSequenceCount / elapsedSeconds : 0);
+        
+        pthread_mutex_destroy(&run.lock);
+        free(workers);
+        
+        return (divergenceCount > 0) ? 1 : 0;
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+#pragma mark - Private Functions Implementation
+
+
+/**
+ Get the time of the monotonic clock.
+ 
+ @return Returns the time in nanoseconds.
+ */
+static uint64_t NIBFuzzerNow(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+/**
+ Get the next random number of a SplitMix64 generator.
+ 
+ @param state   The state of the generator.
+ 
+ @return Returns the random number.
+ */
+static uint64_t NIBFuzzerNextRandom(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    
+    return z ^ (z >> 31);
+}
+
+/**
+ Get a random index.
+ 
+ @param state   The state of the generator.
+ @param count   The number of indexes.
+ 
+ @return Returns an index less than the count.
+ */
+static NSUInteger NIBFuzzerRandomIndex(uint64_t *state, NSUInteger count) {
+    return (NSUInteger)(NIBFuzzerNextRandom(state) % count);
+}
+
+/**
+ Get a random number to type. Most numbers are small integers, which the
+ operators are exact on, and the rest are decimals, larger integers, the
+ edges of the operators and powers of ten.
+ 
+ @param state   The state of the generator.
+ 
+ @return Returns the number.
+ */
+static double NIBFuzzerRandomOperand(uint64_t *state) {
+    NSUInteger choice = NIBFuzzerRandomIndex(state, 100);
+    double operand;
+    
+    if (choice < 50) {
+        operand = NIBFuzzerRandomIndex(state, 10);
+    } else if (choice < 65) {
+        operand = NIBFuzzerRandomIndex(state, 1000);
+    } else if (choice < 80) {
+        operand = NIBFuzzerRandomIndex(state, 10000) / 100.0;
+    } else if (choice < 90) {
+        operand = NIB_FUZZER_SPECIAL_OPERANDS[NIBFuzzerRandomIndex(state, sizeof(NIB_FUZZER_SPECIAL_OPERANDS) / sizeof(double))];
+    } else {
+        operand = (1 + NIBFuzzerRandomIndex(state, 9)) * pow(10, (double)NIBFuzzerRandomIndex(state, 41) - 20);
+    }
+    
+    return (NIBFuzzerRandomIndex(state, 100) < 15) ? -operand : operand;
+}
+
+/**
+ Generate a sequence of keys. The keys are weighted toward the numbers, the
+ arithmetic operators and the parentheses, which build the expressions the
+ fast paths of the brain take.
+ 
+ @param seed        The seed of the run.
+ @param index       The index of the sequence.
+ @param keys        The keys of the sequence.
+ @param maxLength   The most keys of the sequence.
+ 
+ @return Returns the number of keys.
+ */
+static NSUInteger NIBFuzzerGenerateSequence(uint64_t seed, uint64_t index, NIBFuzzerKey *keys, NSUInteger maxLength) {
+    uint64_t state = seed ^ (index * 0xD1B54A32D192ED03ULL);
+    NSUInteger count = 1 + NIBFuzzerRandomIndex(&state, maxLength);
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        NSUInteger choice = NIBFuzzerRandomIndex(&state, 100);
+        NIBFuzzerKey key = {NIBFuzzerKeyKindPress, NIBButtonEquality, 0};
+        
+        if (choice < 30) {
+            key.kind = NIBFuzzerKeyKindNumber;
+            key.operand = NIBFuzzerRandomOperand(&state);
+        } else if (choice < 52) {
+            key.tag = NIB_FUZZER_ARITHMETIC_TAGS[NIBFuzzerRandomIndex(&state, sizeof(NIB_FUZZER_ARITHMETIC_TAGS) / sizeof(NIBButtonTag))];
+        } else if (choice < 57) {
+            key.tag = NIB_FUZZER_POWER_TAGS[NIBFuzzerRandomIndex(&state, sizeof(NIB_FUZZER_POWER_TAGS) / sizeof(NIBButtonTag))];
+        } else if (choice < 65) {
+            key.tag = NIBButtonEquality;
+        } else if (choice < 70) {
+            key.tag = NIBButtonOpenningParenthesis;
+        } else if (choice < 75) {
+            key.tag = NIBButtonClosingParenthesis;
+        } else if (choice < 87) {
+            key.tag = NIB_FUZZER_UNARY_TAGS[NIBFuzzerRandomIndex(&state, sizeof(NIB_FUZZER_UNARY_TAGS) / sizeof(NIBButtonTag))];
+        } else if (choice < 92) {
+            /* a peek is of an operator the keypad peeks, a binary or an unary operator */
+            key.kind = NIBFuzzerKeyKindPeek;
+            key.tag = (NIBFuzzerRandomIndex(&state, 2) == 0)
+                ? NIB_FUZZER_ARITHMETIC_TAGS[NIBFuzzerRandomIndex(&state, sizeof(NIB_FUZZER_ARITHMETIC_TAGS) / sizeof(NIBButtonTag))]
+                : NIB_FUZZER_UNARY_TAGS[NIBFuzzerRandomIndex(&state, sizeof(NIB_FUZZER_UNARY_TAGS) / sizeof(NIBButtonTag))];
+        } else {
+            key.tag = NIB_FUZZER_OTHER_TAGS[NIBFuzzerRandomIndex(&state, sizeof(NIB_FUZZER_OTHER_TAGS) / sizeof(NIBButtonTag))];
+        }
+        
+        keys[i] = key;
+    }
+    
+    return count;
+}
+
+/**
+ Press the sequences of a run until there are none left to take or the
+ deadline passes. The worker has its own pair of calculators, which are reused
+ from sequence to sequence.
+ 
+ @param argument    The worker.
+ 
+ @return Returns NULL.
+ */
+static void *NIBFuzzerRunWorker(void *argument) {
+    NIBFuzzerWorker *worker = argument;
+    NIBFuzzerRun *run = worker->run;
+    NIBFuzzerKey *keys = malloc(run->maxLength * sizeof(NIBFuzzerKey));
+
+#ifdef GNUSTEP
+    /* a thread which is not an NSThread has to be known to GNUstep before it uses Foundation */
+    BOOL isRegistered = GSRegisterCurrentThread();
+#endif
+    
+    @autoreleasepool {
+        NIBCalculatorBrain *calculator = [[NIBCalculatorBrain alloc] init];
+        NIBReferenceCalculatorBrain *reference = [[NIBReferenceCalculatorBrain alloc] init];
+        
+        while (run->deadline == 0 || NIBFuzzerNow() < run->deadline) {
+            uint64_t start = atomic_fetch_add(&run->nextSequence, NIB_FUZZER_CHUNK_SIZE);
+            
+            if (start >= run->sequenceCount) break;
+            
+            uint64_t end = MIN(start + NIB_FUZZER_CHUNK_SIZE, run->sequenceCount);
+            
+            @autoreleasepool {
+                for (uint64_t i = start; i < end; i++) {
+                    NSUInteger count = NIBFuzzerGenerateSequence(run->seed, i, keys, run->maxLength);
+                    NSUInteger divergentIndex = count;
+                    NIBFuzzerComparison comparison = NIBFuzzerPressSequence(calculator, reference, keys, count,
+                                                                            run->tolerance, &divergentIndex, NULL, NULL);
+                    
+                    worker->sequenceCount++;
+                    worker->keyCount += (comparison == NIBFuzzerComparisonSame) ? count :
+                                        (comparison == NIBFuzzerComparisonSkipped) ? divergentIndex : divergentIndex + 1;
+                    
+                    if (comparison == NIBFuzzerComparisonDivergent) {
+                        worker->divergenceCount++;
+                        NIBFuzzerReportSequence(run, i, keys, count);
+                    }
+                }
+            }
+        }
+    }
+
+#ifdef GNUSTEP
+    if (isRegistered) GSUnregisterCurrentThread();
+#endif
+    
+    free(keys);
+    
+    return NULL;
+}
+
+/**
+ Press a sequence of keys on both calculators, which start with a cleared
+ arithmetic, a cleared memory, a display of 0 and the degree mode, until they
+ disagree. A key after which the calculators differ as the brain is meant to
+ ends the comparison, since the rest of the sequence starts from different
+ numbers, and so does a sin, cos or tan on an angle the reference can not
+ take, before the key is pressed.
+ 
+ @param calculator              The calculator.
+ @param reference               The reference calculator.
+ @param keys                    The keys.
+ @param count                   The number of keys.
+ @param tolerance               The relative difference allowed between numbers.
+ @param divergentIndex          The index of the key which ends the comparison.
+ @param calculatorObservation   What the calculator shows after the last key
+                                pressed, or NULL.
+ @param referenceObservation    What the reference shows after the last key
+                                pressed, or NULL.
+ 
+ @return Returns how the calculators compare.
+ */
+static NIBFuzzerComparison NIBFuzzerPressSequence(id<NIBFuzzerCalculator> calculator, id<NIBFuzzerCalculator> reference,
+                                                  const NIBFuzzerKey *keys, NSUInteger count, double tolerance,
+                                                  NSUInteger *divergentIndex, NIBFuzzerObservation *calculatorObservation,
+                                                  NIBFuzzerObservation *referenceObservation) {
+    NIBKeypadState calculatorState = {0, YES};
+    NIBKeypadState referenceState = {0, YES};
+    NIBFuzzerObservation observation;
+    NIBFuzzerObservation referenceObservationOfKey;
+    NIBFuzzerIntendedDifference pendingDifferences = NIBFuzzerIntendedDifferenceNone;
+    NIBButtonTag repeatedTag = NIBButtonEquality;
+    
+    NIBFuzzerResetCalculator(calculator);
+    NIBFuzzerResetCalculator(reference);
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        NIBButtonTag tag = keys[i].tag;
+        
+        /* the equality repeats the last unary operator on the display */
+        if (keys[i].kind == NIBFuzzerKeyKindPress && tag == NIBButtonEquality) tag = repeatedTag;
+        
+        /* if the reference can not take the angle of the key, stop before it */
+        if (keys[i].kind == NIBFuzzerKeyKindPress &&
+            NIBFuzzerIsSkippedAngle(tag, referenceState.display, reference.isRadianMode)) {
+            *divergentIndex = i;
+            return NIBFuzzerComparisonSkipped;
+        }
+        
+        // the binary operators which are pressed earlier are performed by
+        // the key as well, the unary operators only by themselves
+        NIBFuzzerIntendedDifference differences = pendingDifferences;
+        
+        if (keys[i].kind != NIBFuzzerKeyKindNumber) {
+            differences |= NIBFuzzerIntendedDifferenceOfTag(tag, reference.isRadianMode);
+        }
+        
+        NIBFuzzerPressKey(calculator, &calculatorState, keys[i], &observation);
+        NIBFuzzerPressKey(reference, &referenceState, keys[i], &referenceObservationOfKey);
+        
+        if (calculatorObservation) *calculatorObservation = observation;
+        if (referenceObservation) *referenceObservation = referenceObservationOfKey;
+        
+        /* if the calculators disagree, stop at the key */
+        if (!NIBFuzzerIsSameObservation(&observation, &referenceObservationOfKey, tolerance)) {
+            *divergentIndex = i;
+            
+            return NIBFuzzerIsIntendedObservation(&observation, &referenceObservationOfKey, differences)
+                ? NIBFuzzerComparisonIntended
+                : NIBFuzzerComparisonDivergent;
+        }
+        
+        if (keys[i].kind == NIBFuzzerKeyKindPress && NIBIsBinaryOperatorTag(keys[i].tag)) {
+            pendingDifferences |= NIBFuzzerIntendedDifferenceOfTag(keys[i].tag, reference.isRadianMode);
+        }
+        
+        if (keys[i].kind == NIBFuzzerKeyKindPress && NIBFuzzerIsUnaryTag(keys[i].tag)) {
+            repeatedTag = keys[i].tag;
+        }
+    }
+    
+    return NIBFuzzerComparisonSame;
+}
+
+/**
+ Press a sequence of keys on new calculators and compare them.
+ 
+ @param keys                    The keys.
+ @param count                   The number of keys.
+ @param tolerance               The relative difference allowed between numbers.
+ @param divergentIndex          The index of the key which ends the comparison.
+ @param calculatorObservation   What the calculator shows after the last key
+                                pressed, or NULL.
+ @param referenceObservation    What the reference shows after the last key
+                                pressed, or NULL.
+ 
+ @return Returns how the calculators compare.
+ */
+static NIBFuzzerComparison NIBFuzzerCompareSequence(const NIBFuzzerKey *keys, NSUInteger count, double tolerance,
+                                                    NSUInteger *divergentIndex, NIBFuzzerObservation *calculatorObservation,
+                                                    NIBFuzzerObservation *referenceObservation) {
+    @autoreleasepool {
+        return NIBFuzzerPressSequence([[NIBCalculatorBrain alloc] init], [[NIBReferenceCalculatorBrain alloc] init],
+                                      keys, count, tolerance, divergentIndex, calculatorObservation, referenceObservation);
+    }
+}
+
+/**
+ Reset a calculator to a cleared arithmetic, a cleared memory and the degree
+ mode.
+ 
+ @param calculator  The calculator.
+ */
+static void NIBFuzzerResetCalculator(id<NIBFuzzerCalculator> calculator) {
+    [calculator clearArithmetic];
+    [calculator clearMemory];
+    
+    if (calculator.isRadianMode) [calculator toggleRadianMode];
+}
+
+/**
+ Press a key on a calculator and observe what it shows after the key.
+ 
+ @param calculator  The calculator.
+ @param state       The state of the keypad.
+ @param key         The key.
+ @param observation What the calculator shows after the key.
+ */
+static void NIBFuzzerPressKey(id<NIBFuzzerCalculator> calculator, NIBKeypadState *state, NIBFuzzerKey key,
+                              NIBFuzzerObservation *observation) {
+    NSNumber *number = nil;
+    
+    observation->isException = NO;
+    
+    @try {
+        switch (key.kind) {
+            /* a number is typed on the display */
+            case NIBFuzzerKeyKindNumber:
+                state->display = key.operand;
+                state->canBinaryOperatorPushOperand = YES;
+                break;
+            
+            /* a peek changes nothing the keypad shows */
+            case NIBFuzzerKeyKindPeek:
+                number = [calculator performOperator:[NIBOperator operatorWithTag:key.tag] withExperimentalModeOn:YES];
+                break;
+            
+            case NIBFuzzerKeyKindPress:
+                number = NIBFuzzerPressButton(calculator, state, key.tag);
+                break;
+        }
+    } @catch (NSException *__unused exception) {
+        number = nil;
+        observation->isException = YES;
+    }
+    
+    NSNumber *memory = calculator.memory;
+    
+    observation->result = number ? number.doubleValue : NAN;
+    observation->hasResult = (number != nil);
+    observation->display = state->display;
+    observation->memory = memory ? memory.doubleValue : NAN;
+    observation->hasMemory = (memory != nil);
+    observation->isWaitingForOperand = [calculator isWaitingForOperandInInfixExpression];
+}
+
+/**
+ Press a button on a calculator as the actions of the view controller do.
+ 
+ @param calculator  The calculator.
+ @param state       The state of the keypad.
+ @param tag         The tag of the button.
+ 
+ @return Returns the number which the button shows on the display, or nil.
+ */
+static NSNumber *NIBFuzzerPressButton(id<NIBFuzzerCalculator> calculator, NIBKeypadState *state, NIBButtonTag tag) {
+    NSNumber *number = nil;
+    
+    switch (tag) {
+        /* the equality and the closing parenthesis push the display */
+        case NIBButtonEquality:
+        case NIBButtonClosingParenthesis:
+            [calculator pushOperand:state->display];
+            number = [calculator performOperator:[NIBOperator operatorWithTag:tag]];
+            break;
+        
+        /* the openning parenthesis pushes nothing */
+        case NIBButtonOpenningParenthesis:
+            number = [calculator performOperator:[NIBOperator operatorWithTag:tag]];
+            break;
+        
+        /* the memory keys do nothing on an error */
+        case NIBButtonMemoryClear:
+            if (!isnan(state->display)) [calculator clearMemory];
+            break;
+        
+        case NIBButtonMemoryPlus:
+            if (!isnan(state->display)) [calculator addToMemory:state->display];
+            break;
+        
+        case NIBButtonMemoryMinus:
+            if (!isnan(state->display)) [calculator subtractFromMemory:state->display];
+            break;
+        
+        case NIBButtonMemoryRead:
+            if (!isnan(state->display)) {
+                number = calculator.memory;
+                state->canBinaryOperatorPushOperand = YES;
+            }
+            break;
+        
+        /* the constants are typed on the display */
+        case NIBButtonPi:
+        case NIBButtonEulerNumber:
+        case NIBButtonRand:
+            number = [calculator constantNumber:[NIBOperator operatorWithTag:tag]];
+            state->canBinaryOperatorPushOperand = YES;
+            break;
+        
+        /* the sign toggle edits the display */
+        case NIBButtonSignToggle:
+            state->display = -state->display;
+            state->canBinaryOperatorPushOperand = YES;
+            break;
+        
+        /* the arithmetic clear clears the calculator and the display */
+        case NIBButtonArithmeticClear:
+            [calculator clearArithmetic];
+            state->display = 0;
+            state->canBinaryOperatorPushOperand = YES;
+            break;
+        
+        /* the clear clears the display */
+        case NIBButtonClear:
+            state->display = 0;
+            state->canBinaryOperatorPushOperand = YES;
+            break;
+        
+        /* the angle mode keys switch to their mode */
+        case NIBButtonRad:
+        case NIBButtonDeg:
+            if (calculator.isRadianMode != (tag == NIBButtonRad)) [calculator toggleRadianMode];
+            break;
+        
+        default:
+            /* if the key is a binary operator, it pushes the display once after a number is typed */
+            if (NIBIsBinaryOperatorTag(tag)) {
+                if (state->canBinaryOperatorPushOperand) {
+                    [calculator pushOperand:state->display];
+                    state->canBinaryOperatorPushOperand = NO;
+                }
+            
+            /* otherwise, the key is an unary operator, which pushes the display */
+            } else {
+                [calculator pushOperand:state->display];
+            }
+            
+            number = [calculator performOperator:[NIBOperator operatorWithTag:tag]];
+            break;
+    }
+    
+    /* if the key has a result, show it on the display */
+    if (number) state->display = number.doubleValue;
+    
+    return number;
+}
+
+/**
+ Check if two calculators show the same after a key.
+ 
+ @param observation         What the calculator shows.
+ @param otherObservation    What the other calculator shows.
+ @param tolerance           The relative difference allowed between numbers.
+ 
+ @return Returns YES if the calculators show the same and neither raises an
+ exception, otherwise NO.
+ */
+static BOOL NIBFuzzerIsSameObservation(const NIBFuzzerObservation *observation,
+                                       const NIBFuzzerObservation *otherObservation, double tolerance) {
+    if (observation->isException || otherObservation->isException) {
+        return NO;
+    }
+    
+    if (observation->hasResult != otherObservation->hasResult ||
+        observation->hasMemory != otherObservation->hasMemory ||
+        observation->isWaitingForOperand != otherObservation->isWaitingForOperand) {
+        return NO;
+    }
+    
+    return (!observation->hasResult || NIBFuzzerIsSameNumber(observation->result, otherObservation->result, tolerance)) &&
+           (!observation->hasMemory || NIBFuzzerIsSameNumber(observation->memory, otherObservation->memory, tolerance)) &&
+           NIBFuzzerIsSameNumber(observation->display, otherObservation->display, tolerance);
+}
+
+/**
+ Check if two numbers are the same. Two errors are the same.
+ 
+ @param number      The number.
+ @param otherNumber The other number.
+ @param tolerance   The relative difference allowed between the numbers.
+ 
+ @return Returns YES if the numbers are the same, otherwise NO.
+ */
+static BOOL NIBFuzzerIsSameNumber(double number, double otherNumber, double tolerance) {
+    if (isnan(number) || isnan(otherNumber)) {
+        return isnan(number) && isnan(otherNumber);
+    }
+    
+    if (number == otherNumber) {
+        return YES;
+    }
+    
+    return isfinite(number) && isfinite(otherNumber) &&
+           fabs(number - otherNumber) <= tolerance * MAX(fabs(number), fabs(otherNumber));
+}
+
+/**
+ Check if a tag is of an unary operator which is generated, which the equality
+ repeats.
+ 
+ @param tag The tag of the button.
+ 
+ @return Returns YES if the tag is of a generated unary operator, otherwise NO.
+ */
+static BOOL NIBFuzzerIsUnaryTag(NIBButtonTag tag) {
+    for (NSUInteger i = 0; i < sizeof(NIB_FUZZER_UNARY_TAGS) / sizeof(NIBButtonTag); i++) {
+        if (NIB_FUZZER_UNARY_TAGS[i] == tag) return YES;
+    }
+    
+    return NO;
+}
+
+/**
+ Check if a key is skipped because the reference can not take its angle. The
+ reference steps through the odd multiples of pi/2 up to the angle of tan,
+ which stalls on a large angle, and loses a large angle in degree, which the
+ brain reduces exactly.
+ 
+ @param tag             The tag of the operator the key performs.
+ @param angle           The angle on the display.
+ @param isRadianMode    YES if the reference is in the radian mode.
+ 
+ @return Returns YES if the key is skipped, otherwise NO.
+ */
+static BOOL NIBFuzzerIsSkippedAngle(NIBButtonTag tag, double angle, BOOL isRadianMode) {
+    if (isnan(angle) || fabs(angle) <= NIB_FUZZER_MAX_ANGLE) {
+        return NO;
+    }
+    
+    return tag == NIBButtonTan || (!isRadianMode && (tag == NIBButtonSin || tag == NIBButtonCos));
+}
+
+/**
+ Get the differences which an operator is meant to have from the reference.
+ 
+ @param tag             The tag of the operator.
+ @param isRadianMode    YES if the reference is in the radian mode.
+ 
+ @return Returns the intended differences of the operator.
+ */
+static NIBFuzzerIntendedDifference NIBFuzzerIntendedDifferenceOfTag(NIBButtonTag tag, BOOL isRadianMode) {
+    NIBFuzzerIntendedDifference differences = NIBFuzzerIntendedDifferenceNone;
+    
+    switch (tag) {
+        /* the powers, the roots and the exponentials */
+        case NIBButtonXSquared:
+        case NIBButtonXCubed:
+        case NIBButtonXPowerY:
+        case NIBButtonYPowerX:
+        case NIBButtonYthRootOfX:
+        case NIBButtonSquareRootOfX:
+        case NIBButtonEulerNumberPowerX:
+        case NIBButtonTenPowerX:
+        case NIBButtonTwoPowerX:
+        case NIBButtonEE:
+            differences = NIBFuzzerIntendedDifferencePower;
+            break;
+        
+        /* the trigonometric functions in degree */
+        case NIBButtonSin:
+        case NIBButtonCos:
+        case NIBButtonTan:
+            if (!isRadianMode) differences = NIBFuzzerIntendedDifferenceDegreeAngle;
+            break;
+        
+        case NIBButtonXFactorial:
+            differences = NIBFuzzerIntendedDifferenceFactorial;
+            break;
+        
+        default:
+            break;
+    }
+    
+    return differences;
+}
+
+/**
+ Check if two calculators differ after a key only as the brain is meant to.
+ 
+ @param observation             What the calculator shows.
+ @param referenceObservation    What the reference shows.
+ @param differences             The intended differences of the key.
+ 
+ @return Returns YES if every number either calculator shows is the same or
+ differs as intended, and the rest they show is the same, otherwise NO.
+ */
+static BOOL NIBFuzzerIsIntendedObservation(const NIBFuzzerObservation *observation,
+                                           const NIBFuzzerObservation *referenceObservation,
+                                           NIBFuzzerIntendedDifference differences) {
+    if (differences == NIBFuzzerIntendedDifferenceNone ||
+        observation->isException || referenceObservation->isException) {
+        return NO;
+    }
+    
+    if (observation->hasResult != referenceObservation->hasResult ||
+        observation->hasMemory != referenceObservation->hasMemory ||
+        observation->isWaitingForOperand != referenceObservation->isWaitingForOperand) {
+        return NO;
+    }
+    
+    return (!observation->hasResult || NIBFuzzerIsIntendedNumber(observation->result, referenceObservation->result, differences)) &&
+           (!observation->hasMemory || NIBFuzzerIsIntendedNumber(observation->memory, referenceObservation->memory, differences)) &&
+           NIBFuzzerIsIntendedNumber(observation->display, referenceObservation->display, differences);
+}
+
+/**
+ Check if a number of the calculator is the number of the reference or differs
+ from it as intended. The powers, the angles in degree and the factorials
+ differ by a relative rounding, sin, cos and tan in degree also by an absolute
+ rounding near 0, and a factorial of a non-integer is a number where the
+ reference has an error.
+ 
+ @param number          The number of the calculator.
+ @param referenceNumber The number of the reference.
+ @param differences     The intended differences.
+ 
+ @return Returns YES if the numbers are the same or differ as intended,
+ otherwise NO.
+ */
+static BOOL NIBFuzzerIsIntendedNumber(double number, double referenceNumber, NIBFuzzerIntendedDifference differences) {
+    if (NIBFuzzerIsSameNumber(number, referenceNumber, NIB_FUZZER_INTENDED_TOLERANCE)) {
+        return YES;
+    }
+    
+    if ((differences & NIBFuzzerIntendedDifferenceDegreeAngle) &&
+        fabs(number - referenceNumber) <= NIB_FUZZER_INTENDED_TOLERANCE) {
+        return YES;
+    }
+    
+    return (differences & NIBFuzzerIntendedDifferenceFactorial) && isnan(referenceNumber) && isfinite(number);
+}
+
+/**
+ Minimize a divergent sequence of keys on new calculators. The keys after the
+ first divergent key are dropped, the chunks of keys are removed from halves
+ down to single keys while the sequence is still divergent, which is repeated
+ until nothing can be removed, and then the numbers are replaced with simpler
+ ones.
+ 
+ @param keys        The keys, which are replaced with the minimized keys.
+ @param count       The number of keys.
+ @param tolerance   The relative difference allowed between numbers.
+ 
+ @return Returns the number of minimized keys, or 0 if the sequence is not
+ divergent on new calculators.
+ */
+static NSUInteger NIBFuzzerMinimizeSequence(NIBFuzzerKey *keys, NSUInteger count, double tolerance) {
+    static const double simpleOperands[] = {0, 1, 2, -1};
+    NIBFuzzerKey *candidate = malloc(MAX(count, 1) * sizeof(NIBFuzzerKey));
+    NSUInteger divergentIndex = 0;
+    BOOL isRemoved = YES;
+    
+    /* if the sequence depends on an earlier sequence, it can not be minimized */
+    if (NIBFuzzerCompareSequence(keys, count, tolerance, &divergentIndex, NULL, NULL) != NIBFuzzerComparisonDivergent) {
+        free(candidate);
+        return 0;
+    }
+    
+    count = divergentIndex + 1;
+    
+    while (isRemoved && count > 1) {
+        isRemoved = NO;
+        
+        for (NSUInteger chunkLength = MAX(count / 2, 1); chunkLength > 0; chunkLength /= 2) {
+            NSUInteger start = 0;
+            
+            while (start + chunkLength <= count && chunkLength < count) {
+                /* try the sequence without the chunk */
+                memcpy(candidate, keys, start * sizeof(NIBFuzzerKey));
+                memcpy(candidate + start, keys + start + chunkLength, (count - start - chunkLength) * sizeof(NIBFuzzerKey));
+                
+                if (NIBFuzzerCompareSequence(candidate, count - chunkLength, tolerance, &divergentIndex, NULL, NULL) ==
+                    NIBFuzzerComparisonDivergent) {
+                    count = divergentIndex + 1;
+                    memcpy(keys, candidate, count * sizeof(NIBFuzzerKey));
+                    isRemoved = YES;
+                } else {
+                    start += chunkLength;
+                }
+            }
+        }
+    }
+    
+    /* replace the numbers with the simplest numbers which keep the sequence divergent */
+    for (NSUInteger i = 0; i < count; i++) {
+        if (keys[i].kind != NIBFuzzerKeyKindNumber) continue;
+        
+        for (NSUInteger j = 0; j < sizeof(simpleOperands) / sizeof(double); j++) {
+            if (keys[i].operand == simpleOperands[j]) break;
+            
+            memcpy(candidate, keys, count * sizeof(NIBFuzzerKey));
+            candidate[i].operand = simpleOperands[j];
+            
+            if (NIBFuzzerCompareSequence(candidate, count, tolerance, &divergentIndex, NULL, NULL) == NIBFuzzerComparisonDivergent &&
+                divergentIndex + 1 == count) {
+                keys[i].operand = simpleOperands[j];
+                break;
+            }
+        }
+    }
+    
+    free(candidate);
+    
+    return count;
+}
+
+/**
+ Minimize a divergent sequence and write it, unless the same minimized
+ sequence is already written or the reports are used up.
+ 
+ @param run     The run.
+ @param index   The index of the sequence.
+ @param keys    The keys of the sequence.
+ @param count   The number of keys.
+ */
+static void NIBFuzzerReportSequence(NIBFuzzerRun *run, uint64_t index, const NIBFuzzerKey *keys, NSUInteger count) {
+    pthread_mutex_lock(&run->lock);
+    BOOL isReportable = run->reportedSequences.count < run->reportLimit;
+    pthread_mutex_unlock(&run->lock);
+    
+    /* if the reports are used up, only count the sequence */
+    if (!isReportable) {
+        return;
+    }
+    
+    NIBFuzzerKey *minimizedKeys = malloc(count * sizeof(NIBFuzzerKey));
+    
+    memcpy(minimizedKeys, keys, count * sizeof(NIBFuzzerKey));
+    
+    NSUInteger minimizedCount = NIBFuzzerMinimizeSequence(minimizedKeys, count, run->tolerance);
+    NSString *report;
+    NSString *sequence;
+    
+    /* if the sequence can not be reproduced on new calculators, report it as it is */
+    if (minimizedCount == 0) {
+        sequence = NIBFuzzerDescriptionOfSequence(keys, count);
+        report = [NSString stringWithFormat:@"sequence %llu of seed %llu is divergent only after earlier sequences:\n    %@\n",
+                  (unsigned long long)index, (unsigned long long)run->seed, sequence];
+    } else {
+        NIBFuzzerObservation observation;
+        NIBFuzzerObservation referenceObservation;
+        NSUInteger divergentIndex = 0;
+        
+        NIBFuzzerCompareSequence(minimizedKeys, minimizedCount, run->tolerance, &divergentIndex,
+                                 &observation, &referenceObservation);
+        
+        sequence = NIBFuzzerDescriptionOfSequence(minimizedKeys, minimizedCount);
+        report = [NSString stringWithFormat:@"sequence %llu of seed %llu is divergent, minimized from %lu to %lu keys:\n"
+                  "    %@\n"
+                  "    after key %lu %@\n"
+                  "        calculator %@\n"
+                  "        reference  %@\n",
+                  (unsigned long long)index, (unsigned long long)run->seed, (unsigned long)count,
+                  (unsigned long)minimizedCount, sequence, (unsigned long)divergentIndex + 1,
+                  NIBFuzzerDescriptionOfKey(minimizedKeys[divergentIndex]),
+                  NIBFuzzerDescriptionOfObservation(&observation),
+                  NIBFuzzerDescriptionOfObservation(&referenceObservation)];
+    }
+    
+    free(minimizedKeys);
+    
+    pthread_mutex_lock(&run->lock);
+    
+    /* write every minimized sequence once */
+    if (run->reportedSequences.count < run->reportLimit && ![run->reportedSequences containsObject:sequence]) {
+        [run->reportedSequences addObject:sequence];
+        fputs(report.UTF8String, stdout);
+        fflush(stdout);
+    }
+    
+    pthread_mutex_unlock(&run->lock);
+}
+
+/**
+ Read a sequence of keys separated by spaces.
+ 
+ @param text    The keys, which end with a null character.
+ @param keys    The keys of the sequence, which hold a key for every two
+                characters of the text.
+ @param count   The number of keys.
+ 
+ @return Returns YES if every key is known, otherwise NO.
+ */
+static BOOL NIBFuzzerParseSequence(const char *text, NIBFuzzerKey *keys, NSUInteger *count) {
+    size_t length = strlen(text);
+    size_t i = 0;
+    
+    *count = 0;
+    
+    while (i < length) {
+        /* skip the spaces between the keys */
+        if (isspace((unsigned char)text[i])) {
+            i++;
+            continue;
+        }
+        
+        size_t start = i;
+        
+        while (i < length && !isspace((unsigned char)text[i])) i++;
+        
+        const char *token = text + start;
+        size_t tokenLength = i - start;
+        NIBFuzzerKey key = {NIBFuzzerKeyKindPress, NIBButtonEquality, 0};
+        BOOL isKnown = NO;
+        
+        /* a leading question mark peeks the key */
+        if (tokenLength > 1 && token[0] == '?') {
+            key.kind = NIBFuzzerKeyKindPeek;
+            token++;
+            tokenLength--;
+        }
+        
+        for (NSUInteger j = 0; j < sizeof(NIB_FUZZER_KEYS) / sizeof(NIB_FUZZER_KEYS[0]) && !isKnown; j++) {
+            if (strncmp(NIB_FUZZER_KEYS[j].name, token, tokenLength) == 0 && NIB_FUZZER_KEYS[j].name[tokenLength] == '\0') {
+                key.tag = NIB_FUZZER_KEYS[j].tag;
+                isKnown = YES;
+            }
+        }
+        
+        /* if the token is not a key, it must be a number, which is not peeked */
+        if (!isKnown) {
+            char number[NIB_FUZZER_MAX_TOKEN_LENGTH + 1];
+            char *numberEnd = NULL;
+            
+            if (key.kind == NIBFuzzerKeyKindPeek || tokenLength > NIB_FUZZER_MAX_TOKEN_LENGTH) {
+                return NO;
+            }
+            
+            memcpy(number, token, tokenLength);
+            number[tokenLength] = '\0';
+            
+            key.kind = NIBFuzzerKeyKindNumber;
+            key.operand = strtod(number, &numberEnd);
+            
+            if (numberEnd != number + tokenLength || isnan(key.operand) || isinf(key.operand)) {
+                return NO;
+            }
+        }
+        
+        keys[(*count)++] = key;
+    }
+    
+    return YES;
+}
+
+/**
+ Press a sequence of keys on new calculators and write what both show after
+ every key. A key after which the calculators differ as intended is marked
+ with `~` and a divergent key with `!`, and the keys after either are not
+ pressed.
+ 
+ @param text        The keys separated by spaces.
+ @param tolerance   The relative difference allowed between numbers.
+ 
+ @return Returns 0 if the calculators agree, 1 if they disagree and 2 if the
+ keys can not be read.
+ */
+static int NIBFuzzerReplaySequence(const char *text, double tolerance) {
+    NIBFuzzerKey *keys = malloc((strlen(text) / 2 + 1) * sizeof(NIBFuzzerKey));
+    NSUInteger count = 0;
+    NIBFuzzerComparison comparison = NIBFuzzerComparisonSame;
+    
+    if (!NIBFuzzerParseSequence(text, keys, &count)) {
+        fprintf(stderr, "Can not read the keys %s\n", text);
+        free(keys);
+        return 2;
+    }
+    
+    // the prefixes are pressed again for every key, which costs nothing at
+    // the length of a sequence and keeps a single way to press a sequence
+    for (NSUInteger i = 1; i <= count && comparison == NIBFuzzerComparisonSame; i++) {
+        NIBFuzzerObservation observation;
+        NIBFuzzerObservation referenceObservation;
+        NSUInteger divergentIndex = 0;
+        
+        comparison = NIBFuzzerCompareSequence(keys, i, tolerance, &divergentIndex,
+                                              &observation, &referenceObservation);
+        
+        /* if the key is skipped, neither calculator shows it */
+        if (comparison == NIBFuzzerComparisonSkipped) {
+            printf("  %-8s skipped, the reference can not take the angle\n", NIBFuzzerDescriptionOfKey(keys[i - 1]).UTF8String);
+            break;
+        }
+        
+        printf("%s %-8s calculator %s\n",
+               (comparison == NIBFuzzerComparisonDivergent) ? "!" : (comparison == NIBFuzzerComparisonIntended) ? "~" : " ",
+               NIBFuzzerDescriptionOfKey(keys[i - 1]).UTF8String, NIBFuzzerDescriptionOfObservation(&observation).UTF8String);
+        printf("  %-8s reference  %s\n", "", NIBFuzzerDescriptionOfObservation(&referenceObservation).UTF8String);
+    }
+    
+    free(keys);
+    
+    return (comparison == NIBFuzzerComparisonDivergent) ? 1 : 0;
+}
+
+/**
+ Get the description of a sequence of keys as it is read by the fuzzer and by
+ `NIBCalculatorBatch`.
+ 
+ @param keys    The keys.
+ @param count   The number of keys.
+ 
+ @return Returns the keys separated by spaces.
+ */
+static NSString *NIBFuzzerDescriptionOfSequence(const NIBFuzzerKey *keys, NSUInteger count) {
+    NSMutableString *description = [NSMutableString string];
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        if (i > 0) [description appendString:@" "];
+        [description appendString:NIBFuzzerDescriptionOfKey(keys[i])];
+    }
+    
+    return description;
+}
+
+/**
+ Get the description of a key.
+ 
+ @param key The key.
+ 
+ @return Returns the name of the key, or the number.
+ */
+static NSString *NIBFuzzerDescriptionOfKey(NIBFuzzerKey key) {
+    
+    /* if the key is a number, write it with the fewest digits which read back the same */
+    if (key.kind == NIBFuzzerKeyKindNumber) {
+        char number[NIB_FUZZER_TEXT_LENGTH];
+        
+        NIBFuzzerFormatNumber(number, sizeof(number), key.operand);
+        
+        return @(number);
+    }
+    
+    for (NSUInteger i = 0; i < sizeof(NIB_FUZZER_KEYS) / sizeof(NIB_FUZZER_KEYS[0]); i++) {
+        if (NIB_FUZZER_KEYS[i].tag == key.tag) {
+            return [NSString stringWithFormat:@"%s%s", (key.kind == NIBFuzzerKeyKindPeek) ? "?" : "", NIB_FUZZER_KEYS[i].name];
+        }
+    }
+    
+    return [NSString stringWithFormat:@"#%ld", (long)key.tag];
+}
+
+/**
+ Get the description of what a calculator shows after a key.
+ 
+ @param observation What the calculator shows.
+ 
+ @return Returns the description.
+ */
+static NSString *NIBFuzzerDescriptionOfObservation(const NIBFuzzerObservation *observation) {
+    char result[NIB_FUZZER_TEXT_LENGTH] = "nil";
+    char display[NIB_FUZZER_TEXT_LENGTH];
+    char memory[NIB_FUZZER_TEXT_LENGTH] = "nil";
+    
+    if (observation->isException) {
+        return @"raises an exception";
+    }
+    
+    if (observation->hasResult) NIBFuzzerFormatNumber(result, sizeof(result), observation->result);
+    if (observation->hasMemory) NIBFuzzerFormatNumber(memory, sizeof(memory), observation->memory);
+    NIBFuzzerFormatNumber(display, sizeof(display), observation->display);
+    
+    return [NSString stringWithFormat:@"result %s, display %s, memory %s, %s", result, display, memory,
+            observation->isWaitingForOperand ? "waiting for an operand" : "not waiting"];
+}
+
+/**
+ Write a number with the fewest digits which read back the same number, or
+ `Error` if it is not a number.
+ 
+ @param buffer  The buffer of the number.
+ @param size    The size of the buffer.
+ @param number  The number.
+ */
+static void NIBFuzzerFormatNumber(char *buffer, size_t size, double number) {
+    if (isnan(number)) {
+        snprintf(buffer, size, "Error");
+        return;
+    }
+    
+    snprintf(buffer, size, "%.15g", number);
+    
+    if (strtod(buffer, NULL) != number) snprintf(buffer, size, "%.17g", number);
+}
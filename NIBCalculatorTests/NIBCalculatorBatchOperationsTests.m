@@ -0,0 +1,152 @@
+//
+//  NIBCalculatorBatchOperationsTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBConstants.h"
+
+#pragma mark -
+
+@interface NIBCalculatorBatchOperationsTests : XCTestCase
+
+@property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+
+@end
+
+#pragma mark -
+
+@implementation NIBCalculatorBatchOperationsTests
+
+- (void)setUp {
+    [super setUp];
+    self.calculator = [[NIBCalculatorBrain alloc] init];
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+    [super tearDown];
+}
+
+#pragma mark - Unary Operations Testing
+
+- (void)testUnaryOperatorsOnOperands
+{
+    NIBButtonTag operatorTags[] = { NIBButtonPercentage, NIBButtonSquareRootOfX, NIBButtonCubicRootOfX,
+                                    NIBButtonXSquared, NIBButtonXCubed, NIBButtonEulerNumberPowerX,
+                                    NIBButtonTenPowerX, NIBButtonTwoPowerX, NIBButtonSin, NIBButtonCos,
+                                    NIBButtonTan, NIBButtonSinh, NIBButtonCosh, NIBButtonTanh,
+                                    NIBButtonOneOverX, NIBButtonArcSin, NIBButtonArcCos, NIBButtonArcTan,
+                                    NIBButtonArcSinh, NIBButtonArcCosh, NIBButtonArcTanh,
+                                    NIBButtonNaturalLogarithm, NIBButtonCommonLogarithm,
+                                    NIBButtonLogarithmBaseTwo, NIBButtonXFactorial };
+    double operands[] = { 0, 1, -1, 0.5, 2, -8, 3.7, 45, 90, -270, 180, 400, 1000, 171, NAN };
+    NSUInteger count = sizeof(operands)/sizeof(operands[0]);
+    double results[sizeof(operands)/sizeof(operands[0])];
+    
+    for (NSUInteger mode = 0; mode < 2; mode++) {
+        /* test every operator in degree mode, then in radian mode */
+        if (mode == 1) [self.calculator toggleRadianMode];
+        
+        for (NSUInteger i = 0; i < sizeof(operatorTags)/sizeof(operatorTags[0]); i++) {
+            NIBOperator *operator = [NIBOperator operatorWithTag:operatorTags[i]];
+            
+            [self.calculator performOperator:operator onOperands:operands count:count results:results];
+            
+            for (NSUInteger j = 0; j < count; j++) {
+                NSNumber *expectedResult = nil;
+                NSNumber *calculatedResult = nil;
+                
+                [self.calculator clearArithmetic];
+                [self.calculator pushOperand:operands[j]];
+                expectedResult = [self.calculator performOperator:operator];
+                calculatedResult = isnan(results[j]) ? [NSDecimalNumber notANumber] : [[NSNumber alloc] initWithDouble:results[j]];
+                
+                XCTAssertEqualObjects(calculatedResult, expectedResult, @"Batch calculation %@(%g) is incorrect", operator, operands[j]);
+            }
+        }
+    }
+}
+
+- (void)testUnaryOperatorOnOperandsInPlace
+{
+    double operands[] = { 1, 4, 9, 16 };
+    
+    /* test sqrt in place */
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSquareRootOfX]
+                          onOperands:operands
+                               count:4
+                             results:operands];
+    
+    XCTAssertEqual(operands[0], 1.0, @"Batch calculation sqrt(1) in place is incorrect");
+    XCTAssertEqual(operands[1], 2.0, @"Batch calculation sqrt(4) in place is incorrect");
+    XCTAssertEqual(operands[2], 3.0, @"Batch calculation sqrt(9) in place is incorrect");
+    XCTAssertEqual(operands[3], 4.0, @"Batch calculation sqrt(16) in place is incorrect");
+}
+
+#pragma mark - Binary Operations Testing
+
+- (void)testBinaryOperatorsOnOperands
+{
+    NIBButtonTag operatorTags[] = { NIBButtonAddition, NIBButtonSubstraction, NIBButtonMultiplication,
+                                    NIBButtonDivision, NIBButtonXPowerY, NIBButtonYPowerX,
+                                    NIBButtonYthRootOfX, NIBButtonLogarithmBaseYOfX, NIBButtonEE };
+    double leftOperands[] = { 3, -8, 2.5, 0, 1e300, 100, 7, -27 };
+    double rightOperands[] = { 4, 3, 0, 0, 10, 0.5, -2, 3 };
+    NSUInteger count = sizeof(leftOperands)/sizeof(leftOperands[0]);
+    double results[sizeof(leftOperands)/sizeof(leftOperands[0])];
+    
+    for (NSUInteger i = 0; i < sizeof(operatorTags)/sizeof(operatorTags[0]); i++) {
+        NIBOperator *operator = [NIBOperator operatorWithTag:operatorTags[i]];
+        
+        [self.calculator performOperator:operator
+                          onLeftOperands:leftOperands
+                           rightOperands:rightOperands
+                                   count:count
+                                 results:results];
+        
+        for (NSUInteger j = 0; j < count; j++) {
+            NSNumber *expectedResult = nil;
+            NSNumber *calculatedResult = nil;
+            
+            [self.calculator clearArithmetic];
+            [self.calculator pushOperand:leftOperands[j]];
+            [self.calculator performOperator:operator];
+            [self.calculator pushOperand:rightOperands[j]];
+            expectedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+            calculatedResult = isnan(results[j]) ? [NSDecimalNumber notANumber] : [[NSNumber alloc] initWithDouble:results[j]];
+            
+            XCTAssertEqualObjects(calculatedResult, expectedResult, @"Batch calculation %g%@%g is incorrect", leftOperands[j], operator, rightOperands[j]);
+        }
+    }
+}
+
+- (void)testBatchOperationsWithWrongOperator
+{
+    double operands[] = { 1, 2 };
+    double results[] = { 0, 0 };
+    
+    /* test a binary operator on operands */
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]
+                          onOperands:operands
+                               count:2
+                             results:results];
+    
+    XCTAssertTrue(isnan(results[0]) && isnan(results[1]), @"Batch calculation of a binary operator on operands is incorrect");
+    
+    /* test a unary operator on pairs of operands */
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]
+                      onLeftOperands:operands
+                       rightOperands:operands
+                               count:2
+                             results:results];
+    
+    XCTAssertTrue(isnan(results[0]) && isnan(results[1]), @"Batch calculation of a unary operator on pairs of operands is incorrect");
+}
+
+@end
@@ -9,6 +9,7 @@
 #import <XCTest/XCTest.h>
 #import "NIBOperator.h"
 #import "NIBCalculatorBrain.h"
+#import "NIBCalculatorKernels.h"
 #import "NIBConstants.h"
 
 @interface NIBCalculatorCachedOperationTests : XCTestCase
@@ -103,6 +104,120 @@
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
 
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Cached 4+3*2=1= is incorrect");
+    
+    /* test 2*3=4=5= */
+    expectedResult = [[NSNumber alloc] initWithDouble:15.0];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator pushOperand:4];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator pushOperand:5];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Cached 2*3=4=5= is incorrect");
+    
+    /* test 2*3=4=8-1=5= */
+    expectedResult = [[NSNumber alloc] initWithDouble:4.0];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator pushOperand:4];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator pushOperand:8];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSubstraction]];
+    [self.calculator pushOperand:1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator pushOperand:5];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Cached 2*3=4=8-1=5= is incorrect");
+}
+
+- (void)testCachedBinaryOperationOnParenthesizedOperand {
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test peeking 2*3=(4)= */
+    expectedResult = [[NSNumber alloc] initWithDouble:12.0];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis]];
+    [self.calculator pushOperand:4];
+    [self.calculator pushOperand:[[self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonClosingParenthesis]] doubleValue]];
+    calculatedResult = [self.calculator peekOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Peeking cached 2*3=(4)= is incorrect");
+    
+    /* test 2*3=(4)= */
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Cached 2*3=(4)= is incorrect");
+    
+    /* test peeking 2*3=(4)=((5= */
+    expectedResult = [[NSNumber alloc] initWithDouble:15.0];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis]];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis]];
+    [self.calculator pushOperand:5];
+    calculatedResult = [self.calculator peekOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Peeking cached 2*3=(4)=((5= is incorrect");
+    
+    /* test 2*3=(4)=((5= */
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Cached 2*3=(4)=((5= is incorrect");
+}
+
+- (void)testMemoizedUnaryOperation {
+    NSNumber *calculatedResult = nil;
+    NIBUnaryMemoStatistics memoStatistics;
+    
+    NIBResetUnaryMemoOfCurrentThread();
+    
+    /* test sin 90 in degree, then again from the memo */
+    for (NSUInteger i = 0; i < 2; i++) {
+        [self.calculator pushOperand:90];
+        calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+        
+        XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:1.0], @"Memoized sin 90 is incorrect");
+    }
+    
+    memoStatistics = NIBUnaryMemoStatisticsOfCurrentThread();
+    XCTAssertEqual(memoStatistics.hitCount, 1, @"Hits of the unary memo are incorrect");
+    XCTAssertEqual(memoStatistics.missCount, 1, @"Misses of the unary memo are incorrect");
+    
+    /* test sin 90 in radian is not the result in degree */
+    [self.calculator toggleRadianMode];
+    [self.calculator pushOperand:90];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:NIBPerformUnaryOperator(NIBButtonSin, 90, YES)],
+                          @"Memoized sin 90 in radian is incorrect");
+    
+    /* test the memoized results of -0, 0 and NAN are the results of the kernel */
+    const double operands[] = {-0.0, 0.0, NAN, -1};
+    const NIBButtonTag operatorTags[] = {NIBButtonArcTan, NIBButtonNaturalLogarithm, NIBButtonXFactorial};
+    
+    for (NSUInteger i = 0; i < sizeof(operands) / sizeof(operands[0]); i++) {
+        for (NSUInteger j = 0; j < sizeof(operatorTags) / sizeof(operatorTags[0]); j++) {
+            double expectedResult = NIBPerformUnaryOperator(operatorTags[j], operands[i], YES);
+            double memoizedResult = NIBPerformMemoizedUnaryOperator(operatorTags[j], operands[i], YES, NO);
+            
+            XCTAssertEqual(memcmp(&memoizedResult, &expectedResult, sizeof(double)), 0, @"Memoized %@ %g is incorrect",
+                           [NIBOperator operatorWithTag:operatorTags[j]], operands[i]);
+        }
+    }
+    
+    /* test resetting the memo */
+    NIBResetUnaryMemoOfCurrentThread();
+    memoStatistics = NIBUnaryMemoStatisticsOfCurrentThread();
+    
+    XCTAssertEqual(memoStatistics.hitCount + memoStatistics.missCount, 0, @"Counters of the reset unary memo are incorrect");
 }
 
 @end
@@ -0,0 +1,248 @@
+//
+//  NIBCalculatorDecimalModeTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBConstants.h"
+#import "NIBDecimal128.h"
+
+#pragma mark -
+
+@interface NIBCalculatorDecimalModeTests : XCTestCase
+
+@property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+
+@end
+
+#pragma mark -
+
+@implementation NIBCalculatorDecimalModeTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.calculator = [[NIBCalculatorBrain alloc] init];
+    [self.calculator toggleDecimalMode];
+}
+
+#pragma mark - Decimal Arithmetic Testing
+
+- (void)testDecimalArithmetic
+{
+    NIBDecimal128 oneTenth = NIBDecimal128FromDouble(0.1);
+    NIBDecimal128 twoTenths = NIBDecimal128FromDouble(0.2);
+    NIBDecimal128 threeTenths = NIBDecimal128FromDouble(0.3);
+    NIBDecimal128 three = NIBDecimal128Make(3, 0, NO);
+    int64_t integer = 0;
+    
+    /* test 0.1 + 0.2 - 0.3 */
+    NIBDecimal128 difference = NIBDecimal128Subtract(NIBDecimal128Add(oneTenth, twoTenths), threeTenths);
+    XCTAssertEqual(NIBDecimal128ToDouble(difference), 0, @"Calculation 0.1 + 0.2 - 0.3 is incorrect");
+    
+    /* test 1 / 3 * 3, which is 0.999...9 of 34 digits */
+    NIBDecimal128 product = NIBDecimal128Multiply(NIBDecimal128Divide(NIBDecimal128Make(1, 0, NO), three), three);
+    NIBDecimal128 shortfall = NIBDecimal128Subtract(NIBDecimal128Make(1, 0, NO), product);
+    XCTAssertEqual(NIBDecimal128ToDouble(shortfall), 1e-34, @"Calculation 1 - 1/3*3 is incorrect");
+    
+    /* test 1.1^2 */
+    NIBDecimal128 power = NIBDecimal128RaiseToIntegerPower(NIBDecimal128FromDouble(1.1), 2);
+    XCTAssertEqual(NIBDecimal128ToDouble(power), 1.21, @"Calculation 1.1^2 is incorrect");
+    
+    /* test 2^-3 */
+    power = NIBDecimal128RaiseToIntegerPower(NIBDecimal128Make(2, 0, NO), -3);
+    XCTAssertEqual(NIBDecimal128ToDouble(power), 0.125, @"Calculation 2^-3 is incorrect");
+    
+    /* test 1.5EE3 is the integer 1500 */
+    XCTAssertTrue(NIBDecimal128GetInteger(NIBDecimal128ScaleByPowerOfTen(NIBDecimal128FromDouble(1.5), 3), &integer));
+    XCTAssertEqual(integer, 1500, @"Calculation 1.5EE3 is incorrect");
+    
+    /* test 1 / 0 and an overflow are not numbers */
+    XCTAssertTrue(NIBDecimal128IsNaN(NIBDecimal128Divide(three, NIBDecimal128Make(0, 0, NO))));
+    XCTAssertTrue(NIBDecimal128IsNaN(NIBDecimal128ScaleByPowerOfTen(three, 7000)));
+}
+
+- (void)testDecimalFromDouble
+{
+    const double values[] = {0, 0.1, -0.3, 1.21, 123456.789, 1e-300, -2.5e300, 1.0 / 3, 9007199254740993.0, 0.1 + 0.2};
+    
+    for (NSUInteger i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        XCTAssertEqual(NIBDecimal128ToDouble(NIBDecimal128FromDouble(values[i])), values[i],
+                       @"The decimal of %.17g does not read back to it!", values[i]);
+    }
+    
+    XCTAssertTrue(NIBDecimal128IsNaN(NIBDecimal128FromDouble(NAN)));
+    XCTAssertTrue(NIBDecimal128IsNaN(NIBDecimal128FromDouble(INFINITY)));
+}
+
+#pragma mark - Decimal Mode Testing
+
+- (void)testDecimalModeArithmetic
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    XCTAssertTrue(self.calculator.isDecimalMode);
+    
+    /* test 0.1 + 0.2 = */
+    expectedResult = [[NSNumber alloc] initWithDouble:0.3];
+    [self.calculator pushOperand:0.1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:0.2];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 0.1 + 0.2 = is incorrect");
+    
+    /* test repeating + 0.2 on 0.3 */
+    expectedResult = [[NSNumber alloc] initWithDouble:0.5];
+    [self.calculator pushOperand:0.3];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 0.3 + 0.2 = is incorrect");
+    
+    /* test 0.1 + 0.2 - 0.3 = */
+    expectedResult = [[NSNumber alloc] initWithDouble:0];
+    [self.calculator clearArithmetic];
+    [self.calculator pushOperand:0.1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:0.2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSubstraction]];
+    [self.calculator pushOperand:0.3];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 0.1 + 0.2 - 0.3 = is incorrect");
+    
+    /* test 4.35 × 100 = */
+    expectedResult = [[NSNumber alloc] initWithDouble:435];
+    [self.calculator pushOperand:4.35];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:100];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 4.35 × 100 = is incorrect");
+    
+    /* test 1.1 ^ 3 = */
+    expectedResult = [[NSNumber alloc] initWithDouble:1.331];
+    [self.calculator pushOperand:1.1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXPowerY]];
+    [self.calculator pushOperand:3];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 1.1 ^ 3 = is incorrect");
+    
+    /* test 2 ÷ 0 = */
+    expectedResult = [NSDecimalNumber notANumber];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonDivision]];
+    [self.calculator pushOperand:0];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 2 ÷ 0 = is incorrect");
+}
+
+- (void)testDecimalModeUnaryOperators
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test 1.1 squared */
+    expectedResult = [[NSNumber alloc] initWithDouble:1.21];
+    [self.calculator pushOperand:1.1];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXSquared]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 1.1 squared is incorrect");
+    
+    /* test 0.7% */
+    expectedResult = [[NSNumber alloc] initWithDouble:0.007];
+    [self.calculator pushOperand:0.7];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonPercentage]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 0.7%% is incorrect");
+    
+    /* test sin 270 in degree, which has no decimal kernel */
+    expectedResult = [[NSNumber alloc] initWithDouble:-1.0];
+    [self.calculator pushOperand:270];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation sin 270 is incorrect");
+}
+
+- (void)testDecimalModeMemory
+{
+    /* test adding 0.1 to the memory ten times */
+    for (NSUInteger i = 0; i < 10; i++) {
+        [self.calculator addToMemory:0.1];
+    }
+    
+    XCTAssertEqualObjects(self.calculator.memory, [[NSNumber alloc] initWithDouble:1.0], @"Memory of ten times 0.1 is incorrect");
+    
+    /* test subtracting 0.3 from the memory */
+    [self.calculator subtractFromMemory:0.3];
+    
+    XCTAssertEqualObjects(self.calculator.memory, [[NSNumber alloc] initWithDouble:0.7], @"Memory of 1 - 0.3 is incorrect");
+}
+
+- (void)testDecimalModeMemoryBeyondDoublePrecision
+{
+    /* test adding 0.1 and 1e16 to the memory, whose sum is not exact in a double */
+    [self.calculator addToMemory:0.1];
+    [self.calculator addToMemory:1e16];
+    
+    /* test subtracting 1e16 from the memory */
+    [self.calculator subtractFromMemory:1e16];
+    
+    XCTAssertEqualObjects(self.calculator.memory, [[NSNumber alloc] initWithDouble:0.1], @"Memory of 0.1 + 1e16 - 1e16 is incorrect");
+    
+    /* test the memory after toggling decimal mode off */
+    [self.calculator toggleDecimalMode];
+    [self.calculator addToMemory:0.2];
+    
+    XCTAssertEqualObjects(self.calculator.memory, [[NSNumber alloc] initWithDouble:0.1 + 0.2], @"Memory of 0.1 + 0.2 after toggling decimal mode off is incorrect");
+}
+
+- (void)testTogglingDecimalMode
+{
+    NSNumber *calculatedResult = nil;
+    
+    /* test the binary floating point mode after toggling decimal mode off */
+    [self.calculator toggleDecimalMode];
+    XCTAssertFalse(self.calculator.isDecimalMode);
+    
+    [self.calculator pushOperand:0.1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:0.2];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:0.1 + 0.2], @"Calculation 0.1 + 0.2 = is incorrect");
+}
+
+- (void)testTogglingDecimalModeDuringCalculation
+{
+    NSNumber *calculatedResult = nil;
+    
+    /* test 0.1 + 0.2 = toggling decimal mode off before the second operand */
+    [self.calculator pushOperand:0.1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator toggleDecimalMode];
+    [self.calculator pushOperand:0.2];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:0.1 + 0.2], @"Calculation 0.1 + 0.2 = after toggling decimal mode off is incorrect");
+    
+    /* test 0.1 + 0.2 + toggling decimal mode on before the equality */
+    [self.calculator clearArithmetic];
+    [self.calculator pushOperand:0.1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:0.2];
+    [self.calculator toggleDecimalMode];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:0.3], @"Calculation 0.1 + 0.2 = after toggling decimal mode on is incorrect");
+}
+
+@end
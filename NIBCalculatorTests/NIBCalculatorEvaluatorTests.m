@@ -0,0 +1,109 @@
+//
+//  NIBCalculatorEvaluatorTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBCalculatorEvaluator.h"
+#import "NIBCalculatorFuture.h"
+#import "NIBConstants.h"
+
+@interface NIBCalculatorEvaluatorTests : XCTestCase
+
+@property (readwrite, strong, nonatomic) NIBCalculatorEvaluator *evaluator;
+
+@end
+
+@implementation NIBCalculatorEvaluatorTests
+
+- (void)setUp {
+    [super setUp];
+    self.evaluator = [NIBCalculatorEvaluator evaluatorWithCalculator:[[NIBCalculatorBrain alloc] init]];
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+    [super tearDown];
+}
+
+- (void)testEvaluationsInOrder
+{
+    NIBCalculatorFuture *future = nil;
+    
+    /* test 2 + 3 x 4 = evaluated one key after another */
+    [self.evaluator evaluate:^id (NIBCalculatorBrain *calculator, NIBCalculatorFuture * __unused evaluation) {
+        [calculator pushOperand:2];
+        return [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    }];
+    [self.evaluator evaluate:^id (NIBCalculatorBrain *calculator, NIBCalculatorFuture * __unused evaluation) {
+        [calculator pushOperand:3];
+        return [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    }];
+    future = [self.evaluator evaluate:^id (NIBCalculatorBrain *calculator, NIBCalculatorFuture * __unused evaluation) {
+        [calculator pushOperand:4];
+        return [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    }];
+    
+    XCTAssertEqualObjects([future waitForResult], [[NSNumber alloc] initWithDouble:14], @"Evaluation 2 + 3 x 4 = is incorrect");
+    XCTAssertTrue(future.isFinished);
+    XCTAssertFalse(future.isCancelled);
+    
+    /* test the result is sent to a block */
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Result is notified"];
+    
+    [future notifyOnQueue:dispatch_get_main_queue() usingBlock:^(id result) {
+        XCTAssertEqualObjects(result, [[NSNumber alloc] initWithDouble:14]);
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+- (void)testCancellingEvaluations
+{
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    __block BOOL isSkippedEvaluationStarted = NO;
+    
+    /* hold the queue, so the next evaluations are not started when they are cancelled */
+    NIBCalculatorFuture *runningFuture = [self.evaluator evaluate:^id (NIBCalculatorBrain * __unused calculator, NIBCalculatorFuture * __unused evaluation) {
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        return @1;
+    }];
+    NIBCalculatorFuture *skippedFuture = [self.evaluator evaluate:^id (NIBCalculatorBrain * __unused calculator, NIBCalculatorFuture * __unused evaluation) {
+        isSkippedEvaluationStarted = YES;
+        return @2;
+    }];
+    [self.evaluator performChange:^(NIBCalculatorBrain *calculator) {
+        [calculator toggleRadianMode];
+    }];
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Result of cancelled future is not notified"];
+    expectation.inverted = YES;
+    
+    [skippedFuture notifyOnQueue:dispatch_get_main_queue() usingBlock:^(id __unused result) {
+        [expectation fulfill];
+    }];
+    
+    [self.evaluator cancelAllEvaluations];
+    dispatch_semaphore_signal(semaphore);
+    [self.evaluator waitUntilFinished];
+    
+    /* test the running evaluation finishes and the one which is not started is skipped */
+    XCTAssertTrue(runningFuture.isCancelled);
+    XCTAssertEqualObjects(runningFuture.result, @1, @"Running evaluation is not finished");
+    XCTAssertTrue(skippedFuture.isFinished);
+    XCTAssertNil(skippedFuture.result, @"Cancelled evaluation has a result");
+    XCTAssertFalse(isSkippedEvaluationStarted, @"Cancelled evaluation is started");
+    
+    /* test the change is not cancelled with the evaluations */
+    XCTAssertTrue(self.evaluator.calculator.isRadianMode, @"Change is cancelled");
+    
+    [self waitForExpectationsWithTimeout:0.2 handler:nil];
+}
+
+@end
@@ -12,6 +12,7 @@
 #import "NIBOperator.h"
 #import "NIBCalculatorBrain.h"
 #import "NIBConstants.h"
+#import "NIBCalculatorKernels.h"
 
 #pragma mark -
 
@@ -90,6 +91,13 @@
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonCubicRootOfX]];
     
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation cubic root of -3.5 is incorrect");
+    
+    /* test cubic root of -8 */
+    expectedResult = [[NSNumber alloc] initWithDouble:-2.0];
+    [self.calculator pushOperand:-8];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonCubicRootOfX]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation cubic root of -8 is incorrect");
 }
 
 - (void)testYthRootOfX
@@ -236,14 +244,14 @@
     NSNumber *calculatedResult = nil;
     
     /* test e^2.2 */
-    expectedResult = [[NSNumber alloc] initWithDouble:pow(M_E, 2.2)];
+    expectedResult = [[NSNumber alloc] initWithDouble:exp(2.2)];
     [self.calculator pushOperand:2.2];
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEulerNumberPowerX]];
     
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation e^(2.2) is incorrect");
     
     /* test e^(-2.2) */
-    expectedResult = [[NSNumber alloc] initWithDouble:pow(M_E, -2.2)];
+    expectedResult = [[NSNumber alloc] initWithDouble:exp(-2.2)];
     [self.calculator pushOperand:-2.2];
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEulerNumberPowerX]];
     
@@ -268,6 +276,13 @@
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonTenPowerX]];
     
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 10^(-2.3) is incorrect");
+    
+    /* test 10^(-4) */
+    expectedResult = [[NSNumber alloc] initWithDouble:1e-4];
+    [self.calculator pushOperand:-4];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonTenPowerX]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 10^(-4) is incorrect");
 }
 
 - (void)testTwoPowerX
@@ -276,14 +291,14 @@
     NSNumber *calculatedResult = nil;
     
     /* test 2^2.4 */
-    expectedResult = [[NSNumber alloc] initWithDouble:pow(2.0, 2.4)];
+    expectedResult = [[NSNumber alloc] initWithDouble:exp2(2.4)];
     [self.calculator pushOperand:2.4];
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonTwoPowerX]];
     
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 2^(2.4) is incorrect");
     
     /* test 2^(-2.4) */
-    expectedResult = [[NSNumber alloc] initWithDouble:pow(2.0, -2.4)];
+    expectedResult = [[NSNumber alloc] initWithDouble:exp2(-2.4)];
     [self.calculator pushOperand:-2.4];
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonTwoPowerX]];
     
@@ -348,6 +363,25 @@
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
     
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation e^(2.2)= (x^y) is incorrect");
+    
+    /* test 1e10^-40=, whose squares overflow before the result underflows */
+    expectedResult = [[NSNumber alloc] initWithDouble:0];
+    [self.calculator pushOperand:1e10];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXPowerY]];
+    [self.calculator pushOperand:-40];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 1e10^-40= (x^y) is incorrect");
+    
+    /* test 1e5^-64=, which is subnormal */
+    expectedResult = [[NSNumber alloc] initWithDouble:pow(1e5, -64)];
+    [self.calculator pushOperand:1e5];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXPowerY]];
+    [self.calculator pushOperand:-64];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 1e5^-64= (x^y) is incorrect");
+    XCTAssertEqualWithAccuracy(calculatedResult.doubleValue, 1e-320, 1e-323, @"Calculation 1e5^-64= (x^y) is incorrect");
 }
 
 - (void)testYPowerX
@@ -558,6 +592,67 @@
     
 }
 
+- (void)testTrigonometricExactValuesInDegreeMode
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test sin(30) */
+    expectedResult = [[NSNumber alloc] initWithDouble:0.5];
+    [self.calculator pushOperand:30];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation sin(30) in degree mode is incorrect");
+    
+    /* test sin(-210) */
+    expectedResult = [[NSNumber alloc] initWithDouble:0.5];
+    [self.calculator pushOperand:-210];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation sin(-210) in degree mode is incorrect");
+    
+    /* test cos(420) */
+    expectedResult = [[NSNumber alloc] initWithDouble:0.5];
+    [self.calculator pushOperand:420];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonCos]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation cos(420) in degree mode is incorrect");
+    
+    /* test tan(135) */
+    expectedResult = [[NSNumber alloc] initWithDouble:-1.0];
+    [self.calculator pushOperand:135];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonTan]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation tan(135) in degree mode is incorrect");
+}
+
+- (void)testTrigonometricFunctionsOfLargeAnglesInDegreeMode
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test sin(10^15), 10^15 = 280 (mod 360) */
+    expectedResult = [[NSNumber alloc] initWithDouble:-cos(10*M_PI/180)];
+    [self.calculator pushOperand:1e15];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation sin(10^15) in degree mode is incorrect");
+    
+    /* test tan(360 * 10^12 + 90) */
+    expectedResult = [NSDecimalNumber notANumber];
+    [self.calculator pushOperand:360e12 + 90];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonTan]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation tan(360 * 10^12 + 90) in degree mode is incorrect");
+    
+    /* test cos(10^300), 10^300 = 0 (mod 360) */
+    expectedResult = [[NSNumber alloc] initWithDouble:1.0];
+    [self.calculator pushOperand:1e300];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonCos]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation cos(10^300) in degree mode is incorrect");
+}
+
 - (void)testSinFunctionInRadianMode
 {
     NSNumber *expectedResult = nil;
@@ -1284,6 +1379,7 @@
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXFactorial]];
     
     XCTAssertNotEqualObjects(calculatedResult, expectedResult, @"Calculation 170! is incorrect");
+    XCTAssertEqualWithAccuracy(calculatedResult.doubleValue, 7.257415615307999e306, 1e292, @"Calculation 170! is incorrect");
     
     /* test 171! */
     expectedResult = [NSDecimalNumber notANumber];
@@ -1293,12 +1389,25 @@
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 171! is incorrect");
     
     /* test 3.14! */
-    expectedResult = [NSDecimalNumber notANumber];
+    expectedResult = [[NSNumber alloc] initWithDouble:tgamma(4.14)];
     [self.calculator pushOperand:3.14];
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXFactorial]];
     
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 3.14! is incorrect");
     
+    /* test -0.5! */
+    [self.calculator pushOperand:-0.5];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXFactorial]];
+    
+    XCTAssertEqualWithAccuracy(calculatedResult.doubleValue, sqrt(M_PI), 1e-15, @"Calculation -0.5! is incorrect");
+    
+    /* test 171.7! */
+    expectedResult = [NSDecimalNumber notANumber];
+    [self.calculator pushOperand:171.7];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXFactorial]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 171.7! is incorrect");
+    
     /* test -3! */
     expectedResult = [NSDecimalNumber notANumber];
     [self.calculator pushOperand:-3];
@@ -1307,6 +1416,23 @@
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation -3! is incorrect");
 }
 
+- (void)testLogarithmOfFactorial
+{
+    /* test ln(0!) and ln(5!) */
+    XCTAssertEqual(NIBLogarithmOfFactorial(0), 0, @"Calculation ln(0!) is incorrect");
+    XCTAssertEqualWithAccuracy(NIBLogarithmOfFactorial(5), log(120), 1e-15, @"Calculation ln(5!) is incorrect");
+    
+    /* test ln(1000!) which overflows as a factorial */
+    XCTAssertEqualWithAccuracy(NIBLogarithmOfFactorial(1000), 5912.128178488163, 1e-9, @"Calculation ln(1000!) is incorrect");
+    
+    /* test ln(200!/(198!*2!)) = ln(19900) */
+    double logOfCombination = NIBLogarithmOfFactorial(200) - NIBLogarithmOfFactorial(198) - NIBLogarithmOfFactorial(2);
+    XCTAssertEqualWithAccuracy(exp(logOfCombination), 19900, 1e-6, @"Calculation C(200, 2) is incorrect");
+    
+    /* test ln((-1)!) */
+    XCTAssertTrue(isnan(NIBLogarithmOfFactorial(-1)), @"Calculation ln((-1)!) is incorrect");
+}
+
 - (void)testScientificNotation
 {
     NSNumber *expectedResult = nil;
@@ -1347,6 +1473,15 @@
     calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
     
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 3EE5.7 is incorrect");
+    
+    /* test 1.5EE-5= */
+    expectedResult = [[NSNumber alloc] initWithDouble:1.5e-5];
+    [self.calculator pushOperand:1.5];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEE]];
+    [self.calculator pushOperand:-5];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 1.5EE-5= is incorrect");
 }
 
 - (void)testGetAConstantNumber
@@ -500,4 +500,49 @@
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation mix operation ”5+2%%=” is incorrect");
 }
 
+- (void)testMixMainOperationsInLongExpression
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test 1+2x3+4x5+...+22x23= */
+    double sum = 1;
+    [self.calculator pushOperand:1];
+    
+    for (NSInteger i = 2; i < 24; i += 2) {
+        sum += i * (i + 1);
+        [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+        [self.calculator pushOperand:i];
+        [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+        [self.calculator pushOperand:i + 1];
+    }
+    
+    expectedResult = [[NSNumber alloc] initWithDouble:sum];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator clearArithmetic];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation mix operation ”1+2x3+4x5+...+22x23=” is incorrect");
+    
+    /* test ((((((((((((1+1)+1)+1)+1)+1)+1)+1)+1)+1)+1)+1)+1)x2= */
+    for (NSInteger i = 0; i < 12; i++) {
+        [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis]];
+    }
+    
+    [self.calculator pushOperand:1];
+    
+    for (NSInteger i = 0; i < 12; i++) {
+        [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+        [self.calculator pushOperand:1];
+        [self.calculator pushOperand:[[self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonClosingParenthesis]] doubleValue]];
+    }
+    
+    expectedResult = [[NSNumber alloc] initWithDouble:26];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:2];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator clearArithmetic];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation mix operation ”((((((((((((1+1)+1)...+1)x2=” is incorrect");
+}
+
 @end
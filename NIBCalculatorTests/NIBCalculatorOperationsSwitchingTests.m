@@ -193,5 +193,91 @@
     XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation switching ”2/(2*3*” is incorrect!");
 }
 
+- (void)testOperationsSwitchingInExperimentalMode
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test experimental = on 2x(3+4 does not change 2x(3+4= */
+    expectedResult = [[NSNumber alloc] initWithDouble:14];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis]];
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:4];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality] withExperimentalModeOn:YES];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The experimental operation ”2x(3+4=” is incorrect!");
+    
+    XCTAssertTrue(![self.calculator isWaitingForOperandInInfixExpression], @"The experimental operation ”2x(3+4=” changes the expression!");
+    
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator clearArithmetic];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation ”2x(3+4=” after experimental operation is incorrect!");
+    
+    /* test experimental x on 2+ does not change 2+3= */
+    expectedResult = [[NSNumber alloc] initWithDouble:5];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication] withExperimentalModeOn:YES];
+    
+    XCTAssertTrue([self.calculator isWaitingForOperandInInfixExpression], @"The experimental operation ”2+x” changes the expression!");
+    
+    [self.calculator pushOperand:3];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator clearArithmetic];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation ”2+3=” after experimental operation is incorrect!");
+}
+
+
+- (void)testOperationsSwitchingToHigherPriority
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test operation switching 2x3+^ */
+    expectedResult = [[NSNumber alloc] initWithDouble:3];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXPowerY]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation switching ”2x3+^” is incorrect!");
+    
+    /* test operation switching 2x3+^2= */
+    expectedResult = [[NSNumber alloc] initWithDouble:2*pow(3, 2)];
+    [self.calculator pushOperand:2];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator clearArithmetic];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation switching ”2x3+^2=” is incorrect!");
+    
+    /* test operation switching 1+(2x3-x4) */
+    expectedResult = [[NSNumber alloc] initWithDouble:2*3*4];
+    [self.calculator pushOperand:1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis]];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSubstraction]];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:4];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonClosingParenthesis]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation switching ”1+(2x3-x4)” is incorrect!");
+    
+    /* test operation switching 1+(2x3-x4)= */
+    expectedResult = [[NSNumber alloc] initWithDouble:1+2*3*4];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator clearArithmetic];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation switching ”1+(2x3-x4)=” is incorrect!");
+}
+
 
 @end
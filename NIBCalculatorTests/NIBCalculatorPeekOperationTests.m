@@ -0,0 +1,116 @@
+//
+//  NIBCalculatorPeekOperationTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBConstants.h"
+
+#pragma mark -
+
+@interface NIBCalculatorPeekOperationTests : XCTestCase
+
+@property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+
+@end
+
+#pragma mark -
+
+@implementation NIBCalculatorPeekOperationTests
+
+- (void)setUp {
+    [super setUp];
+    self.calculator = [[NIBCalculatorBrain alloc] init];
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+    [super tearDown];
+}
+
+#pragma mark - Peek Operation Testing
+
+- (void)testPeekOperatorBeforePerformingIt
+{
+    // the key presses of 1+(2x3-x4)^2/(5+6)^2=, an operand is pushed before
+    // every operator which has a non negative operand. The result of a closing
+    // parenthesis or a unary operator is pushed as the controller does
+    double operands[] = { 1, -1, 2, 3, -1, 4, 24, 2, -1, 5, 6, 11, 121 };
+    NIBButtonTag operatorTags[] = { NIBButtonAddition, NIBButtonOpenningParenthesis, NIBButtonMultiplication,
+                                    NIBButtonSubstraction, NIBButtonMultiplication, NIBButtonClosingParenthesis,
+                                    NIBButtonXPowerY, NIBButtonDivision, NIBButtonOpenningParenthesis,
+                                    NIBButtonAddition, NIBButtonClosingParenthesis, NIBButtonXSquared,
+                                    NIBButtonEquality };
+    
+    for (NSUInteger i = 0; i < sizeof(operatorTags)/sizeof(operatorTags[0]); i++) {
+        NIBOperator *operator = [NIBOperator operatorWithTag:operatorTags[i]];
+        
+        if (operands[i] >= 0) [self.calculator pushOperand:operands[i]];
+        
+        /* test peeking twice does not change the result */
+        NSNumber *peekedResult = [self.calculator peekOperator:operator];
+        
+        XCTAssertEqualObjects([self.calculator peekOperator:operator], peekedResult, @"The peek operation %@ changes the expression!", operator);
+        
+        /* test the peeked result is the performed result */
+        NSNumber *calculatedResult = [self.calculator performOperator:operator];
+        
+        XCTAssertEqualObjects(peekedResult, calculatedResult, @"The peek operation %@ is incorrect!", operator);
+    }
+}
+
+- (void)testPeekOperatorDoesNotChangeArithmeticCache
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test peek = on 2x3 then 4 does not change the arithmetic cache x3 */
+    expectedResult = [[NSNumber alloc] initWithDouble:12];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator pushOperand:4];
+    [self.calculator peekOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    [self.calculator clearArithmetic];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation ”4=” after peek operation is incorrect!");
+    
+    /* test peek + on 2x3 does not reduce 2x3^2= */
+    expectedResult = [[NSNumber alloc] initWithDouble:2*pow(3, 2)];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:3];
+    
+    XCTAssertEqualObjects([self.calculator peekOperator:[NIBOperator operatorWithTag:NIBButtonAddition]], [[NSNumber alloc] initWithDouble:6], @"The peek operation ”2x3+” is incorrect!");
+    
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXPowerY]];
+    [self.calculator pushOperand:2];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"The operation ”2x3^2=” after peek operation is incorrect!");
+}
+
+- (void)testPeekOperatorWithResult
+{
+    double result = 0;
+    
+    /* test result of 1234.5x2+ */
+    [self.calculator pushOperand:1234.5];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:2];
+    
+    XCTAssertTrue([self.calculator peekOperator:[NIBOperator operatorWithTag:NIBButtonAddition] withResult:&result], @"The peek operation ”1234.5x2+” should have a result!");
+    XCTAssertEqual(result, 2469, @"The result of peek operation ”1234.5x2+” is incorrect!");
+    
+    /* test result of 1234.5x2( */
+    XCTAssertFalse([self.calculator peekOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis] withResult:&result], @"The peek operation ”1234.5x2(” should have no result!");
+}
+
+@end
@@ -0,0 +1,150 @@
+//
+//  NIBCalculatorProgramTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBCalculatorProgram.h"
+#import "NIBConstants.h"
+
+@interface NIBCalculatorProgramTests : XCTestCase
+
+@property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+
+@end
+
+@implementation NIBCalculatorProgramTests
+
+- (void)setUp {
+    [super setUp];
+    self.calculator = [[NIBCalculatorBrain alloc] init];
+}
+
+- (void)tearDown {
+    // Put teardown code here. This method is called after the invocation of each test method in the class.
+    [super tearDown];
+}
+
+- (void)testProgramFromInfixExpression
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test 2+3x(4-1)^2 */
+    NIBToken infixExp[] = { NIBTokenMakeOperand(2),
+                            NIBTokenMakeOperator(NIBButtonAddition),
+                            NIBTokenMakeOperand(3),
+                            NIBTokenMakeOperator(NIBButtonMultiplication),
+                            NIBTokenMakeOperator(NIBButtonOpenningParenthesis),
+                            NIBTokenMakeOperand(4),
+                            NIBTokenMakeOperator(NIBButtonSubstraction),
+                            NIBTokenMakeOperand(1),
+                            NIBTokenMakeOperator(NIBButtonClosingParenthesis),
+                            NIBTokenMakeOperator(NIBButtonXPowerY),
+                            NIBTokenMakeOperand(2) };
+    NIBCalculatorProgram *program = [self.calculator programWithInfixExpression:infixExp
+                                                                          count:sizeof(infixExp)/sizeof(infixExp[0])];
+    
+    XCTAssertEqual(program.numberOfOperands, (NSUInteger)5, @"Number of operands of program 2+3x(4-1)^2 is incorrect");
+    
+    expectedResult = [[NSNumber alloc] initWithDouble:2+3*pow(4-1, 2)];
+    calculatedResult = [program resultWithOperands:NULL];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Program 2+3x(4-1)^2 is incorrect");
+    
+    /* test 1+5x(7-4)^3 */
+    double operands[] = {1, 5, 7, 4, 3};
+    expectedResult = [[NSNumber alloc] initWithDouble:1+5*pow(7-4, 3)];
+    calculatedResult = [program resultWithOperands:operands];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Program 2+3x(4-1)^2 with operands 1, 5, 7, 4, 3 is incorrect");
+    
+    /* test 1+5x(7-4)^-0.5 */
+    operands[4] = -0.5;
+    expectedResult = [[NSNumber alloc] initWithDouble:1+5*pow(7-4, -0.5)];
+    calculatedResult = [program resultWithOperands:operands];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Program 2+3x(4-1)^2 with operands 1, 5, 7, 4, -0.5 is incorrect");
+    
+    /* test 1+5x(3-3)^-1 */
+    operands[2] = 3;
+    operands[3] = 3;
+    operands[4] = -1;
+    expectedResult = [NSDecimalNumber notANumber];
+    calculatedResult = [program resultWithOperands:operands];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Program 2+3x(4-1)^2 with operands 1, 5, 3, 3, -1 is incorrect");
+}
+
+- (void)testProgramFromInfixExpressionOfCalculator
+{
+    NSNumber *expectedResult = nil;
+    NSNumber *calculatedResult = nil;
+    
+    /* test 8/2-1 */
+    [self.calculator pushOperand:8];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonDivision]];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSubstraction]];
+    [self.calculator pushOperand:1];
+    
+    NIBCalculatorProgram *program = [self.calculator programFromInfixExpression];
+    
+    expectedResult = [[NSNumber alloc] initWithDouble:8.0/2-1];
+    calculatedResult = [program resultWithOperands:NULL];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Program 8/2-1 is incorrect");
+    
+    /* the infix expression of the calculator is not modified */
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, expectedResult, @"Calculation 8/2-1= after compiling program is incorrect");
+    
+    /* test empty program */
+    program = [self.calculator programFromInfixExpression];
+    
+    XCTAssertNil([program resultWithOperands:NULL], @"Empty program has a result");
+}
+
+- (void)testProgramEvaluationOverManyOperands
+{
+    /* test x/y+1 */
+    NIBToken infixExp[] = { NIBTokenMakeOperand(0),
+                            NIBTokenMakeOperator(NIBButtonDivision),
+                            NIBTokenMakeOperand(0),
+                            NIBTokenMakeOperator(NIBButtonAddition),
+                            NIBTokenMakeOperand(1) };
+    NIBCalculatorProgram *program = [self.calculator programWithInfixExpression:infixExp
+                                                                          count:sizeof(infixExp)/sizeof(infixExp[0])];
+    
+    const NSUInteger count = 1000;
+    double *operands = malloc(count * program.numberOfOperands * sizeof(double));
+    double *results = malloc(count * sizeof(double));
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        operands[i * 3] = (double)i;
+        operands[i * 3 + 1] = (double)(i % 10);
+        operands[i * 3 + 2] = 1;
+    }
+    
+    [program evaluateWithOperands:operands count:count results:results];
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        /* if the divisor is zero, result is not a number */
+        if (i % 10 == 0) {
+            XCTAssertTrue(isnan(results[i]), @"Program x/y+1 with y = 0 is a number");
+        } else {
+            XCTAssertEqual(results[i], (double)i/(i % 10) + 1, @"Program x/y+1 is incorrect");
+        }
+    }
+    
+    free(operands);
+    free(results);
+}
+
+@end
@@ -0,0 +1,161 @@
+//
+//  NIBCalculatorSnapshotTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBCalculatorSnapshot.h"
+#import "NIBConstants.h"
+
+#pragma mark -
+
+@interface NIBCalculatorSnapshotTests : XCTestCase
+
+@property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+@property (readwrite, copy, nonatomic) NSString *path;
+
+/**
+ Get the length of the snapshot file.
+ 
+ @return Returns the length of the file in bytes.
+ */
+- (unsigned long long)fileLength;
+
+@end
+
+#pragma mark -
+
+@implementation NIBCalculatorSnapshotTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.calculator = [[NIBCalculatorBrain alloc] init];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:NULL];
+    [super tearDown];
+}
+
+#pragma mark - Snapshot Testing
+
+- (void)testRestoringCalculationInProgress
+{
+    NIBCalculatorSnapshot *snapshot = [NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path];
+    NSNumber *calculatedResult = nil;
+    
+    /* save 2 + 3 x in radian mode with 5 in the memory */
+    [self.calculator toggleRadianMode];
+    [self.calculator addToMemory:5];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator writeStateToSnapshot:snapshot];
+    [snapshot save];
+    [snapshot waitUntilSaved];
+    
+    /* test the calculation continues on a new calculator */
+    NIBCalculatorBrain *restoredCalculator = [[NIBCalculatorBrain alloc] init];
+    
+    XCTAssertTrue([restoredCalculator readStateFromSnapshot:[NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path]]);
+    XCTAssertTrue(restoredCalculator.isRadianMode);
+    XCTAssertEqualObjects(restoredCalculator.memory, [[NSNumber alloc] initWithDouble:5], @"Restored memory is incorrect");
+    
+    [restoredCalculator pushOperand:4];
+    calculatedResult = [restoredCalculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:14], @"Restored calculation 2 + 3 x 4 = is incorrect");
+    
+    /* test the arithmetic cache is restored with it, x 4 is repeated */
+    NIBCalculatorSnapshot *resultSnapshot = [NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path];
+    
+    [restoredCalculator writeStateToSnapshot:resultSnapshot];
+    [resultSnapshot save];
+    [resultSnapshot waitUntilSaved];
+    
+    restoredCalculator = [[NIBCalculatorBrain alloc] init];
+    [restoredCalculator readStateFromSnapshot:[NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path]];
+    [restoredCalculator pushOperand:14];
+    calculatedResult = [restoredCalculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:56], @"Restored repeating x 4 on 14 is incorrect");
+}
+
+- (void)testSavingChangedFields
+{
+    NIBCalculatorSnapshot *snapshot = [NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path];
+    
+    [self.calculator writeStateToSnapshot:snapshot];
+    [snapshot save];
+    [snapshot waitUntilSaved];
+    
+    unsigned long long fileLength = [self fileLength];
+    
+    /* test saving without changes does not write */
+    [self.calculator writeStateToSnapshot:snapshot];
+    [snapshot save];
+    [snapshot waitUntilSaved];
+    
+    XCTAssertEqual([self fileLength], fileLength, @"Saving without changes writes the snapshot");
+    
+    /* test saving a new memory appends only the memory, a record header and a double */
+    [self.calculator addToMemory:7];
+    [self.calculator writeStateToSnapshot:snapshot];
+    [snapshot save];
+    [snapshot waitUntilSaved];
+    
+    XCTAssertEqual([self fileLength], fileLength + 12 + sizeof(double), @"Saving a new memory writes more than the memory");
+    
+    /* test the last record of the memory is read */
+    NIBCalculatorBrain *restoredCalculator = [[NIBCalculatorBrain alloc] init];
+    
+    XCTAssertTrue([restoredCalculator readStateFromSnapshot:[NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path]]);
+    XCTAssertEqualObjects(restoredCalculator.memory, [[NSNumber alloc] initWithDouble:7], @"Restored memory is incorrect");
+}
+
+- (void)testReadingDamagedSnapshot
+{
+    NIBCalculatorSnapshot *snapshot = [NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path];
+    
+    [self.calculator addToMemory:3];
+    [self.calculator writeStateToSnapshot:snapshot];
+    [snapshot save];
+    [snapshot waitUntilSaved];
+    
+    /* test a record cut short at the end is ignored */
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingAtPath:self.path];
+    const uint8_t cutRecord[] = {2, 0, 0, 0, 8, 0, 0, 0, 1, 2, 3};
+    
+    [fileHandle seekToEndOfFile];
+    [fileHandle writeData:[NSData dataWithBytes:cutRecord length:sizeof(cutRecord)]];
+    [fileHandle closeFile];
+    
+    NIBCalculatorBrain *restoredCalculator = [[NIBCalculatorBrain alloc] init];
+    
+    XCTAssertTrue([restoredCalculator readStateFromSnapshot:[NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path]]);
+    XCTAssertEqualObjects(restoredCalculator.memory, [[NSNumber alloc] initWithDouble:3], @"Restored memory is incorrect");
+    
+    /* test a file which is not a snapshot has no state */
+    [[@"not a snapshot" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:self.path atomically:YES];
+    
+    XCTAssertFalse([restoredCalculator readStateFromSnapshot:[NIBCalculatorSnapshot snapshotWithContentsOfFile:self.path]]);
+    XCTAssertEqualObjects(restoredCalculator.memory, [[NSNumber alloc] initWithDouble:3], @"Calculator is modified by a damaged snapshot");
+}
+
+#pragma mark - Helpers
+
+- (unsigned long long)fileLength
+{
+    return [[[NSFileManager defaultManager] attributesOfItemAtPath:self.path error:NULL] fileSize];
+}
+
+@end
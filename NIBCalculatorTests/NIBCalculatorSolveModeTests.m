@@ -0,0 +1,292 @@
+//
+//  NIBCalculatorSolveModeTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBCalculatorKernels.h"
+#import "NIBCalculatorTape.h"
+#import "NIBConstants.h"
+
+#pragma mark -
+
+@interface NIBCalculatorSolveModeTests : XCTestCase
+
+@property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+
+@end
+
+#pragma mark -
+
+@implementation NIBCalculatorSolveModeTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.calculator = [[NIBCalculatorBrain alloc] init];
+}
+
+#pragma mark - Dual Kernels Testing
+
+- (void)testDualKernels
+{
+    NIBDual result;
+    
+    /* test x^2 at 3 */
+    result = NIBPerformDualUnaryOperator(NIBButtonXSquared, NIBDualMake(3, 1), NO);
+    XCTAssertEqual(result.value, 9, @"Value of x^2 at 3 is incorrect");
+    XCTAssertEqual(result.derivative, 6, @"Derivative of x^2 at 3 is incorrect");
+    
+    /* test sin at 60 degrees, the derivative is per degree */
+    result = NIBPerformDualUnaryOperator(NIBButtonSin, NIBDualMake(60, 1), NO);
+    XCTAssertEqualWithAccuracy(result.derivative, 0.5*M_PI/180, 1e-15, @"Derivative of sin at 60 degrees is incorrect");
+    
+    /* test ln at 2 */
+    result = NIBPerformDualUnaryOperator(NIBButtonNaturalLogarithm, NIBDualMake(2, 1), YES);
+    XCTAssertEqual(result.derivative, 0.5, @"Derivative of ln at 2 is incorrect");
+    
+    /* test x! at 3, which is 3!*digamma(4) */
+    result = NIBPerformDualUnaryOperator(NIBButtonXFactorial, NIBDualMake(3, 1), YES);
+    XCTAssertEqualWithAccuracy(result.derivative, 6*(1 + 1.0/2 + 1.0/3 - 0.57721566490153286), 1e-12, @"Derivative of x! at 3 is incorrect");
+    
+    /* test a constant operand, which has no derivative */
+    result = NIBPerformDualUnaryOperator(NIBButtonTan, NIBDualMake(1, 0), YES);
+    XCTAssertEqual(result.derivative, 0, @"Derivative of a constant is incorrect");
+    
+    /* test x^y at 2^3 with respect to x and y */
+    result = NIBPerformDualBinaryOperator(NIBButtonXPowerY, NIBDualMake(2, 1), NIBDualMake(3, 0));
+    XCTAssertEqual(result.derivative, 12, @"Derivative of x^3 at 2 is incorrect");
+    
+    result = NIBPerformDualBinaryOperator(NIBButtonXPowerY, NIBDualMake(2, 0), NIBDualMake(3, 1));
+    XCTAssertEqualWithAccuracy(result.derivative, 8*M_LN2, 1e-14, @"Derivative of 2^y at 3 is incorrect");
+    
+    /* test division with respect to the divisor */
+    result = NIBPerformDualBinaryOperator(NIBButtonDivision, NIBDualMake(1, 0), NIBDualMake(4, 1));
+    XCTAssertEqual(result.derivative, -1.0/16, @"Derivative of 1/y at 4 is incorrect");
+    
+    /* test x^y with respect to y at a negative base, which is not real */
+    result = NIBPerformDualBinaryOperator(NIBButtonXPowerY, NIBDualMake(-2, 0), NIBDualMake(3, 1));
+    XCTAssertTrue(isnan(result.derivative), @"Derivative of (-2)^y at 3 is incorrect");
+}
+
+- (void)testDualPostfixExpression
+{
+    NIBDual result;
+    
+    /* test sin(x) * x at 90 degrees, an unary operator in the expression is performed on the top of the stack */
+    NIBToken postfixExp[] = {
+        NIBTokenMakeOperand(0),
+        NIBTokenMakeOperator(NIBButtonSin),
+        NIBTokenMakeOperand(90),
+        NIBTokenMakeOperator(NIBButtonMultiplication)
+    };
+    
+    XCTAssertTrue(NIBEvaluateDualPostfixExpression(postfixExp, 4, 0, 90, NO, &result));
+    XCTAssertEqual(result.value, 90, @"Value of sin(x) * 90 at 90 degrees is incorrect");
+    XCTAssertEqualWithAccuracy(result.derivative, 0, 1e-15, @"Derivative of sin(x) * 90 at 90 degrees is incorrect");
+    
+    /* test the same expression with respect to the second operand */
+    XCTAssertTrue(NIBEvaluateDualPostfixExpression(postfixExp, 4, 1, 2, NO, &result));
+    XCTAssertEqual(result.value, 0, @"Value of sin(0) * y at 2 is incorrect");
+    XCTAssertEqual(result.derivative, 0, @"Derivative of sin(0) * y at 2 is incorrect");
+}
+
+#pragma mark - Solver Testing
+
+- (void)testSolver
+{
+    double root = NAN;
+    NSUInteger passCount = 0;
+    
+    /* test x*2+3 = 11, a linear expression is solved by one Newton step */
+    NIBToken linearExp[] = {
+        NIBTokenMakeOperand(1),
+        NIBTokenMakeOperand(2),
+        NIBTokenMakeOperator(NIBButtonMultiplication),
+        NIBTokenMakeOperand(3),
+        NIBTokenMakeOperator(NIBButtonAddition)
+    };
+    
+    XCTAssertTrue(NIBSolvePostfixExpression(linearExp, 5, 0, 11, 1, NO, &root, &passCount));
+    XCTAssertEqual(root, 4, @"Root of x*2+3 = 11 is incorrect");
+    XCTAssertLessThanOrEqual(passCount, 3, @"Solving x*2+3 = 11 takes too many passes");
+    
+    /* test sin(x) = 0.5 in degree from 10 */
+    NIBToken sinExp[] = {NIBTokenMakeOperand(10), NIBTokenMakeOperator(NIBButtonSin)};
+    
+    XCTAssertTrue(NIBSolvePostfixExpression(sinExp, 2, 0, 0.5, 10, NO, &root, &passCount));
+    XCTAssertEqualWithAccuracy(root, 30, 1e-12, @"Root of sin(x) = 0.5 is incorrect");
+    XCTAssertLessThanOrEqual(passCount, 8, @"Solving sin(x) = 0.5 takes too many passes");
+    
+    /* test ln(x) = 1 from -5, which is not in the domain */
+    NIBToken lnExp[] = {NIBTokenMakeOperand(-5), NIBTokenMakeOperator(NIBButtonNaturalLogarithm)};
+    
+    XCTAssertTrue(NIBSolvePostfixExpression(lnExp, 2, 0, 1, -5, YES, &root, NULL));
+    XCTAssertEqualWithAccuracy(root, M_E, 1e-14, @"Root of ln(x) = 1 is incorrect");
+    
+    /* test x^2 = 2 from 0, where the derivative is zero */
+    NIBToken squareExp[] = {NIBTokenMakeOperand(0), NIBTokenMakeOperator(NIBButtonXSquared)};
+    
+    XCTAssertTrue(NIBSolvePostfixExpression(squareExp, 2, 0, 2, 0, YES, &root, NULL));
+    XCTAssertEqualWithAccuracy(fabs(root), M_SQRT2, 1e-15, @"Root of x^2 = 2 is incorrect");
+    
+    /* test x^2 = -1, which has no root */
+    XCTAssertFalse(NIBSolvePostfixExpression(squareExp, 2, 0, -1, 1, YES, &root, NULL));
+    XCTAssertTrue(isnan(root), @"Root of x^2 = -1 is incorrect");
+    
+    /* test 1/x = 0, which has a pole and no root */
+    NIBToken inverseExp[] = {NIBTokenMakeOperand(1), NIBTokenMakeOperator(NIBButtonOneOverX)};
+    
+    XCTAssertFalse(NIBSolvePostfixExpression(inverseExp, 2, 0, 0, 1, YES, &root, NULL));
+    XCTAssertTrue(isnan(root), @"Root of 1/x = 0 is incorrect");
+}
+
+#pragma mark - Solve Mode Testing
+
+- (void)testSolvingUnknown
+{
+    NSNumber *calculatedResult = nil;
+    
+    /* test x*2+3 = 11 */
+    [self.calculator pushUnknown:1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:3];
+    
+    XCTAssertTrue([self.calculator hasUnknownInInfixExpression]);
+    
+    calculatedResult = [self.calculator solveForTarget:11];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:4], @"Solving x*2+3 = 11 is incorrect");
+    XCTAssertFalse([self.calculator hasUnknownInInfixExpression]);
+    
+    /* test 3+2*x = 11, the unknown is not the first operand */
+    [self.calculator pushOperand:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushUnknown:1];
+    calculatedResult = [self.calculator solveForTarget:11];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:4], @"Solving 3+2*x = 11 is incorrect");
+}
+
+- (void)testSolvingUnknownOfUnaryOperator
+{
+    NSNumber *calculatedResult = nil;
+    
+    /* test sin(x) = 0.5 in degree, the result of the unknown is pushed back as the unknown */
+    [self.calculator pushUnknown:10];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+    [self.calculator pushUnknown:calculatedResult.doubleValue];
+    calculatedResult = [self.calculator solveForTarget:0.5];
+    
+    XCTAssertEqualWithAccuracy(calculatedResult.doubleValue, 30, 1e-12, @"Solving sin(x) = 0.5 is incorrect");
+    
+    /* test 2*sqrt(x) = 6 */
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushUnknown:1];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSquareRootOfX]];
+    [self.calculator pushUnknown:calculatedResult.doubleValue];
+    calculatedResult = [self.calculator solveForTarget:6];
+    
+    XCTAssertEqualWithAccuracy(calculatedResult.doubleValue, 9, 1e-12, @"Solving 2*sqrt(x) = 6 is incorrect");
+}
+
+- (void)testSolvingUnknownInParentheses
+{
+    NSNumber *calculatedResult = nil;
+    
+    /* test (x+1)*2 = 10 */
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis]];
+    [self.calculator pushUnknown:3];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:1];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonClosingParenthesis]];
+    [self.calculator pushUnknown:calculatedResult.doubleValue];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:2];
+    calculatedResult = [self.calculator solveForTarget:10];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:4], @"Solving (x+1)*2 = 10 is incorrect");
+}
+
+- (void)testEqualityAfterSolving
+{
+    NIBTokenBuffer expression = {NULL, 0, 0};
+    NSNumber *calculatedResult = nil;
+    double result = 0;
+    
+    self.calculator.tape = [NIBCalculatorTape tapeWithCapacity:4 contentsOfFile:nil];
+    
+    /* test x*2+3 = 11 is recorded at the root */
+    [self.calculator pushUnknown:1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonMultiplication]];
+    [self.calculator pushOperand:2];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:3];
+    [self.calculator solveForTarget:11];
+    
+    XCTAssertEqual(self.calculator.tape.count, 1);
+    XCTAssertTrue([self.calculator.tape getEntryAtIndex:0 expression:&expression result:&result]);
+    XCTAssertEqual(expression.count, 5);
+    XCTAssertEqual(expression.tokens[0].operand, 4);
+    XCTAssertEqual(result, 11);
+    
+    /* test the equality repeats + 3 on the next operand, as it does after x*2+3= */
+    [self.calculator pushOperand:10];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:13], @"Equality after solving x*2+3 = 11 is incorrect");
+    XCTAssertEqual(self.calculator.tape.count, 2);
+    
+    /* test sin(x) = 0.5 is recorded with the sine of the root */
+    NIBTokenBufferTruncate(&expression, 0);
+    [self.calculator pushUnknown:10];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonSin]];
+    [self.calculator pushUnknown:calculatedResult.doubleValue];
+    [self.calculator solveForTarget:0.5];
+    
+    XCTAssertTrue([self.calculator.tape getEntryAtIndex:2 expression:&expression result:&result]);
+    XCTAssertEqual(expression.count, 1);
+    XCTAssertEqualWithAccuracy(result, 0.5, 1e-15, @"Recording sin(x) = 0.5 is incorrect");
+    
+    NIBTokenBufferFree(&expression);
+}
+
+- (void)testSolvingWithoutRoot
+{
+    NSNumber *calculatedResult = nil;
+    
+    /* test x^2 = -1 */
+    [self.calculator pushUnknown:1];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonXSquared]];
+    [self.calculator pushUnknown:calculatedResult.doubleValue];
+    calculatedResult = [self.calculator solveForTarget:-1];
+    
+    XCTAssertEqualObjects(calculatedResult, [NSDecimalNumber notANumber], @"Solving x^2 = -1 is incorrect");
+    
+    /* test 1+2 = 5 without unknown */
+    [self.calculator pushOperand:1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [self.calculator pushOperand:2];
+    
+    XCTAssertFalse([self.calculator hasUnknownInInfixExpression]);
+    XCTAssertNil([self.calculator solveForTarget:5], @"Solving without unknown is incorrect");
+    
+    /* test x+ = 5 waiting for an operand */
+    [self.calculator clearArithmetic];
+    [self.calculator pushUnknown:1];
+    [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    
+    XCTAssertNil([self.calculator solveForTarget:5], @"Solving an expression waiting for an operand is incorrect");
+}
+
+@end
@@ -0,0 +1,132 @@
+//
+//  NIBCalculatorStackTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBCalculatorStack.h"
+
+@interface NIBCalculatorStackTests : XCTestCase
+
+@end
+
+@implementation NIBCalculatorStackTests
+
+#pragma mark - Stack Testing
+
+- (void)testPushingBeyondInlineStorage
+{
+    NIBCalculatorStack<NSNumber *> *stack = [[NIBCalculatorStack alloc] init];
+    const NSUInteger depth = NIB_STACK_INLINE_CAPACITY * 4 + 1;
+    
+    XCTAssertNil([stack pop]);
+    XCTAssertNil([stack peek]);
+    
+    for (NSUInteger i = 0; i < depth; i++) {
+        [stack push:@(i)];
+    }
+    
+    XCTAssertEqual(stack.count, depth);
+    XCTAssertEqualObjects([stack peek], @(depth - 1));
+    
+    /* test the objects are popped in reverse order across the inline storage */
+    for (NSUInteger i = depth; i > 0; i--) {
+        XCTAssertEqualObjects([stack pop], @(i - 1));
+    }
+    
+    XCTAssertEqual(stack.count, 0);
+    XCTAssertNil([stack pop]);
+}
+
+- (void)testReleasingObjects
+{
+    NIBCalculatorStack<NSObject *> *stack = [[NIBCalculatorStack alloc] init];
+    __weak NSObject *inlineObject = nil;
+    __weak NSObject *heapObject = nil;
+    
+    @autoreleasepool {
+        NSObject *object = [[NSObject alloc] init];
+        
+        inlineObject = object;
+        [stack push:object];
+        
+        for (NSUInteger i = 0; i < NIB_STACK_INLINE_CAPACITY; i++) {
+            [stack push:[[NSObject alloc] init]];
+        }
+        
+        heapObject = [stack peek];
+    }
+    
+    /* test the stack keeps its objects after it grows */
+    XCTAssertNotNil(inlineObject);
+    XCTAssertNotNil(heapObject);
+    
+    @autoreleasepool {
+        [stack pop];
+    }
+    
+    XCTAssertNil(heapObject, @"Popped object is not released");
+    
+    @autoreleasepool {
+        [stack clear];
+    }
+    
+    XCTAssertNil(inlineObject, @"Cleared object is not released");
+    XCTAssertEqual(stack.count, 0);
+}
+
+- (void)testCopying
+{
+    NIBCalculatorStack<NSNumber *> *stack = [[NIBCalculatorStack alloc] init];
+    
+    for (NSUInteger i = 0; i < NIB_STACK_INLINE_CAPACITY + 8; i++) {
+        [stack push:@(i)];
+    }
+    
+    NIBCalculatorStack<NSNumber *> *copiedStack = [stack copy];
+    
+    /* test the copy does not change with the stack */
+    [stack clear];
+    
+    XCTAssertEqual(copiedStack.count, NIB_STACK_INLINE_CAPACITY + 8);
+    XCTAssertEqualObjects([copiedStack pop], @(NIB_STACK_INLINE_CAPACITY + 7));
+}
+
+- (void)testDoubleStack
+{
+    NIBDoubleStack stack;
+    
+    NIBDoubleStackInit(&stack);
+    
+    XCTAssertTrue(isnan(NIBDoubleStackPop(&stack)));
+    
+    /* test the inline storage is used without allocation */
+    for (NSUInteger i = 0; i < NIB_STACK_INLINE_CAPACITY; i++) {
+        NIBDoubleStackPush(&stack, i);
+    }
+    
+    XCTAssertTrue(stack.heapValues == NULL);
+    
+    /* test the values are kept when the stack grows */
+    NIBDoubleStackPush(&stack, 0.5);
+    
+    XCTAssertTrue(stack.heapValues != NULL);
+    XCTAssertEqual(NIBDoubleStackPeek(&stack), 0.5);
+    XCTAssertEqual(NIBDoubleStackPop(&stack), 0.5);
+    
+    for (NSUInteger i = NIB_STACK_INLINE_CAPACITY; i > 0; i--) {
+        XCTAssertEqual(NIBDoubleStackPop(&stack), i - 1);
+    }
+    
+    XCTAssertTrue(isnan(NIBDoubleStackPeek(&stack)));
+    
+    NIBDoubleStackFree(&stack);
+    
+    XCTAssertTrue(stack.heapValues == NULL);
+    XCTAssertEqual(stack.capacity, NIB_STACK_INLINE_CAPACITY);
+}
+
+@end
@@ -0,0 +1,185 @@
+//
+//  NIBCalculatorTapeTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBCalculatorTape.h"
+#import "NIBConstants.h"
+
+#pragma mark -
+
+@interface NIBCalculatorTapeTests : XCTestCase
+
+@property (readwrite, copy, nonatomic) NSString *path;
+
+@end
+
+#pragma mark -
+
+@implementation NIBCalculatorTapeTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:NULL];
+    [super tearDown];
+}
+
+#pragma mark - Tape Testing
+
+- (void)testRecordingCompletedExpressions
+{
+    NIBCalculatorBrain *calculator = [[NIBCalculatorBrain alloc] init];
+    NIBTokenBuffer expression = {NULL, 0, 0};
+    double result = 0;
+    
+    calculator.tape = [NIBCalculatorTape tapeWithCapacity:4 contentsOfFile:nil];
+    
+    /* test 2 + 3 = is recorded with its result */
+    [calculator pushOperand:2];
+    [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonAddition]];
+    [calculator pushOperand:3];
+    [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqual(calculator.tape.count, 1);
+    XCTAssertTrue([calculator.tape getEntryAtIndex:0 expression:&expression result:&result]);
+    XCTAssertEqual(expression.count, 3);
+    XCTAssertEqual(expression.tokens[0].operand, 2);
+    XCTAssertTrue(NIBTokenIsOperatorWithTag(expression.tokens[1], NIBButtonAddition));
+    XCTAssertEqual(expression.tokens[2].operand, 3);
+    XCTAssertEqual(result, 5);
+    
+    /* test the repeated + 3 is recorded on its operand */
+    NIBTokenBufferTruncate(&expression, 0);
+    [calculator pushOperand:10];
+    [calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertTrue([calculator.tape getEntryAtIndex:1 expression:&expression result:&result]);
+    XCTAssertEqual(expression.count, 3);
+    XCTAssertEqual(expression.tokens[0].operand, 10);
+    XCTAssertEqual(result, 13);
+    XCTAssertFalse([calculator.tape getEntryAtIndex:2 expression:NULL result:NULL]);
+    
+    NIBTokenBufferFree(&expression);
+}
+
+- (void)testRingBufferKeepsLastEntries
+{
+    NIBCalculatorTape *tape = [NIBCalculatorTape tapeWithCapacity:3 contentsOfFile:nil];
+    NIBToken token = NIBTokenMakeOperand(0);
+    double result = 0;
+    
+    for (NSInteger i = 1; i <= 5; i++) {
+        token.operand = i;
+        [tape appendExpression:&token count:1 result:i];
+    }
+    
+    /* test the two oldest entries are dropped */
+    XCTAssertEqual(tape.count, 3);
+    XCTAssertTrue([tape getEntryAtIndex:0 expression:NULL result:&result]);
+    XCTAssertEqual(result, 3);
+    XCTAssertTrue([tape getEntryAtIndex:2 expression:NULL result:&result]);
+    XCTAssertEqual(result, 5);
+    
+    /* test an expression longer than the ring buffer can keep is dropped from it */
+    NIBTokenBuffer longExpression = {NULL, 0, 0};
+    
+    for (NSUInteger i = 0; i < 1000; i++) {
+        NIBTokenBufferAppend(&longExpression, token);
+    }
+    
+    [tape appendExpression:longExpression.tokens count:longExpression.count result:6];
+    
+    XCTAssertEqual(tape.count, 3);
+    XCTAssertTrue([tape getEntryAtIndex:2 expression:NULL result:&result]);
+    XCTAssertEqual(result, 5);
+    
+    NIBTokenBufferFree(&longExpression);
+}
+
+- (void)testReopeningLog
+{
+    NIBCalculatorTape *tape = [NIBCalculatorTape tapeWithCapacity:2 contentsOfFile:self.path];
+    NIBToken tokens[3] = {NIBTokenMakeOperand(0), NIBTokenMakeOperator(NIBButtonMultiplication), NIBTokenMakeOperand(2)};
+    
+    /* log enough entries to grow the file several times */
+    for (NSInteger i = 0; i < 10000; i++) {
+        tokens[0].operand = i;
+        [tape appendExpression:tokens count:3 result:2 * i];
+    }
+    
+    tape = nil;
+    
+    /* test the reopened tape has every entry and keeps the last ones in memory */
+    NIBCalculatorTape *reopenedTape = [NIBCalculatorTape tapeWithCapacity:2 contentsOfFile:self.path];
+    NIBTokenBuffer expression = {NULL, 0, 0};
+    double result = 0;
+    __block NSInteger enumeratedCount = 0;
+    __block double lastResult = NAN;
+    
+    XCTAssertEqual(reopenedTape.loggedCount, 10000);
+    XCTAssertEqual(reopenedTape.count, 2);
+    XCTAssertTrue([reopenedTape getEntryAtIndex:1 expression:&expression result:&result]);
+    XCTAssertEqual(expression.count, 3);
+    XCTAssertEqual(expression.tokens[0].operand, 9999);
+    XCTAssertEqual(result, 19998);
+    
+    [reopenedTape enumerateLoggedEntriesWithOptions:0 usingBlock:^(const NIBToken *entryTokens, NSUInteger count, double __unused entryResult, BOOL * __unused stop) {
+        XCTAssertEqual(count, 3);
+        XCTAssertEqual(entryTokens[0].operand, enumeratedCount);
+        enumeratedCount++;
+    }];
+    [reopenedTape enumerateLoggedEntriesWithOptions:NSEnumerationReverse usingBlock:^(const NIBToken * __unused entryTokens, NSUInteger __unused count, double entryResult, BOOL *stop) {
+        lastResult = entryResult;
+        *stop = YES;
+    }];
+    
+    XCTAssertEqual(enumeratedCount, 10000);
+    XCTAssertEqual(lastResult, 19998);
+    
+    /* test the entries are removed from the log */
+    [reopenedTape removeAllEntries];
+    reopenedTape = nil;
+    
+    XCTAssertEqual([NIBCalculatorTape tapeWithCapacity:2 contentsOfFile:self.path].loggedCount, 0);
+    
+    NIBTokenBufferFree(&expression);
+}
+
+- (void)testDamagedLog
+{
+    NIBCalculatorTape *tape = [NIBCalculatorTape tapeWithCapacity:2 contentsOfFile:self.path];
+    NIBToken token = NIBTokenMakeOperand(1);
+    
+    [tape appendExpression:&token count:1 result:1];
+    [tape appendExpression:&token count:1 result:2];
+    tape = nil;
+    
+    /* damage the last byte of the last record */
+    NSMutableData *contents = [NSMutableData dataWithContentsOfFile:self.path];
+    
+    ((uint8_t *)contents.mutableBytes)[contents.length - 1] ^= 0xFF;
+    [contents writeToFile:self.path atomically:YES];
+    
+    /* test the log ends before the damaged record */
+    NIBCalculatorTape *reopenedTape = [NIBCalculatorTape tapeWithCapacity:2 contentsOfFile:self.path];
+    double result = 0;
+    
+    XCTAssertEqual(reopenedTape.loggedCount, 1);
+    XCTAssertEqual(reopenedTape.count, 1);
+    XCTAssertTrue([reopenedTape getEntryAtIndex:0 expression:NULL result:&result]);
+    XCTAssertEqual(result, 1);
+}
+
+@end
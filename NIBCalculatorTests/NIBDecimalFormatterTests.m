@@ -0,0 +1,123 @@
+//
+//  NIBDecimalFormatterTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBDecimalFormatter.h"
+
+#pragma mark -
+
+@interface NIBDecimalFormatterTests : XCTestCase
+
+@property (readwrite, copy, nonatomic) NSArray<NSString *> *localeIdentifiers;
+
+@end
+
+#pragma mark -
+
+@implementation NIBDecimalFormatterTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.localeIdentifiers = @[@"en_US", @"fi_FI", @"de_DE", @"en_IN", @"es_ES", @"fr_CH"];
+}
+
+#pragma mark - Formatting Testing
+
+- (void)testFormattingWithFractionDigits
+{
+    const double values[] = {0, 1, -1, 0.1, 0.1 + 0.2, -4.6 / 2.2, 4.3 * 5.3, 3.4 - 2.1, -3.3 + 2.5, 2.675, 0.0005,
+                             -0.0004, 1234.5678, -98765.4321, 1234567.891, 1e15 + 0.3, 123456789012345678.0};
+    
+    for (NSString *localeIdentifier in self.localeIdentifiers) {
+        NSLocale *locale = [[NSLocale alloc] initWithLocaleIdentifier:localeIdentifier];
+        NIBDecimalFormatter *decimalFormatter = [NIBDecimalFormatter formatterWithLocale:locale];
+        
+        for (NSUInteger fractionDigits = 0; fractionDigits <= 15; fractionDigits++) {
+            NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
+            numberFormatter.locale = locale;
+            numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+            numberFormatter.maximumFractionDigits = fractionDigits;
+            
+            for (NSUInteger i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+                NSString *expectedStr = [numberFormatter stringFromNumber:@(values[i])];
+                
+                XCTAssertEqualObjects([decimalFormatter stringFromDouble:values[i] maximumFractionDigits:fractionDigits], expectedStr,
+                                      @"The string of %.17g with %lu fraction digits in %@ is incorrect!", values[i], (unsigned long)fractionDigits, localeIdentifier);
+            }
+        }
+    }
+}
+
+- (void)testFormattingWithSignificantDigits
+{
+    const double values[] = {0, 7, -7, 1000, -1234, 12345, 999999999, -123456789, 9007199254740993.0, 12345678901234567890.0};
+    
+    for (NSString *localeIdentifier in self.localeIdentifiers) {
+        NSLocale *locale = [[NSLocale alloc] initWithLocaleIdentifier:localeIdentifier];
+        NIBDecimalFormatter *decimalFormatter = [NIBDecimalFormatter formatterWithLocale:locale];
+        
+        for (NSUInteger significantDigits = 1; significantDigits <= 16; significantDigits++) {
+            NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
+            numberFormatter.locale = locale;
+            numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+            numberFormatter.usesGroupingSeparator = YES;
+            numberFormatter.usesSignificantDigits = YES;
+            numberFormatter.maximumSignificantDigits = significantDigits;
+            
+            for (NSUInteger i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+                NSString *expectedStr = [numberFormatter stringFromNumber:@(values[i])];
+                
+                XCTAssertEqualObjects([decimalFormatter stringFromDouble:values[i] maximumSignificantDigits:significantDigits], expectedStr,
+                                      @"The string of %.17g with %lu significant digits in %@ is incorrect!", values[i], (unsigned long)significantDigits, localeIdentifier);
+            }
+        }
+    }
+}
+
+- (void)testCountingDigits
+{
+    NIBDecimalFormatter *decimalFormatter = [NIBDecimalFormatter formatterWithLocale:[[NSLocale alloc] initWithLocaleIdentifier:@"en_US"]];
+    
+    XCTAssertEqual([decimalFormatter digitsOfDouble:-1234.5678 maximumFractionDigits:2], (NSUInteger)6, @"The digits of -1,234.57 are incorrect!");
+    XCTAssertEqual([decimalFormatter digitsOfDouble:0.0001 maximumFractionDigits:3], (NSUInteger)1, @"The digits of 0 are incorrect!");
+    XCTAssertEqual([decimalFormatter digitsOfIntegerPartOfDouble:-1234.5678 maximumFractionDigits:2], (NSUInteger)4, @"The digits of integer part of -1,234.57 are incorrect!");
+    XCTAssertEqual([decimalFormatter digitsOfIntegerPartOfDouble:1234.0001 maximumFractionDigits:2], (NSUInteger)4, @"The digits of integer part of 1,234 are incorrect!");
+}
+
+#pragma mark - Parsing Testing
+
+- (void)testParsing
+{
+    NSArray<NSString *> *numStrs = @[@"-4,6", @"2,2", @"4,3", @"5,3", @"3,4", @"2,1", @"-3,3", @"2,5", @"0,", @"1 234,5"];
+    NSLocale *locale = [[NSLocale alloc] initWithLocaleIdentifier:@"fi_FI"];
+    NIBDecimalFormatter *decimalFormatter = [NIBDecimalFormatter formatterWithLocale:locale];
+    NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
+    numberFormatter.locale = locale;
+    numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+    numberFormatter.lenient = YES;
+    
+    for (NSString *numStr in numStrs) {
+        NSString *localizedStr = [numStr stringByReplacingOccurrencesOfString:@" " withString:decimalFormatter.groupingSeparator];
+        NSNumber *expectedNumber = [numberFormatter numberFromString:localizedStr];
+        double value = 0;
+        
+        XCTAssertEqual([decimalFormatter getDouble:&value fromString:localizedStr], decimalFormatter.isCompatible, @"The string ”%@” is not parsed!", localizedStr);
+        
+        /* a string the formatter does not parse is left to the number formatter */
+        if (decimalFormatter.isCompatible) {
+            XCTAssertEqual(value, expectedNumber.doubleValue, @"The number of ”%@” is incorrect!", localizedStr);
+        }
+    }
+    
+    /* test a string in scientific notation is left to the number formatter */
+    double value = 0;
+    XCTAssertFalse([decimalFormatter getDouble:&value fromString:@"1,5e10"], @"The string in scientific notation is parsed!");
+}
+
+@end
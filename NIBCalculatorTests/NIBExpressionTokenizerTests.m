@@ -0,0 +1,159 @@
+//
+//  NIBExpressionTokenizerTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBCalculatorBrain.h"
+#import "NIBConstants.h"
+#import "NIBExpressionTokenizer.h"
+
+#pragma mark -
+
+@interface NIBExpressionTokenizerTests : XCTestCase
+
+@property (readwrite, strong, nonatomic) NIBCalculatorBrain *calculator;
+
+/**
+ Tokenize an expression with a decimal point and perform it on the calculator.
+ 
+ @param expression  The expression.
+ 
+ @return Returns the display after the expression, or nil if the text is not
+ an expression.
+ */
+- (NSNumber *_Nullable)performExpression:(const char *)expression;
+
+@end
+
+#pragma mark -
+
+@implementation NIBExpressionTokenizerTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.calculator = [[NIBCalculatorBrain alloc] init];
+}
+
+#pragma mark - Tokenizing Testing
+
+- (void)testTokenizingExpression
+{
+    const char *text = "2 + 9 sqrt x 3 =";
+    NIBNumberSeparators separators = NIBNumberSeparatorsOfLocale(nil);
+    NIBTokenBuffer tokens = {0};
+    
+    XCTAssertTrue(NIBTokenizeExpression(text, strlen(text), &separators, &tokens, NULL));
+    XCTAssertEqual(tokens.count, 7, @"Number of tokens of %s is incorrect", text);
+    XCTAssertEqual(tokens.tokens[0].operand, 2, @"Token 2 is incorrect");
+    XCTAssertTrue(NIBTokenIsOperatorWithTag(tokens.tokens[1], NIBButtonAddition), @"Token + is incorrect");
+    XCTAssertEqual(tokens.tokens[2].operand, 9, @"Token 9 is incorrect");
+    XCTAssertTrue(NIBTokenIsOperatorWithTag(tokens.tokens[3], NIBButtonSquareRootOfX), @"Token sqrt is incorrect");
+    XCTAssertTrue(NIBTokenIsOperatorWithTag(tokens.tokens[4], NIBButtonMultiplication), @"Token x is incorrect");
+    XCTAssertTrue(NIBTokenIsOperatorWithTag(tokens.tokens[6], NIBButtonEquality), @"Token = is incorrect");
+    
+    /* test a function before its operand follows it */
+    text = "sqrt(2 + 7)";
+    NIBTokenBufferTruncate(&tokens, 0);
+    
+    XCTAssertTrue(NIBTokenizeExpression(text, strlen(text), &separators, &tokens, NULL));
+    XCTAssertEqual(tokens.count, 6, @"Number of tokens of %s is incorrect", text);
+    XCTAssertTrue(NIBTokenIsOperatorWithTag(tokens.tokens[4], NIBButtonClosingParenthesis), @"Token ) is incorrect");
+    XCTAssertTrue(NIBTokenIsOperatorWithTag(tokens.tokens[5], NIBButtonSquareRootOfX), @"Token sqrt is incorrect");
+    
+    NIBTokenBufferFree(&tokens);
+}
+
+- (void)testTokenizingNumbers
+{
+    NIBNumberSeparators separators = {",", "."};
+    NIBTokenBuffer tokens = {0};
+    const char *text = "1.234,5 x -2e-3";
+    
+    /* test the separators of the locale */
+    XCTAssertTrue(NIBTokenizeExpression(text, strlen(text), &separators, &tokens, NULL));
+    XCTAssertEqual(tokens.count, 3, @"Number of tokens of %s is incorrect", text);
+    XCTAssertEqual(tokens.tokens[0].operand, 1234.5, @"Token 1.234,5 is incorrect");
+    XCTAssertEqual(tokens.tokens[2].operand, -2e-3, @"Token -2e-3 is incorrect");
+    
+    /* test a description ending with a digit does not take the digits of a number */
+    text = "2^25";
+    NIBTokenBufferTruncate(&tokens, 0);
+    
+    XCTAssertTrue(NIBTokenizeExpression(text, strlen(text), &separators, &tokens, NULL));
+    XCTAssertEqual(tokens.count, 3, @"Number of tokens of %s is incorrect", text);
+    XCTAssertTrue(NIBTokenIsOperatorWithTag(tokens.tokens[1], NIBButtonXPowerY), @"Token ^ is incorrect");
+    XCTAssertEqual(tokens.tokens[2].operand, 25, @"Token 25 is incorrect");
+    
+    NIBTokenBufferFree(&tokens);
+}
+
+- (void)testTokenizingInvalidExpressions
+{
+    NIBNumberSeparators separators = NIBNumberSeparatorsOfLocale(nil);
+    NIBTokenBuffer tokens = {0};
+    NSUInteger errorOffset = 0;
+    
+    XCTAssertFalse(NIBTokenizeExpression("2 + abc", 7, &separators, &tokens, &errorOffset));
+    XCTAssertEqual(errorOffset, 4, @"Error offset of 2 + abc is incorrect");
+    XCTAssertEqual(tokens.count, 0, @"Tokens of 2 + abc are kept");
+    
+    XCTAssertFalse(NIBTokenizeExpression("1)", 2, &separators, &tokens, &errorOffset));
+    XCTAssertEqual(errorOffset, 1, @"Error offset of 1) is incorrect");
+    
+    XCTAssertFalse(NIBTokenizeExpression("sqrt", 4, &separators, &tokens, &errorOffset));
+    
+    NIBTokenBufferFree(&tokens);
+}
+
+#pragma mark - Performing Expressions Testing
+
+- (void)testPerformingExpression
+{
+    XCTAssertEqualObjects([self performExpression:"2 + 3 x 4 ="], [[NSNumber alloc] initWithDouble:14], @"Calculation 2 + 3 x 4 = is incorrect");
+    XCTAssertEqualObjects([self performExpression:"(2 + 3) x 4 ="], [[NSNumber alloc] initWithDouble:20], @"Calculation (2 + 3) x 4 = is incorrect");
+    XCTAssertEqualObjects([self performExpression:"sqrt(2 + 7) x 2 ="], [[NSNumber alloc] initWithDouble:6], @"Calculation sqrt(2 + 7) x 2 = is incorrect");
+    XCTAssertEqualObjects([self performExpression:"3! + 4 ^2 ="], [[NSNumber alloc] initWithDouble:22], @"Calculation 3! + 4 ^2 = is incorrect");
+    XCTAssertEqualObjects([self performExpression:"1 / 0 ="], [NSDecimalNumber notANumber], @"Calculation 1 / 0 = is incorrect");
+    XCTAssertNil([self performExpression:""], @"Calculation of no expression is incorrect");
+}
+
+- (void)testPerformingExpressionAsKeys
+{
+    NSNumber *calculatedResult = nil;
+    
+    /* test the expression leaves the calculator as the keys do */
+    calculatedResult = [self performExpression:"2 x 5 ="];
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:10], @"Calculation 2 x 5 = is incorrect");
+    
+    /* test repeating x 5 on the result */
+    [self.calculator pushOperand:calculatedResult.doubleValue];
+    calculatedResult = [self.calculator performOperator:[NIBOperator operatorWithTag:NIBButtonEquality]];
+    
+    XCTAssertEqualObjects(calculatedResult, [[NSNumber alloc] initWithDouble:50], @"Calculation 10 x 5 = is incorrect");
+}
+
+#pragma mark - Helpers
+
+- (NSNumber *)performExpression:(const char *)expression
+{
+    NIBNumberSeparators separators = NIBNumberSeparatorsOfLocale(nil);
+    NIBTokenBuffer tokens = {0};
+    NSNumber *result = nil;
+    
+    if (NIBTokenizeExpression(expression, strlen(expression), &separators, &tokens, NULL)) {
+        [self.calculator clearArithmetic];
+        result = [self.calculator performExpression:tokens.tokens count:tokens.count];
+    }
+    
+    NIBTokenBufferFree(&tokens);
+    
+    return result;
+}
+
+@end
@@ -0,0 +1,88 @@
+//
+//  NIBInstrumentationTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBInstrumentation.h"
+#import "NIBConstants.h"
+
+@interface NIBInstrumentationTests : XCTestCase
+
+@end
+
+@implementation NIBInstrumentationTests
+
+- (void)setUp {
+    [super setUp];
+    [NIBInstrumentation reset];
+}
+
+- (void)tearDown {
+    [NIBInstrumentation reset];
+    [super tearDown];
+}
+
+- (void)testLatencyHistogram
+{
+    /* record 1 to 1000 nanoseconds of evaluation */
+    for (uint64_t duration = 1; duration <= 1000; duration++) {
+        NIBInstrumentationRecordInterval(NIBInstrumentationStageEvaluation, 1000, 1000 + duration);
+    }
+    
+    NSDictionary<NSString *, id> *latency = [NIBInstrumentation snapshot][@"latency_ns"][@"evaluation"];
+    
+    XCTAssertEqualObjects(latency[@"count"], @1000);
+    XCTAssertEqualObjects(latency[@"min"], @1);
+    XCTAssertEqualObjects(latency[@"max"], @1000);
+    XCTAssertEqualWithAccuracy([latency[@"mean"] doubleValue], 500.5, 0.001);
+    
+    /* test the percentiles are within a bucket, 1/16 of the values */
+    XCTAssertEqualWithAccuracy([latency[@"p50"] doubleValue], 500, 500 / 16.0);
+    XCTAssertEqualWithAccuracy([latency[@"p99"] doubleValue], 990, 990 / 16.0);
+    XCTAssertLessThanOrEqual([latency[@"p99.9"] doubleValue], 1000);
+    
+    /* test the other stages are empty */
+    XCTAssertEqualObjects([NIBInstrumentation snapshot][@"latency_ns"][@"formatting"][@"count"], @0);
+}
+
+- (void)testCounters
+{
+    NIBToken tokens[3] = {NIBTokenMakeOperand(2), NIBTokenMakeOperand(3), NIBTokenMakeOperator(NIBButtonAddition)};
+    
+    NIBInstrumentationCountOperators(NIBInstrumentationOperatorCounterPostfix, tokens, 3);
+    NIBInstrumentationCountOperator(NIBInstrumentationOperatorCounterUnary, NIBButtonSquareRootOfX);
+    NIBInstrumentationCountOperator(NIBInstrumentationOperatorCounterUnary, NIBButtonSquareRootOfX);
+    NIBInstrumentationCountAllocation(NIBInstrumentationAllocationTokenBuffer, 64);
+    
+    NSDictionary<NSString *, id> *snapshot = [NIBInstrumentation snapshot];
+    NSString *additionKey = [NSString stringWithFormat:@"%ld", (long)NIBButtonAddition];
+    NSString *squareRootKey = [NSString stringWithFormat:@"%ld", (long)NIBButtonSquareRootOfX];
+    
+    XCTAssertEqualObjects(snapshot[@"operators"][@"postfix"], @{additionKey : @1}, @"Operands are counted as operators");
+    XCTAssertEqualObjects(snapshot[@"operators"][@"unary"][squareRootKey], @2);
+    XCTAssertEqualObjects(snapshot[@"allocations"][@"token_buffer"][@"count"], @1);
+    XCTAssertEqualObjects(snapshot[@"allocations"][@"token_buffer"][@"bytes"], @64);
+    
+    /* test the snapshot can be written as JSON */
+    XCTAssertTrue([NSJSONSerialization isValidJSONObject:snapshot]);
+}
+
+- (void)testChromeTrace
+{
+    NIBInstrumentationRecordInterval(NIBInstrumentationStageKeyAction, 2000, 5000);
+    
+    NSDictionary<NSString *, id> *trace = [NSJSONSerialization JSONObjectWithData:[NIBInstrumentation chromeTraceData] options:0 error:NULL];
+    NSArray<NSDictionary<NSString *, id> *> *events = trace[@"traceEvents"];
+    
+    XCTAssertEqual(events.count, 1);
+    XCTAssertEqualObjects(events[0][@"name"], @"key_action");
+    XCTAssertEqualObjects(events[0][@"ph"], @"X");
+    XCTAssertEqualWithAccuracy([events[0][@"ts"] doubleValue], 2, 0.001, @"Time is not in microseconds");
+    XCTAssertEqualWithAccuracy([events[0][@"dur"] doubleValue], 3, 0.001, @"Duration is not in microseconds");
+}
+
+@end
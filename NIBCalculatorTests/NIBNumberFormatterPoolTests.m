@@ -0,0 +1,64 @@
+//
+//  NIBNumberFormatterPoolTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBNumberFormatterPool.h"
+
+#pragma mark -
+
+@interface NIBNumberFormatterPoolTests : XCTestCase
+
+@end
+
+#pragma mark -
+
+@implementation NIBNumberFormatterPoolTests
+
+#pragma mark - Formatter Sharing Testing
+
+- (void)testFormatterIsShared
+{
+    NSNumberFormatter *numberFormatter = [NIBNumberFormatterPool decimalFormatterWithMaximumFractionDigits:8];
+    
+    XCTAssertEqual(numberFormatter, [NIBNumberFormatterPool decimalFormatterWithMaximumFractionDigits:8], @"Formatter with 8 fraction digits is not shared");
+    XCTAssertNotEqual(numberFormatter, [NIBNumberFormatterPool decimalFormatterWithMaximumFractionDigits:9], @"Formatters with 8 and 9 fraction digits are shared");
+    XCTAssertNotEqual(numberFormatter, [NIBNumberFormatterPool decimalFormatterWithMaximumSignificantDigits:8], @"Formatters with 8 fraction digits and 8 significant digits are shared");
+    XCTAssertEqual(numberFormatter.maximumFractionDigits, (NSUInteger)8, @"Fraction digits of formatter are incorrect");
+    XCTAssertEqualObjects(numberFormatter.locale, [NSLocale currentLocale], @"Locale of formatter is incorrect");
+}
+
+- (void)testFormatterWithFormats
+{
+    NSNumberFormatter *numberFormatter = [NIBNumberFormatterPool formatterWithPositiveFormat:@"0.#E0"
+                                                                              negativeFormat:@"-0.#E0"
+                                                                              exponentSymbol:@"e"];
+    
+    XCTAssertEqual(numberFormatter, [NIBNumberFormatterPool formatterWithPositiveFormat:@"0.#E0" negativeFormat:@"-0.#E0" exponentSymbol:@"e"], @"Formatter with formats is not shared");
+    XCTAssertNotEqual(numberFormatter, [NIBNumberFormatterPool formatterWithPositiveFormat:@"0.#E0" negativeFormat:@"-0.#E0" exponentSymbol:nil], @"Formatters with different exponent symbols are shared");
+    XCTAssertEqualObjects([numberFormatter stringFromNumber:@(-25000)], @"-2.5e4", @"Formatter with formats is incorrect");
+}
+
+#pragma mark - Invalidation Testing
+
+- (void)testPoolIsEmptiedWhenLocaleChanges
+{
+    NSNumberFormatter *numberFormatter = [NIBNumberFormatterPool lenientDecimalFormatter];
+    
+    /* test the pool is emptied */
+    [NIBNumberFormatterPool removeAllFormatters];
+    
+    XCTAssertNotEqual(numberFormatter, [NIBNumberFormatterPool lenientDecimalFormatter], @"Formatter is shared after the pool is emptied");
+    
+    /* test the pool is emptied by a locale change */
+    numberFormatter = [NIBNumberFormatterPool lenientDecimalFormatter];
+    [[NSNotificationCenter defaultCenter] postNotificationName:NSCurrentLocaleDidChangeNotification object:nil];
+    
+    XCTAssertNotEqual(numberFormatter, [NIBNumberFormatterPool lenientDecimalFormatter], @"Formatter is shared after the locale changes");
+}
+
+@end
@@ -0,0 +1,105 @@
+//
+//  NIBOperatorTests.m
+//  NIBCalculatorTests
+//
+//  Created by Lieu Vu on 10/17/26.
+//  Copyright © 2026 LV. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NIBOperator.h"
+#import "NIBConstants.h"
+
+#pragma mark -
+
+@interface NIBOperatorTests : XCTestCase
+
+@end
+
+#pragma mark -
+
+@implementation NIBOperatorTests
+
+#pragma mark - Operator Creation Testing
+
+- (void)testOperatorIsShared
+{
+    NIBOperator *operator = [NIBOperator operatorWithTag:NIBButtonAddition];
+    
+    XCTAssertEqual(operator, [NIBOperator operatorWithTag:NIBButtonAddition], @"Operator + is not shared");
+    XCTAssertNotEqual(operator, [NIBOperator operatorWithTag:NIBButtonSubstraction], @"Operators + and - are shared");
+    XCTAssertEqual(operator.idx, (NSInteger)NIBButtonAddition, @"Tag of operator + is incorrect");
+}
+
+#pragma mark - Operator Classification Testing
+
+- (void)testOperatorClassification
+{
+    NIBButtonTag binaryTags[] = { NIBButtonAddition, NIBButtonSubstraction, NIBButtonMultiplication,
+                                  NIBButtonDivision, NIBButtonXPowerY, NIBButtonYPowerX,
+                                  NIBButtonYthRootOfX, NIBButtonLogarithmBaseYOfX, NIBButtonEE };
+    
+    /* test binary operators */
+    for (NSUInteger i = 0; i < sizeof(binaryTags)/sizeof(binaryTags[0]); i++) {
+        NIBOperator *operator = [NIBOperator operatorWithTag:binaryTags[i]];
+        
+        XCTAssertTrue([operator isBinaryOperator], @"Operator %@ is not binary", operator);
+        XCTAssertFalse([operator isUnaryOperator], @"Operator %@ is unary", operator);
+        XCTAssertFalse([operator isParanthesis], @"Operator %@ is a parenthesis", operator);
+    }
+    
+    /* test parentheses */
+    XCTAssertTrue([[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis] isOpeningParanthesis], @"Operator ( is not an opening parenthesis");
+    XCTAssertTrue([[NIBOperator operatorWithTag:NIBButtonClosingParenthesis] isClosingParanthesis], @"Operator ) is not a closing parenthesis");
+    XCTAssertFalse([[NIBOperator operatorWithTag:NIBButtonOpenningParenthesis] isUnaryOperator], @"Operator ( is unary");
+    XCTAssertFalse([[NIBOperator operatorWithTag:NIBButtonClosingParenthesis] isBinaryOperator], @"Operator ) is binary");
+    
+    /* test unary operators */
+    XCTAssertTrue([[NIBOperator operatorWithTag:NIBButtonSin] isUnaryOperator], @"Operator sin is not unary");
+    XCTAssertTrue([[NIBOperator operatorWithTag:NIBButtonXFactorial] isUnaryOperator], @"Operator ! is not unary");
+    XCTAssertTrue([[NIBOperator operatorWithTag:NIBButtonPercentage] isUnaryOperator], @"Operator %% is not unary");
+}
+
+- (void)testOperatorPriority
+{
+    NIBOperator *addition = [NIBOperator operatorWithTag:NIBButtonAddition];
+    NIBOperator *substraction = [NIBOperator operatorWithTag:NIBButtonSubstraction];
+    NIBOperator *multiplication = [NIBOperator operatorWithTag:NIBButtonMultiplication];
+    NIBOperator *power = [NIBOperator operatorWithTag:NIBButtonXPowerY];
+    
+    XCTAssertEqual([addition comparePriorityWithOperator:substraction], NSOrderedSame, @"Priority of + and - is incorrect");
+    XCTAssertEqual([addition comparePriorityWithOperator:multiplication], NSOrderedAscending, @"Priority of + and x is incorrect");
+    XCTAssertEqual([power comparePriorityWithOperator:multiplication], NSOrderedDescending, @"Priority of ^ and x is incorrect");
+}
+
+#pragma mark - Operator Description Testing
+
+- (void)testOperatorDescription
+{
+    XCTAssertEqualObjects([[NIBOperator operatorWithTag:NIBButtonDivision] description], @"/", @"Description of / is incorrect");
+    XCTAssertEqualObjects([[NIBOperator operatorWithTag:NIBButtonEE] description], @"x10^", @"Description of EE is incorrect");
+    XCTAssertEqualObjects([[NIBOperator operatorWithTag:NIBButtonArcTanh] description], @"arctanh", @"Description of arctanh is incorrect");
+    XCTAssertNil([[NIBOperator operatorWithTag:NIBButtonOne] description], @"Description of a digit is incorrect");
+}
+
+- (void)testOperatorTagOfDescriptionPrefix
+{
+    NSUInteger length = 0;
+    
+    /* test the longest description is found */
+    XCTAssertEqual(NIBOperatorTagOfDescriptionPrefix("x10^3", 5, &length), (NSInteger)NIBButtonEE, @"Operator of x10^3 is incorrect");
+    XCTAssertEqual(length, 4, @"Length of x10^ is incorrect");
+    XCTAssertEqual(NIBOperatorTagOfDescriptionPrefix("arcsinh", 7, &length), (NSInteger)NIBButtonArcSinh, @"Operator of arcsinh is incorrect");
+    XCTAssertEqual(NIBOperatorTagOfDescriptionPrefix("log2", 4, &length), (NSInteger)NIBButtonLogarithmBaseTwo, @"Operator of log2 is incorrect");
+    
+    /* test the text is not read beyond its length */
+    XCTAssertEqual(NIBOperatorTagOfDescriptionPrefix("log2", 3, &length), (NSInteger)NIBButtonLogarithmBaseYOfX, @"Operator of log is incorrect");
+    
+    /* test the shared description is found for the lower tag */
+    XCTAssertEqual(NIBOperatorTagOfDescriptionPrefix("^", 1, &length), (NSInteger)NIBButtonXPowerY, @"Operator of ^ is incorrect");
+    
+    /* test a text without description */
+    XCTAssertEqual(NIBOperatorTagOfDescriptionPrefix("7", 1, &length), -1, @"Operator of 7 is incorrect");
+}
+
+@end